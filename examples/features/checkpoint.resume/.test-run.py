@@ -17,6 +17,22 @@ r = call(["python3", "run-cmaes.py"])
 if r!=0:
   exit(r)
 
+r = call(["python3", "run-cmaes-async.py"])
+if r!=0:
+  exit(r)
+
+r = call(["python3", "run-cmaes-async.py"])
+if r!=0:
+  exit(r)
+
+r = call(["python3", "run-adam-multistart.py"])
+if r!=0:
+  exit(r)
+
+r = call(["python3", "run-adam-multistart.py"])
+if r!=0:
+  exit(r)
+
 r = call(["python3", "run-vracer.py"])
 if r!=0:
    exit(r)
@@ -0,0 +1,53 @@
+#!/usr/bin/env python3
+
+# In this example, we demonstrate how a Korali experiment with several
+# starts can be resumed from previous file-saved results. The states of
+# all the starts are stored with the results.
+
+import sys
+import os
+sys.path.append('_model')
+from model import *
+import korali
+
+k = korali.Engine()
+e = korali.Experiment()
+
+# Loading previous run (if exist)
+e["File Output"]["Path"] = "_result_adam_multistart"
+found = e.loadState('_result_adam_multistart/latest')
+
+# If not found, we run first 5 generations.
+if (found == False):
+  print('------------------------------------------------------')
+  print('Running first 5 generations...')
+  print('------------------------------------------------------')
+  e["Solver"]["Termination Criteria"]["Max Generations"] = 5
+
+# If found, we continue with the next 5 generations.
+if (found == True):
+  print('------------------------------------------------------')
+  print('Running next 5 generations...')
+  print('------------------------------------------------------')
+  e["Solver"]["Termination Criteria"]["Max Generations"] = e["Current Generation"] + 5
+
+# Defining experiment
+
+e["Problem"]["Type"] = "Optimization"
+
+e["Solver"]["Type"] = "Optimizer/Adam"
+e["Solver"]["Eta"] = 0.1
+e["Solver"]["Number Of Starts"] = 4
+
+e["Variables"][0]["Name"] = "X"
+e["Variables"][0]["Initial Value"] = 5.0
+e["Variables"][0]["Lower Bound"] = -10.0
+e["Variables"][0]["Upper Bound"] = +10.0
+
+# Setting computational model
+e["Problem"]["Objective Function"] = model_with_gradient
+
+# Making sure we preseve RNG state
+e["Preserve Random Number Generator States"] = True
+
+k.run(e)
@@ -0,0 +1,58 @@
+#!/usr/bin/env python3
+
+# In this example, we demonstrate how a Korali experiment can
+# be resumed from previous file-saved results. This is a useful feature
+# for continuing jobs after an error, or to fragment big jobs into
+# smaller ones that can better fit a supercomputer queue.
+
+# Here, the experiment runs in the asynchronous evaluation mode.
+
+import sys
+import os
+sys.path.append('_model')
+from model import *
+import korali
+
+k = korali.Engine()
+e = korali.Experiment()
+
+# Loading previous run (if exist)
+e["File Output"]["Path"] = "_result_cmaes_async"
+found = e.loadState('_result_cmaes_async/latest')
+
+# If not found, we run first 5 generations.
+if (found == False):
+  print('------------------------------------------------------')
+  print('Running first 5 generations...')
+  print('------------------------------------------------------')
+  e["Solver"]["Termination Criteria"]["Max Generations"] = 5
+
+# If found, we continue with the next 5 generations.
+if (found == True):
+  print('------------------------------------------------------')
+  print('Running next 5 generations...')
+  print('------------------------------------------------------')
+  e["Solver"]["Termination Criteria"]["Max Generations"] = e["Current Generation"] + 5
+ 
+# Defining experiment
+
+e["Problem"]["Type"] = "Optimization"
+
+e["Solver"]["Type"] = "Optimizer/CMAES"
+e["Solver"]["Population Size"] = 5
+
+# The samples in flight when the state is saved are evaluated again after resuming
+e["Solver"]["Evaluation Mode"] = "Asynchronous"
+e["Solver"]["Asynchronous Quorum"] = 2
+
+e["Variables"][0]["Name"] = "X"
+e["Variables"][0]["Lower Bound"] = -10.0
+e["Variables"][0]["Upper Bound"] = +10.0
+
+# Setting computational model
+e["Problem"]["Objective Function"] = model
+
+# Making sure we preseve RNG state
+e["Preserve Random Number Generator States"] = True
+
+k.run(e)
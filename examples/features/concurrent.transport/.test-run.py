@@ -0,0 +1,14 @@
+#! /usr/bin/env python3
+from subprocess import call
+
+r = call(["make", "-j4"])
+if r!=0:
+  exit(r)
+
+for transport in ["Pipe", "Shared Memory"]:
+  for jobs in [1, 4]:
+    r = call(["./run-benchmark", transport, str(jobs), "20000"])
+    if r!=0:
+      exit(r)
+
+exit(0)
@@ -0,0 +1,55 @@
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <korali.hpp>
+#include <string>
+#include <vector>
+
+// No-op model, so that the measured time is dominated by the conduit
+void noOpModel(korali::Sample &s)
+{
+}
+
+int main(int argc, char *argv[])
+{
+  if (argc != 4)
+  {
+    fprintf(stderr, "Usage: %s <Pipe|Shared Memory> <Concurrent Jobs> <Sample Count>\n", argv[0]);
+    return -1;
+  }
+
+  const std::string transport = argv[1];
+  const size_t jobs = atoi(argv[2]);
+  const size_t sampleCount = atoi(argv[3]);
+
+  auto k = korali::Engine();
+  auto e = korali::Experiment();
+
+  std::vector<double> values(sampleCount);
+  for (size_t i = 0; i < sampleCount; i++) values[i] = (double)i;
+
+  e["Problem"]["Type"] = "Propagation";
+  e["Problem"]["Execution Model"] = &noOpModel;
+
+  e["Variables"][0]["Name"] = "X";
+  e["Variables"][0]["Precomputed Values"] = values;
+
+  e["Solver"]["Type"] = "Executor";
+  e["Solver"]["Executions Per Generation"] = sampleCount;
+
+  e["File Output"]["Enabled"] = false;
+  e["Console Output"]["Verbosity"] = "Silent";
+
+  k["Conduit"]["Type"] = "Concurrent";
+  k["Conduit"]["Concurrent Jobs"] = jobs;
+  k["Conduit"]["Transport"] = transport;
+
+  auto startTime = std::chrono::high_resolution_clock::now();
+  k.run(e);
+  auto endTime = std::chrono::high_resolution_clock::now();
+
+  double elapsed = std::chrono::duration<double>(endTime - startTime).count();
+  printf("[Benchmark] Transport: %-14s Jobs: %3lu  Samples: %8lu  Time: %8.3fs  Round-Trips/s: %.0f\n", transport.c_str(), jobs, sampleCount, elapsed, sampleCount / elapsed);
+
+  return 0;
+}
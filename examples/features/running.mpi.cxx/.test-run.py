@@ -13,4 +13,8 @@ r = call(["mpirun", "-n", "9", "./run-tmcmc", "4"])
 if r!=0:
   exit(r)
 
+r = call(["mpirun", "-n", "9", "./run-tmcmc", "2", "Hierarchical"])
+if r!=0:
+  exit(r)
+
 exit(0)
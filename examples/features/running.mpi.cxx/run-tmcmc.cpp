@@ -1,13 +1,17 @@
 #include "_model/jacobi.h"
 #include <korali.hpp>
 #include <stdlib.h>
+#include <string>
 #include <unistd.h>
 
 int main(int argc, char *argv[])
 {
   int n = 1;
+  std::string scheduling = "Flat";
 
-  if (argc == 2)
+  if (argc == 3) scheduling = argv[2];
+
+  if (argc >= 2)
   {
     n = atoi(argv[1]);
     if (64 % n != 0)
@@ -92,7 +96,8 @@ int main(int argc, char *argv[])
 
   k["Conduit"]["Type"] = "Distributed";
   k["Conduit"]["Ranks Per Worker"] = n;
-  k["Conduit"]["Engine Ranks"] = 1;
+  k["Conduit"]["Engine Ranks"] = scheduling == "Hierarchical" ? 3 : 1;
+  k["Conduit"]["Scheduling"] = scheduling;
   k["Profiling"]["Detail"] = "Full";
   k["Profiling"]["Frequency"] = 0.5;
 
@@ -0,0 +1,14 @@
+#! /usr/bin/env python3
+from subprocess import call
+
+r = call(["make", "-j4"])
+if r!=0:
+  exit(r)
+
+# The time per sample should remain constant as the number of samples per generation grows
+for population in [100, 1000, 10000, 100000]:
+  r = call(["./run-benchmark", "1000000", str(population)])
+  if r!=0:
+    exit(r)
+
+exit(0)
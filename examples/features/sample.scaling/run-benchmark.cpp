@@ -0,0 +1,49 @@
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <korali.hpp>
+#include <vector>
+
+// No-op model, so that the measured time is dominated by the engine's sample bookkeeping
+void noOpModel(korali::Sample &s)
+{
+}
+
+int main(int argc, char *argv[])
+{
+  if (argc != 3)
+  {
+    fprintf(stderr, "Usage: %s <Sample Count> <Executions Per Generation>\n", argv[0]);
+    return -1;
+  }
+
+  const size_t sampleCount = atoi(argv[1]);
+  const size_t populationSize = atoi(argv[2]);
+
+  auto k = korali::Engine();
+  auto e = korali::Experiment();
+
+  std::vector<double> values(sampleCount);
+  for (size_t i = 0; i < sampleCount; i++) values[i] = (double)i;
+
+  e["Problem"]["Type"] = "Propagation";
+  e["Problem"]["Execution Model"] = &noOpModel;
+
+  e["Variables"][0]["Name"] = "X";
+  e["Variables"][0]["Precomputed Values"] = values;
+
+  e["Solver"]["Type"] = "Executor";
+  e["Solver"]["Executions Per Generation"] = populationSize;
+
+  e["File Output"]["Enabled"] = false;
+  e["Console Output"]["Verbosity"] = "Silent";
+
+  auto startTime = std::chrono::high_resolution_clock::now();
+  k.run(e);
+  auto endTime = std::chrono::high_resolution_clock::now();
+
+  double elapsed = std::chrono::duration<double>(endTime - startTime).count();
+  printf("[Benchmark] Samples: %8lu  Per Generation: %8lu  Time: %8.3fs  Samples/s: %.0f\n", sampleCount, populationSize, elapsed, sampleCount / elapsed);
+
+  return 0;
+}
@@ -5,6 +5,10 @@ r = call(["python3", "run-adam.py"])
 if r!=0:
   exit(r)
 
+r = call(["python3", "run-adam-multistart.py"])
+if r!=0:
+  exit(r)
+
 r = call(["python3", "run-rprop.py"])
 if r!=0:
   exit(r)
@@ -9,6 +9,22 @@ r = call(["python3", "run-cmaes-gradient.py"])
 if r!=0:
   exit(r)
 
+r = call(["python3", "run-cmaes-bipop.py"])
+if r!=0:
+  exit(r)
+
+r = call(["python3", "run-cmaes-surrogate.py"])
+if r!=0:
+  exit(r)
+
+r = call(["python3", "run-lmcmaes.py"])
+if r!=0:
+  exit(r)
+
+r = call(["python3", "run-vdcmaes.py"])
+if r!=0:
+  exit(r)
+
 r = call(["python3", "run-dea.py"])
 if r!=0:
   exit(r)
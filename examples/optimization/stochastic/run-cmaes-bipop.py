@@ -0,0 +1,55 @@
+#!/usr/bin/env python3
+
+## In this example, we demonstrate how Korali restarts CMA-ES with
+## growing (IPOP) or alternating (BIPOP) population sizes, to find the
+## global maximum of a multimodal function within a fixed budget of
+## model evaluations.
+
+# Importing computational model
+import sys
+import math
+sys.path.append('./_model')
+from model import *
+
+# Starting Korali's Engine
+import korali
+k = korali.Engine()
+
+# Creating new experiment
+e = korali.Experiment()
+
+# Configuring Problem
+e["Random Seed"] = 0xC0FEE
+e["Problem"]["Type"] = "Optimization"
+e["Problem"]["Objective Function"] = negative_ackley
+
+dim = 10
+
+# Defining the problem's variables. Restarts draw their initial mean within the bounds.
+for i in range(dim):
+    e["Variables"][i]["Name"] = "X" + str(i)
+    e["Variables"][i]["Lower Bound"] = -32.0
+    e["Variables"][i]["Upper Bound"] = +32.0
+    e["Variables"][i]["Initial Value"] = 10.0
+    e["Variables"][i]["Initial Standard Deviation"] = 10.0
+
+# Configuring CMA-ES parameters
+e["Solver"]["Type"] = "Optimizer/CMAES"
+e["Solver"]["Population Size"] = 10
+e["Solver"]["Restart Strategy"] = "BIPOP"
+
+# Criteria of a single run, which trigger the restarts
+e["Solver"]["Termination Criteria"]["Min Value Difference Threshold"] = 1e-12
+e["Solver"]["Termination Criteria"]["Max Condition Covariance Matrix"] = 1e14
+
+# Criteria of the whole experiment
+e["Solver"]["Termination Criteria"]["Max Model Evaluations"] = 20000
+e["Solver"]["Termination Criteria"]["Max Value"] = -1e-8
+
+# Configuring results path
+e["File Output"]["Enabled"] = True
+e["File Output"]["Path"] = '_korali_result_cmaes_bipop'
+e["File Output"]["Frequency"] = 100
+
+# Running Korali
+k.run(e)
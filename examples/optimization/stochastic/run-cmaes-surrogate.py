@@ -0,0 +1,46 @@
+#!/usr/bin/env python3
+
+## In this example, we demonstrate how Korali pre-screens the candidates
+## of CMA-ES with a linear-quadratic surrogate, so that only the most
+## promising ones are evaluated with an expensive model.
+
+# Importing computational model
+import sys
+sys.path.append('./_model')
+from model import *
+
+# Starting Korali's Engine
+import korali
+k = korali.Engine()
+
+# Creating new experiment
+e = korali.Experiment()
+
+# Configuring Problem
+e["Random Seed"] = 0xC0FEE
+e["Problem"]["Type"] = "Optimization"
+e["Problem"]["Objective Function"] = negative_rosenbrock
+
+dim = 5
+
+# Defining the problem's variables.
+for i in range(dim):
+    e["Variables"][i]["Name"] = "X" + str(i)
+    e["Variables"][i]["Lower Bound"] = -10.0
+    e["Variables"][i]["Upper Bound"] = +10.0
+
+# Configuring CMA-ES parameters
+e["Solver"]["Type"] = "Optimizer/CMAES"
+e["Solver"]["Population Size"] = 16
+e["Solver"]["Surrogate Model"] = "Linear Quadratic"
+e["Solver"]["Surrogate Rank Agreement Threshold"] = 0.85
+e["Solver"]["Termination Criteria"]["Min Value Difference Threshold"] = 1e-12
+e["Solver"]["Termination Criteria"]["Max Model Evaluations"] = 5000
+
+# Configuring results path
+e["File Output"]["Enabled"] = True
+e["File Output"]["Path"] = '_korali_result_cmaes_surrogate'
+e["File Output"]["Frequency"] = 100
+
+# Running Korali
+k.run(e)
@@ -0,0 +1,46 @@
+#!/usr/bin/env python3
+
+## In this example, we demonstrate how Korali finds values for the
+## variables that maximize the objective function, given by a
+## user-provided computational model.
+
+# Importing computational model
+import sys
+import math
+sys.path.append('./_model')
+from model import *
+
+# Starting Korali's Engine
+import korali
+k = korali.Engine()
+
+# Creating new experiment
+e = korali.Experiment()
+
+# Configuring Problem
+e["Random Seed"] = 0xC0FEE
+e["Problem"]["Type"] = "Optimization"
+e["Problem"]["Objective Function"] = negative_ackley
+
+dim = 10
+
+# Defining the problem's variables.
+for i in range(dim):
+    e["Variables"][i]["Name"] = "X" + str(i)
+    e["Variables"][i]["Initial Value"] = 1.0
+    e["Variables"][i]["Initial Standard Deviation"] = 1.0/math.sqrt(dim)
+
+# Configuring LM-CMA-ES parameters
+e["Solver"]["Type"] = "Optimizer/LMCMAES"
+e["Solver"]["Population Size"] = 32
+e["Solver"]["Mu Value"] = 8
+e["Solver"]["Termination Criteria"]["Min Value Difference Threshold"] = 1e-32
+e["Solver"]["Termination Criteria"]["Max Generations"] = 100
+
+# Configuring results path
+e["File Output"]["Enabled"] = True
+e["File Output"]["Path"] = '_korali_result_lmcmaes'
+e["File Output"]["Frequency"] = 1
+
+# Running Korali
+k.run(e)
@@ -5,8 +5,16 @@ r = call(["python3", "run-mcmc.py"])
 if r!=0:
   exit(r)
   
+r = call(["python3", "run-mcmc-chains.py"])
+if r!=0:
+  exit(r)
+
 r = call(["python3", "run-hmc.py"])
 if r!=0:
   exit(r)
 
+r = call(["python3", "run-hmc-chains.py"])
+if r!=0:
+  exit(r)
+
 exit(0)
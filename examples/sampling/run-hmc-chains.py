@@ -0,0 +1,42 @@
+#!/usr/bin/env python3
+
+# In this example, we demonstrate how Korali samples the posterior
+# distribution in a bayesian problem where the likelihood
+# is provided directly by the computational model.
+# In this case, we use the HMC method with several chains,
+# each one resuming as soon as its own gradient evaluation finishes.
+
+# Importing computational model
+import sys
+sys.path.append('./_model')
+from model import *
+
+# Creating new experiment
+import korali
+e = korali.Experiment()
+
+# Selecting problem and solver types.
+e["Problem"]["Type"] = "Sampling"
+e["Problem"]["Probability Function"] = model
+
+# Configuring the MCMC sampler parameters
+e["Solver"]["Type"] = "Sampler/HMC"
+e["Solver"]["Burn In"] = 500
+e["Solver"]["Chain Count"] = 4
+e["Solver"]["Termination Criteria"]["Max Samples"] = 5000
+
+# Defining problem's variables
+e["Variables"][0]["Name"] = "X"
+e["Variables"][0]["Initial Mean"] = 0.0
+e["Variables"][0]["Initial Standard Deviation"] = 1.0
+
+# Configuring output settings
+e["File Output"]["Frequency"] = 500
+e["File Output"]["Path"] = '_korali_result_hmc_chains'
+e["Console Output"]["Frequency"] = 500
+e["Console Output"]["Verbosity"] = "Detailed"
+
+# Starting Korali's Engine and running experiment
+k = korali.Engine()
+k.run(e)
+
@@ -0,0 +1,43 @@
+#!/usr/bin/env python3
+
+# In this example, we demonstrate how Korali samples the posterior
+# distribution with several MCMC chains advanced in lock-step.
+# The candidates of all chains are evaluated in parallel, and
+# the chains interact through differential evolution proposals.
+
+# Importing computational model
+import sys
+sys.path.append('./_model')
+from model import *
+
+# Creating new experiment
+import korali
+e = korali.Experiment()
+
+# Selecting problem and solver types.
+e["Problem"]["Type"] = "Sampling"
+e["Problem"]["Probability Function"] = model
+
+# Configuring the MCMC sampler parameters
+e["Solver"]["Type"] = "Sampler/MCMC"
+e["Solver"]["Burn In"] = 10
+e["Solver"]["Chain Count"] = 8
+e["Solver"]["Chain Interaction"] = "Differential Evolution"
+e["Solver"]["Rejection Levels"] = 2
+e["Solver"]["Use Adaptive Sampling"] = True
+e["Solver"]["Termination Criteria"]["Max Samples"] = 4000
+
+# Defining problem's variables
+e["Variables"][0]["Name"] = "X"
+e["Variables"][0]["Initial Mean"] = 0.0
+e["Variables"][0]["Initial Standard Deviation"] = 1.0
+
+# Configuring output settings
+e["File Output"]["Frequency"] = 100
+e["File Output"]["Path"] = '_korali_result_mcmc_chains'
+e["Console Output"]["Frequency"] = 100
+e["Console Output"]["Verbosity"] = "Detailed"
+
+# Starting Korali's Engine and running experiment
+k = korali.Engine()
+k.run(e)
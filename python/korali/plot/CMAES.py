@@ -6,7 +6,7 @@ import matplotlib.pyplot as plt
 from korali.plot.helpers import hlsColors, drawMulticoloredLine
 
 
-# Plot CMAES results (read from .json files)
+# Plot CMAES results (read from .json or .cbor result files)
 def plot(genList, **kwargs):
   fig, ax = plt.subplots(2, 2, num='Korali Results', figsize=(8, 8))
   firstKey = next(iter(genList))
@@ -3,7 +3,7 @@
 import numpy as np
 import matplotlib.pyplot as plt
 
-# Plot DEA results (read from .json files)
+# Plot DEA results (read from .json or .cbor result files)
 def plot(genList, **kwargs):
   firstKey = next(iter(genList))
 
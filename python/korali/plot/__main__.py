@@ -6,6 +6,7 @@ import json
 import argparse
 import matplotlib
 import importlib
+from korali.results import loadResultFile
 
 curdir = os.path.abspath(os.path.dirname(os.path.realpath(__file__)))
 
@@ -29,31 +30,34 @@ def main(path, test, output, plotAll=False):
 
   signal.signal(signal.SIGINT, lambda x, y: exit(0))
 
+  # Result files are either in text JSON or in binary format
   configFile = path + '/gen00000000.json'
+  if (not os.path.isfile(configFile)):
+    configFile = path + '/gen00000000.cbor'
   if (not os.path.isfile(configFile)):
     print("[Korali] Error: Did not find any results in the {0} folder...".format(path))
     exit(-1)
 
-  with open(configFile) as f:
-    js = json.load(f)
+  js = loadResultFile(configFile)
   configRunId = js['Run ID']
 
+  # Only complete result files are read, skipping the temporary (.aux) files of a result still being written
   resultFiles = [
       f for f in os.listdir(path)
-      if os.path.isfile(os.path.join(path, f)) and f.startswith('gen')
+      if os.path.isfile(os.path.join(path, f)) and f.startswith('gen') and
+      f.endswith(('.json', '.cbor'))
   ]
   resultFiles = sorted(resultFiles)
 
   genList = {}
 
   for file in resultFiles:
-    with open(path + '/' + file) as f:
-      genJs = json.load(f)
-      solverRunId = genJs['Run ID']
+    genJs = loadResultFile(path + '/' + file)
+    solverRunId = genJs['Run ID']
 
-      if (configRunId == solverRunId):
-        curGen = genJs['Current Generation']
-        genList[curGen] = genJs
+    if (configRunId == solverRunId):
+      curGen = genJs['Current Generation']
+      genList[curGen] = genJs
 
   del genList[0]
 
@@ -77,6 +81,11 @@ def main(path, test, output, plotAll=False):
    solverDir = curdir + '/LMCMAES'
    moduleName = '.LMCMAES'
 
+  # VD-CMA-ES does not store the covariance matrix either
+  if ("vdcmaes" in solverName):
+   solverDir = curdir + '/LMCMAES'
+   moduleName = '.LMCMAES'
+
   if ("mocmaes" in solverName):
    solverDir = curdir + '/MOCMAES'
    moduleName = '.MOCMAES'
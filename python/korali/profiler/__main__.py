@@ -11,6 +11,7 @@ from matplotlib import cm
 import matplotlib.colors as colors
 import argparse
 import numpy as np
+from korali.results import loadResultFile
 
 signal.signal(signal.SIGINT, lambda x, y: exit(0))
 
@@ -66,13 +67,11 @@ for file in args.input:
           ' ...')
     exit(-1)
 
-  with open(file) as f:
-    jsString = f.read()
-    js = json.loads(jsString)
+  js = loadResultFile(file)
 
-    currExperimentCount = js["Experiment Count"]
-    if (currExperimentCount > experimentCount):
-      experimentCount = currExperimentCount
+  currExperimentCount = js["Experiment Count"]
+  if (currExperimentCount > experimentCount):
+    experimentCount = currExperimentCount
 
   fullJs["Timelines"].update(js["Timelines"])
   if (float(js["Elapsed Time"]) > elapsedTime):
@@ -0,0 +1,95 @@
+#! /usr/bin/env python3
+# Reads Korali result files, either in text JSON or in binary (CBOR) format.
+# Arrays of floating point numbers stored as raw little-endian blocks (RFC 8746, tag 86) are decoded into lists.
+
+import json
+import struct
+
+# Tag of the little-endian float64 typed arrays written by Korali
+_FLOAT64_LE_TAG = 86
+
+
+def isBinaryResult(data):
+  # Text JSON starts with an ASCII character, while CBOR arrays, maps, and tags have their highest bit set
+  return len(data) > 0 and (data[0] >> 5) in (4, 5, 6)
+
+
+def loadResultFile(path):
+  with open(path, 'rb') as f:
+    data = f.read()
+
+  if isBinaryResult(data):
+    return parseCbor(data)
+
+  return json.loads(data.decode('utf-8'))
+
+
+def parseCbor(data):
+  value, pos = _readItem(memoryview(data), 0)
+  return value
+
+
+def _readArgument(data, pos, info):
+  if info < 24:
+    return info, pos
+  if info == 24:
+    return data[pos], pos + 1
+  if info == 25:
+    return struct.unpack_from('>H', data, pos)[0], pos + 2
+  if info == 26:
+    return struct.unpack_from('>I', data, pos)[0], pos + 4
+  if info == 27:
+    return struct.unpack_from('>Q', data, pos)[0], pos + 8
+  raise ValueError('[Korali] Unsupported CBOR argument (additional information {0}).'.format(info))
+
+
+def _readItem(data, pos):
+  head = data[pos]
+  pos += 1
+  major = head >> 5
+  info = head & 0x1F
+
+  # Simple values and floating point numbers
+  if major == 7:
+    if info == 20:
+      return False, pos
+    if info == 21:
+      return True, pos
+    if info == 22 or info == 23:
+      return None, pos
+    if info == 25:
+      return struct.unpack_from('>e', data, pos)[0], pos + 2
+    if info == 26:
+      return struct.unpack_from('>f', data, pos)[0], pos + 4
+    if info == 27:
+      return struct.unpack_from('>d', data, pos)[0], pos + 8
+    raise ValueError('[Korali] Unsupported CBOR simple value ({0}).'.format(info))
+
+  argument, pos = _readArgument(data, pos, info)
+
+  if major == 0:
+    return argument, pos
+  if major == 1:
+    return -1 - argument, pos
+  if major == 2:
+    return bytes(data[pos:pos + argument]), pos + argument
+  if major == 3:
+    return str(data[pos:pos + argument], 'utf-8'), pos + argument
+  if major == 4:
+    values = []
+    for i in range(argument):
+      value, pos = _readItem(data, pos)
+      values.append(value)
+    return values, pos
+  if major == 5:
+    values = {}
+    for i in range(argument):
+      key, pos = _readItem(data, pos)
+      values[key], pos = _readItem(data, pos)
+    return values, pos
+
+  # Tags annotate the next item. Only float64 typed arrays change how it is decoded.
+  value, pos = _readItem(data, pos)
+  if argument == _FLOAT64_LE_TAG:
+    value = list(struct.unpack('<{0}d'.format(len(value) // 8), value))
+  return value, pos
@@ -12,6 +12,7 @@ import numpy as np
 import scipy.stats as st
 import matplotlib.pyplot as plt
 from korali.plot.helpers import hlsColors, drawMulticoloredLine
+from korali.results import loadResultFile
 from scipy.signal import savgol_filter
 import pdb
 
@@ -200,8 +201,7 @@ def parseResults( dir, numRuns ):
             if (not os.path.isfile(configFile)):
                 print("[Korali] Error: Did not find any results in the {0} folder...".format(configFile))
                 exit(-1)
-            with open(configFile) as f:
-                data = json.load(f)
+            data = loadResultFile(configFile)
             result.append(data)
         results.append(result)
   
@@ -47,6 +47,10 @@ extern bool __isMPICommGiven;
 
 #define __KORALI_MPI_MESSAGE_JSON_TAG 1
 
+#define __KORALI_MPI_MESSAGE_BINARY_TAG 2
+
+#define __KORALI_MPI_MESSAGE_BATCH_TAG 3
+
 }
 
 #ifdef _KORALI_USE_MPI4PY
@@ -0,0 +1,329 @@
+#include "auxiliar/cbor.hpp"
+#include "auxiliar/logger.hpp"
+#include <cmath>
+#include <cstring>
+
+/**
+ * @brief Minimum length of a floating point array to be stored as a raw block
+ */
+#define CBOR_MIN_TYPED_ARRAY 16
+
+/**
+ * @brief RFC 8746 tag for an array of little-endian float64 values
+ */
+#define CBOR_TAG_FLOAT64_LE 86
+
+namespace korali
+{
+/**
+ * @brief Writes the head (major type and argument) of a CBOR data item
+ * @param out Output buffer
+ * @param major The major type
+ * @param value The argument (value, length, or tag)
+ */
+static void writeHead(std::string &out, const uint8_t major, const uint64_t value)
+{
+  const uint8_t type = major << 5;
+  if (value < 24)
+  {
+    out.push_back(type | (uint8_t)value);
+    return;
+  }
+
+  size_t bytes = 8;
+  uint8_t info = 27;
+  if (value <= 0xFF) bytes = 1, info = 24;
+  else if (value <= 0xFFFF) bytes = 2, info = 25;
+  else if (value <= 0xFFFFFFFF) bytes = 4, info = 26;
+
+  out.push_back(type | info);
+  for (size_t i = 0; i < bytes; i++) out.push_back((uint8_t)(value >> (8 * (bytes - 1 - i))));
+}
+
+/**
+ * @brief Writes a floating point value, in single precision if no precision is lost
+ * @param out Output buffer
+ * @param x The value
+ */
+static void writeFloat(std::string &out, const double x)
+{
+  const float xf = (float)x;
+  if ((double)xf == x || std::isnan(x))
+  {
+    uint32_t bits;
+    memcpy(&bits, &xf, sizeof(float));
+    out.push_back((char)0xFA);
+    for (size_t i = 0; i < 4; i++) out.push_back((uint8_t)(bits >> (8 * (3 - i))));
+    return;
+  }
+
+  uint64_t bits;
+  memcpy(&bits, &x, sizeof(double));
+  out.push_back((char)0xFB);
+  for (size_t i = 0; i < 8; i++) out.push_back((uint8_t)(bits >> (8 * (7 - i))));
+}
+
+/**
+ * @brief Checks whether an array is long enough, and only contains floating point numbers, to be stored as a raw block
+ * @param js The JSON array
+ * @return true, if it can be stored as a typed array; false, otherwise.
+ */
+static bool isFloatArray(const knlohmann::json &js)
+{
+  if (js.size() < CBOR_MIN_TYPED_ARRAY) return false;
+  for (const auto &x : js)
+    if (x.is_number_float() == false) return false;
+  return true;
+}
+
+/**
+ * @brief Recursively encodes a JSON object
+ * @param out Output buffer
+ * @param js The JSON object
+ */
+static void writeItem(std::string &out, const knlohmann::json &js)
+{
+  switch (js.type())
+  {
+  case knlohmann::json::value_t::null: out.push_back((char)0xF6); break;
+  case knlohmann::json::value_t::boolean: out.push_back(js.get<bool>() ? (char)0xF5 : (char)0xF4); break;
+  case knlohmann::json::value_t::number_unsigned: writeHead(out, 0, js.get<uint64_t>()); break;
+  case knlohmann::json::value_t::number_integer:
+  {
+    const int64_t x = js.get<int64_t>();
+    if (x >= 0)
+      writeHead(out, 0, (uint64_t)x);
+    else
+      writeHead(out, 1, (uint64_t)(-1 - x));
+    break;
+  }
+  case knlohmann::json::value_t::number_float: writeFloat(out, js.get<double>()); break;
+  case knlohmann::json::value_t::string:
+  {
+    const auto &str = js.get_ref<const std::string &>();
+    writeHead(out, 3, str.size());
+    out.append(str);
+    break;
+  }
+  case knlohmann::json::value_t::array:
+  {
+    if (isFloatArray(js))
+    {
+      // Storing the values as a raw block, in little-endian order
+      writeHead(out, 6, CBOR_TAG_FLOAT64_LE);
+      writeHead(out, 2, js.size() * sizeof(double));
+      for (const auto &x : js)
+      {
+        uint64_t bits;
+        const double value = x.get<double>();
+        memcpy(&bits, &value, sizeof(double));
+        for (size_t i = 0; i < 8; i++) out.push_back((uint8_t)(bits >> (8 * i)));
+      }
+      break;
+    }
+
+    writeHead(out, 4, js.size());
+    for (const auto &x : js) writeItem(out, x);
+    break;
+  }
+  case knlohmann::json::value_t::object:
+  {
+    writeHead(out, 5, js.size());
+    for (auto it = js.begin(); it != js.end(); it++)
+    {
+      writeHead(out, 3, it.key().size());
+      out.append(it.key());
+      writeItem(out, it.value());
+    }
+    break;
+  }
+  default: KORALI_LOG_ERROR("Cannot encode JSON value of type '%s' as CBOR.\n", js.type_name());
+  }
+}
+
+std::string dumpCbor(const knlohmann::json &js)
+{
+  std::string out;
+  writeItem(out, js);
+  return out;
+}
+
+/**
+ * @brief Sequential reader of a CBOR document, with bounds checking
+ */
+class cborReader
+{
+  public:
+  /**
+   * @brief Pointer to the next byte to read
+   */
+  const uint8_t *_pos;
+
+  /**
+   * @brief Pointer past the last byte of the document
+   */
+  const uint8_t *_end;
+
+  /**
+   * @brief Consumes a number of bytes
+   * @param bytes Number of bytes
+   * @return Pointer to the consumed bytes
+   */
+  const uint8_t *take(const size_t bytes)
+  {
+    if ((size_t)(_end - _pos) < bytes) KORALI_LOG_ERROR("Unexpected end of CBOR document.\n");
+    const uint8_t *data = _pos;
+    _pos += bytes;
+    return data;
+  }
+
+  /**
+   * @brief Reads a big-endian unsigned integer
+   * @param bytes Number of bytes
+   * @return The integer
+   */
+  uint64_t readUnsigned(const size_t bytes)
+  {
+    const uint8_t *data = take(bytes);
+    uint64_t value = 0;
+    for (size_t i = 0; i < bytes; i++) value = (value << 8) | data[i];
+    return value;
+  }
+
+  /**
+   * @brief Reads the argument of a data item, given the additional information of its head
+   * @param info The additional information (lower 5 bits of the head)
+   * @return The argument
+   */
+  uint64_t readArgument(const uint8_t info)
+  {
+    if (info < 24) return info;
+    if (info == 24) return readUnsigned(1);
+    if (info == 25) return readUnsigned(2);
+    if (info == 26) return readUnsigned(4);
+    if (info == 27) return readUnsigned(8);
+    KORALI_LOG_ERROR("Unsupported CBOR argument (additional information %u).\n", info);
+  }
+
+  /**
+   * @brief Recursively decodes a data item
+   * @return The decoded JSON value
+   */
+  knlohmann::json readItem()
+  {
+    const uint8_t head = *take(1);
+    const uint8_t major = head >> 5;
+    const uint8_t info = head & 0x1F;
+
+    // Simple values and floating point numbers are not followed by an argument
+    if (major == 7)
+    {
+      if (info == 20) return false;
+      if (info == 21) return true;
+      if (info == 22 || info == 23) return nullptr;
+      if (info == 25) return decodeHalf(readUnsigned(2));
+      if (info == 26)
+      {
+        uint32_t bits = readUnsigned(4);
+        float x;
+        memcpy(&x, &bits, sizeof(float));
+        return (double)x;
+      }
+      if (info == 27)
+      {
+        uint64_t bits = readUnsigned(8);
+        double x;
+        memcpy(&x, &bits, sizeof(double));
+        return x;
+      }
+      KORALI_LOG_ERROR("Unsupported CBOR simple value (%u).\n", info);
+    }
+
+    const uint64_t argument = readArgument(info);
+
+    switch (major)
+    {
+    case 0: return argument;
+    case 1: return -1 - (int64_t)argument;
+    case 2:
+    case 3:
+    {
+      const uint8_t *data = take(argument);
+      return std::string((const char *)data, argument);
+    }
+    case 4:
+    {
+      auto js = knlohmann::json::array();
+      for (uint64_t i = 0; i < argument; i++) js.push_back(readItem());
+      return js;
+    }
+    case 5:
+    {
+      auto js = knlohmann::json::object();
+      for (uint64_t i = 0; i < argument; i++)
+      {
+        auto key = readItem();
+        if (key.is_string() == false) KORALI_LOG_ERROR("CBOR map keys must be strings.\n");
+        js[key.get<std::string>()] = readItem();
+      }
+      return js;
+    }
+    default:
+    {
+      // Tags annotate the next item. Only float64 typed arrays change how it is decoded.
+      if (argument != CBOR_TAG_FLOAT64_LE) return readItem();
+
+      const uint8_t blockHead = *take(1);
+      if (blockHead >> 5 != 2) KORALI_LOG_ERROR("CBOR typed array is not a byte string.\n");
+      const uint64_t bytes = readArgument(blockHead & 0x1F);
+      if (bytes % sizeof(double) != 0) KORALI_LOG_ERROR("CBOR float64 typed array has an invalid length (%lu bytes).\n", bytes);
+      const uint8_t *data = take(bytes);
+
+      std::vector<double> values(bytes / sizeof(double));
+      for (size_t i = 0; i < values.size(); i++)
+      {
+        uint64_t bits = 0;
+        for (size_t j = 0; j < 8; j++) bits |= (uint64_t)data[i * 8 + j] << (8 * j);
+        memcpy(&values[i], &bits, sizeof(double));
+      }
+      return values;
+    }
+    }
+  }
+
+  /**
+   * @brief Decodes an IEEE 754 half precision number
+   * @param bits The 16 bits of the number
+   * @return The decoded value
+   */
+  static double decodeHalf(const uint64_t bits)
+  {
+    const int exponent = (bits >> 10) & 0x1F;
+    const int mantissa = bits & 0x3FF;
+    double value;
+    if (exponent == 0)
+      value = std::ldexp(mantissa, -24);
+    else if (exponent != 31)
+      value = std::ldexp(mantissa + 1024, exponent - 25);
+    else
+      value = mantissa == 0 ? INFINITY : NAN;
+    return (bits & 0x8000) ? -value : value;
+  }
+};
+
+knlohmann::json parseCbor(const uint8_t *data, const size_t size)
+{
+  cborReader reader;
+  reader._pos = data;
+  reader._end = data + size;
+  return reader.readItem();
+}
+
+bool isCbor(const uint8_t firstByte)
+{
+  // Text JSON starts with an ASCII character, while CBOR arrays, maps, and tags have their highest bit set
+  const uint8_t major = firstByte >> 5;
+  return major == 4 || major == 5 || major == 6;
+}
+
+} // namespace korali
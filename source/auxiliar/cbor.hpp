@@ -0,0 +1,41 @@
+/** \file
+* @brief Contains a compact CBOR (RFC 8949) encoding of JSON objects, used for binary result files.
+*        Long arrays of floating point numbers are stored as raw little-endian blocks (RFC 8746 typed arrays).
+******************************************************************************/
+
+#pragma once
+
+
+#include "auxiliar/json.hpp"
+#include <cstdint>
+#include <string>
+
+/**
+* \namespace korali
+* @brief The Korali namespace includes all Korali-specific functions, variables, and modules.
+*/
+namespace korali
+{
+/**
+  * @brief Encodes a JSON object as CBOR. Arrays of floating point numbers with at least 16 elements are stored as float64 typed arrays.
+  * @param js The JSON object to encode.
+  * @return The encoded bytes.
+ */
+std::string dumpCbor(const knlohmann::json &js);
+
+/**
+  * @brief Decodes a CBOR document into a JSON object. Typed arrays of floating point numbers are decoded into regular arrays, other tags are ignored.
+  * @param data Pointer to the encoded bytes.
+  * @param size Number of encoded bytes.
+  * @return The decoded JSON object.
+ */
+knlohmann::json parseCbor(const uint8_t *data, const size_t size);
+
+/**
+  * @brief Checks whether a file's content is a binary (CBOR) result, rather than text JSON, from its first byte.
+  * @param firstByte The first byte of the file.
+  * @return true, if it is a CBOR document; false, otherwise.
+ */
+bool isCbor(const uint8_t firstByte);
+
+} // namespace korali
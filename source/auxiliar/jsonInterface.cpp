@@ -3,6 +3,7 @@
 ******************************************************************************/
 
 #include "auxiliar/jsonInterface.hpp"
+#include "auxiliar/cbor.hpp"
 #include "auxiliar/logger.hpp"
 #include <string>
 #include <iostream>
@@ -94,7 +95,11 @@ bool loadJsonFromFile(knlohmann::json &dst, const char *fileName)
 
     string[fsize] = '\0';
 
-    dst = knlohmann::json::parse(string);
+    // Binary result files are detected from their first byte
+    if (fsize > 0 && isCbor(string[0]))
+      dst = parseCbor((const uint8_t *)string, fsize);
+    else
+      dst = knlohmann::json::parse(string);
 
     free(string);
     return true;
@@ -131,7 +131,7 @@ std::string getPath(const Key &... key)
 }
 
 /**
-  * @brief Loads a JSON object from a file.
+  * @brief Loads a JSON object from a file, either in text JSON or in binary (CBOR) format.
   * @param dst The JSON object to overwrite.
   * @param fileName The path to the json file to load and parse.
   * @return true, if file was found; false, otherwise.
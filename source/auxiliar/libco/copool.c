@@ -0,0 +1,96 @@
+#include "copool.h"
+
+#include <limits.h>
+#include <stdlib.h>
+#include <sys/mman.h>
+#include <unistd.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+struct co_pool {
+  size_t page_size;
+  size_t stack_size;  /* usable stack bytes, a multiple of the page size */
+  void** slots;       /* every mapped slot (guard page + stack), for destruction */
+  size_t slot_count;
+  size_t slot_capacity;
+  void** free_stacks; /* stacks ready for reuse (as many entries as slots), used as a LIFO so warm stacks go first */
+  size_t free_count;
+};
+
+static int co_pool_add_slot(co_pool* pool, void* slot) {
+  if(pool->slot_count == pool->slot_capacity) {
+    size_t capacity = pool->slot_capacity ? pool->slot_capacity * 2 : 64;
+    void** slots = (void**)realloc(pool->slots, capacity * sizeof(void*));
+    if(!slots) return 0;
+    pool->slots = slots;
+    /* the free list can hold every slot, so that releasing never needs to allocate */
+    void** free_stacks = (void**)realloc(pool->free_stacks, capacity * sizeof(void*));
+    if(!free_stacks) return 0;
+    pool->free_stacks = free_stacks;
+    pool->slot_capacity = capacity;
+  }
+  pool->slots[pool->slot_count++] = slot;
+  return 1;
+}
+
+co_pool* co_pool_create(size_t size) {
+  co_pool* pool = (co_pool*)calloc(1, sizeof(co_pool));
+  if(!pool) return (co_pool*)0;
+
+  pool->page_size = (size_t)sysconf(_SC_PAGESIZE);
+  pool->stack_size = (size + pool->page_size - 1) / pool->page_size * pool->page_size;
+  /* co_derive takes the stack size as an unsigned int, larger stacks cannot be handed over */
+  if(pool->stack_size < size || pool->stack_size > UINT_MAX) {
+    free(pool);
+    return (co_pool*)0;
+  }
+  return pool;
+}
+
+cothread_t co_pool_acquire(co_pool* pool, void (*entrypoint)(void), void** acquired_stack) {
+  cothread_t handle;
+  void* stack;
+
+  if(pool->free_count > 0) {
+    stack = pool->free_stacks[--pool->free_count];
+  } else {
+    /* stacks grow downwards, so the guard page at the start of the slot catches overflows */
+    size_t slot_size = pool->page_size + pool->stack_size;
+    void* slot = mmap(0, slot_size, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+    if(slot == MAP_FAILED) return (cothread_t)0;
+    if(mprotect(slot, pool->page_size, PROT_NONE) != 0 || !co_pool_add_slot(pool, slot)) {
+      munmap(slot, slot_size);
+      return (cothread_t)0;
+    }
+    stack = (char*)slot + pool->page_size;
+  }
+
+  /* backends that cannot derive on user memory (e.g. fibers) return null, the stack stays in the pool */
+  handle = co_derive(stack, (unsigned int)pool->stack_size, entrypoint);
+  if(!handle) {
+    pool->free_stacks[pool->free_count++] = stack;
+    return (cothread_t)0;
+  }
+
+  *acquired_stack = stack;
+  return handle;
+}
+
+void co_pool_release(co_pool* pool, void* stack) {
+  pool->free_stacks[pool->free_count++] = stack;
+}
+
+void co_pool_destroy(co_pool* pool) {
+  size_t i;
+  if(!pool) return;
+  for(i = 0; i < pool->slot_count; i++) munmap(pool->slots[i], pool->page_size + pool->stack_size);
+  free(pool->slots);
+  free(pool->free_stacks);
+  free(pool);
+}
+
+#ifdef __cplusplus
+}
+#endif
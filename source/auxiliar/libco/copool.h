@@ -0,0 +1,37 @@
+/*
+  copool: fixed-size coroutine stack pool for libco
+  license: ISC
+*/
+
+#ifndef COPOOL_H
+#define COPOOL_H
+
+#include "libco.h"
+
+#include <stddef.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+typedef struct co_pool co_pool;
+
+/* creates a pool of stacks of (at least) the given size, each with a guard page below it. returns null if the size is too large for a cothread */
+co_pool* co_pool_create(size_t);
+
+/* takes a stack from the pool (mapping a new one if none is free), derives a cothread on it, and stores the stack in the last argument.
+   the cothread handle may not point to the stack (it depends on the backend), so the stack is what goes back to the pool */
+cothread_t co_pool_acquire(co_pool*, void (*)(void), void**);
+
+/* returns a stack (whose cothread must not be active) to the pool, for reuse */
+void co_pool_release(co_pool*, void*);
+
+/* unmaps all stacks of the pool. no cothread of the pool may be in use */
+void co_pool_destroy(co_pool*);
+
+#ifdef __cplusplus
+}
+#endif
+
+/* ifndef COPOOL_H */
+#endif
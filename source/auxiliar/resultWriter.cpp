@@ -0,0 +1,130 @@
+#include "auxiliar/resultWriter.hpp"
+#include "auxiliar/cbor.hpp"
+#include "auxiliar/logger.hpp"
+#include <cstdio>
+#include <unistd.h>
+
+/**
+ * @brief Number of snapshots that can wait in the queue while another one is being written
+ */
+#define RESULTWRITER_MAX_PENDING 1
+
+namespace korali
+{
+resultWriter::resultWriter()
+{
+  _isWriting = false;
+  _isTerminating = false;
+}
+
+resultWriter::~resultWriter()
+{
+  if (_thread.joinable() == false) return;
+
+  // Writing the remaining snapshots before stopping
+  {
+    std::lock_guard<std::mutex> lock(_mutex);
+    _isTerminating = true;
+  }
+  _jobQueued.notify_one();
+  _thread.join();
+}
+
+std::string resultWriter::writeFile(const std::string &filePath, const std::string &linkPath, const knlohmann::json &js, const bool isBinary, const bool isSynced)
+{
+  const std::string content = isBinary ? dumpCbor(js) : js.dump(1);
+
+  // Writing into a temporary file, so that readers never see a partially written result
+  std::string auxPath = filePath + ".aux";
+  FILE *fid = fopen(auxPath.c_str(), "wb");
+  if (fid == NULL) return "Error trying to save result file: " + filePath + ".\n";
+
+  bool isWritten = fwrite(content.data(), 1, content.size(), fid) == content.size();
+  isWritten = isWritten && fflush(fid) == 0;
+  if (isSynced) isWritten = isWritten && fsync(fileno(fid)) == 0;
+  isWritten = (fclose(fid) == 0) && isWritten;
+  if (isWritten == false) return "Error trying to write result file: " + filePath + ".\n";
+
+  if (rename(auxPath.c_str(), filePath.c_str()) != 0) return "Error trying to rename result file: " + filePath + ".\n";
+
+  // If using multiple files, create a hard link to the latest result
+  if (linkPath.empty() == false)
+  {
+    remove(linkPath.c_str());
+    link(filePath.c_str(), linkPath.c_str());
+  }
+
+  return "";
+}
+
+void resultWriter::write(const std::string &filePath, const std::string &linkPath, knlohmann::json &&js, const bool isBinary)
+{
+  std::unique_lock<std::mutex> lock(_mutex);
+  reportError();
+
+  if (_thread.joinable() == false) _thread = std::thread(&resultWriter::writerLoop, this);
+
+  // A snapshot of the same file that was not written yet is outdated, and can be replaced
+  if (_jobs.empty() == false && _jobs.back().filePath == filePath)
+  {
+    _jobs.back().linkPath = linkPath;
+    _jobs.back().js = std::move(js);
+    _jobs.back().isBinary = isBinary;
+    return;
+  }
+
+  // Applying back-pressure: the engine waits while the writer falls behind
+  _jobWritten.wait(lock, [this]() { return _jobs.size() < RESULTWRITER_MAX_PENDING || _error.empty() == false; });
+  reportError();
+
+  _jobs.push_back(job_t{filePath, linkPath, std::move(js), isBinary});
+  lock.unlock();
+  _jobQueued.notify_one();
+}
+
+void resultWriter::flush()
+{
+  std::unique_lock<std::mutex> lock(_mutex);
+  _jobWritten.wait(lock, [this]() { return (_jobs.empty() && _isWriting == false) || _error.empty() == false; });
+  reportError();
+}
+
+void resultWriter::reportError()
+{
+  if (_error.empty()) return;
+
+  // Dropping the snapshots left, since the result path is not writable
+  std::string error = _error;
+  _error.clear();
+  _jobs.clear();
+  KORALI_LOG_ERROR("%s", error.c_str());
+}
+
+void resultWriter::writerLoop()
+{
+  std::unique_lock<std::mutex> lock(_mutex);
+
+  while (true)
+  {
+    _jobQueued.wait(lock, [this]() { return _jobs.empty() == false || _isTerminating; });
+    if (_jobs.empty()) break;
+
+    job_t job = std::move(_jobs.front());
+    _jobs.pop_front();
+    _isWriting = true;
+
+    // Serializing and syncing without holding the lock, so that the engine can queue the next snapshot meanwhile
+    lock.unlock();
+    _jobWritten.notify_all();
+    // The background writer can afford to sync, so that a crash never leaves an empty latest result
+    auto error = writeFile(job.filePath, job.linkPath, job.js, job.isBinary, true);
+    job.js = knlohmann::json();
+    lock.lock();
+
+    _isWriting = false;
+    if (_error.empty()) _error = error;
+    _jobWritten.notify_all();
+  }
+}
+
+} // namespace korali
@@ -0,0 +1,135 @@
+#pragma once
+
+
+/** \file
+* @brief Implements a background writer for result files. The engine hands over a snapshot of
+*        the results and continues, while the writer thread serializes it and syncs it to disk.
+******************************************************************************/
+
+#include "auxiliar/json.hpp"
+#include <condition_variable>
+#include <deque>
+#include <mutex>
+#include <string>
+#include <thread>
+
+/**
+* \namespace korali
+* @brief The Korali namespace includes all Korali-specific functions, variables, and modules.
+*/
+namespace korali
+{
+/**
+* \class resultWriter
+* @brief Writes result files from a background thread. At most one snapshot is written while another one waits, any further one blocks the caller.
+*/
+class resultWriter
+{
+  public:
+  resultWriter();
+  ~resultWriter();
+
+  /**
+  * @brief Writes a result file and, optionally, hard-links it as the latest result. Temporary file and link replacement make the update atomic.
+  * @param filePath Path of the result file
+  * @param linkPath Path of the link to the latest result. No link is created if empty.
+  * @param js The JSON object to write
+  * @param isBinary If true, the file is written in binary (CBOR) format; otherwise, as text JSON.
+  * @param isSynced If true, the file is synced to disk before it replaces the previous one.
+  * @return An error message, or an empty string if the file was written successfully.
+  */
+  static std::string writeFile(const std::string &filePath, const std::string &linkPath, const knlohmann::json &js, const bool isBinary, const bool isSynced = false);
+
+  /**
+  * @brief Queues a snapshot to be written by the background thread. A snapshot still waiting for the same file is replaced, otherwise the call blocks while the queue is full.
+  * @param filePath Path of the result file
+  * @param linkPath Path of the link to the latest result. No link is created if empty.
+  * @param js The snapshot to write. Its contents are moved into the queue.
+  * @param isBinary If true, the file is written in binary (CBOR) format; otherwise, as text JSON.
+  */
+  void write(const std::string &filePath, const std::string &linkPath, knlohmann::json &&js, const bool isBinary);
+
+  /**
+  * @brief Blocks until all queued snapshots have been written. Reports the first write error, if any.
+  */
+  void flush();
+
+  private:
+  /**
+  * @brief A snapshot waiting to be written
+  */
+  struct job_t
+  {
+    /**
+    * @brief Path of the result file
+    */
+    std::string filePath;
+
+    /**
+    * @brief Path of the link to the latest result
+    */
+    std::string linkPath;
+
+    /**
+    * @brief Results to write
+    */
+    knlohmann::json js;
+
+    /**
+    * @brief Whether to write the results in binary (CBOR) format
+    */
+    bool isBinary;
+  };
+
+  /**
+  * @brief Snapshots waiting to be written
+  */
+  std::deque<job_t> _jobs;
+
+  /**
+  * @brief Whether the background thread is writing a snapshot, already removed from the queue
+  */
+  bool _isWriting;
+
+  /**
+  * @brief Set to stop the background thread once the queue is empty
+  */
+  bool _isTerminating;
+
+  /**
+  * @brief First error found by the background thread, not yet reported to the engine
+  */
+  std::string _error;
+
+  /**
+  * @brief Protects the queue and the writer state
+  */
+  std::mutex _mutex;
+
+  /**
+  * @brief Signaled when a snapshot is queued or the writer should terminate
+  */
+  std::condition_variable _jobQueued;
+
+  /**
+  * @brief Signaled when the background thread finishes writing a snapshot
+  */
+  std::condition_variable _jobWritten;
+
+  /**
+  * @brief The background thread. It is started with the first snapshot, so that processes forked before then do not inherit it.
+  */
+  std::thread _thread;
+
+  /**
+  * @brief Loop run by the background thread: writes queued snapshots until termination.
+  */
+  void writerLoop();
+
+  /**
+  * @brief Reports, and clears, the error found by the background thread. Must be called with the mutex held.
+  */
+  void reportError();
+};
+
+} // namespace korali
@@ -0,0 +1,175 @@
+#include "auxiliar/shmRing.hpp"
+#include "auxiliar/logger.hpp"
+#include <algorithm>
+#include <errno.h>
+#include <new>
+#include <poll.h>
+#include <string.h>
+#include <sys/eventfd.h>
+#include <sys/mman.h>
+#include <unistd.h>
+
+/**
+ * @brief Number of polling iterations before a blocked side goes to sleep on its doorbell
+ */
+#define SHMRING_SPIN_COUNT 16384
+
+namespace korali
+{
+shmRing::shmRing()
+{
+  _control = NULL;
+  _data = NULL;
+  _capacity = 0;
+  _dataDoorbell = -1;
+  _spaceDoorbell = -1;
+}
+
+void shmRing::create(const size_t capacity)
+{
+  _capacity = 1;
+  while (_capacity < capacity) _capacity <<= 1;
+
+  // Anonymous shared mappings are inherited by forked processes
+  size_t mapSize = sizeof(control_t) + _capacity;
+  void *map = mmap(NULL, mapSize, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_ANONYMOUS, -1, 0);
+  if (map == MAP_FAILED) KORALI_LOG_ERROR("Unable to map shared memory ring of %lu bytes.\n", mapSize);
+
+  _control = new (map) control_t;
+  _control->head = 0;
+  _control->tail = 0;
+  _control->consumerSleeping = 0;
+  _control->producerSleeping = 0;
+  _data = (uint8_t *)map + sizeof(control_t);
+
+  _dataDoorbell = eventfd(0, 0);
+  _spaceDoorbell = eventfd(0, 0);
+  if (_dataDoorbell == -1 || _spaceDoorbell == -1) KORALI_LOG_ERROR("Unable to create shared memory ring doorbell.\n");
+}
+
+void shmRing::destroy()
+{
+  if (_control != NULL) munmap(_control, sizeof(control_t) + _capacity);
+  if (_dataDoorbell != -1) close(_dataDoorbell);
+  if (_spaceDoorbell != -1) close(_spaceDoorbell);
+
+  _control = NULL;
+  _data = NULL;
+  _dataDoorbell = -1;
+  _spaceDoorbell = -1;
+}
+
+bool shmRing::empty() const
+{
+  return _control->head.load(std::memory_order_acquire) == _control->tail.load(std::memory_order_relaxed);
+}
+
+bool shmRing::announceSleep()
+{
+  _control->consumerSleeping.store(1, std::memory_order_seq_cst);
+  std::atomic_thread_fence(std::memory_order_seq_cst);
+  return empty();
+}
+
+void shmRing::withdrawSleep()
+{
+  _control->consumerSleeping.store(0, std::memory_order_relaxed);
+
+  // Resetting the doorbell without blocking, in case it was not rung
+  struct pollfd doorbell = {_dataDoorbell, POLLIN, 0};
+  uint64_t count;
+  if (poll(&doorbell, 1, 0) > 0)
+    while (::read(_dataDoorbell, &count, sizeof(uint64_t)) < 0 && errno == EINTR)
+      ;
+}
+
+template <typename F>
+void shmRing::sleep(std::atomic<int> &sleeping, int doorbell, F &&blocked)
+{
+  // Announcing the sleep before re-checking, so that the other side either sees the flag or we see its update
+  // (the fence keeps the acquire loads of the re-check from being ordered before the flag store)
+  sleeping.store(1, std::memory_order_seq_cst);
+  std::atomic_thread_fence(std::memory_order_seq_cst);
+
+  if (blocked())
+  {
+    uint64_t count;
+    while (::read(doorbell, &count, sizeof(uint64_t)) < 0 && errno == EINTR)
+      ;
+  }
+
+  sleeping.store(0, std::memory_order_relaxed);
+}
+
+void shmRing::ring(std::atomic<int> &sleeping, int doorbell)
+{
+  // Pairs with the fence in sleep(): the index update is ordered before the flag check
+  std::atomic_thread_fence(std::memory_order_seq_cst);
+  if (sleeping.load(std::memory_order_seq_cst) == 0) return;
+
+  uint64_t count = 1;
+  while (::write(doorbell, &count, sizeof(uint64_t)) < 0 && errno == EINTR)
+    ;
+}
+
+void shmRing::write(const void *data, size_t size)
+{
+  auto src = (const uint8_t *)data;
+  const size_t head = _control->head.load(std::memory_order_relaxed);
+  size_t sent = 0;
+
+  while (sent < size)
+  {
+    // Waiting for free space, first spinning and then sleeping
+    auto isFull = [&]() { return head + sent - _control->tail.load(std::memory_order_acquire) == _capacity; };
+    for (size_t i = 0; isFull() && i < SHMRING_SPIN_COUNT; i++)
+      ;
+    while (isFull()) sleep(_control->producerSleeping, _spaceDoorbell, isFull);
+
+    // Copying as much as fits, possibly wrapping around the end of the ring
+    const size_t pos = head + sent;
+    const size_t free = _capacity - (pos - _control->tail.load(std::memory_order_acquire));
+    const size_t chunk = std::min(free, size - sent);
+    const size_t offset = pos & (_capacity - 1);
+    const size_t first = std::min(chunk, _capacity - offset);
+    memcpy(_data + offset, src + sent, first);
+    memcpy(_data, src + sent + first, chunk - first);
+    sent += chunk;
+
+    // Publishing the data and waking up the consumer, if sleeping
+    _control->head.store(head + sent, std::memory_order_seq_cst);
+    ring(_control->consumerSleeping, _dataDoorbell);
+  }
+}
+
+void shmRing::read(void *data, size_t size)
+{
+  auto dst = (uint8_t *)data;
+  const size_t tail = _control->tail.load(std::memory_order_relaxed);
+  size_t received = 0;
+
+  while (received < size)
+  {
+    // Waiting for data, first spinning and then sleeping
+    auto isEmpty = [&]() { return _control->head.load(std::memory_order_acquire) == tail + received; };
+    for (size_t i = 0; isEmpty() && i < SHMRING_SPIN_COUNT; i++)
+      ;
+    while (isEmpty()) sleep(_control->consumerSleeping, _dataDoorbell, isEmpty);
+
+    // Copying as much as available, possibly wrapping around the end of the ring
+    const size_t pos = tail + received;
+    const size_t available = _control->head.load(std::memory_order_acquire) - pos;
+    const size_t chunk = std::min(available, size - received);
+    const size_t offset = pos & (_capacity - 1);
+    const size_t first = std::min(chunk, _capacity - offset);
+    memcpy(dst + received, _data + offset, first);
+    memcpy(dst + received + first, _data, chunk - first);
+    received += chunk;
+
+    // Releasing the space and waking up the producer, if sleeping
+    _control->tail.store(tail + received, std::memory_order_seq_cst);
+    ring(_control->producerSleeping, _spaceDoorbell);
+  }
+}
+
+} // namespace korali
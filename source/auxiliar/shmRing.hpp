@@ -0,0 +1,146 @@
+#pragma once
+
+
+/** \file
+* @brief Implements a single-producer/single-consumer byte ring in shared memory,
+*        used to communicate between processes forked by the same parent.
+*        Blocked sides spin for a short while and then sleep on an eventfd doorbell.
+******************************************************************************/
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+
+/**
+* \namespace korali
+* @brief The Korali namespace includes all Korali-specific functions, variables, and modules.
+*/
+namespace korali
+{
+/**
+* \class shmRing
+* @brief Byte stream between exactly one producer and one consumer process. Must be created before forking.
+*/
+class shmRing
+{
+  public:
+  shmRing();
+
+  /**
+  * @brief Maps the shared ring and creates its doorbells. Must be called before the processes fork.
+  * @param capacity Number of bytes the ring can hold. Rounded up to a power of two.
+  */
+  void create(const size_t capacity);
+
+  /**
+  * @brief Unmaps the shared ring and closes its doorbells.
+  */
+  void destroy();
+
+  /**
+  * @brief (Producer) Writes bytes into the ring. Blocks while the ring is full.
+  * @param data Pointer to the data to write
+  * @param size Number of bytes to write
+  */
+  void write(const void *data, size_t size);
+
+  /**
+  * @brief (Consumer) Reads bytes from the ring. Blocks while the ring is empty.
+  * @param data Pointer to the storage to read into
+  * @param size Number of bytes to read
+  */
+  void read(void *data, size_t size);
+
+  /**
+  * @brief (Consumer) Checks, without blocking nor system calls, whether there are bytes pending to read.
+  * @return True, if there are no pending bytes; false, otherwise.
+  */
+  bool empty() const;
+
+  /**
+  * @brief Returns the file descriptor of the doorbell signaled when data becomes available to a sleeping consumer.
+  * @return The eventfd file descriptor
+  */
+  int getDataDoorbell() const { return _dataDoorbell; }
+
+  /**
+  * @brief (Consumer) Announces that the consumer will sleep on the data doorbell outside of read() (e.g., in epoll), so that the producer rings it.
+  * @return True, if the ring is still empty after the announcement and it is safe to sleep; false, otherwise.
+  */
+  bool announceSleep();
+
+  /**
+  * @brief (Consumer) Withdraws a sleep announcement and resets the data doorbell, in case it was rung.
+  */
+  void withdrawSleep();
+
+  private:
+  /**
+  * @brief Control block placed at the start of the shared mapping. Producer and consumer counters live in different cache lines.
+  */
+  struct control_t
+  {
+    /**
+    * @brief Total bytes written by the producer
+    */
+    alignas(64) std::atomic<size_t> head;
+
+    /**
+    * @brief Total bytes read by the consumer
+    */
+    alignas(64) std::atomic<size_t> tail;
+
+    /**
+    * @brief Set by the consumer before sleeping on the data doorbell
+    */
+    alignas(64) std::atomic<int> consumerSleeping;
+
+    /**
+    * @brief Set by the producer before sleeping on the space doorbell
+    */
+    std::atomic<int> producerSleeping;
+  };
+
+  /**
+  * @brief Pointer to the shared control block
+  */
+  control_t *_control;
+
+  /**
+  * @brief Pointer to the shared data region
+  */
+  uint8_t *_data;
+
+  /**
+  * @brief Size of the data region (a power of two)
+  */
+  size_t _capacity;
+
+  /**
+  * @brief Eventfd signaled by the producer when it publishes data and the consumer sleeps
+  */
+  int _dataDoorbell;
+
+  /**
+  * @brief Eventfd signaled by the consumer when it frees space and the producer sleeps
+  */
+  int _spaceDoorbell;
+
+  /**
+  * @brief Sleeps on a doorbell, unless the condition becomes false after announcing the sleep.
+  * @param sleeping The sleeping flag of the waiting side
+  * @param doorbell The doorbell to sleep on
+  * @param blocked Function that returns whether the waiting side is still blocked
+  */
+  template <typename F>
+  void sleep(std::atomic<int> &sleeping, int doorbell, F &&blocked);
+
+  /**
+  * @brief Rings a doorbell if the other side announced it is sleeping on it.
+  * @param sleeping The sleeping flag of the other side
+  * @param doorbell The doorbell to ring
+  */
+  void ring(std::atomic<int> &sleeping, int doorbell);
+};
+
+} // namespace korali
@@ -4,13 +4,20 @@
 #include "modules/problem/problem.hpp"
 #include "modules/solver/solver.hpp"
 #include "sample/sample.hpp"
+#include <errno.h>
 #include <fcntl.h>
 #include <sched.h>
+#include <sys/epoll.h>
 #include <sys/types.h>
 #include <sys/wait.h>
 
 #define BUFFERSIZE 4096
 
+/**
+ * @brief Maximum time (in milliseconds) the engine blocks waiting for worker messages before re-checking worker health
+ */
+#define WAIT_TIMEOUT_MS 100
+
 using namespace std;
 
 namespace korali
@@ -19,6 +26,44 @@ namespace conduit
 {
 ;
 
+/**
+ * @brief Writes exactly the given number of bytes into a blocking pipe, retrying on partial writes
+ * @param fd The pipe's file descriptor
+ * @param data Pointer to the data to write
+ * @param size Number of bytes to write
+ */
+static void writeBytes(int fd, const void *data, size_t size)
+{
+  auto ptr = (const uint8_t *)data;
+  while (size > 0)
+  {
+    ssize_t count = write(fd, ptr, size);
+    if (count < 0 && errno == EINTR) continue;
+    if (count < 0) KORALI_LOG_ERROR("Unable to write to inter-process pipe.\n");
+    ptr += count;
+    size -= count;
+  }
+}
+
+/**
+ * @brief Reads exactly the given number of bytes from a blocking pipe, retrying on partial reads
+ * @param fd The pipe's file descriptor
+ * @param data Pointer to the storage to read into
+ * @param size Number of bytes to read
+ */
+static void readBytes(int fd, void *data, size_t size)
+{
+  auto ptr = (uint8_t *)data;
+  while (size > 0)
+  {
+    ssize_t count = read(fd, ptr, size);
+    if (count < 0 && errno == EINTR) continue;
+    if (count <= 0) KORALI_LOG_ERROR("Unable to read from inter-process pipe.\n");
+    ptr += count;
+    size -= count;
+  }
+}
+
 void Concurrent::initialize()
 {
   // Setting workerId to -1 to identify master process
@@ -28,13 +73,30 @@ void Concurrent::initialize()
   _resultSizePipe.clear();
   _resultContentPipe.clear();
   _inputsPipe.clear();
+  _inputsRing.clear();
+  _resultRing.clear();
   _workerQueue.clear();
 
+  _useSharedMemory = _transport == "Shared Memory";
+  _blockOnIdle = _waitPolicy == "Spin Then Block";
+  _idlePassCount = 0;
+  _epollFd = -1;
+
   for (size_t i = 0; i < _concurrentJobs; i++) _resultSizePipe.push_back(vector<int>(2));
   for (size_t i = 0; i < _concurrentJobs; i++) _resultContentPipe.push_back(vector<int>(2));
   for (size_t i = 0; i < _concurrentJobs; i++) _inputsPipe.push_back(vector<int>(2));
   for (size_t i = 0; i < _concurrentJobs; i++) _workerQueue.push_back(i);
 
+  // Mapping shared memory rings, if requested. They need to be created before forking the workers.
+  if (_useSharedMemory)
+  {
+    if (_ringSize < 64) KORALI_LOG_ERROR("The shared memory ring size should be at least 64 bytes, provided: %lu\n", _ringSize);
+    _inputsRing.resize(_concurrentJobs);
+    _resultRing.resize(_concurrentJobs);
+    for (size_t i = 0; i < _concurrentJobs; i++) _inputsRing[i].create(_ringSize);
+    for (size_t i = 0; i < _concurrentJobs; i++) _resultRing[i].create(_ringSize);
+  }
+
   // Opening Inter-process communicator pipes
   for (size_t i = 0; i < _concurrentJobs; i++)
   {
@@ -59,8 +121,8 @@ void Concurrent::terminateServer()
 
   for (size_t i = 0; i < _concurrentJobs; i++)
   {
-    write(_inputsPipe[i][1], &msgSize, sizeof(size_t));
-    write(_inputsPipe[i][1], msgData.data(), msgSize * sizeof(uint8_t));
+    writeToWorker(i, &msgSize, sizeof(size_t));
+    writeToWorker(i, msgData.data(), msgSize * sizeof(uint8_t));
   }
 
   for (size_t i = 0; i < _concurrentJobs; i++)
@@ -78,6 +140,11 @@ void Concurrent::terminateServer()
     close(_inputsPipe[i][1]);        // Closing pipes
     close(_inputsPipe[i][0]);        // Closing pipes
   }
+
+  for (auto &ring : _inputsRing) ring.destroy();
+  for (auto &ring : _resultRing) ring.destroy();
+
+  if (_epollFd != -1) close(_epollFd);
 }
 
 void Concurrent::initServer()
@@ -93,6 +160,22 @@ void Concurrent::initServer()
     }
     _workerPids.push_back(processId);
   }
+
+  // (Engine-Side) Watching the channels coming from the workers to block on them when idle
+  if (_blockOnIdle)
+  {
+    _epollFd = epoll_create1(0);
+    if (_epollFd == -1) KORALI_LOG_ERROR("Unable to create epoll instance.\n");
+
+    for (size_t i = 0; i < _concurrentJobs; i++)
+    {
+      struct epoll_event event;
+      event.events = EPOLLIN;
+      event.data.u64 = i;
+      int fd = _useSharedMemory ? _resultRing[i].getDataDoorbell() : _resultSizePipe[i][0];
+      if (epoll_ctl(_epollFd, EPOLL_CTL_ADD, fd, &event) == -1) KORALI_LOG_ERROR("Unable to watch channel of worker %lu.\n", i);
+    }
+  }
 }
 
 void Concurrent::broadcastMessageToWorkers(knlohmann::json &message)
@@ -103,8 +186,8 @@ void Concurrent::broadcastMessageToWorkers(knlohmann::json &message)
 
   for (size_t i = 0; i < _concurrentJobs; i++)
   {
-    write(_inputsPipe[i][1], &messageSize, sizeof(size_t));
-    write(_inputsPipe[i][1], msgData.data(), messageSize * sizeof(uint8_t));
+    writeToWorker(i, &messageSize, sizeof(size_t));
+    writeToWorker(i, msgData.data(), messageSize * sizeof(uint8_t));
   }
 }
 
@@ -114,22 +197,66 @@ void Concurrent::sendMessageToEngine(knlohmann::json &message)
   std::vector<std::uint8_t> msgData = knlohmann::json::to_cbor(message);
   size_t messageSize = msgData.size();
 
-  write(_resultSizePipe[_workerId][1], &messageSize, sizeof(size_t));
-  write(_resultContentPipe[_workerId][1], msgData.data(), messageSize * sizeof(uint8_t));
+  // With pipes, the size goes through its own (non-blocking) pipe so that the engine can poll it
+  // (writes below PIPE_BUF bytes are atomic, so the size is either written whole or not at all)
+  if (_useSharedMemory)
+    _resultRing[_workerId].write(&messageSize, sizeof(size_t));
+  else
+  {
+    const int fd = _resultSizePipe[_workerId][1];
+    ssize_t count = write(fd, &messageSize, sizeof(size_t));
+    while (count < 0 && errno == EINTR) count = write(fd, &messageSize, sizeof(size_t));
+    if (count != (ssize_t)sizeof(size_t)) KORALI_LOG_ERROR("Unable to write message size to inter-process pipe.\n");
+  }
+
+  writeToEngine(msgData.data(), messageSize * sizeof(uint8_t));
+
+  // Sending binary buffers as raw bytes right after the message
+  if (message.contains("Binary Buffers"))
+    _workerBuffers.forEachBuffer([&](void *data, size_t size) { writeToEngine(data, size); });
 }
 
 knlohmann::json Concurrent::recvMessageFromEngine()
 {
   size_t inputSize;
-  read(_inputsPipe[_workerId][0], &inputSize, sizeof(size_t));
+  readFromEngine(&inputSize, sizeof(size_t));
   std::vector<uint8_t> msgData(inputSize);
-  read(_inputsPipe[_workerId][0], msgData.data(), inputSize * sizeof(uint8_t));
+  readFromEngine(msgData.data(), inputSize * sizeof(uint8_t));
   auto message = knlohmann::json::from_cbor(msgData);
+
+  // Receiving binary buffers directly into their final storage
+  if (message.contains("Binary Buffers"))
+  {
+    _workerBuffers.allocate(message["Binary Buffers"]);
+    _workerBuffers.forEachBuffer([&](void *data, size_t size) { readFromEngine(data, size); });
+  }
+
   return message;
 }
 
+void Concurrent::waitWorkerMessages()
+{
+  // Shared memory rings only ring their doorbell if the engine announced it is sleeping on them
+  bool isSafeToSleep = true;
+  if (_useSharedMemory)
+    for (auto &ring : _resultRing)
+      if (ring.announceSleep() == false) isSafeToSleep = false;
+
+  if (isSafeToSleep)
+  {
+    std::vector<struct epoll_event> events(_concurrentJobs);
+    epoll_wait(_epollFd, events.data(), events.size(), WAIT_TIMEOUT_MS);
+  }
+
+  if (_useSharedMemory)
+    for (auto &ring : _resultRing) ring.withdrawSleep();
+}
+
 void Concurrent::listenWorkers()
 {
+  // If no messages arrived for a while and there are busy workers, sleep until one does, freeing the engine's core
+  if (_blockOnIdle && _idlePassCount >= _spinCount && _workerQueue.size() < _concurrentJobs) waitWorkerMessages();
+
   // Check for child defunction
   for (size_t i = 0; i < _workerPids.size(); i++)
   {
@@ -139,22 +266,45 @@ void Concurrent::listenWorkers()
   }
 
   // Reading pending messages from all workers
+  bool isMessageReceived = false;
   for (size_t i = 0; i < _workerPids.size(); i++)
   {
-    // Identifying current sample
-    auto sample = _workerToSampleMap[i];
-
+    // Checking whether a message is pending, without blocking
     size_t inputSize;
-    int readBytes = read(_resultSizePipe[i][0], &inputSize, sizeof(size_t));
+    bool isMessagePending = false;
+    if (_useSharedMemory)
+    {
+      isMessagePending = _resultRing[i].empty() == false;
+      if (isMessagePending) _resultRing[i].read(&inputSize, sizeof(size_t));
+    }
+    else
+      isMessagePending = read(_resultSizePipe[i][0], &inputSize, sizeof(size_t)) > 0;
 
-    if (readBytes > 0)
+    if (isMessagePending)
     {
+      // Identifying current sample
+      auto sample = _workerToSampleMap[i];
+
       std::vector<uint8_t> msgData(inputSize);
-      read(_resultContentPipe[i][0], msgData.data(), inputSize * sizeof(uint8_t));
+      readFromWorker(i, msgData.data(), inputSize * sizeof(uint8_t));
       auto message = knlohmann::json::from_cbor(msgData);
+
+      // Receiving binary buffers directly into the sample's storage
+      if (message.contains("Binary Buffers"))
+      {
+        sample->_buffers.allocate(message["Binary Buffers"]);
+        sample->_buffers.forEachBuffer([&](void *data, size_t size) { readFromWorker(i, data, size); });
+      }
+
       sample->_messageQueue.push(message);
+      isMessageReceived = true;
     }
   }
+
+  if (isMessageReceived)
+    _idlePassCount = 0;
+  else
+    _idlePassCount++;
 }
 
 void Concurrent::stackEngine(Engine *engine)
@@ -185,8 +335,44 @@ void Concurrent::sendMessageToSample(Sample &sample, knlohmann::json &message)
   std::vector<std::uint8_t> msgData = knlohmann::json::to_cbor(message);
   size_t messageSize = msgData.size();
 
-  write(_inputsPipe[sample._workerId][1], &messageSize, sizeof(size_t));
-  write(_inputsPipe[sample._workerId][1], msgData.data(), messageSize * sizeof(uint8_t));
+  writeToWorker(sample._workerId, &messageSize, sizeof(size_t));
+  writeToWorker(sample._workerId, msgData.data(), messageSize * sizeof(uint8_t));
+
+  // Sending binary buffers as raw bytes right after the message
+  if (message.contains("Binary Buffers"))
+    sample._buffers.forEachBuffer([&](void *data, size_t size) { writeToWorker(sample._workerId, data, size); });
+}
+
+void Concurrent::writeToWorker(const size_t workerId, const void *data, const size_t size)
+{
+  if (_useSharedMemory)
+    _inputsRing[workerId].write(data, size);
+  else
+    writeBytes(_inputsPipe[workerId][1], data, size);
+}
+
+void Concurrent::readFromWorker(const size_t workerId, void *data, const size_t size)
+{
+  if (_useSharedMemory)
+    _resultRing[workerId].read(data, size);
+  else
+    readBytes(_resultContentPipe[workerId][0], data, size);
+}
+
+void Concurrent::writeToEngine(const void *data, const size_t size)
+{
+  if (_useSharedMemory)
+    _resultRing[_workerId].write(data, size);
+  else
+    writeBytes(_resultContentPipe[_workerId][1], data, size);
+}
+
+void Concurrent::readFromEngine(void *data, const size_t size)
+{
+  if (_useSharedMemory)
+    _inputsRing[_workerId].read(data, size);
+  else
+    readBytes(_inputsPipe[_workerId][0], data, size);
 }
 
 bool Concurrent::isRoot() const
@@ -217,6 +403,54 @@ void Concurrent::setConfiguration(knlohmann::json& js)
  }
   else   KORALI_LOG_ERROR(" + No value provided for mandatory setting: ['Concurrent Jobs'] required by concurrent.\n"); 
 
+ if (isDefined(js, "Transport"))
+ {
+ try { _transport = js["Transport"].get<std::string>();
+} catch (const std::exception& e)
+ { KORALI_LOG_ERROR(" + Object: [ concurrent ] \n + Key:    ['Transport']\n%s", e.what()); } 
+{
+ bool validOption = false; 
+ if (_transport == "Pipe") validOption = true; 
+ if (_transport == "Shared Memory") validOption = true; 
+ if (validOption == false) KORALI_LOG_ERROR(" + Unrecognized value (%s) provided for mandatory setting: ['Transport'] required by concurrent.\n", _transport.c_str()); 
+}
+   eraseValue(js, "Transport");
+ }
+  else   KORALI_LOG_ERROR(" + No value provided for mandatory setting: ['Transport'] required by concurrent.\n"); 
+
+ if (isDefined(js, "Ring Size"))
+ {
+ try { _ringSize = js["Ring Size"].get<size_t>();
+} catch (const std::exception& e)
+ { KORALI_LOG_ERROR(" + Object: [ concurrent ] \n + Key:    ['Ring Size']\n%s", e.what()); } 
+   eraseValue(js, "Ring Size");
+ }
+  else   KORALI_LOG_ERROR(" + No value provided for mandatory setting: ['Ring Size'] required by concurrent.\n"); 
+
+ if (isDefined(js, "Wait Policy"))
+ {
+ try { _waitPolicy = js["Wait Policy"].get<std::string>();
+} catch (const std::exception& e)
+ { KORALI_LOG_ERROR(" + Object: [ concurrent ] \n + Key:    ['Wait Policy']\n%s", e.what()); } 
+{
+ bool validOption = false; 
+ if (_waitPolicy == "Busy Polling") validOption = true; 
+ if (_waitPolicy == "Spin Then Block") validOption = true; 
+ if (validOption == false) KORALI_LOG_ERROR(" + Unrecognized value (%s) provided for mandatory setting: ['Wait Policy'] required by concurrent.\n", _waitPolicy.c_str()); 
+}
+   eraseValue(js, "Wait Policy");
+ }
+  else   KORALI_LOG_ERROR(" + No value provided for mandatory setting: ['Wait Policy'] required by concurrent.\n"); 
+
+ if (isDefined(js, "Spin Count"))
+ {
+ try { _spinCount = js["Spin Count"].get<size_t>();
+} catch (const std::exception& e)
+ { KORALI_LOG_ERROR(" + Object: [ concurrent ] \n + Key:    ['Spin Count']\n%s", e.what()); } 
+   eraseValue(js, "Spin Count");
+ }
+  else   KORALI_LOG_ERROR(" + No value provided for mandatory setting: ['Spin Count'] required by concurrent.\n"); 
+
  Conduit::setConfiguration(js);
  _type = "concurrent";
  if(isDefined(js, "Type")) eraseValue(js, "Type");
@@ -228,13 +462,17 @@ void Concurrent::getConfiguration(knlohmann::json& js)
 
  js["Type"] = _type;
    js["Concurrent Jobs"] = _concurrentJobs;
+   js["Transport"] = _transport;
+   js["Ring Size"] = _ringSize;
+   js["Wait Policy"] = _waitPolicy;
+   js["Spin Count"] = _spinCount;
  Conduit::getConfiguration(js);
 } 
 
 void Concurrent::applyModuleDefaults(knlohmann::json& js) 
 {
 
- std::string defaultString = "{\"Concurrent Jobs\": 1}";
+ std::string defaultString = "{\"Concurrent Jobs\": 1, \"Transport\": \"Pipe\", \"Ring Size\": 1048576, \"Wait Policy\": \"Busy Polling\", \"Spin Count\": 1000}";
  knlohmann::json defaultJs = knlohmann::json::parse(defaultString);
  mergeJson(js, defaultJs); 
  Conduit::applyModuleDefaults(js);
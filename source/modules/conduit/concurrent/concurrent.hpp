@@ -12,6 +12,7 @@
 
 #pragma once
 
+#include "auxiliar/shmRing.hpp"
 #include "modules/conduit/conduit.hpp"
 #include <chrono>
 #include <map>
@@ -33,6 +34,22 @@ class Concurrent : public Conduit
   * @brief Specifies the number of worker processes (jobs) running concurrently.
   */
    size_t _concurrentJobs;
+  /**
+  * @brief Specifies the mechanism used to exchange messages between the engine and the worker processes.
+  */
+   std::string _transport;
+  /**
+  * @brief (Shared Memory transport only) Specifies the capacity, in bytes, of each shared memory ring. Larger messages are streamed through it.
+  */
+   size_t _ringSize;
+  /**
+  * @brief Specifies how the engine waits for incoming worker messages while samples are running.
+  */
+   std::string _waitPolicy;
+  /**
+  * @brief (Spin Then Block policy only) Number of consecutive polling passes without incoming messages before the engine blocks.
+  */
+   size_t _spinCount;
   
  
   /**
@@ -81,6 +98,71 @@ class Concurrent : public Conduit
    */
   std::vector<std::vector<int>> _inputsPipe;
 
+  /**
+   * @brief Indicates whether the shared memory transport is in use
+   */
+  bool _useSharedMemory;
+
+  /**
+   * @brief Shared memory rings to handle sample parameter communication to worker processes
+   */
+  std::vector<shmRing> _inputsRing;
+
+  /**
+   * @brief Shared memory rings to handle result communication coming from worker processes
+   */
+  std::vector<shmRing> _resultRing;
+
+  /**
+   * @brief Indicates whether the engine blocks after a number of idle polling passes
+   */
+  bool _blockOnIdle;
+
+  /**
+   * @brief Number of consecutive polling passes without incoming messages
+   */
+  size_t _idlePassCount;
+
+  /**
+   * @brief (Engine Side) Epoll instance watching the channels coming from the workers
+   */
+  int _epollFd;
+
+  /**
+   * @brief (Engine Side) Blocks until a message from any worker is pending, or a timeout expires
+   */
+  void waitWorkerMessages();
+
+  /**
+   * @brief (Engine Side) Writes bytes into the channel towards a worker
+   * @param workerId The destination worker
+   * @param data Pointer to the data to write
+   * @param size Number of bytes to write
+   */
+  void writeToWorker(const size_t workerId, const void *data, const size_t size);
+
+  /**
+   * @brief (Engine Side) Reads bytes from the channel coming from a worker
+   * @param workerId The source worker
+   * @param data Pointer to the storage to read into
+   * @param size Number of bytes to read
+   */
+  void readFromWorker(const size_t workerId, void *data, const size_t size);
+
+  /**
+   * @brief (Worker Side) Writes bytes into the channel towards the engine
+   * @param data Pointer to the data to write
+   * @param size Number of bytes to write
+   */
+  void writeToEngine(const void *data, const size_t size);
+
+  /**
+   * @brief (Worker Side) Reads bytes from the channel coming from the engine
+   * @param data Pointer to the storage to read into
+   * @param size Number of bytes to read
+   */
+  void readFromEngine(void *data, const size_t size);
+
   bool isRoot() const override;
   void initServer() override;
   void initialize() override;
@@ -1,8 +1,11 @@
 #include "engine.hpp"
 #include "modules/conduit/conduit.hpp"
 #include "modules/experiment/experiment.hpp"
+#include "modules/problem/problem.hpp"
 #include "sample/sample.hpp"
+#include <algorithm>
 #include <chrono>
+#include <functional>
 
 using namespace std;
 
@@ -28,43 +31,72 @@ void Conduit::coroutineWrapper()
 }
 //}
 
-void Conduit::runSample(Sample *sample, Engine *engine)
+Conduit::~Conduit()
 {
-  // Setting sample information
-  (*sample)["Experiment Id"] = engine->_currentExperiment->_experimentId;
-  (*sample)["Current Generation"] = engine->_currentExperiment->_currentGeneration;
-  (*sample)["Has Finished"] = false;
+  co_pool_destroy(_stackPool);
+}
 
+void Conduit::runSample(Sample *sample, Engine *engine)
+{
   // Identifier of the worker that will execute the sample
   size_t workerId = 0;
 
   // Check whether there are available workers to compute this sample.
-  while (engine->_conduit->_workerQueue.empty())
+  while (engine->_conduit->isWorkerAvailable() == false)
   {
     //  If none are available, set sample's state back to initialized
     sample->_state = SampleState::initialized;
 
+    // Queueing the sample to be resumed once a worker becomes available
+    engine->_conduit->_pendingSampleQueue.push_back(sample);
+
     // And come back to the experiment's thread
     co_switch(engine->_currentExperiment->_thread);
   }
 
-  // Selecting the next available worker
-  workerId = engine->_conduit->_workerQueue.front();
-  engine->_conduit->_workerQueue.pop_front();
+  const bool isBatched = engine->_conduit->_batchSize > 1;
+
+  if (isBatched)
+  {
+    if (sample->_buffers.empty() == false) KORALI_LOG_ERROR("Samples with binary buffers cannot be sent in batches. Set the conduit's Batch Size to 1.\n");
+
+    // Joining the last batch not sent yet, or opening a new one on the next available worker
+    auto &batchQueue = engine->_conduit->_batchQueue;
+    if (batchQueue.empty() || batchQueue.back().size() == engine->_conduit->_batchSize)
+    {
+      workerId = engine->_conduit->_workerQueue.front();
+      engine->_conduit->_workerQueue.pop_front();
+      batchQueue.push_back(std::vector<Sample *>());
+    }
+    else
+      workerId = batchQueue.back().front()->_workerId;
+
+    batchQueue.back().push_back(sample);
+  }
+  else
+  {
+    // Selecting the next available worker
+    workerId = engine->_conduit->_workerQueue.front();
+    engine->_conduit->_workerQueue.pop_front();
+    engine->_conduit->_workerToSampleMap[workerId] = sample;
+  }
 
-  // Assigning worker to sample ids and vice-versa for bookkeeping
+  // Assigning worker to sample ids for bookkeeping
   (*sample)["Worker Id"] = workerId;
   sample->_workerId = workerId;
-  engine->_conduit->_workerToSampleMap[workerId] = sample;
 
   // Storing profiling information
   auto timelineJs = knlohmann::json();
   timelineJs["Start Time"] = chrono::duration<double>(chrono::high_resolution_clock::now() - _startTime).count() + _cumulativeTime;
 
-  // Sending sample information to worker
-  auto sampleJs = sample->_js.getJson();
-  sampleJs["Conduit Action"] = "Process Sample";
-  engine->_conduit->sendMessageToSample(*sample, sampleJs);
+  // Sending sample information to worker, unless it travels later with its batch. Binary buffers are only described in the JSON, their contents travel as raw bytes.
+  if (isBatched == false)
+  {
+    auto sampleJs = sample->_js.getJson();
+    sampleJs["Conduit Action"] = "Process Sample";
+    if (sample->_buffers.empty() == false) sampleJs["Binary Buffers"] = sample->_buffers.getHeader();
+    engine->_conduit->sendMessageToSample(*sample, sampleJs);
+  }
 
   // Waiting for ending message from sample
   knlohmann::json endMessage;
@@ -78,11 +110,44 @@ void Conduit::runSample(Sample *sample, Engine *engine)
 
   } while (sample->retrievePendingMessage(endMessage) == false);
 
-  // Now replacing sample's information by that of the end message
+  // The first sample of a batch receives the results of all the batch samples, and hands them over
+  if (isBatched && engine->_conduit->_workerToSampleMap[workerId] == sample)
+  {
+    if (endMessage.contains("Batch Results") == false) KORALI_LOG_ERROR("Samples that send messages to the engine while running cannot be sent in batches. Set the conduit's Batch Size to 1.\n");
+
+    auto &batch = engine->_conduit->_workerToBatchMap[workerId];
+    for (size_t i = 1; i < batch.size(); i++) batch[i]->_messageQueue.push(endMessage["Batch Results"][i]);
+
+    knlohmann::json result = endMessage["Batch Results"][0];
+    endMessage = std::move(result);
+  }
+
+  // Now replacing sample's information by that of the end message. Its binary buffers have already been received by the conduit.
   sample->_js.getJson() = endMessage;
+  sample->_js.getJson().erase("Binary Buffers");
 
-  // Putting worker back to the available worker queue
-  engine->_conduit->_workerQueue.push_back(sample->_workerId);
+  if (isBatched)
+  {
+    // The worker becomes available once all the samples of its batch have finished
+    auto &batch = engine->_conduit->_workerToBatchMap[workerId];
+    batch.erase(std::find(batch.begin(), batch.end(), sample));
+
+    if (batch.empty())
+    {
+      engine->_conduit->_workerQueue.push_back(workerId);
+      engine->_conduit->_workerToBatchMap.erase(workerId);
+      engine->_conduit->_workerToSampleMap.erase(workerId);
+    }
+  }
+  else
+  {
+    // Putting worker back to the available worker queue
+    engine->_conduit->_workerQueue.push_back(sample->_workerId);
+    engine->_conduit->_workerToSampleMap.erase(sample->_workerId);
+  }
+
+  // Notifying the waiting experiment that the sample has finished
+  engine->_conduit->_finishedSampleQueue.push_back(sample);
 
   // Storing profiling information
   timelineJs["End Time"] = chrono::duration<double>(chrono::high_resolution_clock::now() - _startTime).count() + _cumulativeTime;
@@ -101,6 +166,7 @@ void Conduit::worker()
 
     if (js["Conduit Action"] == "Terminate") break;
     if (js["Conduit Action"] == "Process Sample") workerProcessSample(js);
+    if (js["Conduit Action"] == "Process Batch") workerProcessBatch(js);
     if (js["Conduit Action"] == "Stack Engine") workerStackEngine(js);
     if (js["Conduit Action"] == "Pop Engine") workerPopEngine();
   }
@@ -111,8 +177,63 @@ void Conduit::workerProcessSample(const knlohmann::json &js)
   auto expId = js["Experiment Id"];
   Sample s;
   s._js.getJson() = js;
+  s._js.getJson().erase("Binary Buffers");
+
+  // Taking over the binary buffers received with the sample (no copy)
+  s._buffers.swap(_workerBuffers);
+
   s.sampleLauncher();
+
+  // Handing the resulting binary buffers back to the conduit, to be sent along with the results
+  _workerBuffers.clear();
+  _workerBuffers.swap(s._buffers);
+  if (_workerBuffers.empty() == false) s["Binary Buffers"] = _workerBuffers.getHeader();
+
   sendMessageToEngine(s._js.getJson());
+  _workerBuffers.clear();
+}
+
+void Conduit::workerProcessBatch(const knlohmann::json &js)
+{
+  Engine *engine = _engineStack.top();
+  const size_t sampleCount = js["Samples"].size();
+
+  std::vector<Sample> samples(sampleCount);
+  for (size_t i = 0; i < sampleCount; i++) samples[i]._js.getJson() = js["Samples"][i];
+
+  // Consecutive samples of the same experiment and operation are processed together, so that problems can evaluate them with a single model call
+  size_t first = 0;
+  while (first < sampleCount)
+  {
+    size_t last = first + 1;
+    while (last < sampleCount && samples[last]["Experiment Id"] == samples[first]["Experiment Id"] && samples[last]["Module"] == samples[first]["Module"] && samples[last]["Operation"] == samples[first]["Operation"]) last++;
+
+    std::vector<Sample *> group;
+    for (size_t i = first; i < last; i++) group.push_back(&samples[i]);
+
+    size_t experimentId = KORALI_GET(size_t, samples[first], "Experiment Id");
+    auto operation = KORALI_GET(std::string, samples[first], "Operation");
+    auto experiment = engine->_experimentVector[experimentId];
+
+    // Problems that cannot process the whole group at once process each sample individually
+    bool isGroupProcessed = samples[first]["Module"] == "Problem" && experiment->_problem->runBatchOperation(operation, group);
+
+    for (auto sample : group)
+    {
+      if (isGroupProcessed == false) sample->sampleLauncher();
+      (*sample)["Has Finished"] = true;
+    }
+
+    first = last;
+  }
+
+  // Returning the results of all samples in a single message
+  knlohmann::json resultsJs;
+  resultsJs["Batch Results"] = knlohmann::json::array();
+  for (size_t i = 0; i < sampleCount; i++) resultsJs["Batch Results"].push_back(samples[i]._js.getJson());
+  resultsJs["Has Finished"] = true;
+
+  sendMessageToEngine(resultsJs);
 }
 
 void Conduit::workerStackEngine(const knlohmann::json &js)
@@ -147,31 +268,131 @@ void Conduit::start(Sample &sample)
   KORALI_GET(size_t, sample, "Sample Id");
 
   if (sample._state != SampleState::uninitialized) KORALI_LOG_ERROR("Sample has already been initialized.\n");
-  sample._sampleThread = co_create(1 << 28, Conduit::coroutineWrapper);
 
-  _currentSample = &sample;
+  // Setting sample information now, since the sample might be launched later, while another experiment runs
+  Engine *engine = _engineStack.top();
+  sample["Experiment Id"] = engine->_currentExperiment->_experimentId;
+  sample["Current Generation"] = engine->_currentExperiment->_currentGeneration;
+  sample["Has Finished"] = false;
 
   sample._state = SampleState::initialized;
+
+  // Samples waiting for an available worker do not hold a coroutine stack. They are launched in order of arrival.
+  if (isWorkerAvailable() == false || _pendingSampleQueue.empty() == false)
+  {
+    _pendingSampleQueue.push_back(&sample);
+    return;
+  }
+
+  launchSample(sample);
+}
+
+void Conduit::launchSample(Sample &sample)
+{
+  if (_stackPool == NULL)
+  {
+    if (_stackSize < 65536) KORALI_LOG_ERROR("The conduit's stack size must be at least 65536 bytes, provided: %lu\n", _stackSize);
+    _stackPool = co_pool_create(_stackSize);
+    if (_stackPool == NULL) KORALI_LOG_ERROR("Unable to create coroutine stack pool.\n");
+  }
+
+  sample._sampleThread = co_pool_acquire(_stackPool, Conduit::coroutineWrapper, &sample._sampleStack);
+  if (sample._sampleThread == NULL) KORALI_LOG_ERROR("Unable to map a coroutine stack of %lu bytes for the sample.\n", _stackSize);
+
+  _currentSample = &sample;
+
+  sample._state = SampleState::running;
   co_switch(sample._sampleThread);
 }
 
-void Conduit::wait(Sample &sample)
+/**
+ * @brief Checks whether a sample belongs to a contiguous set of samples
+ * @param sample Pointer to the sample
+ * @param first Pointer to the first sample of the set
+ * @param last Pointer past the last sample of the set
+ * @return True, if the sample belongs to the set; false, otherwise.
+ */
+static bool isSampleInSet(const Sample *sample, const Sample *first, const Sample *last)
 {
-  Engine *engine = _engineStack.top();
+  return std::less_equal<const Sample *>()(first, sample) && std::less<const Sample *>()(sample, last);
+}
 
-  while (sample._state == SampleState::waiting || sample._state == SampleState::initialized)
+bool Conduit::isWorkerAvailable() const
+{
+  // Under batching, samples can join the last batch not sent yet, as long as it has room
+  if (_batchQueue.empty() == false && _batchQueue.back().size() < _batchSize) return true;
+
+  return _workerQueue.empty() == false;
+}
+
+void Conduit::startPendingSamples()
+{
+  while (isWorkerAvailable() && _pendingSampleQueue.empty() == false)
   {
-    // Listen for any pending messages
-    listenWorkers();
+    auto sample = _pendingSampleQueue.front();
+    _pendingSampleQueue.pop_front();
 
-    // Check for error signals from python
-    if (isPythonActive && PyErr_CheckSignals() != 0) KORALI_LOG_ERROR("User requested break.\n");
+    // Samples that already have a coroutine are resumed, otherwise they are launched
+    if (sample->_sampleThread != NULL)
+    {
+      sample->_state = SampleState::running;
+      co_switch(sample->_sampleThread);
+    }
+    else
+      launchSample(*sample);
+  }
+}
+
+void Conduit::sendBatches(bool sendPartial)
+{
+  while (_batchQueue.empty() == false)
+  {
+    if (_batchQueue.front().size() < _batchSize && sendPartial == false) break;
 
-    sample._state = SampleState::running;
-    co_switch(sample._sampleThread);
+    // The first sample of the batch receives the messages from the worker
+    size_t workerId = _batchQueue.front().front()->_workerId;
+    _workerToBatchMap[workerId] = _batchQueue.front();
+    _workerToSampleMap[workerId] = _batchQueue.front().front();
+    _batchQueue.pop_front();
 
-    if (sample._state == SampleState::waiting || sample._state == SampleState::initialized) co_switch(engine->_thread);
+    // Sending the information of all batch samples in a single message
+    knlohmann::json batchJs;
+    batchJs["Conduit Action"] = "Process Batch";
+    batchJs["Samples"] = knlohmann::json::array();
+    for (auto sample : _workerToBatchMap[workerId]) batchJs["Samples"].push_back(sample->_js.getJson());
+
+    sendMessageToSample(*_workerToSampleMap[workerId], batchJs);
   }
+}
+
+void Conduit::resumeReadySamples(Sample *first, Sample *last)
+{
+  // Only running samples (at most one per worker, or one batch per worker) can have received messages
+  std::vector<Sample *> readySamples;
+  if (_batchSize > 1)
+  {
+    for (const auto &entry : _workerToBatchMap)
+      for (auto sample : entry.second)
+        if (isSampleInSet(sample, first, last) && sample->_messageQueue.empty() == false)
+          readySamples.push_back(sample);
+  }
+  else
+  {
+    for (const auto &entry : _workerToSampleMap)
+      if (isSampleInSet(entry.second, first, last) && entry.second->_messageQueue.empty() == false)
+        readySamples.push_back(entry.second);
+  }
+
+  for (auto sample : readySamples)
+  {
+    sample->_state = SampleState::running;
+    co_switch(sample->_sampleThread);
+  }
+}
+
+void Conduit::finalizeSample(Sample &sample)
+{
+  Engine *engine = _engineStack.top();
 
   size_t sampleId = KORALI_GET(size_t, sample, "Sample Id");
 
@@ -180,88 +401,135 @@ void Conduit::wait(Sample &sample)
     engine->_currentExperiment->_sampleInfo["Samples"][sampleId] = sample._js.getJson();
 
   sample._state = SampleState::uninitialized;
-  co_delete(sample._sampleThread);
+  co_pool_release(_stackPool, sample._sampleStack);
+  sample._sampleThread = NULL;
+  sample._sampleStack = NULL;
+}
+
+void Conduit::wait(Sample &sample)
+{
+  Engine *engine = _engineStack.top();
+
+  while (sample._state == SampleState::waiting || sample._state == SampleState::initialized)
+  {
+    // Sending full batches and listen for any pending messages
+    sendBatches(false);
+    listenWorkers();
+
+    // Check for error signals from python
+    if (isPythonActive && PyErr_CheckSignals() != 0) KORALI_LOG_ERROR("User requested break.\n");
+
+    startPendingSamples();
+    resumeReadySamples(&sample, &sample + 1);
+
+    // Before yielding, sending batches that are not full, so that their workers do not stay idle
+    if (sample._state == SampleState::waiting || sample._state == SampleState::initialized)
+    {
+      sendBatches(true);
+      co_switch(engine->_thread);
+    }
+  }
+
+  // Removing the sample from the completion queue
+  auto entry = std::find(_finishedSampleQueue.begin(), _finishedSampleQueue.end(), &sample);
+  if (entry != _finishedSampleQueue.end()) _finishedSampleQueue.erase(entry);
+
+  finalizeSample(sample);
 }
 
 size_t Conduit::waitAny(vector<Sample> &samples)
 {
   Engine *engine = _engineStack.top();
-  bool isFinished = false;
-  size_t currentSample;
+  Sample *first = samples.data();
+  Sample *last = samples.data() + samples.size();
 
-  while (isFinished == false)
+  while (true)
   {
-    // Listen for any pending messages
+    // Sending full batches and listen for any pending messages
+    sendBatches(false);
     listenWorkers();
 
     // Check for error signals from python
     if (isPythonActive && PyErr_CheckSignals() != 0) throw pybind11::error_already_set();
 
-    for (currentSample = 0; currentSample < samples.size(); currentSample++)
+    startPendingSamples();
+    resumeReadySamples(first, last);
+
+    // Popping the earliest finished sample of this set from the completion queue (usually, its front)
+    auto entry = _finishedSampleQueue.begin();
+    while (entry != _finishedSampleQueue.end())
     {
-      if (samples[currentSample]._state == SampleState::waiting || samples[currentSample]._state == SampleState::initialized)
+      if (isSampleInSet(*entry, first, last) == false)
       {
-        samples[currentSample]._state = SampleState::running;
-        co_switch(samples[currentSample]._sampleThread);
+        entry++;
+        continue;
       }
 
-      if (samples[currentSample]._state == SampleState::finished)
-      {
-        auto sampleId = KORALI_GET(size_t, samples[currentSample], "Sample Id");
+      Sample *sample = *entry;
+      entry = _finishedSampleQueue.erase(entry);
 
-        // If the user wants to store sample information, this is where we store its information
-        if (engine->_currentExperiment->_storeSampleInformation == true)
-          engine->_currentExperiment->_sampleInfo["Samples"][sampleId] = samples[currentSample]._js.getJson();
+      // Discarding stale entries of samples that were restarted without being waited for
+      if (sample->_state != SampleState::finished) continue;
 
-        samples[currentSample]._state = SampleState::uninitialized;
-        co_delete(samples[currentSample]._sampleThread);
-        isFinished = true;
-        break;
-      }
+      finalizeSample(*sample);
+      return sample - first;
     }
 
-    if (isFinished == false) co_switch(engine->_thread);
+    // Before yielding, sending batches that are not full, so that their workers do not stay idle
+    sendBatches(true);
+    co_switch(engine->_thread);
   }
-
-  return currentSample;
 }
 
 void Conduit::waitAll(vector<Sample> &samples)
 {
   Engine *engine = _engineStack.top();
-  bool isFinished = false;
+  Sample *first = samples.data();
+  Sample *last = samples.data() + samples.size();
 
-  while (isFinished == false)
+  // Counting the samples of this set that remain to be finalized
+  size_t remainingSamples = 0;
+  for (size_t i = 0; i < samples.size(); i++)
+    if (samples[i]._state != SampleState::uninitialized) remainingSamples++;
+
+  while (remainingSamples > 0)
   {
-    // Listen for any pending messages
+    // Sending full batches and listen for any pending messages
+    sendBatches(false);
     listenWorkers();
 
     // Check for error signals from python
     if (isPythonActive && PyErr_CheckSignals() != 0) KORALI_LOG_ERROR("User requested break.\n");
 
-    isFinished = true;
+    startPendingSamples();
+    resumeReadySamples(first, last);
 
-    for (size_t i = 0; i < samples.size(); i++)
-      if (samples[i]._state == SampleState::waiting || samples[i]._state == SampleState::initialized)
+    // Finalizing the finished samples of this set from the completion queue
+    auto entry = _finishedSampleQueue.begin();
+    while (entry != _finishedSampleQueue.end())
+    {
+      if (isSampleInSet(*entry, first, last) == false)
       {
-        isFinished = false;
-        samples[i]._state = SampleState::running;
-        co_switch(samples[i]._sampleThread);
+        entry++;
+        continue;
       }
 
-    if (isFinished == false) co_switch(engine->_thread);
-  }
+      Sample *sample = *entry;
+      entry = _finishedSampleQueue.erase(entry);
 
-  for (size_t i = 0; i < samples.size(); i++)
-  {
-    auto sampleId = KORALI_GET(size_t, samples[i], "Sample Id");
+      // Discarding stale entries of samples that were restarted without being waited for
+      if (sample->_state != SampleState::finished) continue;
 
-    // If the user wants to store sample information, this is where we store its information
-    if (engine->_currentExperiment->_storeSampleInformation == true)
-      engine->_currentExperiment->_sampleInfo["Samples"][sampleId] = samples[i]._js.getJson();
+      finalizeSample(*sample);
+      remainingSamples--;
+    }
 
-    samples[i]._state = SampleState::uninitialized;
-    co_delete(samples[i]._sampleThread);
+    // Before yielding, sending batches that are not full, so that their workers do not stay idle
+    if (remainingSamples > 0)
+    {
+      sendBatches(true);
+      co_switch(engine->_thread);
+    }
   }
 }
 
@@ -273,19 +541,33 @@ void Conduit::listen(std::vector<Sample> &samples)
   // Check for error signals from python
   if (isPythonActive && PyErr_CheckSignals() != 0) throw pybind11::error_already_set();
 
-  // Doing a pass on samples in case they are waiting to execute
-  for (size_t currentSample = 0; currentSample < samples.size(); currentSample++)
-    if (samples[currentSample]._state == SampleState::initialized)
-    {
-      samples[currentSample]._state = SampleState::running;
-      co_switch(samples[currentSample]._sampleThread);
-    }
+  // Starting samples in case they are waiting for a worker
+  startPendingSamples();
+  sendBatches(true);
 }
 
 void Conduit::setConfiguration(knlohmann::json& js) 
 {
  if (isDefined(js, "Results"))  eraseValue(js, "Results");
 
+ if (isDefined(js, "Stack Size"))
+ {
+ try { _stackSize = js["Stack Size"].get<size_t>();
+} catch (const std::exception& e)
+ { KORALI_LOG_ERROR(" + Object: [ conduit ] \n + Key:    ['Stack Size']\n%s", e.what()); } 
+   eraseValue(js, "Stack Size");
+ }
+  else   KORALI_LOG_ERROR(" + No value provided for mandatory setting: ['Stack Size'] required by conduit.\n"); 
+
+ if (isDefined(js, "Batch Size"))
+ {
+ try { _batchSize = js["Batch Size"].get<size_t>();
+} catch (const std::exception& e)
+ { KORALI_LOG_ERROR(" + Object: [ conduit ] \n + Key:    ['Batch Size']\n%s", e.what()); } 
+   eraseValue(js, "Batch Size");
+ }
+  else   KORALI_LOG_ERROR(" + No value provided for mandatory setting: ['Batch Size'] required by conduit.\n"); 
+
  Module::setConfiguration(js);
  _type = ".";
  if(isDefined(js, "Type")) eraseValue(js, "Type");
@@ -296,13 +578,15 @@ void Conduit::getConfiguration(knlohmann::json& js)
 {
 
  js["Type"] = _type;
+   js["Stack Size"] = _stackSize;
+   js["Batch Size"] = _batchSize;
  Module::getConfiguration(js);
 } 
 
 void Conduit::applyModuleDefaults(knlohmann::json& js) 
 {
 
- std::string defaultString = "{}";
+ std::string defaultString = "{\"Stack Size\": 1048576, \"Batch Size\": 1}";
  knlohmann::json defaultJs = knlohmann::json::parse(defaultString);
  mergeJson(js, defaultJs); 
  Module::applyModuleDefaults(js);
@@ -12,7 +12,9 @@
 
 #pragma once
 
+#include "auxiliar/libco/copool.h"
 #include "modules/module.hpp"
+#include "sample/sample.hpp"
 #include <deque>
 #include <vector>
 
@@ -31,6 +33,14 @@ class Engine;
 class Conduit : public Module
 {
   public: 
+  /**
+  * @brief Specifies the size (in bytes) of the coroutine stack of each running sample. Stacks are taken from a pool, protected with a guard page, and reused across samples. Samples waiting for an available worker do not hold a stack.
+  */
+   size_t _stackSize;
+  /**
+  * @brief Specifies the maximum number of samples sent to a worker in a single message. Batches are sent once full, or earlier, if the engine would otherwise wait. Problems with a vectorized model evaluate the whole batch with a single model call. Samples that exchange messages with the engine while running, or carry binary buffers, require a batch size of 1.
+  */
+   size_t _batchSize;
   
  
   /**
@@ -54,11 +64,21 @@ class Conduit : public Module
   void applyVariableDefaults() override;
   
 
+  /**
+   * @brief Releases the coroutine stack pool
+   */
+  ~Conduit();
+
   /**
    * @brief Lifetime function for korali workers.
    */
   void worker();
 
+  /**
+   * @brief Pool of coroutine stacks for the running samples, created upon the first sample start
+   */
+  co_pool *_stackPool = NULL;
+
   /**
    * @brief Double ended queue to store idle workers to assign samples to
    */
@@ -69,6 +89,31 @@ class Conduit : public Module
    */
   std::map<size_t, Sample *> _workerToSampleMap;
 
+  /**
+   * @brief Queue of samples waiting for an available worker, in order of arrival
+   */
+  std::deque<Sample *> _pendingSampleQueue;
+
+  /**
+   * @brief Completion queue of samples whose ending message has arrived, in order of completion
+   */
+  std::deque<Sample *> _finishedSampleQueue;
+
+  /**
+   * @brief (Batch Size > 1) Batches of samples not sent yet, each with its worker already assigned. Only the last one can be partially filled.
+   */
+  std::deque<std::vector<Sample *>> _batchQueue;
+
+  /**
+   * @brief (Batch Size > 1) Map that links workers to the samples of the batch they execute. Messages from the worker are received by the batch's first sample.
+   */
+  std::map<size_t, std::vector<Sample *>> _workerToBatchMap;
+
+  /**
+   * @brief (Worker Side) Binary buffers received along with the current sample, or to be returned with its results
+   */
+  SampleBuffers _workerBuffers;
+
   /**
    * @brief Determines whether the caller rank/thread/process is root.
    * @return True, if it is root; false, otherwise.
@@ -87,6 +132,12 @@ class Conduit : public Module
    */
   void workerProcessSample(const knlohmann::json &js);
 
+  /**
+   * @brief  (Worker Side) Processes a batch of samples and returns all their results in a single message
+   * @param js Contains the input data and metadata of each sample
+   */
+  void workerProcessBatch(const knlohmann::json &js);
+
   /**
    * @brief (Worker Side) Accepts and stacks an incoming Korali engine from the main process
    * @param js Contains Engine's input data and metadata
@@ -123,6 +174,42 @@ class Conduit : public Module
    */
   size_t waitAny(std::vector<Sample> &samples);
 
+  /**
+   * @brief Creates the coroutine of a sample on a pooled stack and runs it until it yields
+   * @param sample A Korali sample
+   */
+  void launchSample(Sample &sample);
+
+  /**
+   * @brief Checks whether a sample can be assigned a worker: either a worker is idle, or the last batch not sent yet has room.
+   * @return True, if a sample can be assigned a worker; false, otherwise.
+   */
+  bool isWorkerAvailable() const;
+
+  /**
+   * @brief Resumes the samples waiting for a worker, as long as there are available workers
+   */
+  void startPendingSamples();
+
+  /**
+   * @brief (Batch Size > 1) Sends the full batches to their workers
+   * @param sendPartial If true, the last batch is also sent, even if it is not full
+   */
+  void sendBatches(bool sendPartial);
+
+  /**
+   * @brief Resumes the running samples of a contiguous set that have received messages
+   * @param first Pointer to the first sample of the set
+   * @param last Pointer past the last sample of the set
+   */
+  void resumeReadySamples(Sample *first, Sample *last);
+
+  /**
+   * @brief Stores the information of a finished sample, if requested, and returns its coroutine stack to the pool
+   * @param sample A finished Korali sample
+   */
+  void finalizeSample(Sample &sample);
+
   /**
    * @brief Stacks a new Engine into the engine stack
    * @param engine A Korali Engine
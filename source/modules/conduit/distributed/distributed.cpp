@@ -5,6 +5,10 @@
 #include "modules/problem/problem.hpp"
 #include "modules/solver/solver.hpp"
 #include "sample/sample.hpp"
+#include <algorithm>
+#include <cstring>
+#include <list>
+#include <unistd.h>
 
 using namespace std;
 
@@ -14,6 +18,31 @@ namespace conduit
 {
 ;
 
+#ifdef _KORALI_USE_MPI
+
+/**
+ * @brief (Hierarchical Scheduling) A packed batch whose non-blocking send is in progress
+ */
+struct batchTransfer_t
+{
+  /**
+   * @brief MPI request of the send
+   */
+  MPI_Request request;
+
+  /**
+   * @brief Packed batch: header size, CBOR header, and the raw bytes of the binary buffers
+   */
+  std::vector<std::uint8_t> data;
+};
+
+/**
+ * @brief (Hierarchical Scheduling) Batches being sent by the current rank. Their storage must outlive the send.
+ */
+static std::list<batchTransfer_t> _batchTransfers;
+
+#endif
+
 void Distributed::initialize()
 {
 #ifndef _KORALI_USE_MPI
@@ -41,6 +70,12 @@ void Distributed::initialize()
     if (_ranksPerWorker < 1) KORALI_LOG_ERROR("The distributed conduit requires that the ranks per worker is equal or larger than 1, provided: %d\n", _ranksPerWorker);
     if (_engineRanks < 1) KORALI_LOG_ERROR("The distributed conduit requires that the engine ranks is equal or larger than 1, provided: %d\n", _engineRanks);
     if (workerRemainder != 0) KORALI_LOG_ERROR("Korali was instantiated with %lu MPI ranks (minus %lu for the engine), divided into %lu workers. This setup does not provide a perfectly divisible distribution, and %lu unused ranks remain.\n", _rankCount, _engineRanks, _workerCount, workerRemainder);
+    if (_scheduling == "Hierarchical")
+    {
+      if (_engineRanks < 2) KORALI_LOG_ERROR("Hierarchical scheduling requires at least 2 engine ranks (the root and one sub-engine), provided: %d\n", _engineRanks);
+      if (_workerCount < _engineRanks - 1) KORALI_LOG_ERROR("Hierarchical scheduling requires at least one worker per sub-engine, but there are %d workers for %d sub-engines.\n", _workerCount, _engineRanks - 1);
+      if (_prefetchDepth < 1) KORALI_LOG_ERROR("Hierarchical scheduling requires a prefetch depth equal or larger than 1, provided: %lu\n", _prefetchDepth);
+    }
   }
 
   // Synchronizing all ranks
@@ -58,11 +93,35 @@ void Distributed::initialize()
   // Storage to map workers to MPI ranks
   _rankToWorkerMap.resize(_rankCount);
 
+  // Initializing wait policy
+  _blockOnIdle = _waitPolicy == "Spin Then Block";
+  _idlePassCount = 0;
+
+  // Under hierarchical scheduling, every engine rank but the root serves a group of workers
+  _isHierarchical = _scheduling == "Hierarchical";
+  _subEngineCount = _isHierarchical ? _engineRanks - 1 : 0;
+  _slotCount = _isHierarchical ? _workerCount * _prefetchDepth : _workerCount;
+
   // Initializing available worker queue
   _workerQueue.clear();
 
-  // Putting workers in the queue
-  for (int i = 0; i < _workerCount; i++) _workerQueue.push_back(i);
+  // Putting worker slots in the queue. Slot i corresponds to worker i % workerCount, so that consecutive samples go to different workers.
+  for (size_t i = 0; i < _slotCount; i++) _workerQueue.push_back(i);
+
+  // Dividing workers into contiguous groups, one per sub-engine
+  _workerToGroupMap.resize(_workerCount);
+  for (int i = 0; i < _workerCount; i++) _workerToGroupMap[i] = _isHierarchical ? (int)(((size_t)i * _subEngineCount) / _workerCount) : 0;
+
+  // Initializing relay storage
+  _groupId = _rankId - (_rankCount - _engineRanks);
+  _broadcastCount = 0;
+  _groupOutbox.assign(_subEngineCount, knlohmann::json::array());
+  _groupOutboxBuffers.assign(_subEngineCount, std::vector<SampleBuffers *>());
+  _relayEpoch = 0;
+  _engineOutbox = knlohmann::json::array();
+  _stealPending = false;
+  _stealVictim = _groupId;
+  _failedStealCount = 0;
 
   // Korali engine as default, is the n+1th worker
   int curWorker = _workerCount + 1;
@@ -84,6 +143,10 @@ void Distributed::initialize()
       currentRank++;
     }
 
+  // Workers exchange messages with the root, or with the sub-engine of their group
+  _engineRankId = getRootRank();
+  if (_isHierarchical && _workerIdSet == true) _engineRankId = getSubEngineRank(_workerToGroupMap[curWorker]);
+
   // Creating communicator
   MPI_Comm_split(__KoraliGlobalMPIComm, curWorker, _rankId, &__koraliWorkerMPIComm);
 
@@ -99,8 +162,11 @@ void Distributed::initServer()
   // Workers run and synchronize at the end
   if (isRoot() == false && _workerIdSet == true) worker();
 
-  // Non root engine ranks passively wait and finish upon synchronization
-  if (isRoot() == false && _workerIdSet == false)
+  // Sub-engines relay samples to their group of workers until termination
+  if (isRoot() == false && _workerIdSet == false && _isHierarchical == true) subEngine();
+
+  // Otherwise, non root engine ranks passively wait and finish upon synchronization
+  if (isRoot() == false && _workerIdSet == false && _isHierarchical == false)
   {
     MPI_Request req;
     int flag;
@@ -126,7 +192,14 @@ void Distributed::terminateServer()
   // Serializing message in binary form
   const std::vector<std::uint8_t> msgData = knlohmann::json::to_cbor(terminationJs);
 
-  if (isRoot())
+  // Sub-engines relay the termination message to their workers
+  if (isRoot() && _isHierarchical)
+  {
+    broadcastMessageToWorkers(terminationJs);
+    progressBatches(true);
+  }
+
+  if (isRoot() && _isHierarchical == false)
   {
     // Sending message to workers for termination
     for (int i = 0; i < _workerCount; i++)
@@ -150,6 +223,23 @@ void Distributed::broadcastMessageToWorkers(knlohmann::json &message)
   // Run broadcast only if this is the master process
   if (!isRoot()) return;
 
+  // Broadcasts travel in order with the sample messages, and start a new epoch for the samples that follow
+  if (_isHierarchical)
+  {
+    knlohmann::json entry;
+    entry["Message"] = message;
+
+    for (int i = 0; i < _subEngineCount; i++)
+    {
+      _groupOutbox[i].push_back(entry);
+      _groupOutboxBuffers[i].push_back(NULL);
+    }
+
+    _broadcastCount++;
+    flushGroupOutboxes();
+    return;
+  }
+
   // Serializing message in binary form
   const std::vector<std::uint8_t> msgData = knlohmann::json::to_cbor(message);
 
@@ -190,7 +280,11 @@ void Distributed::sendMessageToEngine(knlohmann::json &message)
   {
     // Serializing message in binary form
     const std::vector<std::uint8_t> msgData = knlohmann::json::to_cbor(message);
-    MPI_Send(msgData.data(), msgData.size(), MPI_UINT8_T, getRootRank(), __KORALI_MPI_MESSAGE_JSON_TAG, __KoraliGlobalMPIComm);
+    MPI_Send(msgData.data(), msgData.size(), MPI_UINT8_T, _engineRankId, __KORALI_MPI_MESSAGE_JSON_TAG, __KoraliGlobalMPIComm);
+
+    // Sending binary buffers as raw bytes right after the message
+    if (message.contains("Binary Buffers"))
+      _workerBuffers.forEachBuffer([&](void *data, size_t size) { MPI_Send(data, size, MPI_UINT8_T, _engineRankId, __KORALI_MPI_MESSAGE_BINARY_TAG, __KoraliGlobalMPIComm); });
   }
 #endif
 }
@@ -203,54 +297,139 @@ knlohmann::json Distributed::recvMessageFromEngine()
   MPI_Barrier(__koraliWorkerMPIComm);
 
   MPI_Status status;
-  MPI_Probe(getRootRank(), __KORALI_MPI_MESSAGE_JSON_TAG, __KoraliGlobalMPIComm, &status);
+  MPI_Probe(_engineRankId, __KORALI_MPI_MESSAGE_JSON_TAG, __KoraliGlobalMPIComm, &status);
   int messageSize = 0;
   MPI_Get_count(&status, MPI_UINT8_T, &messageSize);
 
   // Allocating receive buffer
   auto msgData = std::vector<std::uint8_t>(messageSize);
-  MPI_Recv(msgData.data(), messageSize, MPI_UINT8_T, getRootRank(), __KORALI_MPI_MESSAGE_JSON_TAG, __KoraliGlobalMPIComm, MPI_STATUS_IGNORE);
+  MPI_Recv(msgData.data(), messageSize, MPI_UINT8_T, _engineRankId, __KORALI_MPI_MESSAGE_JSON_TAG, __KoraliGlobalMPIComm, MPI_STATUS_IGNORE);
   message = knlohmann::json::from_cbor(msgData);
+
+  // Receiving binary buffers directly into their final storage
+  if (message.contains("Binary Buffers"))
+  {
+    _workerBuffers.allocate(message["Binary Buffers"]);
+    _workerBuffers.forEachBuffer([&](void *data, size_t size) { MPI_Recv(data, size, MPI_UINT8_T, _engineRankId, __KORALI_MPI_MESSAGE_BINARY_TAG, __KoraliGlobalMPIComm, MPI_STATUS_IGNORE); });
+  }
 #endif
 
   return message;
 }
 
+void Distributed::waitWorkerMessages()
+{
+#ifdef _KORALI_USE_MPI
+
+  // Blocking until a message from any worker (or engine rank) is pending, it is then received by the regular polling pass
+  MPI_Probe(MPI_ANY_SOURCE, MPI_ANY_TAG, __KoraliGlobalMPIComm, MPI_STATUS_IGNORE);
+  _idlePassCount = 0;
+
+#endif
+}
+
 void Distributed::listenWorkers()
 {
 #ifdef _KORALI_USE_MPI
 
+  // Sending the sample messages produced since the last pass, in a single batch per sub-engine
+  if (_isHierarchical)
+  {
+    flushGroupOutboxes();
+    progressBatches(false);
+  }
+
+  // If no messages arrived for a while and there are busy workers, block until one does, freeing the engine's core
+  if (_blockOnIdle && _idlePassCount >= _spinCount && _workerQueue.size() < _slotCount) waitWorkerMessages();
+
   // Scanning all incoming messages
   int foundMessage = 0;
-
-  // Reading pending messages from any worker
   MPI_Status status;
-  MPI_Iprobe(MPI_ANY_SOURCE, __KORALI_MPI_MESSAGE_JSON_TAG, __KoraliGlobalMPIComm, &foundMessage, &status);
 
-  // If message found, receive it and storing in the corresponding sample's queue
-  if (foundMessage == 1)
+  // Under hierarchical scheduling, receiving all pending batches of worker messages from the sub-engines
+  if (_isHierarchical)
   {
-    // Obtaining source rank, worker ID, and destination sample from the message
-    int source = status.MPI_SOURCE;
-    int worker = _rankToWorkerMap[source];
-    auto sample = _workerToSampleMap[worker];
-
-    // Receiving message from the worker
-    int messageSize = 0;
-    MPI_Get_count(&status, MPI_UINT8_T, &messageSize);
-    auto msgData = std::vector<std::uint8_t>(messageSize);
-    MPI_Recv(msgData.data(), msgData.size(), MPI_UINT8_T, source, __KORALI_MPI_MESSAGE_JSON_TAG, __KoraliGlobalMPIComm, MPI_STATUS_IGNORE);
-    auto message = knlohmann::json::from_cbor(msgData);
-
-    // Storing message in the sample message queue
-    sample->_messageQueue.push(message);
+    bool foundBatch = false;
+
+    MPI_Iprobe(MPI_ANY_SOURCE, __KORALI_MPI_MESSAGE_BATCH_TAG, __KoraliGlobalMPIComm, &foundMessage, &status);
+    while (foundMessage == 1)
+    {
+      int batchSize = 0;
+      MPI_Get_count(&status, MPI_UINT8_T, &batchSize);
+      std::vector<SampleBuffers> buffers;
+      auto batch = recvBatch(status.MPI_SOURCE, batchSize, buffers);
+
+      // Storing each message in the queue of the sample that runs on its slot
+      auto &entries = batch["Entries"];
+      for (size_t i = 0; i < entries.size(); i++)
+      {
+        auto sample = _workerToSampleMap[entries[i]["Slot"].get<size_t>()];
+        if (entries[i]["Message"].contains("Binary Buffers")) sample->_buffers.swap(buffers[i]);
+        sample->_messageQueue.push(entries[i]["Message"]);
+      }
+
+      foundBatch = true;
+      MPI_Iprobe(MPI_ANY_SOURCE, __KORALI_MPI_MESSAGE_BATCH_TAG, __KoraliGlobalMPIComm, &foundMessage, &status);
+    }
+
+    foundMessage = foundBatch ? 1 : 0;
+  }
+
+  // Otherwise, reading a pending message from any worker
+  if (_isHierarchical == false)
+  {
+    MPI_Iprobe(MPI_ANY_SOURCE, __KORALI_MPI_MESSAGE_JSON_TAG, __KoraliGlobalMPIComm, &foundMessage, &status);
+
+    // If message found, receive it and storing in the corresponding sample's queue
+    if (foundMessage == 1)
+    {
+      // Obtaining source rank, worker ID, and destination sample from the message
+      int source = status.MPI_SOURCE;
+      int worker = _rankToWorkerMap[source];
+      auto sample = _workerToSampleMap[worker];
+
+      // Receiving message from the worker, with its binary buffers directly into the sample's storage
+      int messageSize = 0;
+      MPI_Get_count(&status, MPI_UINT8_T, &messageSize);
+      auto message = recvMessageFromWorker(source, messageSize, sample->_buffers);
+
+      // Storing message in the sample message queue
+      sample->_messageQueue.push(message);
+    }
   }
 
+  if (foundMessage == 1)
+    _idlePassCount = 0;
+  else
+    _idlePassCount++;
+
 #endif
 }
 
 void Distributed::sendMessageToSample(Sample &sample, knlohmann::json &message)
 {
+#ifdef _KORALI_USE_MPI
+
+  // Under hierarchical scheduling, queueing the message for the sub-engine of the sample's worker, to be sent with the next batch
+  if (_isHierarchical)
+  {
+    knlohmann::json entry;
+    entry["Slot"] = sample._workerId;
+    entry["Epoch"] = _broadcastCount;
+    entry["Message"] = message;
+
+    int groupId = _workerToGroupMap[sample._workerId % _workerCount];
+    _groupOutbox[groupId].push_back(entry);
+    _groupOutboxBuffers[groupId].push_back(message.contains("Binary Buffers") ? &sample._buffers : NULL);
+    return;
+  }
+
+  sendMessageToWorker(sample._workerId, message, sample._buffers);
+#endif
+}
+
+void Distributed::sendMessageToWorker(int workerId, const knlohmann::json &message, SampleBuffers &buffers)
+{
 #ifdef _KORALI_USE_MPI
 
   // Serializing message in binary form
@@ -258,12 +437,366 @@ void Distributed::sendMessageToSample(Sample &sample, knlohmann::json &message)
 
   for (int i = 0; i < _ranksPerWorker; i++)
   {
-    int rankId = _workerTeams[sample._workerId][i];
+    int rankId = _workerTeams[workerId][i];
     MPI_Send(msgData.data(), msgData.size(), MPI_UINT8_T, rankId, __KORALI_MPI_MESSAGE_JSON_TAG, __KoraliGlobalMPIComm);
+
+    // Sending binary buffers as raw bytes right after the message
+    if (message.contains("Binary Buffers"))
+      buffers.forEachBuffer([&](void *data, size_t size) { MPI_Send(data, size, MPI_UINT8_T, rankId, __KORALI_MPI_MESSAGE_BINARY_TAG, __KoraliGlobalMPIComm); });
+  }
+#endif
+}
+
+knlohmann::json Distributed::recvMessageFromWorker(int sourceRank, int messageSize, SampleBuffers &buffers)
+{
+  auto message = knlohmann::json();
+
+#ifdef _KORALI_USE_MPI
+  auto msgData = std::vector<std::uint8_t>(messageSize);
+  MPI_Recv(msgData.data(), msgData.size(), MPI_UINT8_T, sourceRank, __KORALI_MPI_MESSAGE_JSON_TAG, __KoraliGlobalMPIComm, MPI_STATUS_IGNORE);
+  message = knlohmann::json::from_cbor(msgData);
+
+  // Receiving binary buffers directly into their final storage
+  if (message.contains("Binary Buffers"))
+  {
+    buffers.allocate(message["Binary Buffers"]);
+    buffers.forEachBuffer([&](void *data, size_t size) { MPI_Recv(data, size, MPI_UINT8_T, sourceRank, __KORALI_MPI_MESSAGE_BINARY_TAG, __KoraliGlobalMPIComm, MPI_STATUS_IGNORE); });
+  }
+#endif
+
+  return message;
+}
+
+void Distributed::sendBatch(int rankId, const knlohmann::json &batch, const std::vector<SampleBuffers *> &buffers)
+{
+#ifdef _KORALI_USE_MPI
+
+  // Batches are packed into a single message, so that they can be sent without blocking and without ordering constraints among them
+  const std::vector<std::uint8_t> header = knlohmann::json::to_cbor(batch);
+  const uint64_t headerSize = header.size();
+
+  size_t batchSize = sizeof(uint64_t) + headerSize;
+  for (auto b : buffers)
+    if (b != NULL) b->forEachBuffer([&](void *, size_t size) { batchSize += size; });
+
+  _batchTransfers.emplace_back();
+  auto &transfer = _batchTransfers.back();
+  transfer.data.resize(batchSize);
+
+  size_t offset = 0;
+  memcpy(transfer.data.data() + offset, &headerSize, sizeof(uint64_t));
+  offset += sizeof(uint64_t);
+  memcpy(transfer.data.data() + offset, header.data(), headerSize);
+  offset += headerSize;
+
+  // Appending the raw bytes of the binary buffers, in order of the entries
+  for (auto b : buffers)
+    if (b != NULL) b->forEachBuffer([&](void *data, size_t size) { memcpy(transfer.data.data() + offset, data, size); offset += size; });
+
+  MPI_Isend(transfer.data.data(), transfer.data.size(), MPI_UINT8_T, rankId, __KORALI_MPI_MESSAGE_BATCH_TAG, __KoraliGlobalMPIComm, &transfer.request);
+#endif
+}
+
+knlohmann::json Distributed::recvBatch(int sourceRank, int batchSize, std::vector<SampleBuffers> &buffers)
+{
+  auto batch = knlohmann::json();
+
+#ifdef _KORALI_USE_MPI
+  auto batchData = std::vector<std::uint8_t>(batchSize);
+  MPI_Recv(batchData.data(), batchData.size(), MPI_UINT8_T, sourceRank, __KORALI_MPI_MESSAGE_BATCH_TAG, __KoraliGlobalMPIComm, MPI_STATUS_IGNORE);
+
+  uint64_t headerSize = 0;
+  size_t offset = 0;
+  memcpy(&headerSize, batchData.data() + offset, sizeof(uint64_t));
+  offset += sizeof(uint64_t);
+  batch = knlohmann::json::from_cbor(batchData.data() + offset, batchData.data() + offset + headerSize);
+  offset += headerSize;
+
+  // Unpacking the binary buffers of the entries that describe any
+  auto &entries = batch["Entries"];
+  buffers.resize(entries.size());
+  for (size_t i = 0; i < entries.size(); i++)
+    if (entries[i]["Message"].contains("Binary Buffers"))
+    {
+      buffers[i].allocate(entries[i]["Message"]["Binary Buffers"]);
+      buffers[i].forEachBuffer([&](void *data, size_t size) { memcpy(data, batchData.data() + offset, size); offset += size; });
+    }
+#endif
+
+  return batch;
+}
+
+void Distributed::progressBatches(bool waitAll)
+{
+#ifdef _KORALI_USE_MPI
+  for (auto transfer = _batchTransfers.begin(); transfer != _batchTransfers.end();)
+  {
+    int isSent = 0;
+    if (waitAll)
+    {
+      MPI_Wait(&transfer->request, MPI_STATUS_IGNORE);
+      isSent = 1;
+    }
+    else
+      MPI_Test(&transfer->request, &isSent, MPI_STATUS_IGNORE);
+
+    if (isSent == 1)
+      transfer = _batchTransfers.erase(transfer);
+    else
+      transfer++;
   }
 #endif
 }
 
+void Distributed::flushGroupOutboxes()
+{
+  for (int i = 0; i < _subEngineCount; i++)
+  {
+    if (_groupOutbox[i].empty()) continue;
+
+    knlohmann::json batch;
+    batch["Relay Action"] = "Relay";
+    batch["Entries"] = std::move(_groupOutbox[i]);
+    sendBatch(getSubEngineRank(i), batch, _groupOutboxBuffers[i]);
+
+    _groupOutbox[i] = knlohmann::json::array();
+    _groupOutboxBuffers[i].clear();
+  }
+}
+
+int Distributed::getSubEngineRank(int groupId) const
+{
+  return _rankCount - _engineRanks + groupId;
+}
+
+void Distributed::subEngine()
+{
+#ifdef _KORALI_USE_MPI
+
+  // All workers of the group start idle
+  for (int i = 0; i < _workerCount; i++)
+    if (_workerToGroupMap[i] == _groupId) _idleWorkerQueue.push_back(i);
+
+  bool isTerminated = false;
+  while (isTerminated == false)
+  {
+    int foundMessage = 0;
+    bool foundAny = false;
+    MPI_Status status;
+
+    // Receiving messages from the workers of the group, to be returned to the engine
+    MPI_Iprobe(MPI_ANY_SOURCE, __KORALI_MPI_MESSAGE_JSON_TAG, __KoraliGlobalMPIComm, &foundMessage, &status);
+    while (foundMessage == 1)
+    {
+      int source = status.MPI_SOURCE;
+      int worker = _rankToWorkerMap[source];
+
+      int messageSize = 0;
+      MPI_Get_count(&status, MPI_UINT8_T, &messageSize);
+      _engineOutboxBuffers.emplace_back();
+      auto message = recvMessageFromWorker(source, messageSize, _engineOutboxBuffers.back());
+
+      knlohmann::json entry;
+      entry["Slot"] = _workerToSlotMap[worker];
+      bool hasFinished = message.contains("Has Finished") && message["Has Finished"] == true;
+      entry["Message"] = std::move(message);
+      _engineOutbox.push_back(std::move(entry));
+
+      // The sample's final message frees its worker
+      if (hasFinished)
+      {
+        _slotToWorkerMap.erase(_workerToSlotMap[worker]);
+        _workerToSlotMap.erase(worker);
+        _idleWorkerQueue.push_back(worker);
+      }
+
+      foundAny = true;
+      MPI_Iprobe(MPI_ANY_SOURCE, __KORALI_MPI_MESSAGE_JSON_TAG, __KoraliGlobalMPIComm, &foundMessage, &status);
+    }
+
+    // Receiving batches from the engine and from other sub-engines
+    MPI_Iprobe(MPI_ANY_SOURCE, __KORALI_MPI_MESSAGE_BATCH_TAG, __KoraliGlobalMPIComm, &foundMessage, &status);
+    while (foundMessage == 1 && isTerminated == false)
+    {
+      int source = status.MPI_SOURCE;
+      int batchSize = 0;
+      MPI_Get_count(&status, MPI_UINT8_T, &batchSize);
+      std::vector<SampleBuffers> buffers;
+      auto batch = recvBatch(source, batchSize, buffers);
+
+      if (batch["Relay Action"] == "Relay") isTerminated = relayEntries(batch["Entries"], buffers);
+      if (batch["Relay Action"] == "Steal Request") answerSteal(source);
+      if (batch["Relay Action"] == "Steal Reply")
+      {
+        auto &entries = batch["Entries"];
+        for (size_t i = 0; i < entries.size(); i++)
+        {
+          _relayQueue.emplace_back();
+          _relayQueue.back().entry = std::move(entries[i]);
+          _relayQueue.back().buffers.swap(buffers[i]);
+        }
+
+        _stealPending = false;
+        _failedStealCount = entries.empty() ? _failedStealCount + 1 : 0;
+      }
+
+      foundAny = true;
+      MPI_Iprobe(MPI_ANY_SOURCE, __KORALI_MPI_MESSAGE_BATCH_TAG, __KoraliGlobalMPIComm, &foundMessage, &status);
+    }
+
+    if (isTerminated) break;
+
+    dispatchRelayedSamples();
+    requestSteal();
+
+    // Returning the worker messages to the engine in a single batch
+    if (_engineOutbox.empty() == false)
+    {
+      std::vector<SampleBuffers *> buffers;
+      for (size_t i = 0; i < _engineOutbox.size(); i++)
+        buffers.push_back(_engineOutbox[i]["Message"].contains("Binary Buffers") ? &_engineOutboxBuffers[i] : NULL);
+
+      knlohmann::json batch;
+      batch["Relay Action"] = "Relay";
+      batch["Entries"] = std::move(_engineOutbox);
+      sendBatch(getRootRank(), batch, buffers);
+
+      _engineOutbox = knlohmann::json::array();
+      _engineOutboxBuffers.clear();
+    }
+
+    progressBatches(false);
+
+    // If nothing arrived for a while, block until a message does, freeing the sub-engine's core
+    if (foundAny)
+      _idlePassCount = 0;
+    else
+      _idlePassCount++;
+
+    if (_blockOnIdle && _idlePassCount >= _spinCount) waitWorkerMessages();
+  }
+
+  progressBatches(true);
+#endif
+}
+
+bool Distributed::relayEntries(knlohmann::json &entries, std::vector<SampleBuffers> &buffers)
+{
+  bool isTerminated = false;
+
+  for (size_t i = 0; i < entries.size(); i++)
+  {
+    auto &entry = entries[i];
+    auto &message = entry["Message"];
+
+    // Broadcasts (entries without slot) go to all the workers of the group, and start a new epoch
+    if (entry.contains("Slot") == false)
+    {
+      for (int j = 0; j < _workerCount; j++)
+        if (_workerToGroupMap[j] == _groupId) sendMessageToWorker(j, message, buffers[i]);
+
+      _relayEpoch++;
+      if (message["Conduit Action"] == "Terminate") isTerminated = true;
+      continue;
+    }
+
+    size_t slot = entry["Slot"].get<size_t>();
+
+    // New samples (or batches of samples) wait in the queue for an idle worker
+    if (message.contains("Conduit Action") && (message["Conduit Action"] == "Process Sample" || message["Conduit Action"] == "Process Batch"))
+    {
+      _slotToPeerMap.erase(slot);
+      _failedStealCount = 0;
+
+      _relayQueue.emplace_back();
+      _relayQueue.back().entry = std::move(entry);
+      _relayQueue.back().buffers.swap(buffers[i]);
+      continue;
+    }
+
+    // Messages for running samples go to the worker running them, or to the sub-engine that stole them
+    if (_slotToWorkerMap.count(slot) > 0)
+      sendMessageToWorker(_slotToWorkerMap[slot], message, buffers[i]);
+    else if (_slotToPeerMap.count(slot) > 0)
+    {
+      knlohmann::json batch;
+      batch["Relay Action"] = "Relay";
+      batch["Entries"].push_back(entry);
+      sendBatch(_slotToPeerMap[slot], batch, {message.contains("Binary Buffers") ? &buffers[i] : NULL});
+    }
+    else
+      KORALI_LOG_ERROR("Sub-engine %d received a message for slot %lu, which is not running any sample.\n", _groupId, slot);
+  }
+
+  return isTerminated;
+}
+
+void Distributed::dispatchRelayedSamples()
+{
+  while (_idleWorkerQueue.empty() == false && _relayQueue.empty() == false)
+  {
+    auto &sample = _relayQueue.front();
+
+    // Stolen samples may belong to an engine whose broadcast has not reached this sub-engine yet
+    if (sample.entry["Epoch"].get<size_t>() > _relayEpoch) break;
+
+    int worker = _idleWorkerQueue.front();
+    _idleWorkerQueue.pop_front();
+
+    size_t slot = sample.entry["Slot"].get<size_t>();
+    _slotToWorkerMap[slot] = worker;
+    _workerToSlotMap[worker] = slot;
+
+    sendMessageToWorker(worker, sample.entry["Message"], sample.buffers);
+    _relayQueue.pop_front();
+  }
+}
+
+void Distributed::requestSteal()
+{
+  // Stealing only when all local samples are running and there are idle workers
+  if (_subEngineCount < 2 || _stealPending || _relayQueue.empty() == false || _idleWorkerQueue.empty()) return;
+
+  // After a full round of unsuccessful requests, stealing resumes once new samples arrive from the engine
+  if (_failedStealCount >= _subEngineCount - 1) return;
+
+  // Choosing victims in round-robin order
+  _stealVictim = (_stealVictim + 1) % _subEngineCount;
+  if (_stealVictim == _groupId) _stealVictim = (_stealVictim + 1) % _subEngineCount;
+
+  knlohmann::json batch;
+  batch["Relay Action"] = "Steal Request";
+  batch["Entries"] = knlohmann::json::array();
+  sendBatch(getSubEngineRank(_stealVictim), batch, {});
+
+  _stealPending = true;
+}
+
+void Distributed::answerSteal(int thiefRank)
+{
+  // Giving away the most recently queued half, so that the oldest samples keep their turn
+  size_t stealCount = (_relayQueue.size() + 1) / 2;
+  size_t firstStolen = _relayQueue.size() - stealCount;
+
+  knlohmann::json batch;
+  batch["Relay Action"] = "Steal Reply";
+  batch["Entries"] = knlohmann::json::array();
+  std::vector<SampleBuffers *> buffers;
+
+  for (size_t i = firstStolen; i < _relayQueue.size(); i++)
+  {
+    auto &sample = _relayQueue[i];
+    batch["Entries"].push_back(sample.entry);
+    buffers.push_back(sample.entry["Message"].contains("Binary Buffers") ? &sample.buffers : NULL);
+
+    // Remembering the thief, to forward later messages for the sample
+    _slotToPeerMap[sample.entry["Slot"].get<size_t>()] = thiefRank;
+  }
+
+  sendBatch(thiefRank, batch, buffers);
+  _relayQueue.erase(_relayQueue.begin() + firstStolen, _relayQueue.end());
+}
+
 void Distributed::stackEngine(Engine *engine)
 {
 #ifdef _KORALI_USE_MPI
@@ -322,6 +855,54 @@ void Distributed::setConfiguration(knlohmann::json& js)
  }
   else   KORALI_LOG_ERROR(" + No value provided for mandatory setting: ['Engine Ranks'] required by distributed.\n"); 
 
+ if (isDefined(js, "Scheduling"))
+ {
+ try { _scheduling = js["Scheduling"].get<std::string>();
+} catch (const std::exception& e)
+ { KORALI_LOG_ERROR(" + Object: [ distributed ] \n + Key:    ['Scheduling']\n%s", e.what()); } 
+{
+ bool validOption = false; 
+ if (_scheduling == "Flat") validOption = true; 
+ if (_scheduling == "Hierarchical") validOption = true; 
+ if (validOption == false) KORALI_LOG_ERROR(" + Unrecognized value (%s) provided for mandatory setting: ['Scheduling'] required by distributed.\n", _scheduling.c_str()); 
+}
+   eraseValue(js, "Scheduling");
+ }
+  else   KORALI_LOG_ERROR(" + No value provided for mandatory setting: ['Scheduling'] required by distributed.\n"); 
+
+ if (isDefined(js, "Prefetch Depth"))
+ {
+ try { _prefetchDepth = js["Prefetch Depth"].get<size_t>();
+} catch (const std::exception& e)
+ { KORALI_LOG_ERROR(" + Object: [ distributed ] \n + Key:    ['Prefetch Depth']\n%s", e.what()); } 
+   eraseValue(js, "Prefetch Depth");
+ }
+  else   KORALI_LOG_ERROR(" + No value provided for mandatory setting: ['Prefetch Depth'] required by distributed.\n"); 
+
+ if (isDefined(js, "Wait Policy"))
+ {
+ try { _waitPolicy = js["Wait Policy"].get<std::string>();
+} catch (const std::exception& e)
+ { KORALI_LOG_ERROR(" + Object: [ distributed ] \n + Key:    ['Wait Policy']\n%s", e.what()); } 
+{
+ bool validOption = false; 
+ if (_waitPolicy == "Busy Polling") validOption = true; 
+ if (_waitPolicy == "Spin Then Block") validOption = true; 
+ if (validOption == false) KORALI_LOG_ERROR(" + Unrecognized value (%s) provided for mandatory setting: ['Wait Policy'] required by distributed.\n", _waitPolicy.c_str()); 
+}
+   eraseValue(js, "Wait Policy");
+ }
+  else   KORALI_LOG_ERROR(" + No value provided for mandatory setting: ['Wait Policy'] required by distributed.\n"); 
+
+ if (isDefined(js, "Spin Count"))
+ {
+ try { _spinCount = js["Spin Count"].get<size_t>();
+} catch (const std::exception& e)
+ { KORALI_LOG_ERROR(" + Object: [ distributed ] \n + Key:    ['Spin Count']\n%s", e.what()); } 
+   eraseValue(js, "Spin Count");
+ }
+  else   KORALI_LOG_ERROR(" + No value provided for mandatory setting: ['Spin Count'] required by distributed.\n"); 
+
  Conduit::setConfiguration(js);
  _type = "distributed";
  if(isDefined(js, "Type")) eraseValue(js, "Type");
@@ -334,13 +915,17 @@ void Distributed::getConfiguration(knlohmann::json& js)
  js["Type"] = _type;
    js["Ranks Per Worker"] = _ranksPerWorker;
    js["Engine Ranks"] = _engineRanks;
+   js["Scheduling"] = _scheduling;
+   js["Prefetch Depth"] = _prefetchDepth;
+   js["Wait Policy"] = _waitPolicy;
+   js["Spin Count"] = _spinCount;
  Conduit::getConfiguration(js);
 } 
 
 void Distributed::applyModuleDefaults(knlohmann::json& js) 
 {
 
- std::string defaultString = "{\"Ranks Per Worker\": 1, \"Engine Ranks\": 1}";
+ std::string defaultString = "{\"Ranks Per Worker\": 1, \"Engine Ranks\": 1, \"Scheduling\": \"Flat\", \"Prefetch Depth\": 2, \"Wait Policy\": \"Busy Polling\", \"Spin Count\": 1000}";
  knlohmann::json defaultJs = knlohmann::json::parse(defaultString);
  mergeJson(js, defaultJs); 
  Conduit::applyModuleDefaults(js);
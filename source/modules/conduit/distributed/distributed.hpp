@@ -15,6 +15,7 @@
 #include "auxiliar/MPIUtils.hpp"
 #include "config.hpp"
 #include "modules/conduit/conduit.hpp"
+#include <deque>
 #include <map>
 #include <queue>
 #include <vector>
@@ -25,6 +26,22 @@ namespace conduit
 {
 ;
 
+/**
+* @brief (Hierarchical Scheduling) A sample message queued at a sub-engine, together with its binary buffers
+*/
+struct relayedSample_t
+{
+  /**
+   * @brief Relay entry, containing the sample's slot, the broadcast epoch it was sent in, and the message itself
+   */
+  knlohmann::json entry;
+
+  /**
+   * @brief Binary buffers that travel along with the message
+   */
+  SampleBuffers buffers;
+};
+
 /**
 * @brief Class declaration for module: Distributed.
 */
@@ -36,9 +53,25 @@ class Distributed : public Conduit
   */
    int _ranksPerWorker;
   /**
-  * @brief Specifies the number of MPI ranks for the Korali engine.
+  * @brief Specifies the number of MPI ranks for the Korali engine. Under hierarchical scheduling, all but the root engine rank act as sub-engines.
   */
    int _engineRanks;
+  /**
+  * @brief Specifies how samples are scheduled among workers.
+  */
+   std::string _scheduling;
+  /**
+  * @brief (Hierarchical scheduling only) Number of samples the engine can assign to each worker at once. Samples beyond the first wait in the sub-engine queues, from where other sub-engines can steal them.
+  */
+   size_t _prefetchDepth;
+  /**
+  * @brief Specifies how the engine waits for incoming worker messages while samples are running.
+  */
+   std::string _waitPolicy;
+  /**
+  * @brief (Spin Then Block policy only) Number of consecutive polling passes without incoming messages before the engine blocks.
+  */
+   size_t _spinCount;
   
  
   /**
@@ -97,6 +130,202 @@ class Distributed : public Conduit
    */
   std::vector<int> _rankToWorkerMap;
 
+  /**
+   * @brief Indicates whether the engine backs off after a number of idle polling passes
+   */
+  bool _blockOnIdle;
+
+  /**
+   * @brief Number of consecutive polling passes without incoming messages
+   */
+  size_t _idlePassCount;
+
+  /**
+   * @brief Indicates whether non-root engine ranks act as sub-engines, each scheduling samples for a group of workers
+   */
+  bool _isHierarchical;
+
+  /**
+   * @brief (Worker Side) Rank the worker receives samples from and returns results to: the root, or the sub-engine of its group
+   */
+  int _engineRankId;
+
+  /**
+   * @brief Number of worker slots the engine assigns samples to. Under hierarchical scheduling, each worker has as many slots as the prefetch depth.
+   */
+  size_t _slotCount;
+
+  /**
+   * @brief (Hierarchical Scheduling) Number of sub-engine ranks
+   */
+  int _subEngineCount;
+
+  /**
+   * @brief (Hierarchical Scheduling) Map that indicates to which sub-engine group each worker belongs
+   */
+  std::vector<int> _workerToGroupMap;
+
+  /**
+   * @brief (Hierarchical Scheduling, Engine Side) Number of broadcasts relayed to the sub-engines so far
+   */
+  size_t _broadcastCount;
+
+  /**
+   * @brief (Hierarchical Scheduling, Engine Side) Relay entries per sub-engine waiting to be sent as a single batch
+   */
+  std::vector<knlohmann::json> _groupOutbox;
+
+  /**
+   * @brief (Hierarchical Scheduling, Engine Side) Binary buffers of the relay entries waiting to be sent, per sub-engine
+   */
+  std::vector<std::vector<SampleBuffers *>> _groupOutboxBuffers;
+
+  /**
+   * @brief (Sub-Engine Side) Index of the sub-engine group served by this rank
+   */
+  int _groupId;
+
+  /**
+   * @brief (Sub-Engine Side) Broadcasts relayed to the workers of this group so far
+   */
+  size_t _relayEpoch;
+
+  /**
+   * @brief (Sub-Engine Side) Workers of this group that wait for a sample
+   */
+  std::deque<int> _idleWorkerQueue;
+
+  /**
+   * @brief (Sub-Engine Side) Samples received from the engine (or stolen from other sub-engines) waiting for an idle worker
+   */
+  std::deque<relayedSample_t> _relayQueue;
+
+  /**
+   * @brief (Sub-Engine Side) Map that links engine slots to the local worker running their sample
+   */
+  std::map<size_t, int> _slotToWorkerMap;
+
+  /**
+   * @brief (Sub-Engine Side) Map that links local workers to the engine slot of the sample they run
+   */
+  std::map<int, size_t> _workerToSlotMap;
+
+  /**
+   * @brief (Sub-Engine Side) Map that links engine slots whose sample was stolen to the rank of the thief sub-engine
+   */
+  std::map<size_t, int> _slotToPeerMap;
+
+  /**
+   * @brief (Sub-Engine Side) Worker messages waiting to be returned to the engine as a single batch
+   */
+  knlohmann::json _engineOutbox;
+
+  /**
+   * @brief (Sub-Engine Side) Binary buffers of the worker messages waiting to be returned to the engine
+   */
+  std::deque<SampleBuffers> _engineOutboxBuffers;
+
+  /**
+   * @brief (Sub-Engine Side) Indicates whether a steal request is waiting for its reply
+   */
+  bool _stealPending;
+
+  /**
+   * @brief (Sub-Engine Side) Group index of the next sub-engine to steal samples from
+   */
+  int _stealVictim;
+
+  /**
+   * @brief (Sub-Engine Side) Number of consecutive steal requests that returned no samples
+   */
+  int _failedStealCount;
+
+  /**
+   * @brief (Engine or Sub-Engine Side) Blocks until a message from any rank is pending
+   */
+  void waitWorkerMessages();
+
+  /**
+   * @brief (Engine or Sub-Engine Side) Sends a message, and its binary buffers, to all the ranks of a worker
+   * @param workerId The worker to send the message to
+   * @param message The message to send
+   * @param buffers The binary buffers described by the message, if any
+   */
+  void sendMessageToWorker(int workerId, const knlohmann::json &message, SampleBuffers &buffers);
+
+  /**
+   * @brief (Engine or Sub-Engine Side) Receives a probed message, and its binary buffers, from a worker lead rank
+   * @param sourceRank The rank the message comes from
+   * @param messageSize Size of the probed message, in bytes
+   * @param buffers Storage for the binary buffers described by the message, if any
+   * @return The received message
+   */
+  knlohmann::json recvMessageFromWorker(int sourceRank, int messageSize, SampleBuffers &buffers);
+
+  /**
+   * @brief (Hierarchical Scheduling) Sends a batch of relay entries, packed with their binary buffers into a single non-blocking message
+   * @param rankId The destination rank
+   * @param batch JSON object with the relay action and its entries
+   * @param buffers The binary buffers of each entry (NULL, if none)
+   */
+  void sendBatch(int rankId, const knlohmann::json &batch, const std::vector<SampleBuffers *> &buffers);
+
+  /**
+   * @brief (Hierarchical Scheduling) Receives a probed batch of relay entries and unpacks their binary buffers
+   * @param sourceRank The rank the batch comes from
+   * @param batchSize Size of the probed batch, in bytes
+   * @param buffers Storage for the binary buffers of each entry
+   * @return JSON object with the relay action and its entries
+   */
+  knlohmann::json recvBatch(int sourceRank, int batchSize, std::vector<SampleBuffers> &buffers);
+
+  /**
+   * @brief (Hierarchical Scheduling) Releases the storage of the batches that have been sent
+   * @param waitAll If true, waits for all batches to be sent
+   */
+  void progressBatches(bool waitAll);
+
+  /**
+   * @brief (Hierarchical Scheduling, Engine Side) Sends the pending relay entries to each sub-engine
+   */
+  void flushGroupOutboxes();
+
+  /**
+   * @brief (Hierarchical Scheduling) Returns the rank of a sub-engine
+   * @param groupId Index of the sub-engine group
+   * @return The rank id of the sub-engine
+   */
+  int getSubEngineRank(int groupId) const;
+
+  /**
+   * @brief (Sub-Engine Side) Lifetime function for sub-engines. Relays samples to the workers of its group until termination.
+   */
+  void subEngine();
+
+  /**
+   * @brief (Sub-Engine Side) Processes relay entries coming from the engine or forwarded by other sub-engines
+   * @param entries The relay entries
+   * @param buffers The binary buffers of each entry
+   * @return True, if the engine requested termination; false, otherwise.
+   */
+  bool relayEntries(knlohmann::json &entries, std::vector<SampleBuffers> &buffers);
+
+  /**
+   * @brief (Sub-Engine Side) Sends queued samples to the idle workers of the group
+   */
+  void dispatchRelayedSamples();
+
+  /**
+   * @brief (Sub-Engine Side) Asks another sub-engine for part of its queued samples, if all local samples are running and workers are idle
+   */
+  void requestSteal();
+
+  /**
+   * @brief (Sub-Engine Side) Gives half of the queued samples to the sub-engine that requested them
+   * @param thiefRank The rank of the requesting sub-engine
+   */
+  void answerSteal(int thiefRank);
+
   void initServer() override;
   void initialize() override;
   void terminateServer() override;
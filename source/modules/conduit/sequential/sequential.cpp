@@ -54,6 +54,9 @@ void Sequential::sendMessageToEngine(knlohmann::json &message)
   // Identifying sender sample
   auto sample = _workerToSampleMap[0];
 
+  // Handing binary buffers back to the sample by swapping pointers (no copy)
+  if (message.contains("Binary Buffers")) sample->_buffers.swap(_workerBuffers);
+
   // Queueing outgoing message directly
   sample->_messageQueue.push(message);
 }
@@ -62,14 +65,13 @@ knlohmann::json Sequential::recvMessageFromEngine()
 {
   Engine *engine = _engineStack.top();
 
-  // Identifying sample
-  auto sample = _workerToSampleMap[0];
-
   // While there's no message, keep executing sample until there is
   while (_workerMessageQueue.empty())
   {
-    if (sample->_state == SampleState::running)
-      sample->_state = SampleState::waiting;
+    // Identifying sample, if the worker is still assigned to one
+    auto entry = _workerToSampleMap.find(0);
+    if (entry != _workerToSampleMap.end() && entry->second->_state == SampleState::running)
+      entry->second->_state = SampleState::waiting;
 
     co_switch(engine->_currentExperiment->_thread);
   }
@@ -83,6 +85,9 @@ knlohmann::json Sequential::recvMessageFromEngine()
 
 void Sequential::sendMessageToSample(Sample &sample, knlohmann::json &message)
 {
+  // Handing binary buffers over to the worker by swapping pointers (no copy)
+  if (message.contains("Binary Buffers")) _workerBuffers.swap(sample._buffers);
+
   // Queueing message directly
   _workerMessageQueue.push(message);
 
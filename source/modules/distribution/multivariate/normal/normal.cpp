@@ -40,6 +40,11 @@ void Normal::getRandomVector(double *x, const size_t n)
   gsl_ran_multivariate_gaussian(_range, &_mean_view.vector, &_sigma_view.matrix, &_output_view.vector);
 }
 
+void Normal::getStandardNormalVector(double *x, const size_t n)
+{
+  for (size_t i = 0; i < n; i++) x[i] = gsl_ran_ugaussian(_range);
+}
+
 void Normal::updateDistribution()
 {
   size_t covarianceMatrixSize = _sigma.size();
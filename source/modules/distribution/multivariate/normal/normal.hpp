@@ -115,6 +115,13 @@ class Normal : public Multivariate
    * @param n Vector size
    */
   void getRandomVector(double *x, const size_t n) override;
+
+  /**
+   * @brief Draws a batch of independent standard normal numbers from the distribution's generator, to be transformed by the caller (e.g., several vectors with a single matrix product).
+   * @param x Array to store the random numbers.
+   * @param n Number of random numbers to draw.
+   */
+  void getStandardNormalVector(double *x, const size_t n);
 };
 
 } //multivariate
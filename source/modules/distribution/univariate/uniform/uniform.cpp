@@ -38,6 +38,11 @@ double Uniform::getRandomNumber()
   return gsl_ran_flat(_range, _minimum, _maximum);
 }
 
+void Uniform::getRandomVector(double *x, const size_t n)
+{
+  for (size_t i = 0; i < n; i++) x[i] = gsl_ran_flat(_range, _minimum, _maximum);
+}
+
 void Uniform::updateDistribution()
 {
   if (_maximum - _minimum <= 0.0)
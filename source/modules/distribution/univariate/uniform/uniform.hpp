@@ -112,6 +112,13 @@ class Uniform : public Univariate
    * @return Random real number.
    */
   double getRandomNumber() override;
+
+  /**
+   * @brief Draws a batch of random numbers from the distribution, without a virtual call per number.
+   * @param x Array to store the random numbers.
+   * @param n Number of random numbers to draw.
+   */
+  void getRandomVector(double *x, const size_t n);
 };
 
 } //univariate
@@ -1,5 +1,6 @@
 #include "auxiliar/fs.hpp"
 #include "auxiliar/koraliJson.hpp"
+#include "auxiliar/resultWriter.hpp"
 #include "engine.hpp"
 #include "modules/conduit/conduit.hpp"
 #include "modules/conduit/distributed/distributed.hpp"
@@ -111,7 +112,16 @@ void Experiment::run()
   // Saving last generation and final results
   _timestamp = getTimestamp();
   getConfiguration(_js.getJson());
-  if (_fileOutputEnabled) saveState();
+  if (_fileOutputEnabled)
+  {
+    saveState();
+
+    // Waiting for the background writer, so that all result files are on disk once the experiment finishes
+    auto beginTime = std::chrono::steady_clock::now();
+    _resultWriter->flush();
+    auto endTime = std::chrono::steady_clock::now();
+    _resultSavingTime += std::chrono::duration_cast<std::chrono::nanoseconds>(endTime - beginTime).count();
+  }
 
   _logger->logInfo("Minimal", "--------------------------------------------------------------------\n");
   _logger->logInfo("Minimal", "%s finished correctly.\n", _solver->getType().c_str());
@@ -127,24 +137,29 @@ void Experiment::saveState()
   if (_storeSampleInformation == true) _js["Samples"] = _sampleInfo["Samples"];
 
   char genFileName[256];
+  const bool isBinary = _fileOutputFormat == "Binary";
+  const char *extension = isBinary ? "cbor" : "json";
 
   // Naming result files depends on whether incremental numbering is used, or we overwrite previous results
   if (_fileOutputUseMultipleFiles == true)
-    sprintf(genFileName, "gen%08lu.json", _currentGeneration);
+    sprintf(genFileName, "gen%08lu.%s", _currentGeneration, extension);
   else
-    sprintf(genFileName, "genLatest.json");
+    sprintf(genFileName, "genLatest.%s", extension);
 
   // If results directory doesn't exist, create it
   if (!dirExists(_fileOutputPath)) mkdir(_fileOutputPath);
 
   std::string filePath = "./" + _fileOutputPath + "/" + genFileName;
-
-  if (saveJsonToFile(filePath.c_str(), _js.getJson()) != 0) KORALI_LOG_ERROR("Error trying to save result file: %s.\n", filePath.c_str());
-
-  // If using multiple files, create a hard link to the latest result
   std::string linkPath = "./" + _fileOutputPath + "/latest";
-  remove(linkPath.c_str());
-  link(filePath.c_str(), linkPath.c_str());
+
+  // The engine only takes a snapshot of the results, serializing and writing them is left to the background writer
+  if (_fileOutputAsynchronous)
+    _resultWriter->write(filePath, linkPath, knlohmann::json(_js.getJson()), isBinary);
+  else
+  {
+    auto error = resultWriter::writeFile(filePath, linkPath, _js.getJson(), isBinary);
+    if (error.empty() == false) KORALI_LOG_ERROR("%s", error.c_str());
+  }
 
   auto endTime = std::chrono::steady_clock::now();
   _resultSavingTime += std::chrono::duration_cast<std::chrono::nanoseconds>(endTime - beginTime).count();
@@ -161,6 +176,7 @@ Experiment::Experiment()
   _k = this;
   _logger = NULL;
   _engine = NULL;
+  _resultWriter = NULL;
   _currentGeneration = 0;
   _isInitialized = false;
 }
@@ -201,6 +217,9 @@ void Experiment::initialize()
   // Updating verbosity level
   _logger = new Logger(_consoleOutputVerbosity, stdout);
 
+  // Creating the result writer. Its thread only starts with the first asynchronous result file.
+  _resultWriter = new resultWriter;
+
   // Initializing problem and solver modules
   _problem->initialize();
   _solver->initialize();
@@ -216,6 +235,7 @@ void Experiment::finalize()
   _distributions.clear();
   if (_isInitialized == true) co_delete(_thread);
   delete _logger;
+  delete _resultWriter;
   delete _problem;
 }
 
@@ -364,6 +384,30 @@ void Experiment::setConfiguration(knlohmann::json& js)
  }
   else   KORALI_LOG_ERROR(" + No value provided for mandatory setting: ['File Output']['Frequency'] required by experiment.\n"); 
 
+ if (isDefined(js, "File Output", "Format"))
+ {
+ try { _fileOutputFormat = js["File Output"]["Format"].get<std::string>();
+} catch (const std::exception& e)
+ { KORALI_LOG_ERROR(" + Object: [ experiment ] \n + Key:    ['File Output']['Format']\n%s", e.what()); } 
+{
+ bool validOption = false; 
+ if (_fileOutputFormat == "JSON") validOption = true; 
+ if (_fileOutputFormat == "Binary") validOption = true; 
+ if (validOption == false) KORALI_LOG_ERROR(" + Unrecognized value (%s) provided for mandatory setting: ['File Output']['Format'] required by experiment.\n", _fileOutputFormat.c_str()); 
+}
+   eraseValue(js, "File Output", "Format");
+ }
+  else   KORALI_LOG_ERROR(" + No value provided for mandatory setting: ['File Output']['Format'] required by experiment.\n"); 
+
+ if (isDefined(js, "File Output", "Asynchronous"))
+ {
+ try { _fileOutputAsynchronous = js["File Output"]["Asynchronous"].get<int>();
+} catch (const std::exception& e)
+ { KORALI_LOG_ERROR(" + Object: [ experiment ] \n + Key:    ['File Output']['Asynchronous']\n%s", e.what()); } 
+   eraseValue(js, "File Output", "Asynchronous");
+ }
+  else   KORALI_LOG_ERROR(" + No value provided for mandatory setting: ['File Output']['Asynchronous'] required by experiment.\n"); 
+
  if (isDefined(js, "Store Sample Information"))
  {
  try { _storeSampleInformation = js["Store Sample Information"].get<int>();
@@ -418,6 +462,8 @@ void Experiment::getConfiguration(knlohmann::json& js)
    js["File Output"]["Use Multiple Files"] = _fileOutputUseMultipleFiles;
    js["File Output"]["Enabled"] = _fileOutputEnabled;
    js["File Output"]["Frequency"] = _fileOutputFrequency;
+   js["File Output"]["Format"] = _fileOutputFormat;
+   js["File Output"]["Asynchronous"] = _fileOutputAsynchronous;
    js["Store Sample Information"] = _storeSampleInformation;
    js["Console Output"]["Verbosity"] = _consoleOutputVerbosity;
    js["Console Output"]["Frequency"] = _consoleOutputFrequency;
@@ -431,7 +477,7 @@ void Experiment::getConfiguration(knlohmann::json& js)
 void Experiment::applyModuleDefaults(knlohmann::json& js) 
 {
 
- std::string defaultString = "{\"Random Seed\": 0, \"Preserve Random Number Generator States\": false, \"Distributions\": [], \"Current Generation\": 0, \"File Output\": {\"Enabled\": true, \"Path\": \"_korali_result\", \"Frequency\": 1, \"Use Multiple Files\": true}, \"Console Output\": {\"Verbosity\": \"Normal\", \"Frequency\": 1}, \"Store Sample Information\": false, \"Is Finished\": false}";
+ std::string defaultString = "{\"Random Seed\": 0, \"Preserve Random Number Generator States\": false, \"Distributions\": [], \"Current Generation\": 0, \"File Output\": {\"Enabled\": true, \"Path\": \"_korali_result\", \"Frequency\": 1, \"Use Multiple Files\": true, \"Format\": \"JSON\", \"Asynchronous\": false}, \"Console Output\": {\"Verbosity\": \"Normal\", \"Frequency\": 1}, \"Store Sample Information\": false, \"Is Finished\": false}";
  knlohmann::json defaultJs = knlohmann::json::parse(defaultString);
  mergeJson(js, defaultJs); 
  Module::applyModuleDefaults(js);
@@ -37,6 +37,10 @@ class Problem;
 * @brief Class declaration for module: Experiment.
 */
 class Engine;
+/**
+* @brief Class declaration for module: Experiment.
+*/
+class resultWriter;
 
 /**
 * @brief Class declaration for module: Experiment.
@@ -85,6 +89,14 @@ class Experiment : public Module
   */
    size_t _fileOutputFrequency;
   /**
+  * @brief Specifies the format of the result files.
+  */
+   std::string _fileOutputFormat;
+  /**
+  * @brief If true, result files are serialized and written to disk by a background thread, and the engine only pays for taking a copy of the results. The engine waits if the writer falls more than one file behind. All files are written before the experiment finishes.
+  */
+   int _fileOutputAsynchronous;
+  /**
   * @brief Specifies whether the sample information should be saved to samples.json in the results path.
   */
    int _storeSampleInformation;
@@ -180,6 +192,11 @@ class Experiment : public Module
    */
   double _resultSavingTime;
 
+  /**
+   * @brief Writes result files in the background, if file output is asynchronous
+   */
+  resultWriter *_resultWriter;
+
   /**
    * @brief For testing purposes, this field establishes whether the engine is the one to run samples (default = false) or a custom function (true)
    */
@@ -66,9 +66,11 @@
 #include "solver/optimizer/Adam/Adam.hpp"
 #include "solver/optimizer/CMAES/CMAES.hpp"
 #include "solver/optimizer/DEA/DEA.hpp"
+#include "solver/optimizer/LMCMAES/LMCMAES.hpp"
 #include "solver/optimizer/MADGRAD/MADGRAD.hpp"
 #include "solver/optimizer/MOCMAES/MOCMAES.hpp"
 #include "solver/optimizer/Rprop/Rprop.hpp"
+#include "solver/optimizer/VDCMAES/VDCMAES.hpp"
 #include "solver/optimizer/gridSearch/gridSearch.hpp"
 #include "solver/optimizer/optimizer.hpp"
 #include "solver/sampler/HMC/HMC.hpp"
@@ -179,6 +181,8 @@ Module *Module::getModule(knlohmann::json &js, Experiment *e)
   if (iCompare(moduleType, "Agent/Discrete/dVRACER")) module = new korali::solver::agent::discrete::dVRACER();
   if (iCompare(moduleType, "Optimizer/CMAES")) module = new korali::solver::optimizer::CMAES();
   if (iCompare(moduleType, "Optimizer/DEA")) module = new korali::solver::optimizer::DEA();
+  if (iCompare(moduleType, "Optimizer/LMCMAES")) module = new korali::solver::optimizer::LMCMAES();
+  if (iCompare(moduleType, "Optimizer/VDCMAES")) module = new korali::solver::optimizer::VDCMAES();
   if (iCompare(moduleType, "Optimizer/Rprop")) module = new korali::solver::optimizer::Rprop();
   if (iCompare(moduleType, "Optimizer/Adam")) module = new korali::solver::optimizer::Adam();
   if (iCompare(moduleType, "Optimizer/AdaBelief")) module = new korali::solver::optimizer::AdaBelief();
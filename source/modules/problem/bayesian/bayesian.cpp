@@ -65,7 +65,7 @@ void Bayesian::evaluateLogPriorHessian(Sample &sample)
 void Bayesian::evaluateLogPosterior(Sample &sample)
 {
   const int sampleId = sample["Sample Id"];
-  evaluateLogPrior(sample);
+  if (_isLogPriorEvaluated == false) evaluateLogPrior(sample);
 
   const double logPrior = KORALI_GET(double, sample, "logPrior");
 
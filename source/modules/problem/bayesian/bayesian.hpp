@@ -25,7 +25,12 @@ namespace problem
 */
 class Bayesian : public Problem
 {
-  private:
+  protected:
+  /**
+   * @brief Set while the log prior of the samples being evaluated is already stored in sample["logPrior"], so the log posterior does not evaluate it again
+   */
+  bool _isLogPriorEvaluated = false;
+
   public: 
   
  
@@ -28,9 +28,52 @@ void Reference::initialize()
   if (_k->_variables.size() < 1) KORALI_LOG_ERROR("Bayesian (%s) inference problems require at least one variable.\n", _likelihoodModel.c_str());
 }
 
+void Reference::runComputationalModel(Sample &sample)
+{
+  if (_isBatchEvaluated) return;
+
+  if (_vectorizedModel)
+  {
+    std::vector<Sample *> samples({&sample});
+    runVectorizedModel(_computationalModel, samples);
+  }
+  else
+    sample.run(_computationalModel);
+}
+
+bool Reference::runBatchOperation(const std::string &operation, std::vector<Sample *> &samples)
+{
+  if (_vectorizedModel == false) return false;
+  if (operation != "Evaluate" && operation != "Evaluate logPosterior" && operation != "Evaluate logLikelihood") return false;
+
+  // Samples outside the prior support skip the likelihood, so they do not need a model evaluation
+  std::vector<Sample *> modelSamples;
+  for (auto sample : samples)
+  {
+    if (operation != "Evaluate logLikelihood")
+    {
+      evaluateLogPrior(*sample);
+      const double logPrior = KORALI_GET(double, (*sample), "logPrior");
+      if (logPrior == -Inf) continue;
+    }
+    modelSamples.push_back(sample);
+  }
+
+  runVectorizedModel(_computationalModel, modelSamples);
+
+  // The log priors were evaluated above, the operations only complete the likelihood and posterior
+  _isBatchEvaluated = true;
+  _isLogPriorEvaluated = operation != "Evaluate logLikelihood";
+  for (auto sample : samples) runOperation(operation, *sample);
+  _isBatchEvaluated = false;
+  _isLogPriorEvaluated = false;
+
+  return true;
+}
+
 void Reference::evaluateLoglikelihood(Sample &sample)
 {
-  sample.run(_computationalModel);
+  runComputationalModel(sample);
   if (_likelihoodModel == "Normal")
     loglikelihoodNormal(sample);
   else if (_likelihoodModel == "Positive Normal")
@@ -669,6 +712,15 @@ void Reference::setConfiguration(knlohmann::json& js)
  }
   else   KORALI_LOG_ERROR(" + No value provided for mandatory setting: ['Likelihood Model'] required by reference.\n"); 
 
+ if (isDefined(js, "Vectorized Model"))
+ {
+ try { _vectorizedModel = js["Vectorized Model"].get<int>();
+} catch (const std::exception& e)
+ { KORALI_LOG_ERROR(" + Object: [ reference ] \n + Key:    ['Vectorized Model']\n%s", e.what()); } 
+   eraseValue(js, "Vectorized Model");
+ }
+  else   KORALI_LOG_ERROR(" + No value provided for mandatory setting: ['Vectorized Model'] required by reference.\n"); 
+
  Bayesian::setConfiguration(js);
  _type = "bayesian/reference";
  if(isDefined(js, "Type")) eraseValue(js, "Type");
@@ -682,12 +734,16 @@ void Reference::getConfiguration(knlohmann::json& js)
    js["Computational Model"] = _computationalModel;
    js["Reference Data"] = _referenceData;
    js["Likelihood Model"] = _likelihoodModel;
+   js["Vectorized Model"] = _vectorizedModel;
  Bayesian::getConfiguration(js);
 } 
 
 void Reference::applyModuleDefaults(knlohmann::json& js) 
 {
 
+ std::string defaultString = "{\"Vectorized Model\": false}";
+ knlohmann::json defaultJs = knlohmann::json::parse(defaultString);
+ mergeJson(js, defaultJs); 
  Bayesian::applyModuleDefaults(js);
 } 
 
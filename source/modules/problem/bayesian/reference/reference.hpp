@@ -31,6 +31,17 @@ class Reference : public Bayesian
   private:
   const double _log2pi = 1.83787706640934533908193770912476;
 
+  /**
+   * @brief Set while a batch operation runs the samples' operations, after their computational model has already been evaluated together
+   */
+  bool _isBatchEvaluated = false;
+
+  /**
+   * @brief Evaluates the computational model on a sample, unless it was already evaluated as part of a batch.
+   * @param sample A Korali Sample
+   */
+  void runComputationalModel(korali::Sample &sample);
+
   /**
    * @brief Precomputes the square distance between two vectors (f and y) of the same size normalized by a third vector (g)
    * @param f Vector f
@@ -149,6 +160,10 @@ class Reference : public Bayesian
   * @brief Specifies the likelihood model to approximate the reference data to.
   */
    std::string _likelihoodModel;
+  /**
+  * @brief If true, the computational model evaluates a whole batch of samples (see the conduit's Batch Size) in a single call. It receives a list of parameter vectors in sample["Parameters"] and must return each of its results (e.g., sample["Reference Evaluations"]) as a list with one entry per parameter vector.
+  */
+   int _vectorizedModel;
   
  
   /**
@@ -173,6 +188,7 @@ class Reference : public Bayesian
   
 
   void initialize() override;
+  bool runBatchOperation(const std::string &operation, std::vector<Sample *> &samples) override;
   void evaluateLoglikelihood(korali::Sample &sample) override;
   void evaluateLoglikelihoodGradient(korali::Sample &sample) override;
   void evaluateLogLikelihoodHessian(korali::Sample &sample) override;
@@ -12,6 +12,34 @@ void Optimization::initialize()
   if (_k->_variables.size() == 0) KORALI_LOG_ERROR("Optimization Evaluation problems require at least one variable.\n");
 }
 
+void Optimization::runObjectiveFunction(Sample &sample)
+{
+  if (_isBatchEvaluated) return;
+
+  if (_vectorizedModel)
+  {
+    std::vector<Sample *> samples({&sample});
+    runVectorizedModel(_objectiveFunction, samples);
+  }
+  else
+    sample.run(_objectiveFunction);
+}
+
+bool Optimization::runBatchOperation(const std::string &operation, std::vector<Sample *> &samples)
+{
+  if (_vectorizedModel == false) return false;
+  if (operation != "Evaluate" && operation != "Evaluate Multiple" && operation != "Evaluate With Gradients") return false;
+
+  // Evaluating all samples with a single call, and then checking each result
+  runVectorizedModel(_objectiveFunction, samples);
+
+  _isBatchEvaluated = true;
+  for (auto sample : samples) runOperation(operation, *sample);
+  _isBatchEvaluated = false;
+
+  return true;
+}
+
 void Optimization::evaluateConstraints(Sample &sample)
 {
   for (size_t i = 0; i < _constraints.size(); i++)
@@ -29,7 +57,7 @@ void Optimization::evaluateConstraints(Sample &sample)
 
 void Optimization::evaluate(Sample &sample)
 {
-  sample.run(_objectiveFunction);
+  runObjectiveFunction(sample);
 
   auto evaluation = KORALI_GET(double, sample, "F(x)");
 
@@ -39,7 +67,7 @@ void Optimization::evaluate(Sample &sample)
 
 void Optimization::evaluateMultiple(Sample &sample)
 {
-  sample.run(_objectiveFunction);
+  runObjectiveFunction(sample);
 
   auto evaluation = KORALI_GET(std::vector<double>, sample, "F(x)");
 
@@ -50,7 +78,7 @@ void Optimization::evaluateMultiple(Sample &sample)
 
 void Optimization::evaluateWithGradients(Sample &sample)
 {
-  sample.run(_objectiveFunction);
+  runObjectiveFunction(sample);
 
   auto evaluation = KORALI_GET(double, sample, "F(x)");
   auto gradient = KORALI_GET(std::vector<double>, sample, "Gradient");
@@ -105,6 +133,15 @@ void Optimization::setConfiguration(knlohmann::json& js)
  }
   else   KORALI_LOG_ERROR(" + No value provided for mandatory setting: ['Constraints'] required by optimization.\n"); 
 
+ if (isDefined(js, "Vectorized Model"))
+ {
+ try { _vectorizedModel = js["Vectorized Model"].get<int>();
+} catch (const std::exception& e)
+ { KORALI_LOG_ERROR(" + Object: [ optimization ] \n + Key:    ['Vectorized Model']\n%s", e.what()); } 
+   eraseValue(js, "Vectorized Model");
+ }
+  else   KORALI_LOG_ERROR(" + No value provided for mandatory setting: ['Vectorized Model'] required by optimization.\n"); 
+
  if (isDefined(_k->_js.getJson(), "Variables"))
  for (size_t i = 0; i < _k->_js["Variables"].size(); i++) { 
  } 
@@ -130,6 +167,7 @@ void Optimization::getConfiguration(knlohmann::json& js)
    js["Num Objectives"] = _numObjectives;
    js["Objective Function"] = _objectiveFunction;
    js["Constraints"] = _constraints;
+   js["Vectorized Model"] = _vectorizedModel;
    js["Has Discrete Variables"] = _hasDiscreteVariables;
  for (size_t i = 0; i <  _k->_variables.size(); i++) { 
  } 
@@ -139,7 +177,7 @@ void Optimization::getConfiguration(knlohmann::json& js)
 void Optimization::applyModuleDefaults(knlohmann::json& js) 
 {
 
- std::string defaultString = "{\"Num Objectives\": 1, \"Has Discrete Variables\": false, \"Constraints\": []}";
+ std::string defaultString = "{\"Num Objectives\": 1, \"Vectorized Model\": false, \"Has Discrete Variables\": false, \"Constraints\": []}";
  knlohmann::json defaultJs = knlohmann::json::parse(defaultString);
  mergeJson(js, defaultJs); 
  Problem::applyModuleDefaults(js);
@@ -26,6 +26,17 @@ namespace problem
 class Optimization : public Problem
 {
   private:
+  /**
+   * @brief Indicates that the objective function has already been evaluated for the samples being processed, as part of a batch
+   */
+  bool _isBatchEvaluated = false;
+
+  /**
+   * @brief Evaluates the objective function for a sample, unless already evaluated as part of a batch
+   * @param sample A Korali Sample
+   */
+  void runObjectiveFunction(korali::Sample &sample);
+
   public: 
   /**
   * @brief Number of return values to expect from objective function.
@@ -40,6 +51,10 @@ class Optimization : public Problem
   */
    std::vector<std::uint64_t> _constraints;
   /**
+  * @brief If true, the objective function evaluates a whole batch of samples (see the conduit's Batch Size) in a single call. It receives a list of parameter vectors in sample["Parameters"] and must return each of its results (e.g., sample["F(x)"]) as a list with one entry per parameter vector. Constraints are still evaluated one sample at a time.
+  */
+   int _vectorizedModel;
+  /**
   * @brief [Internal Use] Flag indicating if at least one of the variables is discrete.
   */
    int _hasDiscreteVariables;
@@ -75,6 +90,8 @@ class Optimization : public Problem
 
   void initialize() override;
 
+  bool runBatchOperation(const std::string &operation, std::vector<korali::Sample *> &samples) override;
+
   /**
    * @brief Evaluates a single objective, given a set of parameters.
    * @param sample A sample to process
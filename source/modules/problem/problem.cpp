@@ -1,9 +1,47 @@
 #include "modules/problem/problem.hpp"
+#include "sample/sample.hpp"
 
 namespace korali
 {
 ;
 
+void Problem::runVectorizedModel(const size_t model, std::vector<Sample *> &samples)
+{
+  if (samples.empty()) return;
+
+  // The model sample carries the metadata of the first sample, and the parameters and ids of all of them
+  Sample batch;
+  batch._js.getJson() = samples[0]->_js.getJson();
+
+  auto parameters = knlohmann::json::array();
+  auto sampleIds = knlohmann::json::array();
+  for (auto sample : samples)
+  {
+    const auto params = KORALI_GET(std::vector<double>, (*sample), "Parameters");
+    const auto sampleId = KORALI_GET(size_t, (*sample), "Sample Id");
+    parameters.push_back(params);
+    sampleIds.push_back(sampleId);
+  }
+
+  batch["Parameters"] = parameters;
+  batch["Sample Id"] = sampleIds;
+  batch["Batch Size"] = samples.size();
+  const auto inputJs = batch._js.getJson();
+
+  batch.run(model);
+
+  // Handing each new or updated result entry over to its sample, overwriting the inputs the model replaced
+  for (auto &result : batch._js.getJson().items())
+  {
+    if (inputJs.contains(result.key()) && inputJs[result.key()] == result.value()) continue;
+
+    if (result.value().is_array() == false || result.value().size() != samples.size())
+      KORALI_LOG_ERROR("Vectorized model result '%s' must be a list with one entry per sample (%lu).\n", result.key().c_str(), samples.size());
+
+    for (size_t i = 0; i < samples.size(); i++) (*samples[i])[result.key()] = result.value()[i];
+  }
+}
+
 void Problem::setConfiguration(knlohmann::json& js) 
 {
  if (isDefined(js, "Results"))  eraseValue(js, "Results");
@@ -49,10 +49,19 @@ class Problem : public Module
   
 
   /**
-   * @brief Evaluates whether at least one of constraints have been met.
+   * @brief Runs an operation on a batch of samples at once, if the problem supports it (e.g., with a vectorized model).
    * @param operation Name of the operation
-   * @param sample A Korali Sample
+   * @param samples The samples to process
+   * @return True, if the operation was run on all samples; false, if the samples need to be processed individually.
    */
+  virtual bool runBatchOperation(const std::string &operation, std::vector<Sample *> &samples) { return false; }
+
+  /**
+   * @brief Evaluates a vectorized model with a single call for a set of samples. The model receives the parameters of all samples as a list, and must return each of its results as a list with one entry per sample.
+   * @param model Position of the model function
+   * @param samples The samples to evaluate
+   */
+  void runVectorizedModel(const size_t model, std::vector<Sample *> &samples);
 };
 
 } //korali
@@ -152,9 +152,11 @@ void DeepSupervisor::runTestingGeneration()
       samples[sId]["Sample Id"] = sId;
       samples[sId]["Module"] = "Solver";
       samples[sId]["Operation"] = "Run Evaluation On Worker";
-      samples[sId]["Input Data"] = workerInputDataFlat;
       samples[sId]["Input Dims"] = std::vector<size_t>({NW, T, IC});
-      samples[sId]["Hyperparameters"] = nnHyperparameters;
+
+      // Large arrays travel as binary buffers, bypassing JSON serialization
+      samples[sId].floatBuffer("Input Data") = std::move(workerInputDataFlat);
+      samples[sId].floatBuffer("Hyperparameters") = nnHyperparameters;
     }
 
     // Launching samples
@@ -167,8 +169,10 @@ void DeepSupervisor::runTestingGeneration()
     _evaluation.clear();
     for (size_t i = 0; i < _batchConcurrency; i++)
     {
-      const auto workerEvaluations = KORALI_GET(std::vector<std::vector<float>>, samples[i], "Evaluation");
-      _evaluation.insert(_evaluation.end(), workerEvaluations.begin(), workerEvaluations.end());
+      const auto &workerEvaluationFlat = samples[i].floatBuffer("Evaluation");
+      const size_t OC = workerEvaluationFlat.size() / NW;
+      for (size_t j = 0; j < NW; j++)
+        _evaluation.push_back(std::vector<float>(workerEvaluationFlat.begin() + j * OC, workerEvaluationFlat.begin() + (j + 1) * OC));
     }
   }
 
@@ -230,11 +234,13 @@ void DeepSupervisor::runTrainingGeneration()
       samples[sId]["Sample Id"] = sId;
       samples[sId]["Module"] = "Solver";
       samples[sId]["Operation"] = "Run Training On Worker";
-      samples[sId]["Input Data"] = workerInputDataFlat;
       samples[sId]["Input Dims"] = std::vector<size_t>({NW, T, IC});
-      samples[sId]["Solution Data"] = workerSolutionDataFlat;
       samples[sId]["Solution Dims"] = std::vector<size_t>({NW, OC});
-      samples[sId]["Hyperparameters"] = nnHyperparameters;
+
+      // Large arrays travel as binary buffers, bypassing JSON serialization
+      samples[sId].floatBuffer("Input Data") = std::move(workerInputDataFlat);
+      samples[sId].floatBuffer("Solution Data") = std::move(workerSolutionDataFlat);
+      samples[sId].floatBuffer("Hyperparameters") = nnHyperparameters;
     }
 
     // Launching samples
@@ -249,7 +255,7 @@ void DeepSupervisor::runTrainingGeneration()
     for (size_t i = 0; i < _batchConcurrency; i++)
     {
       _currentLoss += KORALI_GET(float, samples[i], "Squared Loss");
-      const auto workerGradients = KORALI_GET(std::vector<float>, samples[i], "Hyperparameter Gradients");
+      const auto &workerGradients = samples[i].floatBuffer("Hyperparameter Gradients");
       for (size_t i = 0; i < workerGradients.size(); i++) nnHyperparameterGradients[i] += workerGradients[i];
     }
     _currentLoss = _currentLoss / ((float)N * 2.0f);
@@ -341,17 +347,16 @@ std::vector<float> DeepSupervisor::backwardGradients(const std::vector<std::vect
 void DeepSupervisor::runTrainingOnWorker(korali::Sample &sample)
 {
   // Updating hyperparameters in the worker's NN
-  const auto nnHyperparameters = KORALI_GET(std::vector<float>, sample, "Hyperparameters");
-  _neuralNetwork->setHyperparameters(nnHyperparameters);
-  sample._js.getJson().erase("Hyperparameters");
+  _neuralNetwork->setHyperparameters(sample.floatBuffer("Hyperparameters"));
+  sample._buffers._float.erase("Hyperparameters");
 
   // Getting input from sample
-  const auto inputDataFlat = KORALI_GET(std::vector<float>, sample, "Input Data");
-  sample._js.getJson().erase("Input Data");
+  const auto inputDataFlat = std::move(sample.floatBuffer("Input Data"));
+  sample._buffers._float.erase("Input Data");
 
   // Getting solution from sample
-  const auto solutionDataFlat = KORALI_GET(std::vector<float>, sample, "Solution Data");
-  sample._js.getJson().erase("Solution Data");
+  const auto solutionDataFlat = std::move(sample.floatBuffer("Solution Data"));
+  sample._buffers._float.erase("Solution Data");
 
   // Getting input dimensions
   const auto inputDims = KORALI_GET(std::vector<size_t>, sample, "Input Dims");
@@ -399,20 +404,19 @@ void DeepSupervisor::runTrainingOnWorker(korali::Sample &sample)
   backwardGradients(solution);
 
   // Storing the output values for the last given timestep
-  sample["Hyperparameter Gradients"] = _neuralNetwork->getHyperparameterGradients(N);
+  sample.floatBuffer("Hyperparameter Gradients") = _neuralNetwork->getHyperparameterGradients(N);
   sample["Squared Loss"] = squaredLoss;
 }
 
 void DeepSupervisor::runEvaluationOnWorker(korali::Sample &sample)
 {
   // Updating hyperparameters in the worker's NN
-  auto nnHyperparameters = KORALI_GET(std::vector<float>, sample, "Hyperparameters");
-  _neuralNetwork->setHyperparameters(nnHyperparameters);
-  sample._js.getJson().erase("Hyperparameters");
+  _neuralNetwork->setHyperparameters(sample.floatBuffer("Hyperparameters"));
+  sample._buffers._float.erase("Hyperparameters");
 
   // Getting input from sample
-  auto inputDataFlat = KORALI_GET(std::vector<float>, sample, "Input Data");
-  sample._js.getJson().erase("Input Data");
+  auto inputDataFlat = std::move(sample.floatBuffer("Input Data"));
+  sample._buffers._float.erase("Input Data");
 
   // Getting input dimensions
   auto inputDims = KORALI_GET(std::vector<size_t>, sample, "Input Dims");
@@ -428,8 +432,11 @@ void DeepSupervisor::runEvaluationOnWorker(korali::Sample &sample)
       for (size_t k = 0; k < IC; k++)
         input[i][j][k] = inputDataFlat[i * T * IC + j * IC + k];
 
-  // Storing the output values for the last given timestep
-  sample["Evaluation"] = getEvaluation(input);
+  // Storing the output values for the last given timestep, flattened
+  const auto &evaluation = getEvaluation(input);
+  auto &evaluationFlat = sample.floatBuffer("Evaluation");
+  evaluationFlat.clear();
+  for (size_t i = 0; i < evaluation.size(); i++) evaluationFlat.insert(evaluationFlat.end(), evaluation[i].begin(), evaluation[i].end());
 }
 
 void DeepSupervisor::printGenerationAfter()
@@ -198,10 +198,11 @@ void Designer::runGeneration()
   if (_executionsPerGeneration > 0)
     numEvaluations = std::min(_executionsPerGeneration, _numberOfPriorSamples - _modelEvaluations[0].size());
 
-  // Create and start samples
-  _samples.resize(numEvaluations);
-  for (size_t i = 0; i < numEvaluations; i++)
-  {
+  // Stream samples through a bounded window, storing their evaluations as they arrive
+  const size_t firstEvaluation = _modelEvaluations[0].size();
+  for (size_t e = 0; e < _numberOfDesigns; e++) _modelEvaluations[e].resize(firstEvaluation + numEvaluations);
+
+  auto prepareSample = [&](size_t i, Sample &sample) {
     std::vector<double> params(_problem->_parameterVectorSize);
 
     // Set parameter values
@@ -223,24 +224,18 @@ void Designer::runGeneration()
     _priorSamples.push_back(params);
 
     // Configure Sample
-    _samples[i]["Sample Id"] = i;
-    _samples[i]["Module"] = "Problem";
-    _samples[i]["Operation"] = "Run Model";
-    _samples[i]["Parameters"] = params;
-    _samples[i]["Designs"] = _designCandidates;
-
-    // Start Sample
-    KORALI_START(_samples[i]);
+    sample["Sample Id"] = i;
+    sample["Module"] = "Problem";
+    sample["Operation"] = "Run Model";
+    sample["Parameters"] = params;
+    sample["Designs"] = _designCandidates;
 
     // Increase counter
     _modelEvaluationCount++;
-  }
+  };
 
-  KORALI_WAITALL(_samples);
-
-  for (size_t i = 0; i < numEvaluations; i++)
-  {
-    const auto evaluation = KORALI_GET(std::vector<std::vector<double>>, _samples[i], "Model Evaluation");
+  auto storeEvaluation = [&](size_t i, Sample &sample) {
+    const auto evaluation = KORALI_GET(std::vector<std::vector<double>>, sample, "Model Evaluation");
 
     // Check whether one value per design was returned
     if (evaluation.size() != _numberOfDesigns)
@@ -252,10 +247,12 @@ void Designer::runGeneration()
       if (evaluation[e].size() != _problem->_measurementVectorSize)
         KORALI_LOG_ERROR("Evaluation %ld returned vector returned with the wrong size: %lu, expected: %lu.\n", e, evaluation[e].size(), _problem->_measurementVectorSize);
 
-      // Save evaluation
-      _modelEvaluations[e].push_back(evaluation[e]);
+      // Save evaluation, in the same order as the prior samples
+      _modelEvaluations[e][firstEvaluation + i] = evaluation[e];
     }
-  }
+  };
+
+  KORALI_MAP(numEvaluations, prepareSample, storeEvaluation);
 
   if (_modelEvaluations[0].size() < _numberOfPriorSamples)
     return;
@@ -263,39 +260,30 @@ void Designer::runGeneration()
   /*** Step 2: Compute Utility  ***/
   _k->_logger->logInfo("Minimal", "Computing the utility...\n");
 
-  _samples.clear();
-  _samples.resize(_numberOfDesigns);
-  for (size_t e = 0; e < _numberOfDesigns; e++)
-  {
+  auto prepareDesign = [&](size_t e, Sample &sample) {
     // Configure Sample
-    _samples[e]["Sample Id"] = e;
-    _samples[e]["Module"] = "Solver";
-    _samples[e]["Operation"] = "Evaluate Design";
-    _samples[e]["Evaluations"] = _modelEvaluations[e];
-
-    // Start Sample
-    KORALI_START(_samples[e]);
+    sample["Sample Id"] = e;
+    sample["Module"] = "Solver";
+    sample["Operation"] = "Evaluate Design";
+    sample["Evaluations"] = _modelEvaluations[e];
 
     // Increase counter
     _modelEvaluationCount++;
-  }
+  };
 
-  KORALI_WAITALL(_samples);
+  // Gather utilities as they arrive
+  auto storeUtility = [&](size_t e, Sample &sample) { _utility[e] = KORALI_GET(double, sample, "Utility"); };
 
-  // Get utility and determine maximum
+  KORALI_MAP(_numberOfDesigns, prepareDesign, storeUtility);
+
+  // Determine maximum utility
   double maxUtility = -std::numeric_limits<double>::infinity();
   for (size_t e = 0; e < _numberOfDesigns; e++)
-  {
-    // Gather result
-    _utility[e] = KORALI_GET(double, _samples[e], "Utility");
-
-    // Update maximum
     if (_utility[e] > maxUtility)
     {
       maxUtility = _utility[e];
       _optimalDesignIndex = e;
     }
-  }
   (*_k)["Results"]["Utility"] = _utility;
 }
 
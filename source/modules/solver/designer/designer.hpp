@@ -163,11 +163,6 @@ class Designer : public Solver
   bool runOperation(std::string operation, korali::Sample& sample) override;
   
 
-  /**
-   * @brief Container for samples to be evaluated per generation
-   */
-  std::vector<Sample> _samples;
-
   /**
    * @brief Problem pointer
    */
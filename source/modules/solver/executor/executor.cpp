@@ -16,32 +16,30 @@ void Executor::runGeneration()
   _maxModelEvaluations = std::min(_maxModelEvaluations, _sampleCount);
   _executionsPerGeneration = std::min(_executionsPerGeneration, _maxModelEvaluations - _modelEvaluationCount);
 
-  std::vector<Sample> samples(_executionsPerGeneration);
-  std::vector<double> sampleData(_variableCount);
-
-  for (size_t i = 0; i < _executionsPerGeneration; i++)
-  {
+  // Streaming the generation's samples through a bounded window of in-flight samples
+  const size_t firstSampleId = _modelEvaluationCount;
+  auto prepareSample = [&](size_t i, Sample &sample) {
+    std::vector<double> sampleData(_variableCount);
     for (size_t d = 0; d < _variableCount; d++)
     {
       if (_k->_variables[0]->_precomputedValues.size() > 0)
-        sampleData[d] = _k->_variables[d]->_precomputedValues[_modelEvaluationCount];
+        sampleData[d] = _k->_variables[d]->_precomputedValues[firstSampleId + i];
       else
         sampleData[d] = _k->_distributions[_k->_variables[d]->_distributionIndex]->getRandomNumber();
     }
 
-    _k->_logger->logInfo("Detailed", "Running sample %zu with values:\n         ", _modelEvaluationCount);
+    _k->_logger->logInfo("Detailed", "Running sample %zu with values:\n         ", firstSampleId + i);
     for (auto &x : sampleData) _k->_logger->logData("Detailed", " %le   ", x);
     _k->_logger->logData("Detailed", "\n");
 
-    samples[i]["Module"] = "Problem";
-    samples[i]["Operation"] = "Execute";
-    samples[i]["Parameters"] = sampleData;
-    samples[i]["Sample Id"] = _modelEvaluationCount;
-    KORALI_START(samples[i]);
+    sample["Module"] = "Problem";
+    sample["Operation"] = "Execute";
+    sample["Parameters"] = sampleData;
+    sample["Sample Id"] = firstSampleId + i;
     _modelEvaluationCount++;
-  }
+  };
 
-  KORALI_WAITALL(samples);
+  KORALI_MAP(_executionsPerGeneration, prepareSample, [](size_t i, Sample &sample) {});
 }
 
 void Executor::printGenerationBefore()
@@ -24,22 +24,21 @@ void Integrator::runGeneration()
   if (_k->_currentGeneration == 1) setInitialConfiguration();
 
   _executionsPerGeneration = std::min(_executionsPerGeneration, _maxModelEvaluations - _modelEvaluationCount);
-  _samples.resize(_executionsPerGeneration);
 
-  for (size_t i = 0; i < _executionsPerGeneration; i++)
-  {
-    launchSample(i);
+  // Streaming the generation's samples through a bounded window, accumulating the integral as results arrive
+  const size_t firstEvaluation = _modelEvaluationCount;
+  auto prepare = [&](size_t i, Sample &sample) {
+    prepareSample(sample, i, firstEvaluation + i);
     _modelEvaluationCount++;
-  }
-
-  KORALI_WAITALL(_samples);
+  };
 
-  for (size_t i = 0; i < _executionsPerGeneration; i++)
-  {
-    auto f = KORALI_GET(double, _samples[i], "Evaluation");
-    auto w = KORALI_GET(double, _samples[i], "Weight");
+  auto reduce = [&](size_t i, Sample &sample) {
+    auto f = KORALI_GET(double, sample, "Evaluation");
+    auto w = KORALI_GET(double, sample, "Weight");
     _accumulatedIntegral += w * f;
-  }
+  };
+
+  KORALI_MAP(_executionsPerGeneration, prepare, reduce);
 
   (*_k)["Results"]["Integral"] = _accumulatedIntegral;
 }
@@ -67,15 +67,12 @@ class Integrator : public Solver
   
 
   /**
-   * @brief Container for samples to be evaluated per generation
+   * @brief Prepares a sample to be evaluated
+   * @param sample The sample to prepare
+   * @param sampleIndex Index of the sample within the generation
+   * @param evaluationIndex Index of the sample among all evaluations
    */
-  std::vector<Sample> _samples;
-
-  /**
-   * @brief Prepares and launches a sample to be evaluated
-   * @param sampleIndex index of sample to be launched
-   */
-  virtual void launchSample(size_t sampleIndex) = 0;
+  virtual void prepareSample(Sample &sample, size_t sampleIndex, size_t evaluationIndex) = 0;
   virtual void setInitialConfiguration() override;
   void runGeneration() override;
   void printGenerationBefore() override;
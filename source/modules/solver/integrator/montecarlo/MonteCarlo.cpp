@@ -24,7 +24,7 @@ void MonteCarlo::setInitialConfiguration()
   _maxModelEvaluations = std::min(_maxModelEvaluations, _numberOfSamples);
 }
 
-void MonteCarlo::launchSample(size_t sampleIndex)
+void MonteCarlo::prepareSample(Sample &sample, size_t sampleIndex, size_t evaluationIndex)
 {
   std::vector<float> params(_variableCount);
 
@@ -34,16 +34,14 @@ void MonteCarlo::launchSample(size_t sampleIndex)
     params[d] = (_k->_variables[d]->_upperBound - _k->_variables[d]->_lowerBound) * _uniformGenerator->getRandomNumber();
   }
 
-  _samples[sampleIndex]["Sample Id"] = sampleIndex;
-  _samples[sampleIndex]["Module"] = "Problem";
-  _samples[sampleIndex]["Operation"] = "Execute";
-  _samples[sampleIndex]["Parameters"] = params;
-  _samples[sampleIndex]["Weight"] = _weight;
-
   // Store parameter
   _gridPoints.push_back(params);
 
-  KORALI_START(_samples[sampleIndex]);
+  sample["Sample Id"] = sampleIndex;
+  sample["Module"] = "Problem";
+  sample["Operation"] = "Execute";
+  sample["Parameters"] = params;
+  sample["Weight"] = _weight;
 }
 
 void MonteCarlo::setConfiguration(knlohmann::json& js) 
@@ -52,17 +52,15 @@ void Quadrature::setInitialConfiguration()
   _maxModelEvaluations = std::min(_maxModelEvaluations, numEval);
 }
 
-void Quadrature::launchSample(size_t sampleIndex)
+void Quadrature::prepareSample(Sample &sample, size_t sampleIndex, size_t evaluationIndex)
 {
   std::vector<float> params(_variableCount);
 
-  const size_t index = _gridPoints.size();
-
   float weight = _weight;
   // Calculate params and adjust weights
   for (size_t d = 0; d < _variableCount; ++d)
   {
-    const size_t dimIdx = (size_t)(index / _indicesHelper[d]) % _k->_variables[d]->_numberOfGridpoints;
+    const size_t dimIdx = (size_t)(evaluationIndex / _indicesHelper[d]) % _k->_variables[d]->_numberOfGridpoints;
 
     if (_method == "Rectangle")
     {
@@ -90,13 +88,11 @@ void Quadrature::launchSample(size_t sampleIndex)
   // Store parameter
   _gridPoints.push_back(params);
 
-  _samples[sampleIndex]["Sample Id"] = sampleIndex;
-  _samples[sampleIndex]["Module"] = "Problem";
-  _samples[sampleIndex]["Operation"] = "Execute";
-  _samples[sampleIndex]["Parameters"] = params;
-  _samples[sampleIndex]["Weight"] = weight;
-
-  KORALI_START(_samples[sampleIndex]);
+  sample["Sample Id"] = sampleIndex;
+  sample["Module"] = "Problem";
+  sample["Operation"] = "Execute";
+  sample["Parameters"] = params;
+  sample["Weight"] = weight;
 }
 
 void Quadrature::setConfiguration(knlohmann::json& js) 
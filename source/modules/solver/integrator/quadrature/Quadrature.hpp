@@ -60,7 +60,7 @@ class Quadrature : public Integrator
   void applyVariableDefaults() override;
   
 
-  void launchSample(size_t sampleIndex) override;
+  void prepareSample(Sample &sample, size_t sampleIndex, size_t evaluationIndex) override;
   void setInitialConfiguration() override;
 };
 
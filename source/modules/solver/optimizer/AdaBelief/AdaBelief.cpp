@@ -18,56 +18,93 @@ void AdaBelief::setInitialConfiguration()
     if (std::isfinite(_k->_variables[i]->_initialValue) == false)
       KORALI_LOG_ERROR("Initial Value of variable \'%s\' not defined (no defaults can be calculated).\n", _k->_variables[i]->_name.c_str());
 
-  _currentVariable.resize(_variableCount);
-  for (size_t i = 0; i < _variableCount; i++)
-    _currentVariable[i] = _k->_variables[i]->_initialValue;
-
-  _bestEverVariables = _currentVariable;
   _bestEverGradient.resize(_variableCount, 0);
-  _gradient.resize(_variableCount);
-  _firstMoment.resize(_variableCount, 0.0);
-  _biasCorrectedFirstMoment.resize(_variableCount, 0.0);
-  _secondCentralMoment.resize(_variableCount, 0.0);
-  _biasCorrectedSecondCentralMoment.resize(_variableCount, 0.0);
+  _bestEverValue = -Inf;
 
-  _bestEverValue = Inf;
-  _gradientNorm = 1;
+  _startStates.resize(_numberOfStarts);
+  initializeStarts(_uniformGenerator, _normalGenerator);
+  _bestEverVariables = _currentVariable;
 }
 
 void AdaBelief::runGeneration()
 {
   if (_k->_currentGeneration == 1) setInitialConfiguration();
 
+  runMultiStartGeneration();
+}
+
+void AdaBelief::resetStartState(const std::vector<double> &startingPoint)
+{
+  _currentVariable = startingPoint;
+  _gradient.assign(_variableCount, 0.0);
+  _firstMoment.assign(_variableCount, 0.0);
+  _biasCorrectedFirstMoment.assign(_variableCount, 0.0);
+  _secondCentralMoment.assign(_variableCount, 0.0);
+  _biasCorrectedSecondCentralMoment.assign(_variableCount, 0.0);
+  _gradientNorm = 1;
+}
+
+void AdaBelief::swapStartState(const size_t startId)
+{
+  auto &state = _startStates[startId];
+  std::swap(_currentVariable, state.currentVariable);
+  std::swap(_gradient, state.gradient);
+  std::swap(_gradientNorm, state.gradientNorm);
+  std::swap(_firstMoment, state.firstMoment);
+  std::swap(_biasCorrectedFirstMoment, state.biasCorrectedFirstMoment);
+  std::swap(_secondCentralMoment, state.secondCentralMoment);
+  std::swap(_biasCorrectedSecondCentralMoment, state.biasCorrectedSecondCentralMoment);
+  std::swap(_currentBestValue, state.currentBestValue);
+  std::swap(_previousBestValue, state.previousBestValue);
+}
+
+void AdaBelief::getStartState(const size_t startId, knlohmann::json &js) const
+{
+  const auto &state = _startStates[startId];
+  js["Current Variable"] = state.currentVariable;
+  js["Gradient"] = state.gradient;
+  js["Gradient Norm"] = state.gradientNorm;
+  js["First Moment"] = state.firstMoment;
+  js["Bias Corrected First Moment"] = state.biasCorrectedFirstMoment;
+  js["Second Central Moment"] = state.secondCentralMoment;
+  js["Bias Corrected Second Central Moment"] = state.biasCorrectedSecondCentralMoment;
+  js["Current Best Value"] = state.currentBestValue;
+  js["Previous Best Value"] = state.previousBestValue;
+}
+
+void AdaBelief::setStartState(const size_t startId, const knlohmann::json &js)
+{
+  // When resuming, the states of the starts are rebuilt from the stored results
+  if (_startStates.size() != _numberOfStarts) _startStates.resize(_numberOfStarts);
+
+  auto &state = _startStates[startId];
+  state.currentVariable = js["Current Variable"].get<std::vector<double>>();
+  state.gradient = js["Gradient"].get<std::vector<double>>();
+  state.gradientNorm = js["Gradient Norm"].get<double>();
+  state.firstMoment = js["First Moment"].get<std::vector<double>>();
+  state.biasCorrectedFirstMoment = js["Bias Corrected First Moment"].get<std::vector<double>>();
+  state.secondCentralMoment = js["Second Central Moment"].get<std::vector<double>>();
+  state.biasCorrectedSecondCentralMoment = js["Bias Corrected Second Central Moment"].get<std::vector<double>>();
+  state.currentBestValue = js["Current Best Value"].get<double>();
+  state.previousBestValue = js["Previous Best Value"].get<double>();
+}
+
+const std::vector<double> &AdaBelief::updateStartParameters()
+{
   // update parameters
   for (size_t i = 0; i < _variableCount; i++)
   {
     _currentVariable[i] += _eta / (std::sqrt(_biasCorrectedSecondCentralMoment[i]) + _epsilon) * _biasCorrectedFirstMoment[i];
   }
 
-  // Initializing Sample Evaluation
-  Sample sample;
-  sample["Module"] = "Problem";
-  sample["Operation"] = "Evaluate With Gradients";
-  sample["Parameters"] = _currentVariable;
-  sample["Sample Id"] = 0;
-  KORALI_START(sample);
-
-  // Waiting for sample to finish
-  KORALI_WAIT(sample);
-
-  auto evaluation = KORALI_GET(double, sample, "F(x)");
-  auto gradient = KORALI_GET(std::vector<double>, sample, "Gradient");
-
-  // Processing results
-  processResult(evaluation, gradient);
+  return _currentVariable;
 }
 
-void AdaBelief::processResult(double evaluation, std::vector<double> &gradient)
+void AdaBelief::processStartEvaluation(const double evaluation, const std::vector<double> &gradient)
 {
   _modelEvaluationCount++;
   _previousBestValue = _currentBestValue;
   _currentBestValue = evaluation;
-  _bestEverValue = -Inf;
   _gradientNorm = 0.0;
 
   _gradient = gradient;
@@ -97,6 +134,8 @@ void AdaBelief::printGenerationBefore()
 
 void AdaBelief::printGenerationAfter()
 {
+  if (_numberOfStarts > 1) _k->_logger->logInfo("Normal", "Best Start: %zu/%zu\n", _currentStart + 1, _numberOfStarts);
+
   _k->_logger->logInfo("Normal", "x = [ ");
   for (size_t k = 0; k < _variableCount; k++) _k->_logger->logData("Normal", " %.5le  ", _currentVariable[k]);
   _k->_logger->logData("Normal", " ]\n");
@@ -122,6 +161,24 @@ void AdaBelief::setConfiguration(knlohmann::json& js)
 {
  if (isDefined(js, "Results"))  eraseValue(js, "Results");
 
+ if (isDefined(js, "Uniform Generator"))
+ {
+ _uniformGenerator = dynamic_cast<korali::distribution::univariate::Uniform*>(korali::Module::getModule(js["Uniform Generator"], _k));
+ _uniformGenerator->applyVariableDefaults();
+ _uniformGenerator->applyModuleDefaults(js["Uniform Generator"]);
+ _uniformGenerator->setConfiguration(js["Uniform Generator"]);
+   eraseValue(js, "Uniform Generator");
+ }
+
+ if (isDefined(js, "Normal Generator"))
+ {
+ _normalGenerator = dynamic_cast<korali::distribution::univariate::Normal*>(korali::Module::getModule(js["Normal Generator"], _k));
+ _normalGenerator->applyVariableDefaults();
+ _normalGenerator->applyModuleDefaults(js["Normal Generator"]);
+ _normalGenerator->setConfiguration(js["Normal Generator"]);
+   eraseValue(js, "Normal Generator");
+ }
+
  if (isDefined(js, "Current Variable"))
  {
  try { _currentVariable = js["Current Variable"].get<std::vector<double>>();
@@ -259,6 +316,8 @@ void AdaBelief::getConfiguration(knlohmann::json& js)
    js["Epsilon"] = _epsilon;
    js["Termination Criteria"]["Min Gradient Norm"] = _minGradientNorm;
    js["Termination Criteria"]["Max Gradient Norm"] = _maxGradientNorm;
+ if(_uniformGenerator != NULL) _uniformGenerator->getConfiguration(js["Uniform Generator"]);
+ if(_normalGenerator != NULL) _normalGenerator->getConfiguration(js["Normal Generator"]);
    js["Current Variable"] = _currentVariable;
    js["Gradient"] = _gradient;
    js["Best Ever Gradient"] = _bestEverGradient;
@@ -275,7 +334,7 @@ void AdaBelief::getConfiguration(knlohmann::json& js)
 void AdaBelief::applyModuleDefaults(knlohmann::json& js) 
 {
 
- std::string defaultString = "{\"Beta1\": 0.9, \"Beta2\": 0.999, \"Eta\": 0.001, \"Epsilon\": 1e-08, \"Termination Criteria\": {\"Min Gradient Norm\": 1e-12, \"Max Gradient Norm\": 1000000000000.0}}";
+ std::string defaultString = "{\"Uniform Generator\": {\"Type\": \"Univariate/Uniform\", \"Minimum\": 0.0, \"Maximum\": 1.0}, \"Normal Generator\": {\"Type\": \"Univariate/Normal\", \"Mean\": 0.0, \"Standard Deviation\": 1.0}, \"Beta1\": 0.9, \"Beta2\": 0.999, \"Eta\": 0.001, \"Epsilon\": 1e-08, \"Termination Criteria\": {\"Min Gradient Norm\": 1e-12, \"Max Gradient Norm\": 1000000000000.0}}";
  knlohmann::json defaultJs = knlohmann::json::parse(defaultString);
  mergeJson(js, defaultJs); 
  Optimizer::applyModuleDefaults(js);
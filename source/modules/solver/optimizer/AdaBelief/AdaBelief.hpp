@@ -13,6 +13,7 @@
 #pragma once
 
 #include "modules/solver/optimizer/optimizer.hpp"
+#include <vector>
 
 namespace korali
 {
@@ -27,6 +28,63 @@ namespace optimizer
 */
 class AdaBelief : public Optimizer
 {
+  private:
+  /**
+   * @brief State of one of the independent starts, exchanged with the loaded state while the start is advanced
+   */
+  struct startState_t
+  {
+    /**
+     * @brief Current value of parameters.
+     */
+    std::vector<double> currentVariable;
+
+    /**
+     * @brief Gradient of function with respect to parameters.
+     */
+    std::vector<double> gradient;
+
+    /**
+     * @brief Norm of gradient of function with respect to parameters.
+     */
+    double gradientNorm = 1.0;
+
+    /**
+     * @brief Estimate of first moment of gradient.
+     */
+    std::vector<double> firstMoment;
+
+    /**
+     * @brief Bias corrected estimate of first moment of gradient.
+     */
+    std::vector<double> biasCorrectedFirstMoment;
+
+    /**
+     * @brief Estimate of second central moment of gradient.
+     */
+    std::vector<double> secondCentralMoment;
+
+    /**
+     * @brief Bias corrected estimate of second central moment of gradient.
+     */
+    std::vector<double> biasCorrectedSecondCentralMoment;
+
+    /**
+     * @brief Value of the last evaluation.
+     */
+    double currentBestValue = -Inf;
+
+    /**
+     * @brief Value of the previous evaluation.
+     */
+    double previousBestValue = -Inf;
+  };
+
+  /**
+   * @brief States of the starts (only used if there are several starts)
+   */
+  std::vector<startState_t> _startStates;
+
   public: 
   /**
   * @brief Smoothing factor for momentum update.
@@ -45,6 +103,14 @@ class AdaBelief : public Optimizer
   */
    double _epsilon;
   /**
+  * @brief [Internal Use] Uniform random number generator, for the starting points.
+  */
+   korali::distribution::univariate::Uniform* _uniformGenerator;
+  /**
+  * @brief [Internal Use] Normal random number generator, for the starting points.
+  */
+   korali::distribution::univariate::Normal* _normalGenerator;
+  /**
   * @brief [Internal Use] Current value of parameters.
   */
    std::vector<double> _currentVariable;
@@ -117,8 +183,13 @@ class AdaBelief : public Optimizer
    * @param evaluation The value of the objective function at the current set of parameters
    * @param gradient The gradient of the objective function at the current set of parameters
    */
-  void processResult(double evaluation, std::vector<double> &gradient);
+  void processStartEvaluation(const double evaluation, const std::vector<double> &gradient) override;
 
+  void resetStartState(const std::vector<double> &startingPoint) override;
+  void swapStartState(const size_t startId) override;
+  void getStartState(const size_t startId, knlohmann::json &js) const override;
+  void setStartState(const size_t startId, const knlohmann::json &js) override;
+  const std::vector<double> &updateStartParameters() override;
   void finalize() override;
   void setInitialConfiguration() override;
   void runGeneration() override;
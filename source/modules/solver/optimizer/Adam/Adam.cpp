@@ -18,52 +18,93 @@ void Adam::setInitialConfiguration()
     if (std::isfinite(_k->_variables[i]->_initialValue) == false)
       KORALI_LOG_ERROR("Initial Value of variable \'%s\' not defined (no defaults can be calculated).\n", _k->_variables[i]->_name.c_str());
 
-  _currentVariable.resize(_variableCount);
-  for (size_t i = 0; i < _variableCount; i++)
-    _currentVariable[i] = _k->_variables[i]->_initialValue;
-
-  _bestEverVariables = _currentVariable;
-  _gradient.resize(_variableCount);
   _bestEverGradient.resize(_variableCount, 0);
-  _squaredGradient.resize(_variableCount);
-  _firstMoment.resize(_variableCount, 0.0);
-  _biasCorrectedFirstMoment.resize(_variableCount, 0.0);
-  _secondMoment.resize(_variableCount, 0.0);
-  _biasCorrectedSecondMoment.resize(_variableCount, 0.0);
-
   _bestEverValue = -Inf;
-  _gradientNorm = 0.0;
+
+  _startStates.resize(_numberOfStarts);
+  initializeStarts(_uniformGenerator, _normalGenerator);
+  _bestEverVariables = _currentVariable;
 }
 
 void Adam::runGeneration()
 {
   if (_k->_currentGeneration == 1) setInitialConfiguration();
 
+  runMultiStartGeneration();
+}
+
+void Adam::resetStartState(const std::vector<double> &startingPoint)
+{
+  _currentVariable = startingPoint;
+  _gradient.assign(_variableCount, 0.0);
+  _squaredGradient.assign(_variableCount, 0.0);
+  _firstMoment.assign(_variableCount, 0.0);
+  _biasCorrectedFirstMoment.assign(_variableCount, 0.0);
+  _secondMoment.assign(_variableCount, 0.0);
+  _biasCorrectedSecondMoment.assign(_variableCount, 0.0);
+  _gradientNorm = 0.0;
+}
+
+void Adam::swapStartState(const size_t startId)
+{
+  auto &state = _startStates[startId];
+  std::swap(_currentVariable, state.currentVariable);
+  std::swap(_gradient, state.gradient);
+  std::swap(_squaredGradient, state.squaredGradient);
+  std::swap(_gradientNorm, state.gradientNorm);
+  std::swap(_firstMoment, state.firstMoment);
+  std::swap(_biasCorrectedFirstMoment, state.biasCorrectedFirstMoment);
+  std::swap(_secondMoment, state.secondMoment);
+  std::swap(_biasCorrectedSecondMoment, state.biasCorrectedSecondMoment);
+  std::swap(_currentBestValue, state.currentBestValue);
+  std::swap(_previousBestValue, state.previousBestValue);
+}
+
+void Adam::getStartState(const size_t startId, knlohmann::json &js) const
+{
+  const auto &state = _startStates[startId];
+  js["Current Variable"] = state.currentVariable;
+  js["Gradient"] = state.gradient;
+  js["Squared Gradient"] = state.squaredGradient;
+  js["Gradient Norm"] = state.gradientNorm;
+  js["First Moment"] = state.firstMoment;
+  js["Bias Corrected First Moment"] = state.biasCorrectedFirstMoment;
+  js["Second Moment"] = state.secondMoment;
+  js["Bias Corrected Second Moment"] = state.biasCorrectedSecondMoment;
+  js["Current Best Value"] = state.currentBestValue;
+  js["Previous Best Value"] = state.previousBestValue;
+}
+
+void Adam::setStartState(const size_t startId, const knlohmann::json &js)
+{
+  // When resuming, the states of the starts are rebuilt from the stored results
+  if (_startStates.size() != _numberOfStarts) _startStates.resize(_numberOfStarts);
+
+  auto &state = _startStates[startId];
+  state.currentVariable = js["Current Variable"].get<std::vector<double>>();
+  state.gradient = js["Gradient"].get<std::vector<double>>();
+  state.squaredGradient = js["Squared Gradient"].get<std::vector<double>>();
+  state.gradientNorm = js["Gradient Norm"].get<double>();
+  state.firstMoment = js["First Moment"].get<std::vector<double>>();
+  state.biasCorrectedFirstMoment = js["Bias Corrected First Moment"].get<std::vector<double>>();
+  state.secondMoment = js["Second Moment"].get<std::vector<double>>();
+  state.biasCorrectedSecondMoment = js["Bias Corrected Second Moment"].get<std::vector<double>>();
+  state.currentBestValue = js["Current Best Value"].get<double>();
+  state.previousBestValue = js["Previous Best Value"].get<double>();
+}
+
+const std::vector<double> &Adam::updateStartParameters()
+{
   // update parameters
   for (size_t i = 0; i < _variableCount; i++)
   {
     _currentVariable[i] += _eta / (std::sqrt(_biasCorrectedSecondMoment[i]) + _epsilon) * _biasCorrectedFirstMoment[i];
   }
 
-  // Initializing Sample Evaluation
-  Sample sample;
-  sample["Module"] = "Problem";
-  sample["Operation"] = "Evaluate With Gradients";
-  sample["Parameters"] = _currentVariable;
-  sample["Sample Id"] = 0;
-  KORALI_START(sample);
-
-  // Waiting for sample to finish
-  KORALI_WAIT(sample);
-
-  auto evaluation = KORALI_GET(double, sample, "F(x)");
-  auto gradient = KORALI_GET(std::vector<double>, sample, "Gradient");
-
-  // Processing results
-  processResult(evaluation, gradient);
+  return _currentVariable;
 }
 
-void Adam::processResult(double evaluation, std::vector<double> &gradient)
+void Adam::processStartEvaluation(const double evaluation, const std::vector<double> &gradient)
 {
   _modelEvaluationCount++;
   _previousBestValue = _currentBestValue;
@@ -87,13 +128,13 @@ void Adam::processResult(double evaluation, std::vector<double> &gradient)
     _bestEverVariables = _currentVariable;
   }
 
-  // update first and second moment estimators and bias corrected versions
+  // update first and second moment estimators and bias corrected versions (every start takes one step per generation)
   for (size_t i = 0; i < _variableCount; i++)
   {
     _firstMoment[i] = _beta1 * _firstMoment[i] + (1 - _beta1) * _gradient[i];
-    _biasCorrectedFirstMoment[i] = _firstMoment[i] / (1 - std::pow(_beta1, _modelEvaluationCount));
+    _biasCorrectedFirstMoment[i] = _firstMoment[i] / (1 - std::pow(_beta1, _k->_currentGeneration));
     _secondMoment[i] = _beta2 * _secondMoment[i] + (1 - _beta2) * _squaredGradient[i];
-    _biasCorrectedSecondMoment[i] = _secondMoment[i] / (1 - std::pow(_beta2, _modelEvaluationCount));
+    _biasCorrectedSecondMoment[i] = _secondMoment[i] / (1 - std::pow(_beta2, _k->_currentGeneration));
   }
 }
 
@@ -104,6 +145,8 @@ void Adam::printGenerationBefore()
 
 void Adam::printGenerationAfter()
 {
+  if (_numberOfStarts > 1) _k->_logger->logInfo("Normal", "Best Start: %zu/%zu\n", _currentStart + 1, _numberOfStarts);
+
   _k->_logger->logInfo("Normal", "x = [ ");
   for (size_t k = 0; k < _variableCount; k++) _k->_logger->logData("Normal", " %.5le  ", _currentVariable[k]);
   _k->_logger->logData("Normal", " ]\n");
@@ -129,6 +172,24 @@ void Adam::setConfiguration(knlohmann::json& js)
 {
  if (isDefined(js, "Results"))  eraseValue(js, "Results");
 
+ if (isDefined(js, "Uniform Generator"))
+ {
+ _uniformGenerator = dynamic_cast<korali::distribution::univariate::Uniform*>(korali::Module::getModule(js["Uniform Generator"], _k));
+ _uniformGenerator->applyVariableDefaults();
+ _uniformGenerator->applyModuleDefaults(js["Uniform Generator"]);
+ _uniformGenerator->setConfiguration(js["Uniform Generator"]);
+   eraseValue(js, "Uniform Generator");
+ }
+
+ if (isDefined(js, "Normal Generator"))
+ {
+ _normalGenerator = dynamic_cast<korali::distribution::univariate::Normal*>(korali::Module::getModule(js["Normal Generator"], _k));
+ _normalGenerator->applyVariableDefaults();
+ _normalGenerator->applyModuleDefaults(js["Normal Generator"]);
+ _normalGenerator->setConfiguration(js["Normal Generator"]);
+   eraseValue(js, "Normal Generator");
+ }
+
  if (isDefined(js, "Current Variable"))
  {
  try { _currentVariable = js["Current Variable"].get<std::vector<double>>();
@@ -274,6 +335,8 @@ void Adam::getConfiguration(knlohmann::json& js)
    js["Epsilon"] = _epsilon;
    js["Termination Criteria"]["Min Gradient Norm"] = _minGradientNorm;
    js["Termination Criteria"]["Max Gradient Norm"] = _maxGradientNorm;
+ if(_uniformGenerator != NULL) _uniformGenerator->getConfiguration(js["Uniform Generator"]);
+ if(_normalGenerator != NULL) _normalGenerator->getConfiguration(js["Normal Generator"]);
    js["Current Variable"] = _currentVariable;
    js["Gradient"] = _gradient;
    js["Best Ever Gradient"] = _bestEverGradient;
@@ -291,7 +354,7 @@ void Adam::getConfiguration(knlohmann::json& js)
 void Adam::applyModuleDefaults(knlohmann::json& js) 
 {
 
- std::string defaultString = "{\"Beta1\": 0.9, \"Beta2\": 0.999, \"Eta\": 0.001, \"Epsilon\": 1e-08, \"Termination Criteria\": {\"Min Gradient Norm\": 1e-12, \"Max Gradient Norm\": 1000000000000.0}}";
+ std::string defaultString = "{\"Uniform Generator\": {\"Type\": \"Univariate/Uniform\", \"Minimum\": 0.0, \"Maximum\": 1.0}, \"Normal Generator\": {\"Type\": \"Univariate/Normal\", \"Mean\": 0.0, \"Standard Deviation\": 1.0}, \"Beta1\": 0.9, \"Beta2\": 0.999, \"Eta\": 0.001, \"Epsilon\": 1e-08, \"Termination Criteria\": {\"Min Gradient Norm\": 1e-12, \"Max Gradient Norm\": 1000000000000.0}}";
  knlohmann::json defaultJs = knlohmann::json::parse(defaultString);
  mergeJson(js, defaultJs); 
  Optimizer::applyModuleDefaults(js);
@@ -3,8 +3,8 @@
 #include "sample/sample.hpp"
 
 #include <algorithm> // std::sort
+#include <Eigen/Dense>
 #include <chrono>
-#include <gsl/gsl_eigen.h>
 #include <numeric> // std::iota
 #include <stdio.h>
 #include <unistd.h>
@@ -30,6 +30,8 @@ void CMAES::setInitialConfiguration()
   _currentBestValue = _bestEverValue;
 
   if (_populationSize == 1) KORALI_LOG_ERROR("'Population Size' must be larger 1.");
+  if (_restartPopulationIncreaseFactor < 1.0) KORALI_LOG_ERROR("'Restart Population Increase Factor' must be at least 1.0 (is %f).\n", _restartPopulationIncreaseFactor);
+  if ((_asynchronousAgeDecay <= 0.0) || (_asynchronousAgeDecay > 1.0)) KORALI_LOG_ERROR("'Asynchronous Age Decay' must be in (0.0, 1.0] (is %f).\n", _asynchronousAgeDecay);
   if (_muValue == 0) _muValue = _populationSize / 2;
   if (_viabilityMuValue == 0) _viabilityMuValue = _viabilityPopulationSize / 2;
 
@@ -84,6 +86,8 @@ void CMAES::setInitialConfiguration()
 
   _sortingIndex.resize(s_max);
   _valueVector.resize(s_max);
+  _sampleGenerations.resize(s_max);
+  _candidateGenerations.resize(s_max);
 
   if (_useGradientInformation)
   {
@@ -98,10 +102,29 @@ void CMAES::setInitialConfiguration()
     if (_hasConstraints) KORALI_LOG_ERROR("Mirrored Sampling not applicable to problems with constraints");
   }
 
-  _covarianceMatrix.resize(_variableCount * _variableCount);
-  _auxiliarCovarianceMatrix.resize(_variableCount * _variableCount);
-  _covarianceEigenvectorMatrix.resize(_variableCount * _variableCount);
-  _auxiliarCovarianceEigenvectorMatrix.resize(_variableCount * _variableCount);
+  if (_evaluationMode == "Asynchronous")
+  {
+    if (_mirroredSampling) KORALI_LOG_ERROR("Mirrored Sampling not applicable to the Asynchronous Evaluation Mode");
+    if (_hasConstraints) KORALI_LOG_ERROR("Asynchronous Evaluation Mode not applicable to problems with constraints");
+  }
+
+  if (_surrogateModel != "None")
+  {
+    if (_evaluationMode == "Asynchronous") KORALI_LOG_ERROR("Surrogate Model not applicable to the Asynchronous Evaluation Mode");
+    if (_useGradientInformation) KORALI_LOG_ERROR("Surrogate Model not applicable with Use Gradient Information");
+    if ((_surrogateRankAgreementThreshold < -1.0) || (_surrogateRankAgreementThreshold > 1.0)) KORALI_LOG_ERROR("'Surrogate Rank Agreement Threshold' must be in [-1.0, 1.0] (is %f).\n", _surrogateRankAgreementThreshold);
+
+    // By default, the archive holds enough points to fit the full quadratic model twice over
+    if (_surrogateArchiveSize == 0) _surrogateArchiveSize = (_variableCount + 1) * (_variableCount + 2);
+    _surrogateArchiveVariables.clear();
+    _surrogateArchiveValues.clear();
+    _surrogateCenter.resize(_variableCount);
+    _surrogateScaling.resize(_variableCount);
+    _surrogateCoefficients.clear();
+    _surrogateEvaluatedSampleCount = 0;
+    _surrogateRankAgreement = 0.0;
+  }
+
   _bDZMatrix.resize(s_max * _variableCount);
 
   _maskingMatrix.resize(_variableCount);
@@ -193,7 +216,31 @@ void CMAES::setInitialConfiguration()
 
 void CMAES::runGeneration()
 {
-  if (_k->_currentGeneration == 1) setInitialConfiguration();
+  if (_k->_currentGeneration == 1)
+  {
+    setInitialConfiguration();
+
+    // The population sizes of the restarts are derived from the first run
+    _defaultPopulationSize = _populationSize;
+    _defaultMuValue = _muValue;
+    _largePopulationSize = _populationSize;
+    _isSmallPopulationRegime = false;
+    _restartCount = 0;
+    _runStartGeneration = 0;
+    _runStartModelEvaluationCount = _modelEvaluationCount;
+    _largeRegimeModelEvaluationCount = 0;
+    _smallRegimeModelEvaluationCount = 0;
+  }
+
+  // The samples in flight when the state was saved are lost in a resumed run
+  if (_asynchronousSamples.empty() && _asynchronousParameters.empty() == false) resumeAsynchronousSamples();
+
+  // Once the population has been evaluated, the asynchronous mode updates the distribution as soon as a quorum of results arrives
+  if (_asynchronousSamples.empty() == false)
+  {
+    runAsynchronousGeneration();
+    return;
+  }
 
   if (_hasConstraints) checkMeanAndSetRegime();
   prepareGeneration();
@@ -203,6 +250,34 @@ void CMAES::runGeneration()
     handleConstraints();
   }
 
+  // Evaluating the population, or only its most promising candidates if the surrogate ranks them reliably
+  if (_surrogateModel == "None")
+  {
+    std::vector<size_t> sampleIdxs(_currentPopulationSize);
+    std::iota(std::begin(sampleIdxs), std::end(sampleIdxs), 0);
+    evaluateSamples(sampleIdxs);
+  }
+  else
+    evaluateWithSurrogate();
+
+  // All samples come from the current distribution
+  for (size_t i = 0; i < _currentPopulationSize; i++) _sampleGenerations[i] = _k->_currentGeneration - 1;
+
+  updateDistribution();
+
+  // Restarting within the experiment keeps the conduit and its workers busy, under the same evaluation budget
+  if (_restartStrategy != "None" && isRunTerminated())
+    restart();
+  else if (_evaluationMode == "Asynchronous")
+  {
+    _asynchronousSamples.resize(_currentPopulationSize);
+    _asynchronousParameters.assign(_currentPopulationSize, std::vector<double>());
+    for (size_t i = 0; i < _currentPopulationSize; i++) startAsynchronousSample(i);
+  }
+}
+
+void CMAES::evaluateSamples(const std::vector<size_t> &sampleIdxs)
+{
   std::string operation;
   if (_useGradientInformation)
     operation = "Evaluate With Gradients";
@@ -210,15 +285,16 @@ void CMAES::runGeneration()
     operation = "Evaluate";
 
   // Initializing Sample Evaluation
-  std::vector<Sample> samples(_currentPopulationSize);
-  for (size_t i = 0; i < _currentPopulationSize; i++)
+  std::vector<Sample> samples(sampleIdxs.size());
+  for (size_t i = 0; i < sampleIdxs.size(); i++)
   {
-    if (_hasDiscreteVariables) discretize(_samplePopulation[i]);
+    const size_t sampleIdx = sampleIdxs[i];
+    if (_hasDiscreteVariables) discretize(_samplePopulation[sampleIdx]);
 
     samples[i]["Module"] = "Problem";
     samples[i]["Operation"] = operation;
-    samples[i]["Parameters"] = _samplePopulation[i];
-    samples[i]["Sample Id"] = i;
+    samples[i]["Parameters"] = _samplePopulation[sampleIdx];
+    samples[i]["Sample Id"] = sampleIdx;
     _modelEvaluationCount++;
 
     KORALI_START(samples[i]);
@@ -228,14 +304,421 @@ void CMAES::runGeneration()
   KORALI_WAITALL(samples);
 
   // Gathering evaluations
-  for (size_t i = 0; i < _currentPopulationSize; i++)
-    _valueVector[i] = KORALI_GET(double, samples[i], "F(x)");
+  for (size_t i = 0; i < sampleIdxs.size(); i++)
+    _valueVector[sampleIdxs[i]] = KORALI_GET(double, samples[i], "F(x)");
 
   if (_useGradientInformation)
-    for (size_t i = 0; i < _currentPopulationSize; i++)
-      _gradients[i] = KORALI_GET(std::vector<double>, samples[i], "Gradient");
+    for (size_t i = 0; i < sampleIdxs.size(); i++)
+      _gradients[sampleIdxs[i]] = KORALI_GET(std::vector<double>, samples[i], "Gradient");
+
+  // Archiving the evaluations for the surrogate, dropping the oldest ones
+  if (_surrogateModel != "None")
+  {
+    for (size_t sampleIdx : sampleIdxs)
+    {
+      _surrogateArchiveVariables.push_back(_samplePopulation[sampleIdx]);
+      _surrogateArchiveValues.push_back(_valueVector[sampleIdx]);
+    }
+
+    if (_surrogateArchiveValues.size() > _surrogateArchiveSize)
+    {
+      const size_t dropCount = _surrogateArchiveValues.size() - _surrogateArchiveSize;
+      _surrogateArchiveVariables.erase(_surrogateArchiveVariables.begin(), _surrogateArchiveVariables.begin() + dropCount);
+      _surrogateArchiveValues.erase(_surrogateArchiveValues.begin(), _surrogateArchiveValues.begin() + dropCount);
+    }
+  }
+}
+
+void CMAES::evaluateWithSurrogate()
+{
+  std::vector<size_t> pendingIdxs(_currentPopulationSize);
+  std::iota(std::begin(pendingIdxs), std::end(pendingIdxs), 0);
+
+  std::vector<double> predictions(_currentPopulationSize);
+  size_t batchSize = std::max((size_t)1, _currentPopulationSize / 10);
+  _surrogateEvaluatedSampleCount = 0;
+  _surrogateRankAgreement = 0.0;
+
+  // Evaluating increasing batches of the candidates ranked best by the surrogate, until its ranking agrees with the evaluations
+  bool isFitted = fitSurrogate();
+  while (pendingIdxs.empty() == false)
+  {
+    if (isFitted == false)
+    {
+      evaluateSamples(pendingIdxs);
+      _surrogateEvaluatedSampleCount += pendingIdxs.size();
+      pendingIdxs.clear();
+      break;
+    }
+
+    for (size_t i : pendingIdxs) predictions[i] = predictSurrogate(_samplePopulation[i]);
+    std::sort(std::begin(pendingIdxs), std::end(pendingIdxs), [&](size_t a, size_t b) { return predictions[a] > predictions[b]; });
+
+    const size_t batchCount = std::min(batchSize, pendingIdxs.size());
+    std::vector<size_t> batchIdxs(pendingIdxs.begin(), pendingIdxs.begin() + batchCount);
+    evaluateSamples(batchIdxs);
+    pendingIdxs.erase(pendingIdxs.begin(), pendingIdxs.begin() + batchCount);
+    _surrogateEvaluatedSampleCount += batchCount;
+    batchSize *= 2;
+
+    if (pendingIdxs.empty()) break;
+
+    isFitted = fitSurrogate();
+    if (isFitted)
+    {
+      // Comparing the refitted surrogate with the most recent evaluations
+      const size_t archiveSize = _surrogateArchiveValues.size();
+      const size_t testCount = std::min(archiveSize, std::max((size_t)15, std::min((size_t)std::ceil(1.2 * _surrogateEvaluatedSampleCount), (size_t)std::floor(0.75 * _currentPopulationSize))));
+
+      std::vector<double> testPredictions(testCount);
+      std::vector<double> testValues(testCount);
+      for (size_t i = 0; i < testCount; i++)
+      {
+        testPredictions[i] = predictSurrogate(_surrogateArchiveVariables[archiveSize - testCount + i]);
+        testValues[i] = _surrogateArchiveValues[archiveSize - testCount + i];
+      }
+
+      _surrogateRankAgreement = getKendallTau(testPredictions, testValues);
+      if (_surrogateRankAgreement >= _surrogateRankAgreementThreshold) break;
+    }
+  }
+
+  if (pendingIdxs.empty()) return;
+
+  // The remaining candidates take the surrogate values, shifted below the evaluated ones to keep the surrogate ranking
+  double minEvaluatedValue = Inf;
+  for (size_t i = 0; i < _currentPopulationSize; i++)
+    if (std::find(pendingIdxs.begin(), pendingIdxs.end(), i) == pendingIdxs.end()) minEvaluatedValue = std::min(minEvaluatedValue, _valueVector[i]);
+
+  double maxPrediction = -Inf;
+  for (size_t i : pendingIdxs)
+  {
+    predictions[i] = predictSurrogate(_samplePopulation[i]);
+    maxPrediction = std::max(maxPrediction, predictions[i]);
+  }
+
+  for (size_t i : pendingIdxs)
+    _valueVector[i] = maxPrediction < minEvaluatedValue ? predictions[i] : std::nextafter(minEvaluatedValue, -Inf) - (maxPrediction - predictions[i]);
+}
+
+bool CMAES::fitSurrogate()
+{
+  const size_t archiveSize = _surrogateArchiveValues.size();
+
+  // Choosing the richest model that the archive supports
+  const size_t linearTermCount = _variableCount + 1;
+  const size_t diagonalTermCount = 2 * _variableCount + 1;
+  const size_t fullTermCount = (_variableCount + 1) * (_variableCount + 2) / 2;
+
+  size_t termCount;
+  if (archiveSize >= std::ceil(1.1 * fullTermCount))
+  {
+    _surrogateModelTerms = "Full Quadratic";
+    termCount = fullTermCount;
+  }
+  else if (archiveSize >= std::ceil(1.1 * diagonalTermCount))
+  {
+    _surrogateModelTerms = "Diagonal Quadratic";
+    termCount = diagonalTermCount;
+  }
+  else if (archiveSize >= std::ceil(1.1 * linearTermCount))
+  {
+    _surrogateModelTerms = "Linear";
+    termCount = linearTermCount;
+  }
+  else
+    return false;
+
+  // The model is local to the current distribution, in its coordinates
+  for (size_t d = 0; d < _variableCount; ++d)
+  {
+    _surrogateCenter[d] = _currentMean[d];
+    _surrogateScaling[d] = _sigma * std::sqrt(getCovarianceDiagonal(d));
+  }
+
+  // Selecting the archived points nearest to the mean
+  std::vector<double> distances(archiveSize, 0.0);
+  for (size_t j = 0; j < archiveSize; j++)
+    for (size_t d = 0; d < _variableCount; ++d)
+    {
+      const double u = (_surrogateArchiveVariables[j][d] - _surrogateCenter[d]) / _surrogateScaling[d];
+      distances[j] += u * u;
+    }
+
+  const size_t trainingCount = std::min(archiveSize, (size_t)std::ceil(1.5 * termCount));
+  std::vector<size_t> trainingIdxs(archiveSize);
+  std::iota(std::begin(trainingIdxs), std::end(trainingIdxs), 0);
+  std::nth_element(trainingIdxs.begin(), trainingIdxs.begin() + (trainingCount - 1), trainingIdxs.end(), [&](size_t a, size_t b) { return distances[a] < distances[b]; });
+
+  // Least squares fit of the model coefficients
+  Eigen::MatrixXd features(trainingCount, termCount);
+  Eigen::VectorXd values(trainingCount);
+  std::vector<double> rowFeatures;
+  for (size_t j = 0; j < trainingCount; j++)
+  {
+    getSurrogateFeatures(_surrogateArchiveVariables[trainingIdxs[j]], rowFeatures);
+    for (size_t t = 0; t < termCount; t++) features(j, t) = rowFeatures[t];
+    values(j) = _surrogateArchiveValues[trainingIdxs[j]];
+  }
+
+  const Eigen::VectorXd coefficients = features.colPivHouseholderQr().solve(values);
+  _surrogateCoefficients.assign(coefficients.data(), coefficients.data() + termCount);
+
+  return true;
+}
+
+void CMAES::getSurrogateFeatures(const std::vector<double> &x, std::vector<double> &features) const
+{
+  std::vector<double> u(_variableCount);
+  for (size_t d = 0; d < _variableCount; ++d) u[d] = (x[d] - _surrogateCenter[d]) / _surrogateScaling[d];
+
+  features.clear();
+  features.push_back(1.0);
+  features.insert(features.end(), u.begin(), u.end());
+
+  if (_surrogateModelTerms == "Diagonal Quadratic")
+    for (size_t d = 0; d < _variableCount; ++d) features.push_back(u[d] * u[d]);
+
+  if (_surrogateModelTerms == "Full Quadratic")
+    for (size_t d = 0; d < _variableCount; ++d)
+      for (size_t e = d; e < _variableCount; ++e) features.push_back(u[d] * u[e]);
+}
+
+double CMAES::predictSurrogate(const std::vector<double> &x) const
+{
+  std::vector<double> features;
+  getSurrogateFeatures(x, features);
+
+  double prediction = 0.0;
+  for (size_t t = 0; t < features.size(); t++) prediction += _surrogateCoefficients[t] * features[t];
+  return prediction;
+}
+
+double CMAES::getKendallTau(const std::vector<double> &a, const std::vector<double> &b)
+{
+  const size_t n = a.size();
+  if (n < 2) return 0.0;
+
+  double agreement = 0.0;
+  for (size_t i = 0; i < n; i++)
+    for (size_t j = i + 1; j < n; j++)
+    {
+      const double product = (a[i] - a[j]) * (b[i] - b[j]);
+      if (product > 0.0) agreement += 1.0;
+      if (product < 0.0) agreement -= 1.0;
+    }
+
+  return agreement / (0.5 * n * (n - 1));
+}
+
+void CMAES::runAsynchronousGeneration()
+{
+  size_t inFlightCount = 0;
+  for (size_t i = 0; i < _asynchronousSamples.size(); i++)
+    if (_asynchronousSamples[i]._state != SampleState::uninitialized) inFlightCount++;
+
+  const size_t quorum = std::min(_asynchronousQuorum == 0 ? _currentMuValue : _asynchronousQuorum, inFlightCount);
+
+  // Replacing the samples of the population with the new results, as they arrive
+  std::vector<size_t> finishedSampleIdxs;
+  for (size_t j = 0; j < quorum; j++)
+  {
+    const size_t i = KORALI_WAITANY(_asynchronousSamples);
+    _asynchronousParameters[i].clear();
+
+    _samplePopulation[i] = KORALI_GET(std::vector<double>, _asynchronousSamples[i], "Parameters");
+    _valueVector[i] = KORALI_GET(double, _asynchronousSamples[i], "F(x)");
+    if (_useGradientInformation) _gradients[i] = KORALI_GET(std::vector<double>, _asynchronousSamples[i], "Gradient");
+    _sampleGenerations[i] = _candidateGenerations[i];
+
+    finishedSampleIdxs.push_back(i);
+  }
+
+  // Nothing left in flight (the evaluation budget is exhausted)
+  if (finishedSampleIdxs.empty()) return;
+
+  // The population mixes samples of different distributions, their steps are taken from the current mean
+  for (size_t i = 0; i < _currentPopulationSize; i++)
+    for (size_t d = 0; d < _variableCount; ++d)
+      _bDZMatrix[i * _variableCount + d] = (_samplePopulation[i][d] - _currentMean[d]) / _sigma;
+
+  // Restoring the recombination weights, before they are weighted by the age of the samples
+  initMuWeights(_currentMuValue);
 
   updateDistribution();
+
+  // The best value of the generation is taken from the new results only, older ones were already accounted for
+  _currentBestValue = -std::numeric_limits<double>::infinity();
+  for (size_t i : finishedSampleIdxs)
+    if (_valueVector[i] > _currentBestValue)
+    {
+      _currentBestValue = _valueVector[i];
+      _currentBestVariables = _samplePopulation[i];
+    }
+
+  if (_restartStrategy != "None" && isRunTerminated())
+    restart();
+  else
+    for (size_t i : finishedSampleIdxs)
+      if (_modelEvaluationCount < _maxModelEvaluations) startAsynchronousSample(i);
+}
+
+void CMAES::startAsynchronousSample(size_t sampleIdx)
+{
+  updateEigensystemIfOutdated();
+
+  // The population keeps the last evaluated sample of this slot, the candidate only lives in the sample sent for evaluation
+  const auto evaluatedSample = _samplePopulation[sampleIdx];
+
+  std::vector<double> rands(_variableCount);
+  do
+  {
+    for (size_t d = 0; d < _variableCount; ++d) rands[d] = _normalGenerator->getRandomNumber();
+    sampleSingle(sampleIdx, rands);
+
+    if (_hasDiscreteVariables) discretize(_samplePopulation[sampleIdx]);
+  } while (isSampleFeasible(_samplePopulation[sampleIdx]) == false);
+
+  auto &sample = _asynchronousSamples[sampleIdx];
+  sample._js.getJson() = knlohmann::json();
+  sample._buffers.clear();
+
+  sample["Module"] = "Problem";
+  sample["Operation"] = _useGradientInformation ? "Evaluate With Gradients" : "Evaluate";
+  sample["Parameters"] = _samplePopulation[sampleIdx];
+  sample["Sample Id"] = sampleIdx;
+
+  _asynchronousParameters[sampleIdx] = _samplePopulation[sampleIdx];
+  _samplePopulation[sampleIdx] = evaluatedSample;
+  _candidateGenerations[sampleIdx] = _k->_currentGeneration;
+  _modelEvaluationCount++;
+
+  KORALI_START(sample);
+}
+
+void CMAES::finishAsynchronousSamples()
+{
+  std::vector<size_t> inFlightSampleIdxs;
+  for (size_t i = 0; i < _asynchronousSamples.size(); i++)
+    if (_asynchronousSamples[i]._state != SampleState::uninitialized) inFlightSampleIdxs.push_back(i);
+
+  KORALI_WAITALL(_asynchronousSamples);
+
+  // The remaining results do not update the distribution anymore, but may still improve the best ever sample
+  for (size_t i : inFlightSampleIdxs)
+  {
+    const auto value = KORALI_GET(double, _asynchronousSamples[i], "F(x)");
+    if (value > _bestEverValue)
+    {
+      _bestEverValue = value;
+      _bestEverVariables = KORALI_GET(std::vector<double>, _asynchronousSamples[i], "Parameters");
+    }
+  }
+
+  _asynchronousSamples.clear();
+  _asynchronousParameters.clear();
+}
+
+void CMAES::resumeAsynchronousSamples()
+{
+  _asynchronousSamples.resize(_asynchronousParameters.size());
+
+  // Their evaluations were already counted when they were first started
+  for (size_t i = 0; i < _asynchronousParameters.size(); i++)
+    if (_asynchronousParameters[i].empty() == false)
+    {
+      auto &sample = _asynchronousSamples[i];
+      sample["Module"] = "Problem";
+      sample["Operation"] = _useGradientInformation ? "Evaluate With Gradients" : "Evaluate";
+      sample["Parameters"] = _asynchronousParameters[i];
+      sample["Sample Id"] = i;
+
+      KORALI_START(sample);
+    }
+}
+
+bool CMAES::isRunTerminated() const
+{
+  if (_k->_currentGeneration <= _runStartGeneration + 1) return false;
+
+  // Global criteria end the experiment, there is no point in restarting
+  if (_restartCount >= _maxRestarts) return false;
+  if (_modelEvaluationCount >= _maxModelEvaluations) return false;
+  if (_bestEverValue > _maxValue) return false;
+
+  if (_maximumCovarianceEigenvalue >= _maxConditionCovarianceMatrix * _minimumCovarianceEigenvalue) return true;
+  if (_currentMinStandardDeviation <= _minStandardDeviation) return true;
+  if (_currentMaxStandardDeviation >= _maxStandardDeviation) return true;
+  if (fabs(_currentBestValue - _previousBestValue) < _minValueDifferenceThreshold) return true;
+
+  return false;
+}
+
+void CMAES::restart()
+{
+  if (_asynchronousSamples.empty() == false) finishAsynchronousSamples();
+
+  const size_t runModelEvaluationCount = _modelEvaluationCount - _runStartModelEvaluationCount;
+  if (_isSmallPopulationRegime)
+    _smallRegimeModelEvaluationCount += runModelEvaluationCount;
+  else
+    _largeRegimeModelEvaluationCount += runModelEvaluationCount;
+
+  // BIPOP runs in the small population regime while it has spent less evaluations than the large one (Hansen, 2009)
+  double sigmaScale = 1.0;
+  if (_restartStrategy == "BIPOP" && _smallRegimeModelEvaluationCount < _largeRegimeModelEvaluationCount)
+  {
+    _isSmallPopulationRegime = true;
+    const double u = _uniformGenerator->getRandomNumber();
+    _populationSize = std::floor(_defaultPopulationSize * std::pow(0.5 * _largePopulationSize / _defaultPopulationSize, u * u));
+    sigmaScale = std::pow(10.0, -2.0 * _uniformGenerator->getRandomNumber());
+  }
+  else
+  {
+    _isSmallPopulationRegime = false;
+    _largePopulationSize = std::ceil(_largePopulationSize * _restartPopulationIncreaseFactor);
+    _populationSize = _largePopulationSize;
+  }
+
+  _populationSize = std::max(_populationSize, (size_t)2);
+  if (_mirroredSampling && _populationSize % 2 == 1) _populationSize++;
+  _muValue = std::max((size_t)1, (size_t)std::round((double)_defaultMuValue * _populationSize / _defaultPopulationSize));
+
+  _restartCount++;
+  _runStartGeneration = _k->_currentGeneration;
+  _runStartModelEvaluationCount = _modelEvaluationCount;
+
+  _k->_logger->logInfo("Normal", "Restart %zu (%s regime): Population Size = %zu, Mu Value = %zu\n", _restartCount, _isSmallPopulationRegime ? "small population" : "large population", _populationSize, _muValue);
+
+  // Re-initializing the distribution, keeping the best ever sample, the surrogate archive, and the global counters
+  const double bestEverValue = _bestEverValue;
+  const auto bestEverVariables = _bestEverVariables;
+  const auto bestConstraintEvaluations = _bestConstraintEvaluations;
+  const size_t infeasibleSampleCount = _infeasibleSampleCount;
+  auto surrogateArchiveVariables = std::move(_surrogateArchiveVariables);
+  auto surrogateArchiveValues = std::move(_surrogateArchiveValues);
+
+  setInitialConfiguration();
+
+  _bestEverValue = _previousBestEverValue = bestEverValue;
+  _bestEverVariables = bestEverVariables;
+  _bestConstraintEvaluations = bestConstraintEvaluations;
+  _infeasibleSampleCount = infeasibleSampleCount;
+  _surrogateArchiveVariables = std::move(surrogateArchiveVariables);
+  _surrogateArchiveValues = std::move(surrogateArchiveValues);
+
+  std::fill(std::begin(_evolutionPath), std::end(_evolutionPath), 0.0);
+  std::fill(std::begin(_conjugateEvolutionPath), std::end(_conjugateEvolutionPath), 0.0);
+  _sigma *= sigmaScale;
+
+  // Drawing the new initial mean uniformly within the bounds, where they are finite
+  for (size_t d = 0; d < _variableCount; ++d)
+  {
+    const double lowerBound = _k->_variables[d]->_lowerBound;
+    const double upperBound = _k->_variables[d]->_upperBound;
+    if (std::isfinite(lowerBound) && std::isfinite(upperBound))
+      _currentMean[d] = _previousMean[d] = lowerBound + _uniformGenerator->getRandomNumber() * (upperBound - lowerBound);
+  }
 }
 
 void CMAES::initMuWeights(size_t numsamplesmu)
@@ -289,6 +772,14 @@ void CMAES::initMuWeights(size_t numsamplesmu)
   _dampFactor = _initialDampFactor;
   if (_dampFactor <= 0.0)
     _dampFactor = (1.0 + 2 * std::max(0.0, sqrt((_effectiveMu - 1.0) / (_variableCount + 1.0)) - 1)) + _sigmaCumulationFactor;
+
+  // Setting the eigensystem update frequency: the covariance matrix changes slowly, so its decomposition is only refreshed every 1/(c1+cmu)/n/10 generations (Hansen, The CMA Evolution Strategy: A Tutorial)
+  const double ccov1 = 2.0 / (std::pow(_variableCount + 1.3, 2) + _effectiveMu);
+  const double ccovmu = std::min(1.0 - ccov1, 2.0 * (_effectiveMu - 2. + 1. / _effectiveMu) / (std::pow(_variableCount + 2.0, 2) + _effectiveMu));
+  _covarianceEigenvalueEvaluationFrequency = std::max(1.0, std::floor(1.0 / ((ccov1 + ccovmu) * _variableCount * 10.0)));
+
+  // Constraint handling samples from a corrected eigensystem, which must be recomputed from the covariance matrix every generation
+  if (_hasConstraints || _diagonalCovariance) _covarianceEigenvalueEvaluationFrequency = 1;
 }
 
 void CMAES::initCovariance()
@@ -298,6 +789,11 @@ void CMAES::initCovariance()
   for (size_t i = 0; i < _variableCount; ++i) _trace += _k->_variables[i]->_initialStandardDeviation * _k->_variables[i]->_initialStandardDeviation;
   _sigma = sqrt(_trace / _variableCount);
 
+  _covarianceMatrix.assign(_variableCount * _variableCount, 0.0);
+  _auxiliarCovarianceMatrix.assign(_variableCount * _variableCount, 0.0);
+  _covarianceEigenvectorMatrix.assign(_variableCount * _variableCount, 0.0);
+  _auxiliarCovarianceEigenvectorMatrix.assign(_variableCount * _variableCount, 0.0);
+
   // Setting B, C and _axisD
   for (size_t i = 0; i < _variableCount; ++i)
   {
@@ -312,6 +808,8 @@ void CMAES::initCovariance()
   _minimumCovarianceEigenvalue = _minimumCovarianceEigenvalue * _minimumCovarianceEigenvalue;
   _maximumCovarianceEigenvalue = _maximumCovarianceEigenvalue * _maximumCovarianceEigenvalue;
 
+  _isEigensystemUpdated = true;
+
   _maximumDiagonalCovarianceMatrixElement = _covarianceMatrix[0];
   for (size_t i = 1; i < _variableCount; ++i)
     if (_maximumDiagonalCovarianceMatrixElement < _covarianceMatrix[i * _variableCount + i]) _maximumDiagonalCovarianceMatrixElement = _covarianceMatrix[i * _variableCount + i];
@@ -352,29 +850,42 @@ void CMAES::checkMeanAndSetRegime()
   initCovariance();
 }
 
-void CMAES::updateConstraints()
+void CMAES::evaluateConstraints(const std::vector<size_t> &sampleIdxs)
 {
-  for (size_t i = 0; i < _currentPopulationSize; i++)
+  // Dispatching all constraint evaluations before waiting, so that they run concurrently on the workers
+  std::vector<Sample> samples(sampleIdxs.size());
+  for (size_t j = 0; j < sampleIdxs.size(); j++)
   {
-    _sampleConstraintViolationCounts[i] = 0;
-
+    const size_t i = sampleIdxs[j];
     if (_hasDiscreteVariables) discretize(_samplePopulation[i]);
 
-    Sample sample;
-    sample["Sample Id"] = 0;
-    sample["Parameters"] = _samplePopulation[i];
-    sample["Module"] = "Problem";
-    sample["Operation"] = "Evaluate Constraints";
-
-    KORALI_START(sample);
-    KORALI_WAIT(sample);
+    samples[j]["Sample Id"] = i;
+    samples[j]["Parameters"] = _samplePopulation[i];
+    samples[j]["Module"] = "Problem";
+    samples[j]["Operation"] = "Evaluate Constraints";
     _constraintEvaluationCount++;
 
-    const auto cEvals = KORALI_GET(std::vector<double>, sample, "Constraint Evaluations");
+    KORALI_START(samples[j]);
+  }
+
+  KORALI_WAITALL(samples);
+
+  for (size_t j = 0; j < sampleIdxs.size(); j++)
+  {
+    const auto cEvals = KORALI_GET(std::vector<double>, samples[j], "Constraint Evaluations");
 
     for (size_t c = 0; c < _constraintEvaluations.size(); c++)
-      _constraintEvaluations[c][i] = cEvals[c];
+      _constraintEvaluations[c][sampleIdxs[j]] = cEvals[c];
   }
+}
+
+void CMAES::updateConstraints()
+{
+  std::vector<size_t> sampleIdxs(_currentPopulationSize);
+  std::iota(std::begin(sampleIdxs), std::end(sampleIdxs), 0);
+  evaluateConstraints(sampleIdxs);
+
+  for (size_t i = 0; i < _currentPopulationSize; i++) _sampleConstraintViolationCounts[i] = 0;
 
   _maxConstraintViolationCount = 0;
 
@@ -396,39 +907,29 @@ void CMAES::reEvaluateConstraints()
 {
   _maxConstraintViolationCount = 0;
 
+  // Only the resampled (previously violating) samples need to be evaluated again
+  std::vector<size_t> sampleIdxs;
   for (size_t i = 0; i < _currentPopulationSize; ++i)
-    if (_sampleConstraintViolationCounts[i] > 0)
-    {
-      if (_hasDiscreteVariables) discretize(_samplePopulation[i]);
-
-      Sample sample;
-      sample["Sample Id"] = 0;
-      sample["Parameters"] = _samplePopulation[i];
-      sample["Module"] = "Problem";
-      sample["Operation"] = "Evaluate Constraints";
-
-      KORALI_START(sample);
-      KORALI_WAIT(sample);
-      _constraintEvaluationCount++;
+    if (_sampleConstraintViolationCounts[i] > 0) sampleIdxs.push_back(i);
 
-      _sampleConstraintViolationCounts[i] = 0;
+  evaluateConstraints(sampleIdxs);
 
-      const auto cEvals = KORALI_GET(std::vector<double>, sample, "Constraint Evaluations");
+  for (size_t i : sampleIdxs)
+  {
+    _sampleConstraintViolationCounts[i] = 0;
 
-      for (size_t c = 0; c < _constraintEvaluations.size(); c++)
+    for (size_t c = 0; c < _constraintEvaluations.size(); c++)
+    {
+      if (_constraintEvaluations[c][i] > _viabilityBoundaries[c] + 1e-12)
       {
-        _constraintEvaluations[c][i] = cEvals[c];
-
-        if (_constraintEvaluations[c][i] > _viabilityBoundaries[c] + 1e-12)
-        {
-          _viabilityIndicator[c][i] = true;
-          _sampleConstraintViolationCounts[i]++;
-        }
-        else
-          _viabilityIndicator[c][i] = false;
+        _viabilityIndicator[c][i] = true;
+        _sampleConstraintViolationCounts[i]++;
       }
-      if (_sampleConstraintViolationCounts[i] > _maxConstraintViolationCount) _maxConstraintViolationCount = _sampleConstraintViolationCounts[i];
+      else
+        _viabilityIndicator[c][i] = false;
     }
+    if (_sampleConstraintViolationCounts[i] > _maxConstraintViolationCount) _maxConstraintViolationCount = _sampleConstraintViolationCounts[i];
+  }
 }
 
 void CMAES::updateViabilityBoundaries()
@@ -444,28 +945,51 @@ void CMAES::updateViabilityBoundaries()
   }
 }
 
+void CMAES::updateEigensystemIfOutdated()
+{
+  // Lazy update of the eigensystem (states saved by older versions have no update frequency)
+  const size_t eigensystemFrequency = std::max(_covarianceEigenvalueEvaluationFrequency, (size_t)1);
+  if (_isEigensystemUpdated == false && _k->_currentGeneration % eigensystemFrequency == 0) updateEigensystem(_covarianceMatrix);
+}
+
 void CMAES::prepareGeneration()
 {
-  updateEigensystem(_covarianceMatrix);
+  updateEigensystemIfOutdated();
+
+  // Drawing the whole population at once
+  std::vector<double> rands(_currentPopulationSize * _variableCount);
+  for (size_t i = 0; i < _currentPopulationSize; ++i)
+    for (size_t d = 0; d < _variableCount; ++d)
+      if (_mirroredSampling && i % 2 == 1)
+        rands[i * _variableCount + d] = -rands[(i - 1) * _variableCount + d];
+      else
+        rands[i * _variableCount + d] = _normalGenerator->getRandomNumber();
+
+  sampleBatch(rands);
 
+  if (_hasDiscreteVariables)
+    for (size_t i = 0; i < _currentPopulationSize; ++i) discretize(_samplePopulation[i]);
+
+  // Resampling the infeasible samples one by one
   if (_mirroredSampling == false)
     for (size_t i = 0; i < _currentPopulationSize; ++i)
     {
-      do
+      while (isSampleFeasible(_samplePopulation[i]) == false)
       {
         std::vector<double> rands(_variableCount);
         for (size_t d = 0; d < _variableCount; ++d) rands[d] = _normalGenerator->getRandomNumber();
         sampleSingle(i, rands);
 
         if (_hasDiscreteVariables) discretize(_samplePopulation[i]);
-
-      } while (isSampleFeasible(_samplePopulation[i]) == false);
+      }
     }
   else
     for (size_t i = 0; i < _currentPopulationSize; i += 2)
     {
-      bool isFeasible;
-      do
+      bool isFeasible = isSampleFeasible(_samplePopulation[i]);
+      isFeasible = isFeasible && isSampleFeasible(_samplePopulation[i + 1]);
+
+      while (isFeasible == false)
       {
         std::vector<double> randsOne(_variableCount);
         std::vector<double> randsTwo(_variableCount);
@@ -486,8 +1010,7 @@ void CMAES::prepareGeneration()
 
         isFeasible = isSampleFeasible(_samplePopulation[i]);
         isFeasible = isFeasible && isSampleFeasible(_samplePopulation[i + 1]);
-
-      } while (isFeasible == false);
+      }
     }
 }
 
@@ -512,35 +1035,61 @@ void CMAES::sampleSingle(size_t sampleIdx, const std::vector<double> &randomNumb
       _samplePopulation[sampleIdx][d] = _currentMean[d] + _sigma * _bDZMatrix[sampleIdx * _variableCount + d];
     }
 
-  if (_hasDiscreteVariables)
+  if (_hasDiscreteVariables) applyDiscreteMutations(sampleIdx);
+}
+
+void CMAES::sampleBatch(const std::vector<double> &randomNumbers)
+{
+  typedef Eigen::Matrix<double, Eigen::Dynamic, Eigen::Dynamic, Eigen::RowMajor> rowMatrix_t;
+
+  // Row i of Z holds the random numbers of sample i, so that BDZ^T = Z * D * B^T
+  Eigen::Map<const rowMatrix_t> Z(randomNumbers.data(), _currentPopulationSize, _variableCount);
+  Eigen::Map<const Eigen::VectorXd> D(_axisLengths.data(), _variableCount);
+  Eigen::Map<rowMatrix_t> BDZ(_bDZMatrix.data(), _currentPopulationSize, _variableCount);
+
+  if (_diagonalCovariance)
+    BDZ = Z * D.asDiagonal();
+  else
   {
-    if ((sampleIdx + 1) < _numberOfDiscreteMutations)
-    {
-      const double p_geom = std::pow(0.7, 1.0 / _numberMaskingMatrixEntries);
-      size_t select = std::floor(_uniformGenerator->getRandomNumber() * _numberMaskingMatrixEntries);
+    Eigen::Map<const rowMatrix_t> B(_covarianceEigenvectorMatrix.data(), _variableCount, _variableCount);
+    BDZ.noalias() = (Z * D.asDiagonal()) * B.transpose();
+  }
 
-      for (size_t d = 0; d < _variableCount; ++d)
-        if ((_maskingMatrix[d] == 1.0) && (select-- == 0))
-        {
-          double dmutation = 1.0;
-          while (_uniformGenerator->getRandomNumber() > p_geom) dmutation += 1.0;
-          dmutation *= _k->_variables[d]->_granularity;
+  for (size_t i = 0; i < _currentPopulationSize; ++i)
+  {
+    for (size_t d = 0; d < _variableCount; ++d) _samplePopulation[i][d] = _currentMean[d] + _sigma * _bDZMatrix[i * _variableCount + d];
+    if (_hasDiscreteVariables) applyDiscreteMutations(i);
+  }
+}
 
-          if (_uniformGenerator->getRandomNumber() > 0.5) dmutation *= -1.0;
-          _discreteMutations[sampleIdx * _variableCount + d] = dmutation;
-          _samplePopulation[sampleIdx][d] += dmutation;
-        }
-    }
-    else if ((sampleIdx + 1) == _numberOfDiscreteMutations)
-    {
-      for (size_t d = 0; d < _variableCount; ++d)
-        if (_k->_variables[d]->_granularity != 0.0)
-        {
-          const double dmutation = std::round(_bestEverVariables[d] / _k->_variables[d]->_granularity) * _k->_variables[d]->_granularity - _samplePopulation[sampleIdx][d];
-          _discreteMutations[sampleIdx * _variableCount + d] = dmutation;
-          _samplePopulation[sampleIdx][d] += dmutation;
-        }
-    }
+void CMAES::applyDiscreteMutations(size_t sampleIdx)
+{
+  if ((sampleIdx + 1) < _numberOfDiscreteMutations)
+  {
+    const double p_geom = std::pow(0.7, 1.0 / _numberMaskingMatrixEntries);
+    size_t select = std::floor(_uniformGenerator->getRandomNumber() * _numberMaskingMatrixEntries);
+
+    for (size_t d = 0; d < _variableCount; ++d)
+      if ((_maskingMatrix[d] == 1.0) && (select-- == 0))
+      {
+        double dmutation = 1.0;
+        while (_uniformGenerator->getRandomNumber() > p_geom) dmutation += 1.0;
+        dmutation *= _k->_variables[d]->_granularity;
+
+        if (_uniformGenerator->getRandomNumber() > 0.5) dmutation *= -1.0;
+        _discreteMutations[sampleIdx * _variableCount + d] = dmutation;
+        _samplePopulation[sampleIdx][d] += dmutation;
+      }
+  }
+  else if ((sampleIdx + 1) == _numberOfDiscreteMutations)
+  {
+    for (size_t d = 0; d < _variableCount; ++d)
+      if (_k->_variables[d]->_granularity != 0.0)
+      {
+        const double dmutation = std::round(_bestEverVariables[d] / _k->_variables[d]->_granularity) * _k->_variables[d]->_granularity - _samplePopulation[sampleIdx][d];
+        _discreteMutations[sampleIdx * _variableCount + d] = dmutation;
+        _samplePopulation[sampleIdx][d] += dmutation;
+      }
   }
 }
 
@@ -599,6 +1148,21 @@ void CMAES::updateDistribution()
       _muWeights[i] /= valueSum;
   }
 
+  /* down-weight the samples of older distributions (asynchronous mode) */
+  if (_asynchronousSamples.empty() == false)
+  {
+    double weightSum = 0.;
+    for (size_t i = 0; i < _currentMuValue; ++i)
+    {
+      const size_t age = _k->_currentGeneration - 1 - _sampleGenerations[_sortingIndex[i]];
+      _muWeights[i] *= std::pow(_asynchronousAgeDecay, (double)age);
+      weightSum += _muWeights[i];
+    }
+
+    for (size_t i = 0; i < _currentMuValue; ++i)
+      _muWeights[i] /= weightSum;
+  }
+
   /* update mean */
   for (size_t d = 0; d < _variableCount; ++d)
   {
@@ -623,30 +1187,15 @@ void CMAES::updateDistribution()
   for (size_t d = 0; d < _variableCount; ++d)
     _meanUpdate[d] = (_currentMean[d] - _previousMean[d]) / _sigma;
 
-  /* calculate z := D^(-1) * B^(T) * _meanUpdate into _auxiliarBDZMatrix */
-  for (size_t d = 0; d < _variableCount; ++d)
-  {
-    double sum = 0.0;
-    if (_diagonalCovariance)
-      sum = _meanUpdate[d];
-    else
-      for (size_t e = 0; e < _variableCount; ++e) sum += _covarianceEigenvectorMatrix[e * _variableCount + d] * _meanUpdate[e]; /* B^(T) * _meanUpdate ( iterating B[e][d] = B^(T) ) */
-
-    _auxiliarBDZMatrix[d] = sum / _axisLengths[d]; /* D^(-1) * B^(T) * _meanUpdate */
-  }
+  /* calculate C^(-1/2) * _meanUpdate into _auxiliarBDZMatrix */
+  whitenMeanUpdate();
 
   _conjugateEvolutionPathL2Norm = 0.0;
 
-  /* cumulation for _sigma (ps) using B*z */
+  /* cumulation for _sigma (ps) */
   for (size_t d = 0; d < _variableCount; ++d)
   {
-    double sum = 0.0;
-    if (_diagonalCovariance)
-      sum = _auxiliarBDZMatrix[d];
-    else
-      for (size_t e = 0; e < _variableCount; ++e) sum += _covarianceEigenvectorMatrix[d * _variableCount + e] * _auxiliarBDZMatrix[e];
-
-    _conjugateEvolutionPath[d] = (1. - _sigmaCumulationFactor) * _conjugateEvolutionPath[d] + std::sqrt(_sigmaCumulationFactor * (2. - _sigmaCumulationFactor) * _effectiveMu) * sum;
+    _conjugateEvolutionPath[d] = (1. - _sigmaCumulationFactor) * _conjugateEvolutionPath[d] + std::sqrt(_sigmaCumulationFactor * (2. - _sigmaCumulationFactor) * _effectiveMu) * _auxiliarBDZMatrix[d];
 
     /* calculate norm(ps)^2 */
     _conjugateEvolutionPathL2Norm += std::pow(_conjugateEvolutionPath[d], 2.0);
@@ -655,7 +1204,7 @@ void CMAES::updateDistribution()
   /* calculate norm(ps) */
   _conjugateEvolutionPathL2Norm = std::sqrt(_conjugateEvolutionPathL2Norm);
 
-  const int hsig = (1.4 + 2.0 / (_variableCount + 1) > _conjugateEvolutionPathL2Norm / std::sqrt(1. - std::pow(1. - _sigmaCumulationFactor, 2.0 * (1.0 + _k->_currentGeneration))) / _chiSquareNumber);
+  const int hsig = (1.4 + 2.0 / (_variableCount + 1) > _conjugateEvolutionPathL2Norm / std::sqrt(1. - std::pow(1. - _sigmaCumulationFactor, 2.0 * (1.0 + _k->_currentGeneration - _runStartGeneration))) / _chiSquareNumber);
 
   /* cumulation for covariance matrix (pc) using B*D*z~_variableCount(0,C) */
   for (size_t d = 0; d < _variableCount; ++d)
@@ -682,11 +1231,44 @@ void CMAES::updateDistribution()
   // Calculating current Minimum and Maximum STD Devs
   for (size_t i = 0; i < _variableCount; ++i)
   {
-    _currentMinStandardDeviation = std::min(_currentMinStandardDeviation, _sigma * std::sqrt(_covarianceMatrix[i * _variableCount + i]));
-    _currentMaxStandardDeviation = std::max(_currentMaxStandardDeviation, _sigma * std::sqrt(_covarianceMatrix[i * _variableCount + i]));
+    _currentMinStandardDeviation = std::min(_currentMinStandardDeviation, _sigma * std::sqrt(getCovarianceDiagonal(i)));
+    _currentMaxStandardDeviation = std::max(_currentMaxStandardDeviation, _sigma * std::sqrt(getCovarianceDiagonal(i)));
+  }
+}
+
+void CMAES::whitenMeanUpdate()
+{
+  /* calculate z := D^(-1) * B^(T) * _meanUpdate */
+  std::vector<double> z(_variableCount);
+  for (size_t d = 0; d < _variableCount; ++d)
+  {
+    double sum = 0.0;
+    if (_diagonalCovariance)
+      sum = _meanUpdate[d];
+    else
+      for (size_t e = 0; e < _variableCount; ++e) sum += _covarianceEigenvectorMatrix[e * _variableCount + d] * _meanUpdate[e]; /* B^(T) * _meanUpdate ( iterating B[e][d] = B^(T) ) */
+
+    z[d] = sum / _axisLengths[d]; /* D^(-1) * B^(T) * _meanUpdate */
+  }
+
+  /* calculate B * z */
+  for (size_t d = 0; d < _variableCount; ++d)
+  {
+    double sum = 0.0;
+    if (_diagonalCovariance)
+      sum = z[d];
+    else
+      for (size_t e = 0; e < _variableCount; ++e) sum += _covarianceEigenvectorMatrix[d * _variableCount + e] * z[e];
+
+    _auxiliarBDZMatrix[d] = sum;
   }
 }
 
+double CMAES::getCovarianceDiagonal(size_t d) const
+{
+  return _covarianceMatrix[d * _variableCount + d];
+}
+
 void CMAES::adaptC(int hsig)
 {
   /* definitions for speeding up inner-most loop */
@@ -695,16 +1277,34 @@ void CMAES::adaptC(int hsig)
   const double sigmasquare = _sigma * _sigma;
 
   /* update covariance matrix */
-  for (size_t d = 0; d < _variableCount; ++d)
-    for (size_t e = _diagonalCovariance ? d : 0; e <= d; ++e)
+  if (_diagonalCovariance)
+    for (size_t d = 0; d < _variableCount; ++d)
     {
-      _covarianceMatrix[d * _variableCount + e] = (1 - ccov1 - ccovmu) * _covarianceMatrix[d * _variableCount + e] + ccov1 * (_evolutionPath[d] * _evolutionPath[e] + (1 - hsig) * _cumulativeCovariance * (2. - _cumulativeCovariance) * _covarianceMatrix[d * _variableCount + e]);
+      _covarianceMatrix[d * _variableCount + d] = (1 - ccov1 - ccovmu) * _covarianceMatrix[d * _variableCount + d] + ccov1 * (_evolutionPath[d] * _evolutionPath[d] + (1 - hsig) * _cumulativeCovariance * (2. - _cumulativeCovariance) * _covarianceMatrix[d * _variableCount + d]);
 
       for (size_t k = 0; k < _currentMuValue; ++k)
-        _covarianceMatrix[d * _variableCount + e] += ccovmu * _muWeights[k] * (_samplePopulation[_sortingIndex[k]][d] - _previousMean[d]) * (_samplePopulation[_sortingIndex[k]][e] - _previousMean[e]) / sigmasquare;
-
-      if (e < d) _covarianceMatrix[e * _variableCount + d] = _covarianceMatrix[d * _variableCount + e];
+        _covarianceMatrix[d * _variableCount + d] += ccovmu * _muWeights[k] * (_samplePopulation[_sortingIndex[k]][d] - _previousMean[d]) * (_samplePopulation[_sortingIndex[k]][d] - _previousMean[d]) / sigmasquare;
     }
+  else
+  {
+    typedef Eigen::Matrix<double, Eigen::Dynamic, Eigen::Dynamic, Eigen::RowMajor> rowMatrix_t;
+    Eigen::Map<rowMatrix_t> C(_covarianceMatrix.data(), _variableCount, _variableCount);
+    Eigen::Map<const Eigen::VectorXd> pc(_evolutionPath.data(), _variableCount);
+
+    // Steps of the mu best samples (columns of Y), and their weighted version
+    Eigen::MatrixXd Y(_variableCount, _currentMuValue);
+    for (size_t k = 0; k < _currentMuValue; ++k)
+      for (size_t d = 0; d < _variableCount; ++d) Y(d, k) = (_samplePopulation[_sortingIndex[k]][d] - _previousMean[d]) / _sigma;
+    Eigen::MatrixXd weightedY = Y * Eigen::Map<const Eigen::VectorXd>(_muWeights.data(), _currentMuValue).asDiagonal();
+
+    // Rank-one and rank-mu updates on the lower triangle, the latter as a single matrix product
+    C.triangularView<Eigen::Lower>() *= (1 - ccov1 - ccovmu) + ccov1 * (1 - hsig) * _cumulativeCovariance * (2. - _cumulativeCovariance);
+    C.triangularView<Eigen::Lower>() += ccov1 * pc * pc.transpose();
+    C.triangularView<Eigen::Lower>() += ccovmu * weightedY * Y.transpose();
+    C.triangularView<Eigen::StrictlyUpper>() = C.transpose();
+  }
+
+  _isEigensystemUpdated = false;
 
   /* update maximal and minimal diagonal value */
   _maximumDiagonalCovarianceMatrixElement = _minimumDiagonalCovarianceMatrixElement = _covarianceMatrix[0];
@@ -764,9 +1364,9 @@ void CMAES::numericalErrorTreatment()
 {
   // treat minimal standard deviations
   for (size_t d = 0; d < _variableCount; ++d)
-    if (_sigma * sqrt(_covarianceMatrix[d * _variableCount + d]) < _k->_variables[d]->_minimumStandardDeviationUpdate)
+    if (_sigma * sqrt(getCovarianceDiagonal(d)) < _k->_variables[d]->_minimumStandardDeviationUpdate)
     {
-      _sigma = (_k->_variables[d]->_minimumStandardDeviationUpdate) / sqrt(_covarianceMatrix[d * _variableCount + d]) * exp(0.05 + _sigmaCumulationFactor / _dampFactor);
+      _sigma = (_k->_variables[d]->_minimumStandardDeviationUpdate) / sqrt(getCovarianceDiagonal(d)) * exp(0.05 + _sigmaCumulationFactor / _dampFactor);
       _k->_logger->logWarning("Detailed", "Sigma increased due to minimal standard deviation.\n");
     }
 }
@@ -775,7 +1375,8 @@ void CMAES::handleConstraints()
 {
   while (_maxConstraintViolationCount > 0)
   {
-    _auxiliarCovarianceMatrix = _covarianceMatrix;
+    std::vector<std::vector<double>> normals;
+    std::vector<double> downdates;
 
     for (size_t i = 0; i < _currentPopulationSize; ++i)
       if (_sampleConstraintViolationCounts[i] > 0)
@@ -792,19 +1393,15 @@ void CMAES::handleConstraints()
               return;
             }
 
-            double v2 = 0;
             for (size_t d = 0; d < _variableCount; ++d)
-            {
               _normalConstraintApproximation[c][d] = (1.0 - _normalVectorLearningRate) * _normalConstraintApproximation[c][d] + _normalVectorLearningRate * _bDZMatrix[i * _variableCount + d];
-              v2 += _normalConstraintApproximation[c][d] * _normalConstraintApproximation[c][d];
-            }
-            for (size_t d = 0; d < _variableCount; ++d)
-              for (size_t e = 0; e < _variableCount; ++e)
-                _auxiliarCovarianceMatrix[d * _variableCount + e] = _auxiliarCovarianceMatrix[d * _variableCount + e] - ((_covarianceMatrixAdaptionFactor * _covarianceMatrixAdaptionFactor * _normalConstraintApproximation[c][d] * _normalConstraintApproximation[c][e]) / (v2 * _sampleConstraintViolationCounts[i] * _sampleConstraintViolationCounts[i]));
+
+            normals.push_back(_normalConstraintApproximation[c]);
+            downdates.push_back(_covarianceMatrixAdaptionFactor * _covarianceMatrixAdaptionFactor / (_sampleConstraintViolationCounts[i] * _sampleConstraintViolationCounts[i]));
           }
       }
 
-    updateEigensystem(_auxiliarCovarianceMatrix);
+    applyCovarianceCorrections(normals, downdates);
 
     // resample invalid points
     for (size_t i = 0; i < _currentPopulationSize; ++i)
@@ -831,6 +1428,23 @@ void CMAES::handleConstraints()
   } // while _maxConstraintViolationCount > 0
 }
 
+void CMAES::applyCovarianceCorrections(const std::vector<std::vector<double>> &normals, const std::vector<double> &downdates)
+{
+  _auxiliarCovarianceMatrix = _covarianceMatrix;
+
+  for (size_t k = 0; k < normals.size(); k++)
+  {
+    double v2 = 0;
+    for (size_t d = 0; d < _variableCount; ++d) v2 += normals[k][d] * normals[k][d];
+
+    for (size_t d = 0; d < _variableCount; ++d)
+      for (size_t e = 0; e < _variableCount; ++e)
+        _auxiliarCovarianceMatrix[d * _variableCount + e] = _auxiliarCovarianceMatrix[d * _variableCount + e] - downdates[k] * normals[k][d] * normals[k][e] / v2;
+  }
+
+  updateEigensystem(_auxiliarCovarianceMatrix);
+}
+
 void CMAES::updateDiscreteMutationMatrix()
 {
   // implemented based on 'A CMA-ES for Mixed-Integer Nonlinear Optimization' by
@@ -839,7 +1453,7 @@ void CMAES::updateDiscreteMutationMatrix()
   size_t entries = _variableCount + 1; // +1 to prevent 0-ness
   std::fill(std::begin(_maskingMatrixSigma), std::end(_maskingMatrixSigma), 1.0);
   for (size_t d = 0; d < _variableCount; ++d)
-    if (_sigma * std::sqrt(_covarianceMatrix[d * _variableCount + d]) / std::sqrt(_sigmaCumulationFactor) < 0.2 * _k->_variables[d]->_granularity)
+    if (_sigma * std::sqrt(getCovarianceDiagonal(d)) / std::sqrt(_sigmaCumulationFactor) < 0.2 * _k->_variables[d]->_granularity)
     {
       _maskingMatrixSigma[d] = 0.0;
       entries--;
@@ -849,7 +1463,7 @@ void CMAES::updateDiscreteMutationMatrix()
   _numberMaskingMatrixEntries = 0;
   std::fill(std::begin(_maskingMatrix), std::end(_maskingMatrix), 0.0);
   for (size_t d = 0; d < _variableCount; ++d)
-    if (2.0 * _sigma * std::sqrt(_covarianceMatrix[d * _variableCount + d]) < _k->_variables[d]->_granularity)
+    if (2.0 * _sigma * std::sqrt(getCovarianceDiagonal(d)) < _k->_variables[d]->_granularity)
     {
       _maskingMatrix[d] = 1.0;
       _numberMaskingMatrixEntries++;
@@ -883,6 +1497,7 @@ void CMAES::updateEigensystem(const std::vector<double> &M)
 
   _minimumCovarianceEigenvalue = minCovEV;
   _maximumCovarianceEigenvalue = maxCovEV;
+  _isEigensystemUpdated = true;
 
   /* write back */
   for (size_t d = 0; d < _variableCount; ++d) _axisLengths[d] = _auxiliarAxisLengths[d];
@@ -903,37 +1518,15 @@ void CMAES::eigen(size_t size, const std::vector<double> &M, std::vector<double>
   }
   else
   {
-    std::vector<double> data(size * size);
-
-    for (size_t i = 0; i < size; i++)
-      for (size_t j = 0; j <= i; j++)
-      {
-        data[i * size + j] = M[i * size + j];
-        data[j * size + i] = M[i * size + j];
-      }
-
-    // GSL Workspace
-
-    gsl_vector *gsl_eval = gsl_vector_alloc(size);
-    gsl_matrix *gsl_evec = gsl_matrix_alloc(size, size);
-    gsl_eigen_symmv_workspace *gsl_work = gsl_eigen_symmv_alloc(size);
-
-    gsl_matrix_view m = gsl_matrix_view_array(data.data(), size, size);
+    typedef Eigen::Matrix<double, Eigen::Dynamic, Eigen::Dynamic, Eigen::RowMajor> rowMatrix_t;
 
-    gsl_eigen_symmv(&m.matrix, gsl_eval, gsl_evec, gsl_work);
-    gsl_eigen_symmv_sort(gsl_eval, gsl_evec, GSL_EIGEN_SORT_ABS_ASC);
+    // The solver only reads the lower triangle, and returns the eigenvalues in ascending order
+    Eigen::Map<const rowMatrix_t> m(M.data(), size, size);
+    Eigen::SelfAdjointEigenSolver<Eigen::MatrixXd> solver(m);
+    if (solver.info() != Eigen::Success) KORALI_LOG_ERROR("Eigendecomposition of the covariance matrix did not converge.\n");
 
-    for (size_t i = 0; i < size; i++)
-    {
-      gsl_vector_view gsl_evec_i = gsl_matrix_column(gsl_evec, i);
-      for (size_t j = 0; j < size; j++) Q[j * size + i] = gsl_vector_get(&gsl_evec_i.vector, j);
-    }
-
-    for (size_t i = 0; i < size; i++) diag[i] = gsl_vector_get(gsl_eval, i);
-
-    gsl_vector_free(gsl_eval);
-    gsl_matrix_free(gsl_evec);
-    gsl_eigen_symmv_free(gsl_work);
+    Eigen::Map<rowMatrix_t>(Q.data(), size, size) = solver.eigenvectors();
+    Eigen::Map<Eigen::VectorXd>(diag.data(), size) = solver.eigenvalues();
   }
 }
 
@@ -963,6 +1556,8 @@ void CMAES::printGenerationAfter()
     _k->_logger->logInfo("Normal", "\n");
   }
 
+  if (_restartStrategy != "None") _k->_logger->logInfo("Normal", "Restarts:                     %zu (Population Size = %zu)\n", _restartCount, _populationSize);
+  if (_surrogateModel != "None") _k->_logger->logInfo("Normal", "Surrogate:                    %zu/%zu Evaluated (%s, Rank Agreement = %+6.3f)\n", _surrogateEvaluatedSampleCount, _currentPopulationSize, _surrogateCoefficients.empty() ? "None" : _surrogateModelTerms.c_str(), _surrogateRankAgreement);
   _k->_logger->logInfo("Normal", "Sigma:                        %+6.3e\n", _sigma);
   _k->_logger->logInfo("Normal", "Current Function Value: Max = %+6.3e - Best = %+6.3e\n", _currentBestValue, _bestEverValue);
   _k->_logger->logInfo("Normal", "Diagonal Covariance:    Min = %+6.3e -  Max = %+6.3e\n", _minimumDiagonalCovarianceMatrixElement, _maximumDiagonalCovarianceMatrixElement);
@@ -978,11 +1573,15 @@ void CMAES::printGenerationAfter()
       for (size_t c = 0; c < _constraintEvaluations.size(); c++) _k->_logger->logData("Detailed", "         ( %+6.3e )\n", _constraintEvaluations[c][_bestValidSample]);
   }
 
-  _k->_logger->logInfo("Detailed", "Covariance Matrix:\n");
-  for (size_t d = 0; d < _variableCount; d++)
+  // Variants with a limited-memory covariance representation do not store the matrix
+  if (_covarianceMatrix.size() == _variableCount * _variableCount)
   {
-    for (size_t e = 0; e <= d; e++) _k->_logger->logData("Detailed", "   %+6.3e  ", _covarianceMatrix[d * _variableCount + e]);
-    _k->_logger->logInfo("Detailed", "\n");
+    _k->_logger->logInfo("Detailed", "Covariance Matrix:\n");
+    for (size_t d = 0; d < _variableCount; d++)
+    {
+      for (size_t e = 0; e <= d; e++) _k->_logger->logData("Detailed", "   %+6.3e  ", _covarianceMatrix[d * _variableCount + e]);
+      _k->_logger->logInfo("Detailed", "\n");
+    }
   }
 
   _k->_logger->logInfo("Detailed", "Number of Infeasible Samples: %zu\n", _infeasibleSampleCount);
@@ -995,6 +1594,8 @@ void CMAES::printGenerationAfter()
 
 void CMAES::finalize()
 {
+  if (_asynchronousSamples.empty() == false) finishAsynchronousSamples();
+
   // Updating Results
   (*_k)["Results"]["Best Sample"]["F(x)"] = _bestEverValue;
   (*_k)["Results"]["Best Sample"]["Parameters"] = _bestEverVariables;
@@ -1537,6 +2138,166 @@ void CMAES::setConfiguration(knlohmann::json& js)
    eraseValue(js, "Constraint Evaluation Count");
  }
 
+ if (isDefined(js, "Restart Count"))
+ {
+ try { _restartCount = js["Restart Count"].get<size_t>();
+} catch (const std::exception& e)
+ { KORALI_LOG_ERROR(" + Object: [ CMAES ] \n + Key:    ['Restart Count']\n%s", e.what()); } 
+   eraseValue(js, "Restart Count");
+ }
+
+ if (isDefined(js, "Run Start Generation"))
+ {
+ try { _runStartGeneration = js["Run Start Generation"].get<size_t>();
+} catch (const std::exception& e)
+ { KORALI_LOG_ERROR(" + Object: [ CMAES ] \n + Key:    ['Run Start Generation']\n%s", e.what()); } 
+   eraseValue(js, "Run Start Generation");
+ }
+
+ if (isDefined(js, "Run Start Model Evaluation Count"))
+ {
+ try { _runStartModelEvaluationCount = js["Run Start Model Evaluation Count"].get<size_t>();
+} catch (const std::exception& e)
+ { KORALI_LOG_ERROR(" + Object: [ CMAES ] \n + Key:    ['Run Start Model Evaluation Count']\n%s", e.what()); } 
+   eraseValue(js, "Run Start Model Evaluation Count");
+ }
+
+ if (isDefined(js, "Default Population Size"))
+ {
+ try { _defaultPopulationSize = js["Default Population Size"].get<size_t>();
+} catch (const std::exception& e)
+ { KORALI_LOG_ERROR(" + Object: [ CMAES ] \n + Key:    ['Default Population Size']\n%s", e.what()); } 
+   eraseValue(js, "Default Population Size");
+ }
+
+ if (isDefined(js, "Default Mu Value"))
+ {
+ try { _defaultMuValue = js["Default Mu Value"].get<size_t>();
+} catch (const std::exception& e)
+ { KORALI_LOG_ERROR(" + Object: [ CMAES ] \n + Key:    ['Default Mu Value']\n%s", e.what()); } 
+   eraseValue(js, "Default Mu Value");
+ }
+
+ if (isDefined(js, "Large Population Size"))
+ {
+ try { _largePopulationSize = js["Large Population Size"].get<size_t>();
+} catch (const std::exception& e)
+ { KORALI_LOG_ERROR(" + Object: [ CMAES ] \n + Key:    ['Large Population Size']\n%s", e.what()); } 
+   eraseValue(js, "Large Population Size");
+ }
+
+ if (isDefined(js, "Is Small Population Regime"))
+ {
+ try { _isSmallPopulationRegime = js["Is Small Population Regime"].get<int>();
+} catch (const std::exception& e)
+ { KORALI_LOG_ERROR(" + Object: [ CMAES ] \n + Key:    ['Is Small Population Regime']\n%s", e.what()); } 
+   eraseValue(js, "Is Small Population Regime");
+ }
+
+ if (isDefined(js, "Large Regime Model Evaluation Count"))
+ {
+ try { _largeRegimeModelEvaluationCount = js["Large Regime Model Evaluation Count"].get<size_t>();
+} catch (const std::exception& e)
+ { KORALI_LOG_ERROR(" + Object: [ CMAES ] \n + Key:    ['Large Regime Model Evaluation Count']\n%s", e.what()); } 
+   eraseValue(js, "Large Regime Model Evaluation Count");
+ }
+
+ if (isDefined(js, "Small Regime Model Evaluation Count"))
+ {
+ try { _smallRegimeModelEvaluationCount = js["Small Regime Model Evaluation Count"].get<size_t>();
+} catch (const std::exception& e)
+ { KORALI_LOG_ERROR(" + Object: [ CMAES ] \n + Key:    ['Small Regime Model Evaluation Count']\n%s", e.what()); } 
+   eraseValue(js, "Small Regime Model Evaluation Count");
+ }
+
+ if (isDefined(js, "Sample Generations"))
+ {
+ try { _sampleGenerations = js["Sample Generations"].get<std::vector<size_t>>();
+} catch (const std::exception& e)
+ { KORALI_LOG_ERROR(" + Object: [ CMAES ] \n + Key:    ['Sample Generations']\n%s", e.what()); } 
+   eraseValue(js, "Sample Generations");
+ }
+
+ if (isDefined(js, "Asynchronous Parameters"))
+ {
+ try { _asynchronousParameters = js["Asynchronous Parameters"].get<std::vector<std::vector<double>>>();
+} catch (const std::exception& e)
+ { KORALI_LOG_ERROR(" + Object: [ CMAES ] \n + Key:    ['Asynchronous Parameters']\n%s", e.what()); } 
+   eraseValue(js, "Asynchronous Parameters");
+ }
+
+ if (isDefined(js, "Candidate Generations"))
+ {
+ try { _candidateGenerations = js["Candidate Generations"].get<std::vector<size_t>>();
+} catch (const std::exception& e)
+ { KORALI_LOG_ERROR(" + Object: [ CMAES ] \n + Key:    ['Candidate Generations']\n%s", e.what()); } 
+   eraseValue(js, "Candidate Generations");
+ }
+
+ if (isDefined(js, "Surrogate Archive Variables"))
+ {
+ try { _surrogateArchiveVariables = js["Surrogate Archive Variables"].get<std::vector<std::vector<double>>>();
+} catch (const std::exception& e)
+ { KORALI_LOG_ERROR(" + Object: [ CMAES ] \n + Key:    ['Surrogate Archive Variables']\n%s", e.what()); } 
+   eraseValue(js, "Surrogate Archive Variables");
+ }
+
+ if (isDefined(js, "Surrogate Archive Values"))
+ {
+ try { _surrogateArchiveValues = js["Surrogate Archive Values"].get<std::vector<double>>();
+} catch (const std::exception& e)
+ { KORALI_LOG_ERROR(" + Object: [ CMAES ] \n + Key:    ['Surrogate Archive Values']\n%s", e.what()); } 
+   eraseValue(js, "Surrogate Archive Values");
+ }
+
+ if (isDefined(js, "Surrogate Model Terms"))
+ {
+ try { _surrogateModelTerms = js["Surrogate Model Terms"].get<std::string>();
+} catch (const std::exception& e)
+ { KORALI_LOG_ERROR(" + Object: [ CMAES ] \n + Key:    ['Surrogate Model Terms']\n%s", e.what()); } 
+   eraseValue(js, "Surrogate Model Terms");
+ }
+
+ if (isDefined(js, "Surrogate Center"))
+ {
+ try { _surrogateCenter = js["Surrogate Center"].get<std::vector<double>>();
+} catch (const std::exception& e)
+ { KORALI_LOG_ERROR(" + Object: [ CMAES ] \n + Key:    ['Surrogate Center']\n%s", e.what()); } 
+   eraseValue(js, "Surrogate Center");
+ }
+
+ if (isDefined(js, "Surrogate Scaling"))
+ {
+ try { _surrogateScaling = js["Surrogate Scaling"].get<std::vector<double>>();
+} catch (const std::exception& e)
+ { KORALI_LOG_ERROR(" + Object: [ CMAES ] \n + Key:    ['Surrogate Scaling']\n%s", e.what()); } 
+   eraseValue(js, "Surrogate Scaling");
+ }
+
+ if (isDefined(js, "Surrogate Coefficients"))
+ {
+ try { _surrogateCoefficients = js["Surrogate Coefficients"].get<std::vector<double>>();
+} catch (const std::exception& e)
+ { KORALI_LOG_ERROR(" + Object: [ CMAES ] \n + Key:    ['Surrogate Coefficients']\n%s", e.what()); } 
+   eraseValue(js, "Surrogate Coefficients");
+ }
+
+ if (isDefined(js, "Surrogate Evaluated Sample Count"))
+ {
+ try { _surrogateEvaluatedSampleCount = js["Surrogate Evaluated Sample Count"].get<size_t>();
+} catch (const std::exception& e)
+ { KORALI_LOG_ERROR(" + Object: [ CMAES ] \n + Key:    ['Surrogate Evaluated Sample Count']\n%s", e.what()); } 
+   eraseValue(js, "Surrogate Evaluated Sample Count");
+ }
+
+ if (isDefined(js, "Surrogate Rank Agreement"))
+ {
+ try { _surrogateRankAgreement = js["Surrogate Rank Agreement"].get<double>();
+} catch (const std::exception& e)
+ { KORALI_LOG_ERROR(" + Object: [ CMAES ] \n + Key:    ['Surrogate Rank Agreement']\n%s", e.what()); } 
+   eraseValue(js, "Surrogate Rank Agreement");
+ }
+
  if (isDefined(js, "Population Size"))
  {
  try { _populationSize = js["Population Size"].get<size_t>();
@@ -1707,6 +2468,106 @@ void CMAES::setConfiguration(knlohmann::json& js)
  }
   else   KORALI_LOG_ERROR(" + No value provided for mandatory setting: ['Global Success Learning Rate'] required by CMAES.\n"); 
 
+ if (isDefined(js, "Restart Strategy"))
+ {
+ try { _restartStrategy = js["Restart Strategy"].get<std::string>();
+} catch (const std::exception& e)
+ { KORALI_LOG_ERROR(" + Object: [ CMAES ] \n + Key:    ['Restart Strategy']\n%s", e.what()); } 
+{
+ bool validOption = false; 
+ if (_restartStrategy == "None") validOption = true; 
+ if (_restartStrategy == "IPOP") validOption = true; 
+ if (_restartStrategy == "BIPOP") validOption = true; 
+ if (validOption == false) KORALI_LOG_ERROR(" + Unrecognized value (%s) provided for mandatory setting: ['Restart Strategy'] required by CMAES.\n", _restartStrategy.c_str()); 
+}
+   eraseValue(js, "Restart Strategy");
+ }
+  else   KORALI_LOG_ERROR(" + No value provided for mandatory setting: ['Restart Strategy'] required by CMAES.\n"); 
+
+ if (isDefined(js, "Restart Population Increase Factor"))
+ {
+ try { _restartPopulationIncreaseFactor = js["Restart Population Increase Factor"].get<double>();
+} catch (const std::exception& e)
+ { KORALI_LOG_ERROR(" + Object: [ CMAES ] \n + Key:    ['Restart Population Increase Factor']\n%s", e.what()); } 
+   eraseValue(js, "Restart Population Increase Factor");
+ }
+  else   KORALI_LOG_ERROR(" + No value provided for mandatory setting: ['Restart Population Increase Factor'] required by CMAES.\n"); 
+
+ if (isDefined(js, "Max Restarts"))
+ {
+ try { _maxRestarts = js["Max Restarts"].get<size_t>();
+} catch (const std::exception& e)
+ { KORALI_LOG_ERROR(" + Object: [ CMAES ] \n + Key:    ['Max Restarts']\n%s", e.what()); } 
+   eraseValue(js, "Max Restarts");
+ }
+  else   KORALI_LOG_ERROR(" + No value provided for mandatory setting: ['Max Restarts'] required by CMAES.\n"); 
+
+ if (isDefined(js, "Evaluation Mode"))
+ {
+ try { _evaluationMode = js["Evaluation Mode"].get<std::string>();
+} catch (const std::exception& e)
+ { KORALI_LOG_ERROR(" + Object: [ CMAES ] \n + Key:    ['Evaluation Mode']\n%s", e.what()); } 
+{
+ bool validOption = false; 
+ if (_evaluationMode == "Generational") validOption = true; 
+ if (_evaluationMode == "Asynchronous") validOption = true; 
+ if (validOption == false) KORALI_LOG_ERROR(" + Unrecognized value (%s) provided for mandatory setting: ['Evaluation Mode'] required by CMAES.\n", _evaluationMode.c_str()); 
+}
+   eraseValue(js, "Evaluation Mode");
+ }
+  else   KORALI_LOG_ERROR(" + No value provided for mandatory setting: ['Evaluation Mode'] required by CMAES.\n"); 
+
+ if (isDefined(js, "Asynchronous Quorum"))
+ {
+ try { _asynchronousQuorum = js["Asynchronous Quorum"].get<size_t>();
+} catch (const std::exception& e)
+ { KORALI_LOG_ERROR(" + Object: [ CMAES ] \n + Key:    ['Asynchronous Quorum']\n%s", e.what()); } 
+   eraseValue(js, "Asynchronous Quorum");
+ }
+  else   KORALI_LOG_ERROR(" + No value provided for mandatory setting: ['Asynchronous Quorum'] required by CMAES.\n"); 
+
+ if (isDefined(js, "Asynchronous Age Decay"))
+ {
+ try { _asynchronousAgeDecay = js["Asynchronous Age Decay"].get<double>();
+} catch (const std::exception& e)
+ { KORALI_LOG_ERROR(" + Object: [ CMAES ] \n + Key:    ['Asynchronous Age Decay']\n%s", e.what()); } 
+   eraseValue(js, "Asynchronous Age Decay");
+ }
+  else   KORALI_LOG_ERROR(" + No value provided for mandatory setting: ['Asynchronous Age Decay'] required by CMAES.\n"); 
+
+ if (isDefined(js, "Surrogate Model"))
+ {
+ try { _surrogateModel = js["Surrogate Model"].get<std::string>();
+} catch (const std::exception& e)
+ { KORALI_LOG_ERROR(" + Object: [ CMAES ] \n + Key:    ['Surrogate Model']\n%s", e.what()); } 
+{
+ bool validOption = false; 
+ if (_surrogateModel == "None") validOption = true; 
+ if (_surrogateModel == "Linear Quadratic") validOption = true; 
+ if (validOption == false) KORALI_LOG_ERROR(" + Unrecognized value (%s) provided for mandatory setting: ['Surrogate Model'] required by CMAES.\n", _surrogateModel.c_str()); 
+}
+   eraseValue(js, "Surrogate Model");
+ }
+  else   KORALI_LOG_ERROR(" + No value provided for mandatory setting: ['Surrogate Model'] required by CMAES.\n"); 
+
+ if (isDefined(js, "Surrogate Rank Agreement Threshold"))
+ {
+ try { _surrogateRankAgreementThreshold = js["Surrogate Rank Agreement Threshold"].get<double>();
+} catch (const std::exception& e)
+ { KORALI_LOG_ERROR(" + Object: [ CMAES ] \n + Key:    ['Surrogate Rank Agreement Threshold']\n%s", e.what()); } 
+   eraseValue(js, "Surrogate Rank Agreement Threshold");
+ }
+  else   KORALI_LOG_ERROR(" + No value provided for mandatory setting: ['Surrogate Rank Agreement Threshold'] required by CMAES.\n"); 
+
+ if (isDefined(js, "Surrogate Archive Size"))
+ {
+ try { _surrogateArchiveSize = js["Surrogate Archive Size"].get<size_t>();
+} catch (const std::exception& e)
+ { KORALI_LOG_ERROR(" + Object: [ CMAES ] \n + Key:    ['Surrogate Archive Size']\n%s", e.what()); } 
+   eraseValue(js, "Surrogate Archive Size");
+ }
+  else   KORALI_LOG_ERROR(" + No value provided for mandatory setting: ['Surrogate Archive Size'] required by CMAES.\n"); 
+
  if (isDefined(js, "Termination Criteria", "Max Condition Covariance Matrix"))
  {
  try { _maxConditionCovarianceMatrix = js["Termination Criteria"]["Max Condition Covariance Matrix"].get<double>();
@@ -1774,6 +2635,15 @@ void CMAES::getConfiguration(knlohmann::json& js)
    js["Covariance Matrix Adaption Strength"] = _covarianceMatrixAdaptionStrength;
    js["Normal Vector Learning Rate"] = _normalVectorLearningRate;
    js["Global Success Learning Rate"] = _globalSuccessLearningRate;
+   js["Restart Strategy"] = _restartStrategy;
+   js["Restart Population Increase Factor"] = _restartPopulationIncreaseFactor;
+   js["Max Restarts"] = _maxRestarts;
+   js["Evaluation Mode"] = _evaluationMode;
+   js["Asynchronous Quorum"] = _asynchronousQuorum;
+   js["Asynchronous Age Decay"] = _asynchronousAgeDecay;
+   js["Surrogate Model"] = _surrogateModel;
+   js["Surrogate Rank Agreement Threshold"] = _surrogateRankAgreementThreshold;
+   js["Surrogate Archive Size"] = _surrogateArchiveSize;
    js["Termination Criteria"]["Max Condition Covariance Matrix"] = _maxConditionCovarianceMatrix;
    js["Termination Criteria"]["Min Standard Deviation"] = _minStandardDeviation;
    js["Termination Criteria"]["Max Standard Deviation"] = _maxStandardDeviation;
@@ -1842,6 +2712,26 @@ void CMAES::getConfiguration(knlohmann::json& js)
    js["Current Min Standard Deviation"] = _currentMinStandardDeviation;
    js["Current Max Standard Deviation"] = _currentMaxStandardDeviation;
    js["Constraint Evaluation Count"] = _constraintEvaluationCount;
+   js["Restart Count"] = _restartCount;
+   js["Run Start Generation"] = _runStartGeneration;
+   js["Run Start Model Evaluation Count"] = _runStartModelEvaluationCount;
+   js["Default Population Size"] = _defaultPopulationSize;
+   js["Default Mu Value"] = _defaultMuValue;
+   js["Large Population Size"] = _largePopulationSize;
+   js["Is Small Population Regime"] = _isSmallPopulationRegime;
+   js["Large Regime Model Evaluation Count"] = _largeRegimeModelEvaluationCount;
+   js["Small Regime Model Evaluation Count"] = _smallRegimeModelEvaluationCount;
+   js["Sample Generations"] = _sampleGenerations;
+   js["Asynchronous Parameters"] = _asynchronousParameters;
+   js["Candidate Generations"] = _candidateGenerations;
+   js["Surrogate Archive Variables"] = _surrogateArchiveVariables;
+   js["Surrogate Archive Values"] = _surrogateArchiveValues;
+   js["Surrogate Model Terms"] = _surrogateModelTerms;
+   js["Surrogate Center"] = _surrogateCenter;
+   js["Surrogate Scaling"] = _surrogateScaling;
+   js["Surrogate Coefficients"] = _surrogateCoefficients;
+   js["Surrogate Evaluated Sample Count"] = _surrogateEvaluatedSampleCount;
+   js["Surrogate Rank Agreement"] = _surrogateRankAgreement;
  for (size_t i = 0; i <  _k->_variables.size(); i++) { 
    _k->_js["Variables"][i]["Granularity"] = _k->_variables[i]->_granularity;
  } 
@@ -1851,7 +2741,7 @@ void CMAES::getConfiguration(knlohmann::json& js)
 void CMAES::applyModuleDefaults(knlohmann::json& js) 
 {
 
- std::string defaultString = "{\"Population Size\": 0, \"Mu Value\": 0, \"Mu Type\": \"Logarithmic\", \"Initial Sigma Cumulation Factor\": -1.0, \"Initial Damp Factor\": -1.0, \"Is Sigma Bounded\": false, \"Initial Cumulative Covariance\": -1.0, \"Use Gradient Information\": false, \"Gradient Step Size\": 0.01, \"Diagonal Covariance\": false, \"Mirrored Sampling\": false, \"Viability Population Size\": 2, \"Viability Mu Value\": 0, \"Max Covariance Matrix Corrections\": 1000000, \"Target Success Rate\": 0.1818, \"Covariance Matrix Adaption Strength\": 0.1, \"Normal Vector Learning Rate\": -1.0, \"Global Success Learning Rate\": 0.2, \"Termination Criteria\": {\"Max Condition Covariance Matrix\": Infinity, \"Min Standard Deviation\": -Infinity, \"Max Standard Deviation\": Infinity}, \"Uniform Generator\": {\"Type\": \"Univariate/Uniform\", \"Minimum\": 0.0, \"Maximum\": 1.0}, \"Normal Generator\": {\"Type\": \"Univariate/Normal\", \"Mean\": 0.0, \"Standard Deviation\": 1.0}, \"Best Ever Value\": -Infinity, \"Current Min Standard Deviation\": Infinity, \"Current Max Standard Deviation\": -Infinity, \"Minimum Covariance Eigenvalue\": Infinity, \"Maximum Covariance Eigenvalue\": -Infinity}";
+ std::string defaultString = "{\"Population Size\": 0, \"Mu Value\": 0, \"Mu Type\": \"Logarithmic\", \"Initial Sigma Cumulation Factor\": -1.0, \"Initial Damp Factor\": -1.0, \"Is Sigma Bounded\": false, \"Initial Cumulative Covariance\": -1.0, \"Use Gradient Information\": false, \"Gradient Step Size\": 0.01, \"Diagonal Covariance\": false, \"Mirrored Sampling\": false, \"Viability Population Size\": 2, \"Viability Mu Value\": 0, \"Max Covariance Matrix Corrections\": 1000000, \"Target Success Rate\": 0.1818, \"Covariance Matrix Adaption Strength\": 0.1, \"Normal Vector Learning Rate\": -1.0, \"Global Success Learning Rate\": 0.2, \"Restart Strategy\": \"None\", \"Restart Population Increase Factor\": 2.0, \"Max Restarts\": 1000000, \"Evaluation Mode\": \"Generational\", \"Asynchronous Quorum\": 0, \"Asynchronous Age Decay\": 0.5, \"Asynchronous Parameters\": [], \"Surrogate Model\": \"None\", \"Surrogate Rank Agreement Threshold\": 0.85, \"Surrogate Archive Size\": 0, \"Surrogate Model Terms\": \"Linear\", \"Surrogate Evaluated Sample Count\": 0, \"Surrogate Rank Agreement\": 0.0, \"Restart Count\": 0, \"Run Start Generation\": 0, \"Run Start Model Evaluation Count\": 0, \"Is Small Population Regime\": false, \"Large Regime Model Evaluation Count\": 0, \"Small Regime Model Evaluation Count\": 0, \"Termination Criteria\": {\"Max Condition Covariance Matrix\": Infinity, \"Min Standard Deviation\": -Infinity, \"Max Standard Deviation\": Infinity}, \"Uniform Generator\": {\"Type\": \"Univariate/Uniform\", \"Minimum\": 0.0, \"Maximum\": 1.0}, \"Normal Generator\": {\"Type\": \"Univariate/Normal\", \"Mean\": 0.0, \"Standard Deviation\": 1.0}, \"Best Ever Value\": -Infinity, \"Current Min Standard Deviation\": Infinity, \"Current Max Standard Deviation\": -Infinity, \"Minimum Covariance Eigenvalue\": Infinity, \"Maximum Covariance Eigenvalue\": -Infinity}";
  knlohmann::json defaultJs = knlohmann::json::parse(defaultString);
  mergeJson(js, defaultJs); 
  Optimizer::applyModuleDefaults(js);
@@ -104,6 +104,42 @@ class CMAES : public Optimizer
   */
    double _globalSuccessLearningRate;
   /**
+  * @brief Restarts the optimization within the same experiment when a termination criterion of the current run (Min Value Difference Threshold, Max Condition Covariance Matrix, Min or Max Standard Deviation) is met. The experiment stops at the global criteria (e.g., Max Model Evaluations, Max Generations, or Max Value).
+  */
+   std::string _restartStrategy;
+  /**
+  * @brief Factor by which the population size grows at every IPOP restart (or BIPOP restart in the large population regime).
+  */
+   double _restartPopulationIncreaseFactor;
+  /**
+  * @brief Maximum number of restarts. Afterwards, the termination criteria of the current run stop the optimization.
+  */
+   size_t _maxRestarts;
+  /**
+  * @brief Determines how the evaluations of a generation are synchronized. The asynchronous mode keeps the workers busy when the model runtime varies, and is not applicable to problems with constraints.
+  */
+   std::string _evaluationMode;
+  /**
+  * @brief Number of new results that trigger an update of the distribution in the asynchronous mode (by default the Mu Value).
+  */
+   size_t _asynchronousQuorum;
+  /**
+  * @brief Factor by which the recombination weight of a sample decreases for every update of the distribution since it was drawn (asynchronous mode). Must be in (0.0, 1.0], where 1.0 disables the age weighting.
+  */
+   double _asynchronousAgeDecay;
+  /**
+  * @brief Surrogate that pre-screens the candidates, to save evaluations of expensive models. Not applicable to the Asynchronous Evaluation Mode nor with gradient information.
+  */
+   std::string _surrogateModel;
+  /**
+  * @brief Kendall rank correlation between the surrogate and the most recent evaluations above which the remaining candidates of a generation are not evaluated, but take the surrogate values.
+  */
+   double _surrogateRankAgreementThreshold;
+  /**
+  * @brief Maximum number of evaluations kept to fit the surrogate, the oldest are dropped first (by default, twice the number of terms of the full quadratic model).
+  */
+   size_t _surrogateArchiveSize;
+  /**
   * @brief [Internal Use] Normal random number generator.
   */
    korali::distribution::univariate::Normal* _normalGenerator;
@@ -156,7 +192,7 @@ class CMAES : public Optimizer
   */
    double _chiSquareNumber;
   /**
-  * @brief [Internal Use] Establishes how frequently the eigenvalues are updated.
+  * @brief [Internal Use] Establishes how frequently (in generations) the eigensystem of the covariance matrix is updated. It is derived from the learning rates of the covariance matrix.
   */
    size_t _covarianceEigenvalueEvaluationFrequency;
   /**
@@ -364,6 +400,86 @@ class CMAES : public Optimizer
   */
    size_t _constraintEvaluationCount;
   /**
+  * @brief [Internal Use] Number of restarts performed.
+  */
+   size_t _restartCount;
+  /**
+  * @brief [Internal Use] Last generation before the current run (since the last restart) started.
+  */
+   size_t _runStartGeneration;
+  /**
+  * @brief [Internal Use] Number of model evaluations before the current run started.
+  */
+   size_t _runStartModelEvaluationCount;
+  /**
+  * @brief [Internal Use] Population size of the first run, from which the population sizes of the restarts are derived.
+  */
+   size_t _defaultPopulationSize;
+  /**
+  * @brief [Internal Use] Mu value of the first run, scaled with the population size of the restarts.
+  */
+   size_t _defaultMuValue;
+  /**
+  * @brief [Internal Use] Population size of the last run in the large population regime.
+  */
+   size_t _largePopulationSize;
+  /**
+  * @brief [Internal Use] Flag determining if the current run belongs to the small population regime of BIPOP.
+  */
+   int _isSmallPopulationRegime;
+  /**
+  * @brief [Internal Use] Number of model evaluations spent by the runs in the large population regime.
+  */
+   size_t _largeRegimeModelEvaluationCount;
+  /**
+  * @brief [Internal Use] Number of model evaluations spent by the runs in the small population regime of BIPOP.
+  */
+   size_t _smallRegimeModelEvaluationCount;
+  /**
+  * @brief [Internal Use] Generation whose distribution update produced the distribution each sample of the population was drawn from.
+  */
+   std::vector<size_t> _sampleGenerations;
+  /**
+  * @brief [Internal Use] Parameters of the candidate in flight of each population slot, empty if there is none (asynchronous mode). A resumed run evaluates them again.
+  */
+   std::vector<std::vector<double>> _asynchronousParameters;
+  /**
+  * @brief [Internal Use] Generation whose distribution update produced the distribution each candidate in flight was drawn from (asynchronous mode).
+  */
+   std::vector<size_t> _candidateGenerations;
+  /**
+  * @brief [Internal Use] Evaluated samples, to fit the surrogate.
+  */
+   std::vector<std::vector<double>> _surrogateArchiveVariables;
+  /**
+  * @brief [Internal Use] Objective values of the evaluated samples, to fit the surrogate.
+  */
+   std::vector<double> _surrogateArchiveValues;
+  /**
+  * @brief [Internal Use] Terms of the current surrogate: Linear, Diagonal Quadratic, or Full Quadratic.
+  */
+   std::string _surrogateModelTerms;
+  /**
+  * @brief [Internal Use] Point around which the surrogate was fitted (the mean of the distribution).
+  */
+   std::vector<double> _surrogateCenter;
+  /**
+  * @brief [Internal Use] Scaling of the variables in the surrogate (the standard deviations of the distribution).
+  */
+   std::vector<double> _surrogateScaling;
+  /**
+  * @brief [Internal Use] Coefficients of the terms of the surrogate.
+  */
+   std::vector<double> _surrogateCoefficients;
+  /**
+  * @brief [Internal Use] Number of candidates of the current generation evaluated with the computational model.
+  */
+   size_t _surrogateEvaluatedSampleCount;
+  /**
+  * @brief [Internal Use] Kendall rank correlation between the surrogate and the most recent evaluations.
+  */
+   double _surrogateRankAgreement;
+  /**
   * @brief [Termination Criteria] Specifies the maximum condition of the covariance matrix.
   */
    double _maxConditionCovarianceMatrix;
@@ -408,18 +524,75 @@ class CMAES : public Optimizer
    */
   void prepareGeneration();
 
+  /**
+   * @brief Updates the eigensystem of the covariance matrix, if it changed and the update is due in this generation.
+   */
+  void updateEigensystemIfOutdated();
+
+  /**
+   * @brief Updates the distribution with the next quorum of results, and sends new candidates in their place. Method for the asynchronous mode.
+   */
+  void runAsynchronousGeneration();
+
+  /**
+   * @brief Draws a new candidate from the current distribution and starts its evaluation, keeping the last evaluated sample in the population. Method for the asynchronous mode.
+   * @param sampleIdx Index of the population slot
+   */
+  void startAsynchronousSample(size_t sampleIdx);
+
+  /**
+   * @brief Waits for the samples still in flight, keeping their results only for the best ever sample. Method for the asynchronous mode.
+   */
+  void finishAsynchronousSamples();
+
+  /**
+   * @brief Starts again the evaluation of the samples that were in flight when the state was saved, since a resumed run has lost them. Method for the asynchronous mode.
+   */
+  void resumeAsynchronousSamples();
+
   /**
    * @brief Evaluates a single sample
    * @param sampleIdx Index of the sample to evaluate
    * @param randomNumbers Random numbers to generate sample
    */
-  void sampleSingle(size_t sampleIdx, const std::vector<double> &randomNumbers);
+  virtual void sampleSingle(size_t sampleIdx, const std::vector<double> &randomNumbers);
+
+  /**
+   * @brief Generates the whole current population with a single B*D*Z matrix product
+   * @param randomNumbers Random numbers to generate the samples, stored contiguously per sample
+   */
+  virtual void sampleBatch(const std::vector<double> &randomNumbers);
+
+  /**
+   * @brief Applies the discrete mutations to a freshly generated sample. Method for discrete/integer optimization.
+   * @param sampleIdx Index of the sample to mutate
+   */
+  void applyDiscreteMutations(size_t sampleIdx);
 
   /**
    * @brief Adapts the covariance matrix.
    * @param hsig Sign
    */
-  void adaptC(int hsig);
+  virtual void adaptC(int hsig);
+
+  /**
+   * @brief Transforms the mean update back to the isotropic space of the random numbers (C^{-1/2} * mean update), and stores it in _auxiliarBDZMatrix.
+   */
+  virtual void whitenMeanUpdate();
+
+  /**
+   * @brief Returns a diagonal element of the covariance matrix (without the sigma scaling).
+   * @param d Index of the variable
+   * @return The variance of the variable
+   */
+  virtual double getCovarianceDiagonal(size_t d) const;
+
+  /**
+   * @brief Reduces the variance of the proposal distribution along the normal approximations of the violated constraints, and updates the sampling distribution accordingly. Method for CCMA-ES.
+   * @param normals Normal approximations of the violated constraints
+   * @param downdates Variance to remove along each (normalized) normal
+   */
+  virtual void applyCovarianceCorrections(const std::vector<std::vector<double>> &normals, const std::vector<double> &downdates);
 
   /**
    * @brief Updates scaling factor of covariance matrix.
@@ -468,13 +641,58 @@ class CMAES : public Optimizer
   /**
    * @brief Initialize Covariance Matrix and Cholesky Decomposition
    */
-  void initCovariance(); /* init sigma, C and B */
+  virtual void initCovariance(); /* init sigma, C and B */
 
   /**
    * @brief Check if mean of proposal distribution is inside of valid domain (does not violate constraints), if yes, re-initialize internal vars. Method for CCMA-ES.
    */
   void checkMeanAndSetRegime();
 
+  /**
+   * @brief Evaluates samples of the current population with the computational model, and archives them for the surrogate.
+   * @param sampleIdxs Indices of the samples to evaluate
+   */
+  void evaluateSamples(const std::vector<size_t> &sampleIdxs);
+
+  /**
+   * @brief Evaluates the candidates of the current population in the order ranked by the surrogate, until its ranking agrees with the evaluations. The remaining candidates take the surrogate values.
+   */
+  void evaluateWithSurrogate();
+
+  /**
+   * @brief Fits the surrogate on the archived evaluations nearest to the mean of the distribution.
+   * @return True, if the archive holds enough evaluations to fit the surrogate; false, otherwise.
+   */
+  bool fitSurrogate();
+
+  /**
+   * @brief Computes the terms of the surrogate at a point.
+   * @param x Point to compute the terms at
+   * @param features Values of the terms
+   */
+  void getSurrogateFeatures(const std::vector<double> &x, std::vector<double> &features) const;
+
+  /**
+   * @brief Predicts the objective value at a point with the surrogate.
+   * @param x Point to predict the value at
+   * @return The predicted value
+   */
+  double predictSurrogate(const std::vector<double> &x) const;
+
+  /**
+   * @brief Computes the Kendall rank correlation between two sequences.
+   * @param a First sequence
+   * @param b Second sequence
+   * @return The rank correlation, in [-1, 1]
+   */
+  static double getKendallTau(const std::vector<double> &a, const std::vector<double> &b);
+
+  /**
+   * @brief Evaluates the constraints of the given samples concurrently, and stores the results in _constraintEvaluations. Method for CCMA-ES.
+   * @param sampleIdxs Indexes of the samples to evaluate
+   */
+  void evaluateConstraints(const std::vector<size_t> &sampleIdxs);
+
   /**
    * @brief Update constraint evaluationsa. Method for CCMA-ES.
    */
@@ -506,6 +724,17 @@ class CMAES : public Optimizer
    */
   void discretize(std::vector<double> &sample);
 
+  /**
+   * @brief Checks whether the current run (since the last restart) met any of its termination criteria. Method for IPOP/BIPOP restarts.
+   * @return True, if the current run should be restarted.
+   */
+  bool isRunTerminated() const;
+
+  /**
+   * @brief Restarts the optimization with a new population size, initial mean, and step size, keeping the best ever sample. Method for IPOP/BIPOP restarts.
+   */
+  void restart();
+
   /**
    * @brief Configures CMA-ES.
    */
@@ -530,6 +759,11 @@ class CMAES : public Optimizer
    * @brief Final console output at termination.
    */
   void finalize() override;
+
+  /**
+   * @brief Samples in flight, one per population slot. Used by the asynchronous mode only.
+   */
+  std::vector<Sample> _asynchronousSamples;
 };
 
 } //optimizer
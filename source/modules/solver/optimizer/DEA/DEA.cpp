@@ -6,6 +6,7 @@
 
 #include <algorithm>
 #include <chrono>
+#include <cmath>
 #include <numeric>
 #include <stdio.h>
 #include <unistd.h>
@@ -26,12 +27,17 @@ void DEA::setInitialConfiguration()
     if (_k->_variables[d]->_upperBound < _k->_variables[d]->_lowerBound)
       KORALI_LOG_ERROR("Lower Bound (%.4f) of variable \'%s\'  exceeds Upper Bound (%.4f).\n", _k->_variables[d]->_lowerBound, _k->_variables[d]->_name.c_str(), _k->_variables[d]->_upperBound);
 
-  // Allocating Memory
-  _samplePopulation.resize(_populationSize);
-  for (size_t i = 0; i < _populationSize; i++) _samplePopulation[i].resize(_variableCount);
+  // The mutation needs the sample itself, two distinct difference vectors, and (for the random rule) a distinct parent
+  const size_t minPopulationSize = (_parentSelectionRule == "Random") ? 4 : 3;
+  if (_populationSize < minPopulationSize) KORALI_LOG_ERROR("Population Size (%zu) must be at least %zu for the '%s' Parent Selection Rule.\n", _populationSize, minPopulationSize, _parentSelectionRule.c_str());
 
-  _candidatePopulation.resize(_populationSize);
-  for (size_t i = 0; i < _populationSize; i++) _candidatePopulation[i].resize(_variableCount);
+  // Results are accepted one at a time in the asynchronous mode, which only the comparison with the parent supports
+  if (_evaluationMode == "Asynchronous" && _acceptRule != "Greedy") KORALI_LOG_ERROR("Accept Rule (%s) is not supported in the Asynchronous Evaluation Mode, use 'Greedy' instead.\n", _acceptRule.c_str());
+
+  // Allocating Memory, the populations are stored row-major (one sample after the other)
+  _flatSamplePopulation.resize(_populationSize * _variableCount);
+  _flatCandidatePopulation.resize(_populationSize * _variableCount);
+  initializeBuffers();
 
   _previousMean.resize(_variableCount);
   _currentMean.resize(_variableCount);
@@ -63,13 +69,82 @@ void DEA::setInitialConfiguration()
 
   for (size_t i = 0; i < _populationSize; ++i)
     for (size_t d = 0; d < _variableCount; ++d)
-      _currentMean[d] += _samplePopulation[i][d] / ((double)_populationSize);
+      _currentMean[d] += _flatSamplePopulation[i * _variableCount + d] / ((double)_populationSize);
+
+  storePopulations();
+}
+
+void DEA::storePopulations()
+{
+  _samplePopulation.resize(_populationSize);
+  _candidatePopulation.resize(_populationSize);
+  for (size_t i = 0; i < _populationSize; ++i)
+  {
+    const auto sampleRow = _flatSamplePopulation.begin() + i * _variableCount;
+    const auto candidateRow = _flatCandidatePopulation.begin() + i * _variableCount;
+    _samplePopulation[i].assign(sampleRow, sampleRow + _variableCount);
+    _candidatePopulation[i].assign(candidateRow, candidateRow + _variableCount);
+  }
+}
+
+void DEA::loadPopulations()
+{
+  if (_samplePopulation.size() != _populationSize || _candidatePopulation.size() != _populationSize) KORALI_LOG_ERROR("Sample Population and Candidate Population must hold %zu samples.\n", _populationSize);
+
+  _flatSamplePopulation.resize(_populationSize * _variableCount);
+  _flatCandidatePopulation.resize(_populationSize * _variableCount);
+  for (size_t i = 0; i < _populationSize; ++i)
+  {
+    if (_samplePopulation[i].size() != _variableCount || _candidatePopulation[i].size() != _variableCount) KORALI_LOG_ERROR("The samples of Sample Population and Candidate Population must hold %zu variables.\n", _variableCount);
+    std::copy(_samplePopulation[i].begin(), _samplePopulation[i].end(), _flatSamplePopulation.begin() + i * _variableCount);
+    std::copy(_candidatePopulation[i].begin(), _candidatePopulation[i].end(), _flatCandidatePopulation.begin() + i * _variableCount);
+  }
+}
+
+void DEA::initializeBuffers()
+{
+  _lowerBounds.resize(_variableCount);
+  _upperBounds.resize(_variableCount);
+  for (size_t d = 0; d < _variableCount; ++d)
+  {
+    _lowerBounds[d] = _k->_variables[d]->_lowerBound;
+    _upperBounds[d] = _k->_variables[d]->_upperBound;
+  }
+
+  _randomNumbers.resize(_populationSize * getCandidateRandomNumberCount());
+}
+
+size_t DEA::getCandidateRandomNumberCount() const
+{
+  // Indices a, b, c, the forced crossover dimension, 4 numbers for the self adaptation, and one crossover and one repair number per variable
+  return 8 + 2 * _variableCount;
+}
+
+std::vector<double> DEA::getCandidate(size_t sampleIdx) const
+{
+  const auto row = _flatCandidatePopulation.begin() + sampleIdx * _variableCount;
+  return std::vector<double>(row, row + _variableCount);
 }
 
 void DEA::runGeneration()
 {
   if (_k->_currentGeneration == 1) setInitialConfiguration();
 
+  // The buffers are not part of the state, they need to be rebuilt when resuming from a file
+  initializeBuffers();
+  if (_flatSamplePopulation.empty()) loadPopulations();
+
+  // The samples in flight when the state was saved are lost in a resumed run
+  if (_asynchronousSamples.empty() && _asynchronousCandidateIndexes.empty() == false) resumeAsynchronousSamples();
+
+  // Once the population has been evaluated, the asynchronous (steady-state) mode replaces its samples as soon as results arrive
+  if (_asynchronousSamples.empty() == false)
+  {
+    runAsynchronousGeneration();
+    storePopulations();
+    return;
+  }
+
   prepareGeneration();
 
   // Initializing Sample Evaluation
@@ -78,7 +153,7 @@ void DEA::runGeneration()
   {
     samples[i]["Module"] = "Problem";
     samples[i]["Operation"] = "Evaluate";
-    samples[i]["Parameters"] = _candidatePopulation[i];
+    samples[i]["Parameters"] = getCandidate(i);
     samples[i]["Sample Id"] = i;
     _modelEvaluationCount++;
     KORALI_START(samples[i]);
@@ -88,49 +163,190 @@ void DEA::runGeneration()
   KORALI_WAITALL(samples);
 
   updateSolver(samples);
+
+  if (_evaluationMode == "Asynchronous")
+  {
+    // In the first generation, the candidates became the population (all of them are better than their -Inf parents)
+    if (_k->_currentGeneration == 1) _sampleValueVector = _valueVector;
+
+    _asynchronousSamples.resize(_populationSize);
+    for (size_t i = 0; i < _populationSize; i++) startAsynchronousSample(i);
+    _asynchronousCandidateIndexes.resize(_populationSize);
+    std::iota(_asynchronousCandidateIndexes.begin(), _asynchronousCandidateIndexes.end(), 0);
+  }
+
+  storePopulations();
+}
+
+void DEA::runAsynchronousGeneration()
+{
+  size_t inFlightCount = 0;
+  for (size_t i = 0; i < _asynchronousSamples.size(); i++)
+    if (_asynchronousSamples[i]._state != SampleState::uninitialized) inFlightCount++;
+
+  const size_t quorum = std::min(_asynchronousQuorum == 0 ? _populationSize : _asynchronousQuorum, inFlightCount);
+
+  _previousBestEverValue = _bestEverValue;
+  _previousBestValue = _currentBestValue;
+  _previousMean = _currentMean;
+  _currentBestValue = -Inf;
+
+  for (size_t j = 0; j < quorum; j++)
+  {
+    const size_t i = KORALI_WAITANY(_asynchronousSamples);
+    const double value = KORALI_GET(double, _asynchronousSamples[i], "F(x)");
+    _valueVector[i] = value;
+
+    if (value > _currentBestValue)
+    {
+      _currentBestValue = value;
+      _currentBestVariables = getCandidate(i);
+    }
+
+    // The candidate replaces its parent right away (Greedy rule), so that the next candidates already mutate from it
+    if (value > _sampleValueVector[i])
+    {
+      std::copy_n(&_flatCandidatePopulation[i * _variableCount], _variableCount, &_flatSamplePopulation[i * _variableCount]);
+      _sampleValueVector[i] = value;
+      if (value > _sampleValueVector[_bestSampleIndex]) _bestSampleIndex = i;
+    }
+
+    if (value > _bestEverValue)
+    {
+      _bestEverValue = value;
+      _bestEverVariables = getCandidate(i);
+    }
+
+    // Sending the next candidate to the worker that just became free
+    if (_modelEvaluationCount < _maxModelEvaluations) startAsynchronousSample(i);
+  }
+
+  // The candidates in flight stay in the candidate population, saving their indexes is enough to resume them
+  _asynchronousCandidateIndexes.clear();
+  for (size_t i = 0; i < _asynchronousSamples.size(); i++)
+    if (_asynchronousSamples[i]._state != SampleState::uninitialized) _asynchronousCandidateIndexes.push_back(i);
+
+  updatePopulationStatistics();
+}
+
+void DEA::startAsynchronousSample(size_t sampleIdx)
+{
+  // Each free worker gets a single candidate, drawing only the random numbers it needs
+  double *randomNumbers = _randomNumbers.data();
+  _uniformGenerator->getRandomVector(randomNumbers, getCandidateRandomNumberCount());
+  prepareCandidate(sampleIdx, randomNumbers);
+
+  auto &sample = _asynchronousSamples[sampleIdx];
+  sample._js.getJson() = knlohmann::json();
+  sample._buffers.clear();
+
+  sample["Module"] = "Problem";
+  sample["Operation"] = "Evaluate";
+  sample["Parameters"] = getCandidate(sampleIdx);
+  sample["Sample Id"] = sampleIdx;
+  _modelEvaluationCount++;
+
+  KORALI_START(sample);
+}
+
+void DEA::finishAsynchronousSamples()
+{
+  std::vector<size_t> inFlightSampleIdxs;
+  for (size_t i = 0; i < _asynchronousSamples.size(); i++)
+    if (_asynchronousSamples[i]._state != SampleState::uninitialized) inFlightSampleIdxs.push_back(i);
+
+  KORALI_WAITALL(_asynchronousSamples);
+
+  // The remaining results may still improve the best ever sample
+  for (size_t i : inFlightSampleIdxs)
+  {
+    const double value = KORALI_GET(double, _asynchronousSamples[i], "F(x)");
+    if (value > _bestEverValue)
+    {
+      _bestEverValue = value;
+      _bestEverVariables = getCandidate(i);
+    }
+  }
+
+  _asynchronousSamples.clear();
+  _asynchronousCandidateIndexes.clear();
+}
+
+void DEA::resumeAsynchronousSamples()
+{
+  _asynchronousSamples.resize(_populationSize);
+
+  // Their evaluations were already counted when they were first started
+  for (size_t i : _asynchronousCandidateIndexes)
+  {
+    auto &sample = _asynchronousSamples[i];
+    sample["Module"] = "Problem";
+    sample["Operation"] = "Evaluate";
+    sample["Parameters"] = getCandidate(i);
+    sample["Sample Id"] = i;
+
+    KORALI_START(sample);
+  }
 }
 
 void DEA::initSamples()
 {
   /* skip sampling in gen 1 */
+  const size_t sampleCount = _populationSize * _variableCount;
+  _uniformGenerator->getRandomVector(_randomNumbers.data(), sampleCount);
+
   for (size_t i = 0; i < _populationSize; ++i)
     for (size_t d = 0; d < _variableCount; ++d)
     {
-      double width = _k->_variables[d]->_upperBound - _k->_variables[d]->_lowerBound;
-      _candidatePopulation[i][d] = _k->_variables[d]->_lowerBound + width * _uniformGenerator->getRandomNumber();
-      _samplePopulation[i][d] = _candidatePopulation[i][d];
+      const size_t idx = i * _variableCount + d;
+      _flatCandidatePopulation[idx] = _lowerBounds[d] + (_upperBounds[d] - _lowerBounds[d]) * _randomNumbers[idx];
     }
+
+  std::copy(_flatCandidatePopulation.begin(), _flatCandidatePopulation.end(), _flatSamplePopulation.begin());
 }
 
 void DEA::prepareGeneration()
 {
   /* at gen 1 candidates initialized in initialize() */
   if (_k->_currentGeneration > 1)
-    for (size_t i = 0; i < _populationSize; ++i)
-    {
-      bool isFeasible = true;
-      do
-      {
-        mutateSingle(i);
-        if (_fixInfeasible && isFeasible == false) fixInfeasible(i);
+  {
+    // Drawing the random numbers of the whole generation at once
+    const size_t randomNumberCount = getCandidateRandomNumberCount();
+    _uniformGenerator->getRandomVector(_randomNumbers.data(), _populationSize * randomNumberCount);
 
-        isFeasible = isSampleFeasible(_candidatePopulation[i]);
-      } while (isFeasible == false);
-    }
+    for (size_t i = 0; i < _populationSize; ++i) prepareCandidate(i, &_randomNumbers[i * randomNumberCount]);
+  }
   _previousValueVector = _valueVector;
 }
 
-void DEA::mutateSingle(size_t sampleIdx)
+void DEA::prepareCandidate(size_t sampleIdx, double *randomNumbers)
 {
-  size_t a, b;
-  do
+  mutateSingle(sampleIdx, randomNumbers);
+
+  if (_fixInfeasible)
   {
-    a = _uniformGenerator->getRandomNumber() * _populationSize;
-  } while (a == sampleIdx);
-  do
+    fixInfeasible(sampleIdx, randomNumbers + 8 + _variableCount);
+    return;
+  }
+
+  // Otherwise, mutating again until the candidate is feasible
+  while (isCandidateFeasible(sampleIdx) == false)
   {
-    b = _uniformGenerator->getRandomNumber() * _populationSize;
-  } while (b == sampleIdx || b == a);
+    _uniformGenerator->getRandomVector(randomNumbers, getCandidateRandomNumberCount());
+    mutateSingle(sampleIdx, randomNumbers);
+  }
+}
+
+void DEA::mutateSingle(size_t sampleIdx, const double *randomNumbers)
+{
+  // Drawing distinct indices without rejection, by shifting each draw past the (sorted) indices already taken
+  size_t a = randomNumbers[0] * (_populationSize - 1);
+  if (a >= sampleIdx) a++;
+
+  size_t taken[3] = {std::min(sampleIdx, a), std::max(sampleIdx, a), 0};
+  size_t b = randomNumbers[1] * (_populationSize - 2);
+  for (size_t k = 0; k < 2; k++)
+    if (b >= taken[k]) b++;
 
   if (_mutationRule == "Self Adaptive")
   {
@@ -140,58 +356,78 @@ void DEA::mutateSingle(size_t sampleIdx)
     double Fl = 0.1;
     double Fu = 0.9;
 
-    double rd2 = _uniformGenerator->getRandomNumber();
-    double rd3 = _uniformGenerator->getRandomNumber();
-
-    if (rd2 < tau1)
-    {
-      double rd1 = _uniformGenerator->getRandomNumber();
-      _mutationRate = Fl + rd1 * Fu;
-    }
-    if (rd3 < tau2)
-    {
-      double rd4 = _uniformGenerator->getRandomNumber();
-      _crossoverRate = rd4;
-    }
+    if (randomNumbers[5] < tau1) _mutationRate = Fl + randomNumbers[4] * Fu;
+    if (randomNumbers[6] < tau2) _crossoverRate = randomNumbers[7];
   }
 
-  double *parent;
+  const double *parent;
   if (_parentSelectionRule == "Random")
   {
-    size_t c;
-    do
-    {
-      c = _uniformGenerator->getRandomNumber() * _populationSize;
-    } while (c == sampleIdx || c == a || c == b);
-    parent = &_samplePopulation[c][0];
+    taken[2] = b;
+    std::sort(taken, taken + 3);
+
+    size_t c = randomNumbers[2] * (_populationSize - 3);
+    for (size_t k = 0; k < 3; k++)
+      if (c >= taken[k]) c++;
+    parent = &_flatSamplePopulation[c * _variableCount];
   }
   else /* _parentSelectionRule == "Best" */
   {
-    parent = &_samplePopulation[_bestSampleIndex][0];
+    parent = &_flatSamplePopulation[_bestSampleIndex * _variableCount];
   }
 
-  size_t rn = _uniformGenerator->getRandomNumber() * _variableCount;
+  // Mutation and binomial crossover, as a single branch-free pass over contiguous rows
+  const double *sample = &_flatSamplePopulation[sampleIdx * _variableCount];
+  const double *sampleA = &_flatSamplePopulation[a * _variableCount];
+  const double *sampleB = &_flatSamplePopulation[b * _variableCount];
+  const double *crossoverNumbers = randomNumbers + 8;
+  double *candidate = &_flatCandidatePopulation[sampleIdx * _variableCount];
+
+  const size_t rn = randomNumbers[3] * _variableCount;
+  const double mutationRate = _mutationRate;
+  const double crossoverRate = _crossoverRate;
   for (size_t d = 0; d < _variableCount; ++d)
   {
-    if ((_uniformGenerator->getRandomNumber() < _crossoverRate) || (d == rn))
-      _candidatePopulation[sampleIdx][d] = parent[d] + _mutationRate * (_samplePopulation[a][d] - _samplePopulation[b][d]);
-    else
-      _candidatePopulation[sampleIdx][d] = _samplePopulation[sampleIdx][d];
+    const bool isCrossed = (crossoverNumbers[d] < crossoverRate) || (d == rn);
+    candidate[d] = isCrossed ? parent[d] + mutationRate * (sampleA[d] - sampleB[d]) : sample[d];
   }
 }
 
-void DEA::fixInfeasible(size_t sampleIdx)
+void DEA::fixInfeasible(size_t sampleIdx, const double *randomNumbers)
 {
+  const double *sample = &_flatSamplePopulation[sampleIdx * _variableCount];
+  double *candidate = &_flatCandidatePopulation[sampleIdx * _variableCount];
+
+  // Bouncing back: a violated variable is replaced by a random point between the parent and the violated bound
+  size_t violationCount = 0;
   for (size_t d = 0; d < _variableCount; ++d)
   {
-    double len = 0.0;
-    if (_candidatePopulation[sampleIdx][d] < _k->_variables[d]->_lowerBound)
-      len = _candidatePopulation[sampleIdx][d] - _k->_variables[d]->_lowerBound;
-    if (_candidatePopulation[sampleIdx][d] > _k->_variables[d]->_upperBound)
-      len = _candidatePopulation[sampleIdx][d] - _k->_variables[d]->_upperBound;
-
-    _candidatePopulation[sampleIdx][d] = _samplePopulation[sampleIdx][d] - len * _uniformGenerator->getRandomNumber();
+    const double lowerBound = _lowerBounds[d];
+    const double upperBound = _upperBounds[d];
+    const double fromLower = lowerBound + randomNumbers[d] * (sample[d] - lowerBound);
+    const double fromUpper = upperBound - randomNumbers[d] * (upperBound - sample[d]);
+
+    const bool isBelow = candidate[d] < lowerBound;
+    const bool isAbove = candidate[d] > upperBound;
+    violationCount += isBelow | isAbove;
+    candidate[d] = isBelow ? fromLower : (isAbove ? fromUpper : candidate[d]);
   }
+
+  if (violationCount > 0) _infeasibleSampleCount++;
+}
+
+bool DEA::isCandidateFeasible(size_t sampleIdx)
+{
+  const double *candidate = &_flatCandidatePopulation[sampleIdx * _variableCount];
+
+  for (size_t d = 0; d < _variableCount; ++d)
+    if (std::isfinite(candidate[d]) == false || candidate[d] < _lowerBounds[d] || candidate[d] > _upperBounds[d])
+    {
+      _infeasibleSampleCount++;
+      return false;
+    }
+
+  return true;
 }
 
 void DEA::updateSolver(std::vector<Sample> &samples)
@@ -205,10 +441,9 @@ void DEA::updateSolver(std::vector<Sample> &samples)
   _previousBestValue = _currentBestValue;
   _currentBestValue = _valueVector[_bestSampleIndex];
 
-  for (size_t d = 0; d < _variableCount; ++d) _currentBestVariables[d] = _candidatePopulation[_bestSampleIndex][d];
+  std::copy_n(&_flatCandidatePopulation[_bestSampleIndex * _variableCount], _variableCount, _currentBestVariables.begin());
 
   _previousMean = _currentMean;
-  std::fill(std::begin(_currentMean), std::end(_currentMean), 0.0);
 
   if (_currentBestValue > _bestEverValue) _bestEverVariables = _currentBestVariables;
 
@@ -218,7 +453,7 @@ void DEA::updateSolver(std::vector<Sample> &samples)
   {
     if (_currentBestValue > _bestEverValue)
     {
-      for (size_t d = 0; d < _variableCount; ++d) _samplePopulation[_bestSampleIndex][d] = _candidatePopulation[_bestSampleIndex][d];
+      std::copy_n(&_flatCandidatePopulation[_bestSampleIndex * _variableCount], _variableCount, &_flatSamplePopulation[_bestSampleIndex * _variableCount]);
       _bestEverValue = _currentBestValue;
     }
     acceptRuleRecognized = true;
@@ -228,7 +463,7 @@ void DEA::updateSolver(std::vector<Sample> &samples)
   {
     for (size_t i = 0; i < _populationSize; ++i)
       if (_valueVector[i] > _previousValueVector[i])
-        _samplePopulation[i] = _candidatePopulation[i];
+        std::copy_n(&_flatCandidatePopulation[i * _variableCount], _variableCount, &_flatSamplePopulation[i * _variableCount]);
     if (_currentBestValue > _bestEverValue)
     {
       _bestEverValue = _currentBestValue;
@@ -240,7 +475,7 @@ void DEA::updateSolver(std::vector<Sample> &samples)
   {
     for (size_t i = 0; i < _populationSize; ++i)
       if (_valueVector[i] > _bestEverValue)
-        for (size_t d = 0; d < _variableCount; ++d) _samplePopulation[i][d] = _candidatePopulation[i][d];
+        std::copy_n(&_flatCandidatePopulation[i * _variableCount], _variableCount, &_flatSamplePopulation[i * _variableCount]);
     if (_currentBestValue > _bestEverValue)
     {
       _bestEverValue = _currentBestValue;
@@ -252,19 +487,25 @@ void DEA::updateSolver(std::vector<Sample> &samples)
   {
     for (size_t i = 0; i < _populationSize; ++i)
       if (_valueVector[i] > _bestEverValue)
-        for (size_t d = 0; d < _variableCount; ++d)
-        {
-          _samplePopulation[i][d] = _candidatePopulation[i][d];
-          _bestEverValue = _valueVector[i];
-        }
+      {
+        std::copy_n(&_flatCandidatePopulation[i * _variableCount], _variableCount, &_flatSamplePopulation[i * _variableCount]);
+        _bestEverValue = _valueVector[i];
+      }
     acceptRuleRecognized = true;
   }
 
   if (acceptRuleRecognized == false) KORALI_LOG_ERROR("Accept Rule (%s) not recognized.\n", _acceptRule.c_str());
 
+  updatePopulationStatistics();
+}
+
+void DEA::updatePopulationStatistics()
+{
+  std::fill(std::begin(_currentMean), std::end(_currentMean), 0.0);
+
   for (size_t i = 0; i < _populationSize; ++i)
     for (size_t d = 0; d < _variableCount; ++d)
-      _currentMean[d] += _samplePopulation[i][d] / ((double)_populationSize);
+      _currentMean[d] += _flatSamplePopulation[i * _variableCount + d] / ((double)_populationSize);
 
   for (size_t d = 0; d < _variableCount; ++d)
   {
@@ -272,8 +513,8 @@ void DEA::updateSolver(std::vector<Sample> &samples)
     double min = +Inf;
     for (size_t i = 0; i < _populationSize; ++i)
     {
-      if (_samplePopulation[i][d] > max) max = _samplePopulation[i][d];
-      if (_samplePopulation[i][d] < min) min = _samplePopulation[i][d];
+      max = std::max(max, _flatSamplePopulation[i * _variableCount + d]);
+      min = std::min(min, _flatSamplePopulation[i * _variableCount + d]);
     }
     _maxDistances[d] = max - min;
   }
@@ -300,6 +541,8 @@ void DEA::printGenerationAfter()
 
 void DEA::finalize()
 {
+  if (_asynchronousSamples.empty() == false) finishAsynchronousSamples();
+
   // Updating Results
   (*_k)["Results"]["Best Sample"]["F(x)"] = _bestEverValue;
   (*_k)["Results"]["Best Sample"]["Parameters"] = _bestEverVariables;
@@ -364,6 +607,14 @@ void DEA::setConfiguration(knlohmann::json& js)
    eraseValue(js, "Candidate Population");
  }
 
+ if (isDefined(js, "Asynchronous Candidate Indexes"))
+ {
+ try { _asynchronousCandidateIndexes = js["Asynchronous Candidate Indexes"].get<std::vector<size_t>>();
+} catch (const std::exception& e)
+ { KORALI_LOG_ERROR(" + Object: [ DEA ] \n + Key:    ['Asynchronous Candidate Indexes']\n%s", e.what()); } 
+   eraseValue(js, "Asynchronous Candidate Indexes");
+ }
+
  if (isDefined(js, "Best Sample Index"))
  {
  try { _bestSampleIndex = js["Best Sample Index"].get<size_t>();
@@ -420,6 +671,14 @@ void DEA::setConfiguration(knlohmann::json& js)
    eraseValue(js, "Current Minimum Step Size");
  }
 
+ if (isDefined(js, "Sample Value Vector"))
+ {
+ try { _sampleValueVector = js["Sample Value Vector"].get<std::vector<double>>();
+} catch (const std::exception& e)
+ { KORALI_LOG_ERROR(" + Object: [ DEA ] \n + Key:    ['Sample Value Vector']\n%s", e.what()); } 
+   eraseValue(js, "Sample Value Vector");
+ }
+
  if (isDefined(js, "Population Size"))
  {
  try { _populationSize = js["Population Size"].get<size_t>();
@@ -503,6 +762,30 @@ void DEA::setConfiguration(knlohmann::json& js)
  }
   else   KORALI_LOG_ERROR(" + No value provided for mandatory setting: ['Fix Infeasible'] required by DEA.\n"); 
 
+ if (isDefined(js, "Evaluation Mode"))
+ {
+ try { _evaluationMode = js["Evaluation Mode"].get<std::string>();
+} catch (const std::exception& e)
+ { KORALI_LOG_ERROR(" + Object: [ DEA ] \n + Key:    ['Evaluation Mode']\n%s", e.what()); } 
+{
+ bool validOption = false; 
+ if (_evaluationMode == "Generational") validOption = true; 
+ if (_evaluationMode == "Asynchronous") validOption = true; 
+ if (validOption == false) KORALI_LOG_ERROR(" + Unrecognized value (%s) provided for mandatory setting: ['Evaluation Mode'] required by DEA.\n", _evaluationMode.c_str()); 
+}
+   eraseValue(js, "Evaluation Mode");
+ }
+  else   KORALI_LOG_ERROR(" + No value provided for mandatory setting: ['Evaluation Mode'] required by DEA.\n"); 
+
+ if (isDefined(js, "Asynchronous Quorum"))
+ {
+ try { _asynchronousQuorum = js["Asynchronous Quorum"].get<size_t>();
+} catch (const std::exception& e)
+ { KORALI_LOG_ERROR(" + Object: [ DEA ] \n + Key:    ['Asynchronous Quorum']\n%s", e.what()); } 
+   eraseValue(js, "Asynchronous Quorum");
+ }
+  else   KORALI_LOG_ERROR(" + No value provided for mandatory setting: ['Asynchronous Quorum'] required by DEA.\n"); 
+
  if (isDefined(js, "Termination Criteria", "Min Value"))
  {
  try { _minValue = js["Termination Criteria"]["Min Value"].get<double>();
@@ -541,6 +824,8 @@ void DEA::getConfiguration(knlohmann::json& js)
    js["Parent Selection Rule"] = _parentSelectionRule;
    js["Accept Rule"] = _acceptRule;
    js["Fix Infeasible"] = _fixInfeasible;
+   js["Evaluation Mode"] = _evaluationMode;
+   js["Asynchronous Quorum"] = _asynchronousQuorum;
    js["Termination Criteria"]["Min Value"] = _minValue;
    js["Termination Criteria"]["Min Step Size"] = _minStepSize;
  if(_normalGenerator != NULL) _normalGenerator->getConfiguration(js["Normal Generator"]);
@@ -549,6 +834,7 @@ void DEA::getConfiguration(knlohmann::json& js)
    js["Previous Value Vector"] = _previousValueVector;
    js["Sample Population"] = _samplePopulation;
    js["Candidate Population"] = _candidatePopulation;
+   js["Asynchronous Candidate Indexes"] = _asynchronousCandidateIndexes;
    js["Best Sample Index"] = _bestSampleIndex;
    js["Previous Best Ever Value"] = _previousBestEverValue;
    js["Current Mean"] = _currentMean;
@@ -556,6 +842,7 @@ void DEA::getConfiguration(knlohmann::json& js)
    js["Current Best Variables"] = _currentBestVariables;
    js["Max Distances"] = _maxDistances;
    js["Current Minimum Step Size"] = _currentMinimumStepSize;
+   js["Sample Value Vector"] = _sampleValueVector;
  for (size_t i = 0; i <  _k->_variables.size(); i++) { 
  } 
  Optimizer::getConfiguration(js);
@@ -564,7 +851,7 @@ void DEA::getConfiguration(knlohmann::json& js)
 void DEA::applyModuleDefaults(knlohmann::json& js) 
 {
 
- std::string defaultString = "{\"Population Size\": 200, \"Crossover Rate\": 0.9, \"Mutation Rate\": 0.5, \"Mutation Rule\": \"Fixed\", \"Parent Selection Rule\": \"Random\", \"Accept Rule\": \"Greedy\", \"Fix Infeasible\": true, \"Termination Criteria\": {\"Min Value\": -Infinity, \"Max Value\": Infinity, \"Min Step Size\": -Infinity}, \"Uniform Generator\": {\"Type\": \"Univariate/Uniform\", \"Minimum\": 0.0, \"Maximum\": 1.0}, \"Normal Generator\": {\"Type\": \"Univariate/Normal\", \"Mean\": 0.0, \"Standard Deviation\": 1.0}, \"Value Vector\": [], \"Previous Value Vector\": [], \"Sample Population\": [[]], \"Candidate Population\": [[]], \"Best Sample Index\": 0, \"Best Ever Value\": -Infinity, \"Previous Best Ever Value\": -Infinity, \"Current Mean\": [], \"Previous Mean\": [], \"Current Best Variables\": [], \"Max Distances\": [], \"Current Minimum Step Size\": 0.0}";
+ std::string defaultString = "{\"Population Size\": 200, \"Crossover Rate\": 0.9, \"Mutation Rate\": 0.5, \"Mutation Rule\": \"Fixed\", \"Parent Selection Rule\": \"Random\", \"Accept Rule\": \"Greedy\", \"Fix Infeasible\": true, \"Evaluation Mode\": \"Generational\", \"Asynchronous Quorum\": 0, \"Termination Criteria\": {\"Min Value\": -Infinity, \"Max Value\": Infinity, \"Min Step Size\": -Infinity}, \"Uniform Generator\": {\"Type\": \"Univariate/Uniform\", \"Minimum\": 0.0, \"Maximum\": 1.0}, \"Normal Generator\": {\"Type\": \"Univariate/Normal\", \"Mean\": 0.0, \"Standard Deviation\": 1.0}, \"Value Vector\": [], \"Previous Value Vector\": [], \"Sample Population\": [[]], \"Candidate Population\": [[]], \"Asynchronous Candidate Indexes\": [], \"Best Sample Index\": 0, \"Best Ever Value\": -Infinity, \"Previous Best Ever Value\": -Infinity, \"Current Mean\": [], \"Previous Mean\": [], \"Current Best Variables\": [], \"Max Distances\": [], \"Current Minimum Step Size\": 0.0}";
  knlohmann::json defaultJs = knlohmann::json::parse(defaultString);
  mergeJson(js, defaultJs); 
  Optimizer::applyModuleDefaults(js);
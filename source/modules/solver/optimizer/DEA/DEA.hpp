@@ -31,17 +31,64 @@ namespace optimizer
 class DEA : public Optimizer
 {
   private:
+  /**
+   * @brief Sample population, stored row-major (sample by sample) while generating candidates. The results keep the nested Sample Population.
+   */
+  std::vector<double> _flatSamplePopulation;
+
+  /**
+   * @brief Candidate population, stored row-major (sample by sample) while generating candidates. The results keep the nested Candidate Population.
+   */
+  std::vector<double> _flatCandidatePopulation;
+
+  /**
+   * @brief Copies the flat populations into the nested ones of the results.
+   */
+  void storePopulations();
+
+  /**
+   * @brief Rebuilds the flat populations from the nested ones of the results, when resuming.
+   */
+  void loadPopulations();
+
   /**
    * @brief Mutate a sample.
    * @param sampleIdx Index of sample to be mutated.
+   * @param randomNumbers Uniform random numbers of the candidate (see getCandidateRandomNumberCount).
    */
-  void mutateSingle(size_t sampleIdx);
+  void mutateSingle(size_t sampleIdx, const double *randomNumbers);
 
   /**
-   * @brief Fix sample params that are outside of domain.
+   * @brief Fix sample params that are outside of domain, by bouncing them back between the parent and the violated bound.
    * @param sampleIdx Index of sample that is outside of domain.
+   * @param randomNumbers Uniform random numbers, one per variable.
    */
-  void fixInfeasible(size_t sampleIdx);
+  void fixInfeasible(size_t sampleIdx, const double *randomNumbers);
+
+  /**
+   * @brief Checks whether a candidate is finite and inside the bounds, counting it as infeasible otherwise.
+   * @param sampleIdx Index of the candidate.
+   * @return True, if the candidate is feasible.
+   */
+  bool isCandidateFeasible(size_t sampleIdx);
+
+  /**
+   * @brief Returns the number of uniform random numbers needed to prepare a single candidate.
+   * @return The number of random numbers.
+   */
+  size_t getCandidateRandomNumberCount() const;
+
+  /**
+   * @brief Copies a candidate out of the flat candidate population.
+   * @param sampleIdx Index of the candidate.
+   * @return The variables of the candidate.
+   */
+  std::vector<double> getCandidate(size_t sampleIdx) const;
+
+  /**
+   * @brief Caches the variable bounds and allocates the random number buffer, so that generating candidates does not allocate.
+   */
+  void initializeBuffers();
 
   /**
    * @brief Update the state of Differential Evolution
@@ -59,6 +106,59 @@ class DEA : public Optimizer
    */
   void prepareGeneration();
 
+  /**
+   * @brief Mutates a sample and repairs its candidate (or, without Fix Infeasible, mutates it again until it is feasible).
+   * @param sampleIdx Index of the sample to mutate.
+   * @param randomNumbers Uniform random numbers of the candidate, redrawn in place when the candidate is rejected.
+   */
+  void prepareCandidate(size_t sampleIdx, double *randomNumbers);
+
+  /**
+   * @brief Updates the mean, the spread, and the step size of the population.
+   */
+  void updatePopulationStatistics();
+
+  /**
+   * @brief Processes the next quorum of results, replacing the parents as they arrive and sending new candidates to the free workers. Method for the asynchronous mode.
+   */
+  void runAsynchronousGeneration();
+
+  /**
+   * @brief Mutates a sample and starts the evaluation of its candidate. Method for the asynchronous mode.
+   * @param sampleIdx Index of the sample to mutate.
+   */
+  void startAsynchronousSample(size_t sampleIdx);
+
+  /**
+   * @brief Waits for the samples still in flight, keeping their results only for the best ever sample. Method for the asynchronous mode.
+   */
+  void finishAsynchronousSamples();
+
+  /**
+   * @brief Starts again the evaluation of the samples that were in flight when the state was saved, since a resumed run has lost them. Method for the asynchronous mode.
+   */
+  void resumeAsynchronousSamples();
+
+  /**
+   * @brief Candidates in flight, one per sample of the population. Used by the asynchronous mode only.
+   */
+  std::vector<Sample> _asynchronousSamples;
+
+  /**
+   * @brief Lower bounds of the variables, stored contiguously for the repair.
+   */
+  std::vector<double> _lowerBounds;
+
+  /**
+   * @brief Upper bounds of the variables, stored contiguously for the repair.
+   */
+  std::vector<double> _upperBounds;
+
+  /**
+   * @brief Uniform random numbers of the current generation, stored contiguously per candidate.
+   */
+  std::vector<double> _randomNumbers;
+
   public: 
   /**
   * @brief Specifies the number of samples to evaluate per generation (preferably 5-10x the number of variables).
@@ -85,10 +185,18 @@ class DEA : public Optimizer
   */
    std::string _acceptRule;
   /**
-  * @brief If set true, Korali samples a random sample between Parent and the voiolated boundary. If set false, infeasible samples are mutated again until feasible.
+  * @brief If set true, every variable that violates its bounds is bounced back to a random point between the parent and the violated bound. If set false, infeasible samples are mutated again until feasible.
   */
    int _fixInfeasible;
   /**
+  * @brief Determines how the evaluations of a generation are synchronized. The asynchronous mode keeps the workers busy when the model runtime varies. This mode only supports the Greedy Accept Rule.
+  */
+   std::string _evaluationMode;
+  /**
+  * @brief Number of results processed per generation in the asynchronous mode (by default the Population Size).
+  */
+   size_t _asynchronousQuorum;
+  /**
   * @brief [Internal Use] Normal random number generator.
   */
    korali::distribution::univariate::Normal* _normalGenerator;
@@ -113,6 +221,10 @@ class DEA : public Optimizer
   */
    std::vector<std::vector<double>> _candidatePopulation;
   /**
+  * @brief [Internal Use] Indexes of the candidates in flight (asynchronous mode). A resumed run evaluates them again.
+  */
+   std::vector<size_t> _asynchronousCandidateIndexes;
+  /**
   * @brief [Internal Use] Index of the best sample in current generation.
   */
    size_t _bestSampleIndex;
@@ -141,6 +253,10 @@ class DEA : public Optimizer
   */
    double _currentMinimumStepSize;
   /**
+  * @brief [Internal Use] Objective Function Values of the sample population (asynchronous mode).
+  */
+   std::vector<double> _sampleValueVector;
+  /**
   * @brief [Termination Criteria] Specifies the target fitness to stop minimization.
   */
    double _minValue;
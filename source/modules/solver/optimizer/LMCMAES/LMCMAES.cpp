@@ -0,0 +1,350 @@
+#include "engine.hpp"
+#include "modules/solver/optimizer/LMCMAES/LMCMAES.hpp"
+#include "sample/sample.hpp"
+
+#include <algorithm>
+#include <cmath>
+
+namespace korali
+{
+namespace solver
+{
+namespace optimizer
+{
+;
+
+void LMCMAES::setInitialConfiguration()
+{
+  _variableCount = _k->_variables.size();
+
+  if (_variableCount < 2) KORALI_LOG_ERROR("LMCMAES requires at least 2 variables (is %zu).\n", _variableCount);
+  if (_diagonalCovariance) KORALI_LOG_ERROR("'Diagonal Covariance' is not applicable to LMCMAES.\n");
+
+  if (_memorySize == 0) _memorySize = 4 + std::floor(3.0 * std::log((double)_variableCount));
+
+  // Configuring the CMA-ES internals, which calls back initCovariance() for the limited-memory representation
+  CMAES::setInitialConfiguration();
+}
+
+void LMCMAES::initCovariance()
+{
+  // Setting Sigma
+  _trace = 0.0;
+  for (size_t i = 0; i < _variableCount; ++i) _trace += _k->_variables[i]->_initialStandardDeviation * _k->_variables[i]->_initialStandardDeviation;
+  _sigma = sqrt(_trace / _variableCount);
+
+  // The axis lengths hold the (fixed) scaling of the variables, the direction vectors learn their dependencies
+  _covarianceDiagonalEstimate.resize(_variableCount);
+  for (size_t i = 0; i < _variableCount; ++i)
+  {
+    _axisLengths[i] = _k->_variables[i]->_initialStandardDeviation * sqrt(_variableCount / _trace);
+    _covarianceDiagonalEstimate[i] = _axisLengths[i] * _axisLengths[i];
+  }
+
+  _directionVectors.resize(_memorySize);
+  for (size_t j = 0; j < _memorySize; j++) _directionVectors[j].assign(_variableCount, 0.0);
+  _activeDirectionCount = 0;
+
+  _constraintCorrectionDirections.clear();
+  _constraintCorrectionFactors.clear();
+
+  // There is no eigensystem to update
+  _isEigensystemUpdated = true;
+
+  updateCovarianceStatistics();
+}
+
+double LMCMAES::getDirectionLearningRate(size_t j) const
+{
+  return 1.0 / (std::pow(1.5, j) * _variableCount);
+}
+
+double LMCMAES::getPathLearningRate(size_t j) const
+{
+  return std::min(1.0, _currentPopulationSize / (std::pow(4.0, j) * _variableCount));
+}
+
+void LMCMAES::multiplyDirections(std::vector<double> &x, const bool transpose) const
+{
+  // Every direction vector m contributes a symmetric factor (1-c) I + c m m^T
+  for (size_t k = 0; k < _activeDirectionCount; k++)
+  {
+    const size_t j = transpose ? _activeDirectionCount - 1 - k : k;
+    const double c = getDirectionLearningRate(j);
+    const auto &m = _directionVectors[j];
+
+    double dot = 0.0;
+    for (size_t d = 0; d < _variableCount; ++d) dot += m[d] * x[d];
+    for (size_t d = 0; d < _variableCount; ++d) x[d] = (1.0 - c) * x[d] + c * dot * m[d];
+  }
+}
+
+void LMCMAES::solveDirections(std::vector<double> &x) const
+{
+  // Inverting the factors in reverse order, with the Sherman-Morrison formula
+  for (size_t k = 0; k < _activeDirectionCount; k++)
+  {
+    const size_t j = _activeDirectionCount - 1 - k;
+    const double c = getDirectionLearningRate(j);
+    const auto &m = _directionVectors[j];
+
+    double dot = 0.0;
+    double m2 = 0.0;
+    for (size_t d = 0; d < _variableCount; ++d)
+    {
+      dot += m[d] * x[d];
+      m2 += m[d] * m[d];
+    }
+
+    const double scale = c * dot / ((1.0 - c) + c * m2);
+    for (size_t d = 0; d < _variableCount; ++d) x[d] = (x[d] - scale * m[d]) / (1.0 - c);
+  }
+}
+
+void LMCMAES::sampleSingle(size_t sampleIdx, const std::vector<double> &randomNumbers)
+{
+  std::vector<double> y(randomNumbers.begin(), randomNumbers.begin() + _variableCount);
+
+  multiplyDirections(y, false);
+  for (size_t d = 0; d < _variableCount; ++d) y[d] *= _axisLengths[d];
+
+  // Contracting the step along the constraint normals, if any
+  for (size_t k = 0; k < _constraintCorrectionDirections.size(); k++)
+  {
+    const auto &n = _constraintCorrectionDirections[k];
+
+    double dot = 0.0;
+    for (size_t d = 0; d < _variableCount; ++d) dot += n[d] * y[d];
+    for (size_t d = 0; d < _variableCount; ++d) y[d] -= _constraintCorrectionFactors[k] * dot * n[d];
+  }
+
+  for (size_t d = 0; d < _variableCount; ++d)
+  {
+    _bDZMatrix[sampleIdx * _variableCount + d] = y[d];
+    _samplePopulation[sampleIdx][d] = _currentMean[d] + _sigma * y[d];
+  }
+
+  if (_hasDiscreteVariables) applyDiscreteMutations(sampleIdx);
+}
+
+void LMCMAES::sampleBatch(const std::vector<double> &randomNumbers)
+{
+  for (size_t i = 0; i < _currentPopulationSize; ++i)
+  {
+    std::vector<double> rands(randomNumbers.begin() + i * _variableCount, randomNumbers.begin() + (i + 1) * _variableCount);
+    sampleSingle(i, rands);
+  }
+}
+
+void LMCMAES::whitenMeanUpdate()
+{
+  std::vector<double> x = _meanUpdate;
+
+  // Undoing the constraint contractions, in reverse order
+  for (size_t k = _constraintCorrectionDirections.size(); k-- > 0;)
+  {
+    const auto &n = _constraintCorrectionDirections[k];
+    const double gamma = _constraintCorrectionFactors[k];
+
+    double dot = 0.0;
+    for (size_t d = 0; d < _variableCount; ++d) dot += n[d] * x[d];
+    for (size_t d = 0; d < _variableCount; ++d) x[d] += gamma / (1.0 - gamma) * dot * n[d];
+  }
+
+  for (size_t d = 0; d < _variableCount; ++d) x[d] /= _axisLengths[d];
+  solveDirections(x);
+
+  _auxiliarBDZMatrix = x;
+}
+
+void LMCMAES::adaptC(int hsig)
+{
+  // Every direction vector is an evolution path of the whitened steps, with its own learning rate
+  for (size_t j = 0; j < _memorySize; j++)
+  {
+    const double c = getPathLearningRate(j);
+    const double weight = std::sqrt(_effectiveMu * c * (2.0 - c));
+    for (size_t d = 0; d < _variableCount; ++d) _directionVectors[j][d] = (1.0 - c) * _directionVectors[j][d] + weight * _auxiliarBDZMatrix[d];
+  }
+
+  if (_activeDirectionCount < _memorySize) _activeDirectionCount++;
+
+  // The diagonal of the covariance matrix is not available, estimating it from the steps of the population
+  for (size_t d = 0; d < _variableCount; ++d)
+  {
+    double sum = 0.0;
+    for (size_t i = 0; i < _currentPopulationSize; ++i) sum += _bDZMatrix[i * _variableCount + d] * _bDZMatrix[i * _variableCount + d];
+    _covarianceDiagonalEstimate[d] = sum / _currentPopulationSize;
+  }
+
+  // Constraint contractions only apply to the generation they were computed for
+  _constraintCorrectionDirections.clear();
+  _constraintCorrectionFactors.clear();
+
+  updateCovarianceStatistics();
+}
+
+double LMCMAES::getCovarianceDiagonal(size_t d) const
+{
+  return _covarianceDiagonalEstimate[d];
+}
+
+void LMCMAES::applyCovarianceCorrections(const std::vector<std::vector<double>> &normals, const std::vector<double> &downdates)
+{
+  std::vector<std::vector<double>> directions;
+  std::vector<double> factors;
+
+  for (size_t k = 0; k < normals.size(); k++)
+  {
+    double norm = 0.0;
+    for (size_t d = 0; d < _variableCount; ++d) norm += normals[k][d] * normals[k][d];
+    norm = std::sqrt(norm);
+
+    std::vector<double> n(_variableCount);
+    for (size_t d = 0; d < _variableCount; ++d) n[d] = normals[k][d] / norm;
+
+    // Variance of the (already contracted) distribution along the normal
+    std::vector<double> u = n;
+    for (size_t l = directions.size(); l-- > 0;)
+    {
+      double dot = 0.0;
+      for (size_t d = 0; d < _variableCount; ++d) dot += directions[l][d] * u[d];
+      for (size_t d = 0; d < _variableCount; ++d) u[d] -= factors[l] * dot * directions[l][d];
+    }
+    for (size_t d = 0; d < _variableCount; ++d) u[d] *= _axisLengths[d];
+    multiplyDirections(u, true);
+
+    double variance = 0.0;
+    for (size_t d = 0; d < _variableCount; ++d) variance += u[d] * u[d];
+
+    const double remaining = 1.0 - downdates[k] / variance;
+    if (remaining <= 0.0)
+    {
+      _k->_logger->logWarning("Detailed", "Constraint correction would remove all the variance along a constraint normal (no update possible).\n");
+      return;
+    }
+
+    directions.push_back(n);
+    factors.push_back(1.0 - std::sqrt(remaining));
+  }
+
+  _constraintCorrectionDirections = directions;
+  _constraintCorrectionFactors = factors;
+}
+
+void LMCMAES::updateCovarianceStatistics()
+{
+  _minimumDiagonalCovarianceMatrixElement = *std::min_element(std::begin(_covarianceDiagonalEstimate), std::end(_covarianceDiagonalEstimate));
+  _maximumDiagonalCovarianceMatrixElement = *std::max_element(std::begin(_covarianceDiagonalEstimate), std::end(_covarianceDiagonalEstimate));
+
+  // The eigenvalues are not available either, their range is approximated by the range of the variances
+  _minimumCovarianceEigenvalue = _minimumDiagonalCovarianceMatrixElement;
+  _maximumCovarianceEigenvalue = _maximumDiagonalCovarianceMatrixElement;
+}
+
+void LMCMAES::setConfiguration(knlohmann::json& js) 
+{
+ if (isDefined(js, "Results"))  eraseValue(js, "Results");
+
+ if (isDefined(js, "Direction Vectors"))
+ {
+ try { _directionVectors = js["Direction Vectors"].get<std::vector<std::vector<double>>>();
+} catch (const std::exception& e)
+ { KORALI_LOG_ERROR(" + Object: [ LMCMAES ] \n + Key:    ['Direction Vectors']\n%s", e.what()); } 
+   eraseValue(js, "Direction Vectors");
+ }
+
+ if (isDefined(js, "Active Direction Count"))
+ {
+ try { _activeDirectionCount = js["Active Direction Count"].get<size_t>();
+} catch (const std::exception& e)
+ { KORALI_LOG_ERROR(" + Object: [ LMCMAES ] \n + Key:    ['Active Direction Count']\n%s", e.what()); } 
+   eraseValue(js, "Active Direction Count");
+ }
+
+ if (isDefined(js, "Covariance Diagonal Estimate"))
+ {
+ try { _covarianceDiagonalEstimate = js["Covariance Diagonal Estimate"].get<std::vector<double>>();
+} catch (const std::exception& e)
+ { KORALI_LOG_ERROR(" + Object: [ LMCMAES ] \n + Key:    ['Covariance Diagonal Estimate']\n%s", e.what()); } 
+   eraseValue(js, "Covariance Diagonal Estimate");
+ }
+
+ if (isDefined(js, "Constraint Correction Directions"))
+ {
+ try { _constraintCorrectionDirections = js["Constraint Correction Directions"].get<std::vector<std::vector<double>>>();
+} catch (const std::exception& e)
+ { KORALI_LOG_ERROR(" + Object: [ LMCMAES ] \n + Key:    ['Constraint Correction Directions']\n%s", e.what()); } 
+   eraseValue(js, "Constraint Correction Directions");
+ }
+
+ if (isDefined(js, "Constraint Correction Factors"))
+ {
+ try { _constraintCorrectionFactors = js["Constraint Correction Factors"].get<std::vector<double>>();
+} catch (const std::exception& e)
+ { KORALI_LOG_ERROR(" + Object: [ LMCMAES ] \n + Key:    ['Constraint Correction Factors']\n%s", e.what()); } 
+   eraseValue(js, "Constraint Correction Factors");
+ }
+
+ if (isDefined(js, "Memory Size"))
+ {
+ try { _memorySize = js["Memory Size"].get<size_t>();
+} catch (const std::exception& e)
+ { KORALI_LOG_ERROR(" + Object: [ LMCMAES ] \n + Key:    ['Memory Size']\n%s", e.what()); } 
+   eraseValue(js, "Memory Size");
+ }
+  else   KORALI_LOG_ERROR(" + No value provided for mandatory setting: ['Memory Size'] required by LMCMAES.\n"); 
+
+ if (isDefined(_k->_js.getJson(), "Variables"))
+ for (size_t i = 0; i < _k->_js["Variables"].size(); i++) { 
+ } 
+ CMAES::setConfiguration(js);
+ _type = "optimizer/LMCMAES";
+ if(isDefined(js, "Type")) eraseValue(js, "Type");
+ if(isEmpty(js) == false) KORALI_LOG_ERROR(" + Unrecognized settings for Korali module: LMCMAES: \n%s\n", js.dump(2).c_str());
+} 
+
+void LMCMAES::getConfiguration(knlohmann::json& js) 
+{
+
+ js["Type"] = _type;
+   js["Memory Size"] = _memorySize;
+   js["Direction Vectors"] = _directionVectors;
+   js["Active Direction Count"] = _activeDirectionCount;
+   js["Covariance Diagonal Estimate"] = _covarianceDiagonalEstimate;
+   js["Constraint Correction Directions"] = _constraintCorrectionDirections;
+   js["Constraint Correction Factors"] = _constraintCorrectionFactors;
+ for (size_t i = 0; i <  _k->_variables.size(); i++) { 
+ } 
+ CMAES::getConfiguration(js);
+} 
+
+void LMCMAES::applyModuleDefaults(knlohmann::json& js) 
+{
+
+ std::string defaultString = "{\"Memory Size\": 0}";
+ knlohmann::json defaultJs = knlohmann::json::parse(defaultString);
+ mergeJson(js, defaultJs); 
+ CMAES::applyModuleDefaults(js);
+} 
+
+void LMCMAES::applyVariableDefaults() 
+{
+
+ CMAES::applyVariableDefaults();
+} 
+
+bool LMCMAES::checkTermination()
+{
+ bool hasFinished = false;
+
+ hasFinished = hasFinished || CMAES::checkTermination();
+ return hasFinished;
+}
+
+;
+
+} //optimizer
+} //solver
+} //korali
+;
@@ -0,0 +1,168 @@
+/** \namespace optimizer
+* @brief Namespace declaration for modules of type: optimizer.
+*/
+
+/** \file
+* @brief Header file for module: LMCMAES.
+*/
+
+/** \dir solver/optimizer/LMCMAES
+* @brief Contains code, documentation, and scripts for module: LMCMAES.
+*/
+
+#pragma once
+
+#include "modules/solver/optimizer/CMAES/CMAES.hpp"
+#include <vector>
+
+namespace korali
+{
+namespace solver
+{
+namespace optimizer
+{
+;
+
+/**
+* @brief Class declaration for module: LMCMAES.
+*/
+class LMCMAES : public CMAES
+{
+  public: 
+  /**
+  * @brief Number of direction vectors that represent the covariance matrix (by default $4+3*log(N)$, where $N$ is the number of variables).
+  */
+   size_t _memorySize;
+  /**
+  * @brief [Internal Use] Evolution paths, each one with a different learning rate, whose rank-one transformations generate the samples.
+  */
+   std::vector<std::vector<double>> _directionVectors;
+  /**
+  * @brief [Internal Use] Number of direction vectors in use. It grows by one every generation, up to the memory size.
+  */
+   size_t _activeDirectionCount;
+  /**
+  * @brief [Internal Use] Estimate of the diagonal of the covariance matrix, computed from the steps of the last population.
+  */
+   std::vector<double> _covarianceDiagonalEstimate;
+  /**
+  * @brief [Internal Use] Normalized approximations of the constraint normals, along which the samples of the current generation are contracted.
+  */
+   std::vector<std::vector<double>> _constraintCorrectionDirections;
+  /**
+  * @brief [Internal Use] Contraction applied to the samples along each constraint correction direction.
+  */
+   std::vector<double> _constraintCorrectionFactors;
+  
+ 
+  /**
+  * @brief Determines whether the module can trigger termination of an experiment run.
+  * @return True, if it should trigger termination; false, otherwise.
+  */
+  bool checkTermination() override;
+  /**
+  * @brief Obtains the entire current state and configuration of the module.
+  * @param js JSON object onto which to save the serialized state of the module.
+  */
+  void getConfiguration(knlohmann::json& js) override;
+  /**
+  * @brief Sets the entire state and configuration of the module, given a JSON object.
+  * @param js JSON object from which to deserialize the state of the module.
+  */
+  void setConfiguration(knlohmann::json& js) override;
+  /**
+  * @brief Applies the module's default configuration upon its creation.
+  * @param js JSON object containing user configuration. The defaults will not override any currently defined settings.
+  */
+  void applyModuleDefaults(knlohmann::json& js) override;
+  /**
+  * @brief Applies the module's default variable configuration to each variable in the Experiment upon creation.
+  */
+  void applyVariableDefaults() override;
+  
+
+  /**
+   * @brief Applies the sampling transformation (the product of the rank-one transformations of the active direction vectors) to a vector, in place.
+   * @param x Vector to transform
+   * @param transpose If true, applies the transposed transformation.
+   */
+  void multiplyDirections(std::vector<double> &x, const bool transpose) const;
+
+  /**
+   * @brief Applies the inverse of the sampling transformation to a vector, in place.
+   * @param x Vector to transform
+   */
+  void solveDirections(std::vector<double> &x) const;
+
+  /**
+   * @brief Returns the learning rate of a direction vector in the sampling transformation.
+   * @param j Index of the direction vector
+   * @return The learning rate
+   */
+  double getDirectionLearningRate(size_t j) const;
+
+  /**
+   * @brief Returns the learning rate of a direction vector in its evolution path update.
+   * @param j Index of the direction vector
+   * @return The learning rate
+   */
+  double getPathLearningRate(size_t j) const;
+
+  /**
+   * @brief Updates the extreme values of the covariance diagonal estimate, used for the output and the termination criteria.
+   */
+  void updateCovarianceStatistics();
+
+  /**
+   * @brief Generates a single sample from the limited-memory representation of the covariance matrix.
+   * @param sampleIdx Index of the sample to generate
+   * @param randomNumbers Random numbers to generate the sample
+   */
+  void sampleSingle(size_t sampleIdx, const std::vector<double> &randomNumbers) override;
+
+  /**
+   * @brief Generates the whole current population.
+   * @param randomNumbers Random numbers to generate the samples, stored contiguously per sample
+   */
+  void sampleBatch(const std::vector<double> &randomNumbers) override;
+
+  /**
+   * @brief Updates the direction vectors with the whitened mean update, and the estimate of the covariance diagonal.
+   * @param hsig Not used, the direction vectors are always updated.
+   */
+  void adaptC(int hsig) override;
+
+  /**
+   * @brief Transforms the mean update back to the isotropic space of the random numbers, and stores it in _auxiliarBDZMatrix.
+   */
+  void whitenMeanUpdate() override;
+
+  /**
+   * @brief Returns the estimate of a diagonal element of the covariance matrix (without the sigma scaling).
+   * @param d Index of the variable
+   * @return The estimated variance of the variable
+   */
+  double getCovarianceDiagonal(size_t d) const override;
+
+  /**
+   * @brief Contracts the samples of the current generation along the normal approximations of the violated constraints. Method for CCMA-ES.
+   * @param normals Normal approximations of the violated constraints
+   * @param downdates Variance to remove along each (normalized) normal
+   */
+  void applyCovarianceCorrections(const std::vector<std::vector<double>> &normals, const std::vector<double> &downdates) override;
+
+  /**
+   * @brief Initializes sigma, the variable scaling, and the direction vectors.
+   */
+  void initCovariance() override;
+
+  /**
+   * @brief Configures LM-CMA-ES.
+   */
+  void setInitialConfiguration() override;
+};
+
+} //optimizer
+} //solver
+} //korali
+;
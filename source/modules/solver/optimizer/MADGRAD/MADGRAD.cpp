@@ -18,30 +18,82 @@ void MADGRAD::setInitialConfiguration()
     if (std::isfinite(_k->_variables[i]->_initialValue) == false)
       KORALI_LOG_ERROR("Initial Value of variable \'%s\' not defined (no defaults can be calculated).\n", _k->_variables[i]->_name.c_str());
 
-  _currentVariable.resize(_variableCount);
-  for (size_t i = 0; i < _variableCount; i++)
-    _currentVariable[i] = _k->_variables[i]->_initialValue;
-
-  _bestEverVariables = _currentVariable;
-  _initialParameter = _currentVariable;
-  _gradient.resize(_variableCount, 0.0);
   _bestEverGradient.resize(_variableCount, 0);
-  _gradientSum.resize(_variableCount, 0.0);
-  _squaredGradientSum.resize(_variableCount, 0.0);
 
   _bestEverValue = -Inf;
-  _gradientNorm = 0.0;
   _scaledLearningRate = _eta;
 
   if (_eta <= 0) KORALI_LOG_ERROR("Learning Rate 'eta' must be larger 0 (is %lf).\n", _eta);
   if (_weightDecay <= 0) KORALI_LOG_ERROR("Weight decaymust be larger 0 (is %lf).\n", _weightDecay);
   if (_epsilon <= 0) KORALI_LOG_ERROR("Epsilon must be larger 0 (is %lf).\n", _epsilon);
+
+  _startStates.resize(_numberOfStarts);
+  initializeStarts(_uniformGenerator, _normalGenerator);
+  _bestEverVariables = _currentVariable;
 }
 
 void MADGRAD::runGeneration()
 {
   if (_k->_currentGeneration == 1) setInitialConfiguration();
 
+  runMultiStartGeneration();
+}
+
+void MADGRAD::resetStartState(const std::vector<double> &startingPoint)
+{
+  // The starting point is also the anchor of the dual averaging
+  _currentVariable = startingPoint;
+  _initialParameter = startingPoint;
+  _gradient.assign(_variableCount, 0.0);
+  _gradientSum.assign(_variableCount, 0.0);
+  _squaredGradientSum.assign(_variableCount, 0.0);
+  _gradientNorm = 0.0;
+}
+
+void MADGRAD::swapStartState(const size_t startId)
+{
+  auto &state = _startStates[startId];
+  std::swap(_currentVariable, state.currentVariable);
+  std::swap(_initialParameter, state.initialParameter);
+  std::swap(_gradient, state.gradient);
+  std::swap(_gradientNorm, state.gradientNorm);
+  std::swap(_gradientSum, state.gradientSum);
+  std::swap(_squaredGradientSum, state.squaredGradientSum);
+  std::swap(_currentBestValue, state.currentBestValue);
+  std::swap(_previousBestValue, state.previousBestValue);
+}
+
+void MADGRAD::getStartState(const size_t startId, knlohmann::json &js) const
+{
+  const auto &state = _startStates[startId];
+  js["Current Variable"] = state.currentVariable;
+  js["Initial Parameter"] = state.initialParameter;
+  js["Gradient"] = state.gradient;
+  js["Gradient Norm"] = state.gradientNorm;
+  js["Gradient Sum"] = state.gradientSum;
+  js["Squared Gradient Sum"] = state.squaredGradientSum;
+  js["Current Best Value"] = state.currentBestValue;
+  js["Previous Best Value"] = state.previousBestValue;
+}
+
+void MADGRAD::setStartState(const size_t startId, const knlohmann::json &js)
+{
+  // When resuming, the states of the starts are rebuilt from the stored results
+  if (_startStates.size() != _numberOfStarts) _startStates.resize(_numberOfStarts);
+
+  auto &state = _startStates[startId];
+  state.currentVariable = js["Current Variable"].get<std::vector<double>>();
+  state.initialParameter = js["Initial Parameter"].get<std::vector<double>>();
+  state.gradient = js["Gradient"].get<std::vector<double>>();
+  state.gradientNorm = js["Gradient Norm"].get<double>();
+  state.gradientSum = js["Gradient Sum"].get<std::vector<double>>();
+  state.squaredGradientSum = js["Squared Gradient Sum"].get<std::vector<double>>();
+  state.currentBestValue = js["Current Best Value"].get<double>();
+  state.previousBestValue = js["Previous Best Value"].get<double>();
+}
+
+const std::vector<double> &MADGRAD::updateStartParameters()
+{
   // update parameters
   for (size_t i = 0; i < _variableCount; i++)
   {
@@ -49,25 +101,10 @@ void MADGRAD::runGeneration()
     _currentVariable[i] = (1.0 - _weightDecay) * _currentVariable[i] + _weightDecay * intermediateParam;
   }
 
-  // Initializing Sample Evaluation
-  Sample sample;
-  sample["Module"] = "Problem";
-  sample["Operation"] = "Evaluate With Gradients";
-  sample["Parameters"] = _currentVariable;
-  sample["Sample Id"] = 0;
-  KORALI_START(sample);
-
-  // Waiting for sample to finish
-  KORALI_WAIT(sample);
-
-  auto evaluation = KORALI_GET(double, sample, "F(x)");
-  auto gradient = KORALI_GET(std::vector<double>, sample, "Gradient");
-
-  // Processing results
-  processResult(evaluation, gradient);
+  return _currentVariable;
 }
 
-void MADGRAD::processResult(double evaluation, std::vector<double> &gradient)
+void MADGRAD::processStartEvaluation(const double evaluation, const std::vector<double> &gradient)
 {
   _modelEvaluationCount++;
   _previousBestValue = _currentBestValue;
@@ -101,6 +138,8 @@ void MADGRAD::printGenerationBefore()
 
 void MADGRAD::printGenerationAfter()
 {
+  if (_numberOfStarts > 1) _k->_logger->logInfo("Normal", "Best Start: %zu/%zu\n", _currentStart + 1, _numberOfStarts);
+
   _k->_logger->logInfo("Normal", "x = [ ");
   for (size_t k = 0; k < _variableCount; k++) _k->_logger->logData("Normal", " %.5le  ", _currentVariable[k]);
   _k->_logger->logData("Normal", " ]\n");
@@ -126,6 +165,24 @@ void MADGRAD::setConfiguration(knlohmann::json& js)
 {
  if (isDefined(js, "Results"))  eraseValue(js, "Results");
 
+ if (isDefined(js, "Uniform Generator"))
+ {
+ _uniformGenerator = dynamic_cast<korali::distribution::univariate::Uniform*>(korali::Module::getModule(js["Uniform Generator"], _k));
+ _uniformGenerator->applyVariableDefaults();
+ _uniformGenerator->applyModuleDefaults(js["Uniform Generator"]);
+ _uniformGenerator->setConfiguration(js["Uniform Generator"]);
+   eraseValue(js, "Uniform Generator");
+ }
+
+ if (isDefined(js, "Normal Generator"))
+ {
+ _normalGenerator = dynamic_cast<korali::distribution::univariate::Normal*>(korali::Module::getModule(js["Normal Generator"], _k));
+ _normalGenerator->applyVariableDefaults();
+ _normalGenerator->applyModuleDefaults(js["Normal Generator"]);
+ _normalGenerator->setConfiguration(js["Normal Generator"]);
+   eraseValue(js, "Normal Generator");
+ }
+
  if (isDefined(js, "Current Variable"))
  {
  try { _currentVariable = js["Current Variable"].get<std::vector<double>>();
@@ -253,6 +310,8 @@ void MADGRAD::getConfiguration(knlohmann::json& js)
    js["Epsilon"] = _epsilon;
    js["Termination Criteria"]["Min Gradient Norm"] = _minGradientNorm;
    js["Termination Criteria"]["Max Gradient Norm"] = _maxGradientNorm;
+ if(_uniformGenerator != NULL) _uniformGenerator->getConfiguration(js["Uniform Generator"]);
+ if(_normalGenerator != NULL) _normalGenerator->getConfiguration(js["Normal Generator"]);
    js["Current Variable"] = _currentVariable;
    js["Scaled Learning Rate"] = _scaledLearningRate;
    js["Initial Parameter"] = _initialParameter;
@@ -269,7 +328,7 @@ void MADGRAD::getConfiguration(knlohmann::json& js)
 void MADGRAD::applyModuleDefaults(knlohmann::json& js) 
 {
 
- std::string defaultString = "{\"Eta\": 0.01, \"Weight Decay\": 0.9, \"Epsilon\": 1e-06, \"Termination Criteria\": {\"Min Gradient Norm\": 1e-12, \"Max Gradient Norm\": 1000000000000.0}}";
+ std::string defaultString = "{\"Uniform Generator\": {\"Type\": \"Univariate/Uniform\", \"Minimum\": 0.0, \"Maximum\": 1.0}, \"Normal Generator\": {\"Type\": \"Univariate/Normal\", \"Mean\": 0.0, \"Standard Deviation\": 1.0}, \"Eta\": 0.01, \"Weight Decay\": 0.9, \"Epsilon\": 1e-06, \"Termination Criteria\": {\"Min Gradient Norm\": 1e-12, \"Max Gradient Norm\": 1000000000000.0}}";
  knlohmann::json defaultJs = knlohmann::json::parse(defaultString);
  mergeJson(js, defaultJs); 
  Optimizer::applyModuleDefaults(js);
@@ -13,6 +13,7 @@
 #pragma once
 
 #include "modules/solver/optimizer/optimizer.hpp"
+#include <vector>
 
 namespace korali
 {
@@ -27,6 +28,58 @@ namespace optimizer
 */
 class MADGRAD : public Optimizer
 {
+  private:
+  /**
+   * @brief State of one of the independent starts, exchanged with the loaded state while the start is advanced
+   */
+  struct startState_t
+  {
+    /**
+     * @brief Current value of parameters.
+     */
+    std::vector<double> currentVariable;
+
+    /**
+     * @brief Starting point of the start, the anchor of its dual averaging.
+     */
+    std::vector<double> initialParameter;
+
+    /**
+     * @brief Gradient of function with respect to parameters.
+     */
+    std::vector<double> gradient;
+
+    /**
+     * @brief Norm of gradient of function with respect to parameters.
+     */
+    double gradientNorm = 0.0;
+
+    /**
+     * @brief Scaled sum of the gradients.
+     */
+    std::vector<double> gradientSum;
+
+    /**
+     * @brief Scaled sum of the squared gradients.
+     */
+    std::vector<double> squaredGradientSum;
+
+    /**
+     * @brief Value of the last evaluation.
+     */
+    double currentBestValue = -Inf;
+
+    /**
+     * @brief Value of the previous evaluation.
+     */
+    double previousBestValue = -Inf;
+  };
+
+  /**
+   * @brief States of the starts (only used if there are several starts)
+   */
+  std::vector<startState_t> _startStates;
+
   public: 
   /**
   * @brief Learning Rate (Step Size)
@@ -41,6 +94,14 @@ class MADGRAD : public Optimizer
   */
    double _epsilon;
   /**
+  * @brief [Internal Use] Uniform random number generator, for the starting points.
+  */
+   korali::distribution::univariate::Uniform* _uniformGenerator;
+  /**
+  * @brief [Internal Use] Normal random number generator, for the starting points.
+  */
+   korali::distribution::univariate::Normal* _normalGenerator;
+  /**
   * @brief [Internal Use] Current value of parameters.
   */
    std::vector<double> _currentVariable;
@@ -113,8 +174,13 @@ class MADGRAD : public Optimizer
    * @param evaluation The value of the objective function at the current set of parameters
    * @param gradient The gradient of the objective function at the current set of parameters
    */
-  void processResult(double evaluation, std::vector<double> &gradient);
+  void processStartEvaluation(const double evaluation, const std::vector<double> &gradient) override;
 
+  void resetStartState(const std::vector<double> &startingPoint) override;
+  void swapStartState(const size_t startId) override;
+  void getStartState(const size_t startId, knlohmann::json &js) const override;
+  void setStartState(const size_t startId, const knlohmann::json &js) override;
+  const std::vector<double> &updateStartParameters() override;
   void finalize() override;
   void setInitialConfiguration() override;
   void runGeneration() override;
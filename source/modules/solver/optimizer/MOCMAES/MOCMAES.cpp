@@ -5,6 +5,9 @@
 
 #include <gsl/gsl_linalg.h> // Cholesky
 
+#include <algorithm>
+#include <numeric>
+
 namespace korali
 {
 namespace solver
@@ -233,105 +236,260 @@ void MOCMAES::sampleSingle(size_t sampleIdx)
   _currentSuccessProbabilities[sampleIdx] = _parentSuccessProbabilities[parentIdx];
 }
 
-std::vector<int> MOCMAES::sortSampleIndices(const std::vector<std::vector<double>> &values) const
+bool MOCMAES::isDominating(const std::vector<double> &a, const std::vector<double> &b)
+{
+  bool isBetter = false;
+  for (size_t k = 0; k < a.size(); ++k)
+  {
+    if (a[k] < b[k]) return false;
+    if (a[k] > b[k]) isBetter = true;
+  }
+  return isBetter;
+}
+
+std::vector<std::vector<size_t>> MOCMAES::sortNonDominatedFronts(const std::vector<std::vector<double>> &values) const
 {
   const size_t numValues = values.size();
 
-  // find rank based on non-dominance
-  size_t minRank = numValues;
-  std::vector<size_t> rank(numValues, 0);
-  for (size_t r = numValues; r >= 1; --r) // start with the best ranks
+  // For every value, count by how many others it is dominated and list the ones it dominates
+  std::vector<size_t> dominationCount(numValues, 0);
+  std::vector<std::vector<size_t>> dominatedIndices(numValues);
+
+#pragma omp parallel for schedule(dynamic, 16)
+  for (size_t i = 0; i < numValues; ++i)
+    for (size_t j = 0; j < numValues; ++j)
+    {
+      if (i == j) continue;
+      if (isDominating(values[j], values[i]))
+        dominationCount[i]++;
+      else if (isDominating(values[i], values[j]))
+        dominatedIndices[i].push_back(j);
+    }
+
+  // Peel off the fronts, each one is dominated only by the fronts before it
+  std::vector<std::vector<size_t>> fronts;
+  std::vector<size_t> front;
+  for (size_t i = 0; i < numValues; ++i)
+    if (dominationCount[i] == 0) front.push_back(i);
+
+  while (front.empty() == false)
+  {
+    std::vector<size_t> nextFront;
+    for (size_t i : front)
+      for (size_t j : dominatedIndices[i])
+        if (--dominationCount[j] == 0) nextFront.push_back(j);
+
+    fronts.push_back(std::move(front));
+    front = std::move(nextFront);
+  }
+
+  return fronts;
+}
+
+double MOCMAES::getHypervolume(std::vector<std::vector<double>> points, const std::vector<double> &reference)
+{
+  if (points.empty()) return 0.0;
+
+  const size_t numObjectives = reference.size();
+
+  if (numObjectives == 1)
+  {
+    double maxValue = reference[0];
+    for (const auto &p : points) maxValue = std::max(maxValue, p[0]);
+    return maxValue - reference[0];
+  }
+
+  if (numObjectives == 2)
+  {
+    // Sweep in descending order of the first objective, adding the slab each point gains in the second
+    std::sort(points.begin(), points.end(), [](const std::vector<double> &a, const std::vector<double> &b) { return a[0] > b[0]; });
+
+    double volume = 0.0;
+    double maxSecond = reference[1];
+    for (const auto &p : points)
+      if (p[1] > maxSecond)
+      {
+        volume += (p[0] - reference[0]) * (p[1] - maxSecond);
+        maxSecond = p[1];
+      }
+    return volume;
+  }
+
+  // WFG: sum of the exclusive hypervolumes of each point w.r.t. the points after it
+  std::sort(points.begin(), points.end(), [](const std::vector<double> &a, const std::vector<double> &b) { return a.back() > b.back(); });
+
+  double volume = 0.0;
+  for (size_t i = 0; i < points.size(); ++i)
+  {
+    std::vector<std::vector<double>> limitSet(points.begin() + i + 1, points.end());
+    volume += getExclusiveHypervolume(points[i], limitSet, reference);
+  }
+
+  return volume;
+}
+
+double MOCMAES::getExclusiveHypervolume(const std::vector<double> &point, std::vector<std::vector<double>> &others, const std::vector<double> &reference)
+{
+  const size_t numObjectives = reference.size();
+
+  double volume = 1.0;
+  for (size_t k = 0; k < numObjectives; ++k) volume *= point[k] - reference[k];
+  if (volume <= 0.0) return 0.0;
+
+  // Limiting the other points to the box of this one, and keeping the non-dominated ones
+  for (auto &q : others)
+    for (size_t k = 0; k < numObjectives; ++k) q[k] = std::min(q[k], point[k]);
+
+  std::vector<std::vector<double>> limitSet;
+  for (size_t i = 0; i < others.size(); ++i)
+  {
+    bool isDominated = false;
+    for (size_t j = 0; j < others.size() && isDominated == false; ++j)
+      if (isDominating(others[j], others[i]) || (j < i && others[j] == others[i])) isDominated = true;
+    if (isDominated == false) limitSet.push_back(others[i]);
+  }
+
+  return volume - getHypervolume(std::move(limitSet), reference);
+}
+
+std::vector<size_t> MOCMAES::sortByHypervolumeContribution(const std::vector<std::vector<double>> &front, const std::vector<double> &reference) const
+{
+  const size_t numPoints = front.size();
+  std::vector<size_t> removalOrder;
+  removalOrder.reserve(numPoints);
+
+  if (_numObjectives == 2)
   {
-    size_t minMaxNBetter = _numObjectives;
-    std::vector<size_t> maxNBetter(numValues, 0);
-    for (size_t i = 0; i < numValues; ++i)
-      if (rank[i] == 0) // sample i not yet ranked
+    // In two dimensions the front is a staircase: a contribution only depends on the neighbours of the point,
+    // so removing a point only updates the contributions of its two neighbours
+    std::vector<size_t> order(numPoints);
+    std::iota(order.begin(), order.end(), 0);
+    std::sort(order.begin(), order.end(), [&](size_t a, size_t b) { return front[a][0] != front[b][0] ? front[a][0] > front[b][0] : front[a][1] < front[b][1]; });
+
+    std::vector<long> previous(numPoints), next(numPoints);
+    for (size_t i = 0; i < numPoints; ++i)
+    {
+      previous[i] = (long)i - 1;
+      next[i] = i + 1 < numPoints ? (long)i + 1 : -1;
+    }
+
+    auto getContribution = [&](long i) {
+      const double nextFirst = next[i] >= 0 ? front[order[next[i]]][0] : reference[0];
+      const double previousSecond = previous[i] >= 0 ? front[order[previous[i]]][1] : reference[1];
+      return (front[order[i]][0] - nextFirst) * (front[order[i]][1] - previousSecond);
+    };
+
+    std::vector<double> contributions(numPoints);
+    for (size_t i = 0; i < numPoints; ++i) contributions[i] = getContribution(i);
+
+    std::vector<bool> isRemoved(numPoints, false);
+    for (size_t r = 0; r < numPoints; ++r)
+    {
+      long minIdx = -1;
+      for (size_t i = 0; i < numPoints; ++i)
+        if (isRemoved[i] == false && (minIdx < 0 || contributions[i] < contributions[minIdx])) minIdx = i;
+
+      isRemoved[minIdx] = true;
+      removalOrder.push_back(order[minIdx]);
+
+      if (previous[minIdx] >= 0) next[previous[minIdx]] = next[minIdx];
+      if (next[minIdx] >= 0) previous[next[minIdx]] = previous[minIdx];
+      if (previous[minIdx] >= 0) contributions[previous[minIdx]] = getContribution(previous[minIdx]);
+      if (next[minIdx] >= 0) contributions[next[minIdx]] = getContribution(next[minIdx]);
+    }
+
+    return removalOrder;
+  }
+
+  // In higher dimensions, removing a point only changes the contributions of the points whose joint box with it
+  // is not covered by any other remaining point, so only these are recomputed after every removal
+  std::vector<size_t> remaining(numPoints);
+  std::iota(remaining.begin(), remaining.end(), 0);
+
+  auto getContribution = [&](size_t i) {
+    std::vector<std::vector<double>> others;
+    others.reserve(remaining.size() - 1);
+    for (size_t j : remaining)
+      if (i != j) others.push_back(front[j]);
+    return getExclusiveHypervolume(front[i], others, reference);
+  };
+
+  std::vector<double> contributions(numPoints);
+  std::vector<size_t> updatedPoints = remaining;
+  std::vector<double> jointBox(_numObjectives);
+
+  while (remaining.empty() == false)
+  {
+#pragma omp parallel for schedule(dynamic, 1)
+    for (size_t u = 0; u < updatedPoints.size(); ++u) contributions[updatedPoints[u]] = getContribution(updatedPoints[u]);
+
+    size_t minPos = 0;
+    for (size_t i = 1; i < remaining.size(); ++i)
+      if (contributions[remaining[i]] < contributions[remaining[minPos]]) minPos = i;
+
+    const size_t removed = remaining[minPos];
+    removalOrder.push_back(removed);
+    remaining.erase(remaining.begin() + minPos);
+
+    // The region shared by the removed point and another one becomes exclusive to the latter, unless a third point covers it
+    updatedPoints.clear();
+    for (size_t q : remaining)
+    {
+      bool isCovered = false;
+      for (size_t k = 0; k < _numObjectives; ++k)
       {
-        for (size_t j = 0; j < numValues; ++j)
-          if (i != j && rank[j] == 0) // compare not with yourself and not with already ranked samples
-          {
-            // Compare with other sample and count how many times it is better
-            size_t nBetter = 0;
-            for (size_t k = 0; k < _numObjectives; ++k)
-              if (values[i][k] < values[j][k]) nBetter++;
-            if (nBetter > maxNBetter[i]) maxNBetter[i] = nBetter;
-          }
-
-        if (maxNBetter[i] < minMaxNBetter) minMaxNBetter = maxNBetter[i];
+        jointBox[k] = std::min(front[removed][k], front[q][k]);
+        if (jointBox[k] <= reference[k]) isCovered = true;
       }
 
-    for (size_t i = 0; i < numValues; ++i)
-      if (rank[i] == 0 && maxNBetter[i] == minMaxNBetter) // sample i not yet ranked and amongst best performing
+      for (size_t r : remaining)
       {
-        rank[i] = r;
-        if (r < minRank) minRank = r;
+        if (isCovered) break;
+        if (r == q) continue;
+        isCovered = true;
+        for (size_t k = 0; k < _numObjectives && isCovered; ++k)
+          if (front[r][k] < jointBox[k]) isCovered = false;
       }
+
+      if (isCovered == false) updatedPoints.push_back(q);
+    }
   }
 
-  // remove offset
-  const size_t maxRank = numValues - minRank;
-  for (size_t i = 0; i < numValues; ++i)
-    rank[i] -= minRank;
+  return removalOrder;
+}
+
+std::vector<int> MOCMAES::sortSampleIndices(const std::vector<std::vector<double>> &values) const
+{
+  const size_t numValues = values.size();
+
+  // find rank based on non-dominance, the first front is the best
+  const auto fronts = sortNonDominatedFronts(values);
 
-  // find reference point
+  // find reference point, below all (finite) values
   std::vector<double> reference(_numObjectives, Inf);
   for (size_t i = 0; i < numValues; ++i)
     for (size_t k = 0; k < _numObjectives; ++k)
-      if (values[i][k] < reference[k])
+      if (std::isfinite(values[i][k]) && values[i][k] < reference[k])
         reference[k] = values[i][k];
+  for (size_t k = 0; k < _numObjectives; ++k)
+    if (std::isfinite(reference[k]) == false) reference[k] = 0.0;
 
   std::vector<int> sortedIndeces(numValues, -1);
 
-  // sort samples based on contributing hypervolume
+  // sort samples ascending, from the worst front to the best one (primary), and from the least to the most
+  // contributing hypervolume within each front (secondary)
   int order = 0;
-  for (size_t r = 0; r <= maxRank; ++r)
+  for (size_t r = fronts.size(); r-- > 0;)
   {
-    // next samples to sort
-    std::vector<size_t> unsorted;
-    for (size_t i = 0; i < numValues; ++i)
-      if (rank[i] == r && sortedIndeces[i] == -1) unsorted.push_back(i);
-
-    while (unsorted.size() > 0)
+    // values that do not reach the reference do not contribute any hypervolume
+    std::vector<std::vector<double>> front(fronts[r].size());
+    for (size_t i = 0; i < fronts[r].size(); ++i)
     {
-      const size_t numUnsorted = unsorted.size();
-
-      // init exclusive upper bounds
-      std::vector<std::vector<double>> exclusiveUpperbound(numUnsorted);
-      for (size_t i = 0; i < numUnsorted; ++i) exclusiveUpperbound[i] = std::vector<double>(_numObjectives, -Inf);
-
-      // calculate exclusive upper bound
-      for (size_t i = 0; i < numUnsorted; ++i)
-        for (size_t j = 0; j < numUnsorted; ++j)
-          if (i != j)
-            for (size_t k = 0; k < _numObjectives; ++k)
-              if (values[unsorted[j]][k] > exclusiveUpperbound[i][k]) exclusiveUpperbound[i][k] = values[unsorted[j]][k];
-
-      // calculate (negative) contributing hypervolume
-      std::vector<double> contributingHypervolume(numUnsorted, 0.0);
-      for (size_t i = 0; i < numUnsorted; ++i)
-        for (size_t k = 0; k < _numObjectives; ++k)
-          contributingHypervolume[i] += (exclusiveUpperbound[i][k] - reference[k]);
-
-      // sort samples ascending based on rank (primary) and descending based on contributing hypervolume (secondary)
-      // descending because we use a different (negative) interpretation of the contributing hypervolume
-      size_t nextSample = unsorted[0];
-      double currentMaxContribution = contributingHypervolume[0];
-      for (size_t i = 1; i < numUnsorted; ++i)
-      {
-        if (contributingHypervolume[i] > currentMaxContribution)
-        {
-          currentMaxContribution = contributingHypervolume[i];
-          nextSample = unsorted[i];
-        }
-      }
-
-      sortedIndeces[nextSample] = (int)order;
-
-      unsorted.clear();
-      for (size_t i = 0; i < numValues; ++i)
-        if (rank[i] == r && sortedIndeces[i] == -1) unsorted.push_back(i);
-      order++;
+      front[i] = values[fronts[r][i]];
+      for (size_t k = 0; k < _numObjectives; ++k) front[i][k] = std::max(front[i][k], reference[k]);
     }
+
+    for (size_t i : sortByHypervolumeContribution(front, reference)) sortedIndeces[fronts[r][i]] = order++;
   }
 
   return sortedIndeces;
@@ -259,7 +259,47 @@ class MOCMAES : public Optimizer
   void sampleSingle(size_t sampleIdx);
 
   /**
-   * @brief Sort sample indeces based on non-dominance (primary) and contribution and contributing hypervolume (secondary).
+   * @brief Checks whether a value dominates another one, i.e., it is not worse in any objective and better in at least one.
+   * @param a Value to check
+   * @param b Value to compare with
+   * @return True, if a dominates b; false, otherwise.
+   */
+  static bool isDominating(const std::vector<double> &a, const std::vector<double> &b);
+
+  /**
+   * @brief Sorts values into non-dominated fronts (fast non-dominated sorting), in parallel.
+   * @param values Values to sort
+   * @return Indices of the values in every front, starting with the non-dominated one
+   */
+  std::vector<std::vector<size_t>> sortNonDominatedFronts(const std::vector<std::vector<double>> &values) const;
+
+  /**
+   * @brief Calculates the exact hypervolume dominated by a set of points, with the WFG algorithm (a sweep in two dimensions).
+   * @param points Points, not below the reference
+   * @param reference Reference point
+   * @return The hypervolume
+   */
+  static double getHypervolume(std::vector<std::vector<double>> points, const std::vector<double> &reference);
+
+  /**
+   * @brief Calculates the hypervolume dominated by a point and by none of the other points.
+   * @param point Point whose exclusive hypervolume to calculate
+   * @param others Other points, which are limited to the box of the point in place
+   * @param reference Reference point
+   * @return The exclusive hypervolume
+   */
+  static double getExclusiveHypervolume(const std::vector<double> &point, std::vector<std::vector<double>> &others, const std::vector<double> &reference);
+
+  /**
+   * @brief Orders the points of a front by repeatedly removing the one with the smallest exact hypervolume contribution.
+   * @param front Points of a non-dominated front, not below the reference
+   * @param reference Reference point
+   * @return Indices of the points, from the least to the most contributing
+   */
+  std::vector<size_t> sortByHypervolumeContribution(const std::vector<std::vector<double>> &front, const std::vector<double> &reference) const;
+
+  /**
+   * @brief Sort sample indeces based on non-dominance (primary) and exact contributing hypervolume (secondary).
    * @param values Values to sort
    * @return sorted indices
    */
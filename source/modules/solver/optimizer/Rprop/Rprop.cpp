@@ -23,52 +23,97 @@ void Rprop::setInitialConfiguration()
     if (std::isfinite(_k->_variables[i]->_initialValue) == false)
       KORALI_LOG_ERROR("Initial Value of variable \'%s\' not defined (no defaults can be calculated).\n", _k->_variables[i]->_name.c_str());
 
-  _currentVariable.resize(_variableCount, 0.0);
-  for (size_t i = 0; i < _variableCount; i++)
-    _currentVariable[i] = _k->_variables[i]->_initialValue;
-
-  _bestEverVariables = _currentVariable;
-  _delta.resize(_variableCount, _delta0);
-  _currentGradient.resize(_variableCount, 0);
   _bestEverGradient.resize(_variableCount, 0);
-  _previousGradient.resize(_variableCount, 0.0);
 
   _bestEverValue = Inf;
   _xDiff = Inf;
   _maxStallCounter = 0;
+
+  _startStates.resize(_numberOfStarts);
+  initializeStarts(_uniformGenerator, _normalGenerator);
+  _bestEverVariables = _currentVariable;
+}
+
+void Rprop::runGeneration(void)
+{
+  if (_k->_currentGeneration == 1) setInitialConfiguration();
+
+  const double previousBestEverValue = _bestEverValue;
+
+  runMultiStartGeneration();
+
+  // The generation stalls only if no start improved the best value
+  if (_bestEverValue < previousBestEverValue)
+    _maxStallCounter = 0;
+  else
+    _maxStallCounter++;
+}
+
+void Rprop::resetStartState(const std::vector<double> &startingPoint)
+{
+  _currentVariable = startingPoint;
+  _delta.assign(_variableCount, _delta0);
+  _currentGradient.assign(_variableCount, 0.0);
+  _previousGradient.assign(_variableCount, 0.0);
   _normPreviousGradient = Inf;
   _previousBestValue = Inf;
 }
 
-void Rprop::evaluateFunctionAndGradient(Sample &sample)
+void Rprop::swapStartState(const size_t startId)
 {
-  // Initializing Sample Evaluation
-  sample["Module"] = "Problem";
-  sample["Operation"] = "Evaluate With Gradients";
-  sample["Parameters"] = _currentVariable;
-  sample["Sample Id"] = 0;
-  _modelEvaluationCount++;
-  KORALI_START(sample);
+  auto &state = _startStates[startId];
+  std::swap(_currentVariable, state.currentVariable);
+  std::swap(_delta, state.delta);
+  std::swap(_currentGradient, state.currentGradient);
+  std::swap(_previousGradient, state.previousGradient);
+  std::swap(_normPreviousGradient, state.normPreviousGradient);
+  std::swap(_currentBestValue, state.currentBestValue);
+  std::swap(_previousBestValue, state.previousBestValue);
+}
 
-  // Waiting for samples to finish
-  KORALI_WAIT(sample);
+void Rprop::getStartState(const size_t startId, knlohmann::json &js) const
+{
+  const auto &state = _startStates[startId];
+  js["Current Variable"] = state.currentVariable;
+  js["Delta"] = state.delta;
+  js["Current Gradient"] = state.currentGradient;
+  js["Previous Gradient"] = state.previousGradient;
+  js["Norm Previous Gradient"] = state.normPreviousGradient;
+  js["Current Best Value"] = state.currentBestValue;
+  js["Previous Best Value"] = state.previousBestValue;
+}
 
-  // Processing results
-  // The 'minus' is there because we want Rprop to do Maximization be default.
-  _currentBestValue = -KORALI_GET(double, sample, "F(x)");
-  _currentGradient = KORALI_GET(std::vector<double>, sample, "Gradient");
+void Rprop::setStartState(const size_t startId, const knlohmann::json &js)
+{
+  // When resuming, the states of the starts are rebuilt from the stored results
+  if (_startStates.size() != _numberOfStarts) _startStates.resize(_numberOfStarts);
+
+  auto &state = _startStates[startId];
+  state.currentVariable = js["Current Variable"].get<std::vector<double>>();
+  state.delta = js["Delta"].get<std::vector<double>>();
+  state.currentGradient = js["Current Gradient"].get<std::vector<double>>();
+  state.previousGradient = js["Previous Gradient"].get<std::vector<double>>();
+  state.normPreviousGradient = js["Norm Previous Gradient"].get<double>();
+  state.currentBestValue = js["Current Best Value"].get<double>();
+  state.previousBestValue = js["Previous Best Value"].get<double>();
+}
 
-  for (size_t i = 0; i < _variableCount; i++)
-    _currentGradient[i] = -_currentGradient[i];
+const std::vector<double> &Rprop::updateStartParameters()
+{
+  // The parameters are updated after their evaluation
+  return _currentVariable;
 }
 
-void Rprop::runGeneration(void)
+void Rprop::processStartEvaluation(const double evaluation, const std::vector<double> &gradient)
 {
-  if (_k->_currentGeneration == 1) setInitialConfiguration();
+  _modelEvaluationCount++;
 
-  Sample sample;
+  // The 'minus' is there because we want Rprop to do Maximization be default.
+  _currentBestValue = -evaluation;
+  _currentGradient = gradient;
 
-  evaluateFunctionAndGradient(sample);
+  for (size_t i = 0; i < _variableCount; i++)
+    _currentGradient[i] = -_currentGradient[i];
 
   performUpdate();
 
@@ -85,11 +130,6 @@ void Rprop::runGeneration(void)
     _xDiff = vectorNorm(tmp);
     _bestEverVariables = _currentVariable;
     _bestEverGradient = _currentGradient;
-    _maxStallCounter = 0;
-  }
-  else
-  {
-    _maxStallCounter++;
   }
 }
 
@@ -119,6 +159,8 @@ void Rprop::printGenerationBefore()
 
 void Rprop::printGenerationAfter()
 {
+  if (_numberOfStarts > 1) _k->_logger->logInfo("Normal", "Best Start: %zu/%zu\n", _currentStart + 1, _numberOfStarts);
+
   _k->_logger->logInfo("Normal", "X = [ ");
   for (size_t k = 0; k < _variableCount; k++) _k->_logger->logData("Normal", " %.5le  ", _currentVariable[k]);
   _k->_logger->logData("Normal", " ]\n");
@@ -147,6 +189,24 @@ void Rprop::setConfiguration(knlohmann::json& js)
 {
  if (isDefined(js, "Results"))  eraseValue(js, "Results");
 
+ if (isDefined(js, "Uniform Generator"))
+ {
+ _uniformGenerator = dynamic_cast<korali::distribution::univariate::Uniform*>(korali::Module::getModule(js["Uniform Generator"], _k));
+ _uniformGenerator->applyVariableDefaults();
+ _uniformGenerator->applyModuleDefaults(js["Uniform Generator"]);
+ _uniformGenerator->setConfiguration(js["Uniform Generator"]);
+   eraseValue(js, "Uniform Generator");
+ }
+
+ if (isDefined(js, "Normal Generator"))
+ {
+ _normalGenerator = dynamic_cast<korali::distribution::univariate::Normal*>(korali::Module::getModule(js["Normal Generator"], _k));
+ _normalGenerator->applyVariableDefaults();
+ _normalGenerator->applyModuleDefaults(js["Normal Generator"]);
+ _normalGenerator->setConfiguration(js["Normal Generator"]);
+   eraseValue(js, "Normal Generator");
+ }
+
  if (isDefined(js, "Current Variable"))
  {
  try { _currentVariable = js["Current Variable"].get<std::vector<double>>();
@@ -312,6 +372,8 @@ void Rprop::getConfiguration(knlohmann::json& js)
    js["Termination Criteria"]["Max Gradient Norm"] = _maxGradientNorm;
    js["Termination Criteria"]["Max Stall Generations"] = _maxStallGenerations;
    js["Termination Criteria"]["Parameter Relative Tolerance"] = _parameterRelativeTolerance;
+ if(_uniformGenerator != NULL) _uniformGenerator->getConfiguration(js["Uniform Generator"]);
+ if(_normalGenerator != NULL) _normalGenerator->getConfiguration(js["Normal Generator"]);
    js["Current Variable"] = _currentVariable;
    js["Best Ever Variable"] = _bestEverVariable;
    js["Delta"] = _delta;
@@ -329,7 +391,7 @@ void Rprop::getConfiguration(knlohmann::json& js)
 void Rprop::applyModuleDefaults(knlohmann::json& js) 
 {
 
- std::string defaultString = "{\"Delta0\": 0.1, \"Delta Min\": 1e-06, \"Delta Max\": 50, \"Eta Minus\": 0.5, \"Eta Plus\": 1.2, \"Termination Criteria\": {\"Max Gradient Norm\": 0.0, \"Max Stall Generations\": 20, \"Parameter Relative Tolerance\": 0.0001}}";
+ std::string defaultString = "{\"Uniform Generator\": {\"Type\": \"Univariate/Uniform\", \"Minimum\": 0.0, \"Maximum\": 1.0}, \"Normal Generator\": {\"Type\": \"Univariate/Normal\", \"Mean\": 0.0, \"Standard Deviation\": 1.0}, \"Delta0\": 0.1, \"Delta Min\": 1e-06, \"Delta Max\": 50, \"Eta Minus\": 0.5, \"Eta Plus\": 1.2, \"Termination Criteria\": {\"Max Gradient Norm\": 0.0, \"Max Stall Generations\": 20, \"Parameter Relative Tolerance\": 0.0001}}";
  knlohmann::json defaultJs = knlohmann::json::parse(defaultString);
  mergeJson(js, defaultJs); 
  Optimizer::applyModuleDefaults(js);
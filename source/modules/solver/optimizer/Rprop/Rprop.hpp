@@ -29,10 +29,54 @@ namespace optimizer
 class Rprop : public Optimizer
 {
   private:
-  void evaluateFunctionAndGradient(Sample &sample);
-
   void performUpdate(void); // iRprop_minus
 
+  /**
+   * @brief State of one of the independent starts, exchanged with the loaded state while the start is advanced
+   */
+  struct startState_t
+  {
+    /**
+     * @brief Current value of parameters.
+     */
+    std::vector<double> currentVariable;
+
+    /**
+     * @brief Step sizes of the parameters.
+     */
+    std::vector<double> delta;
+
+    /**
+     * @brief Gradient of the last evaluation (negated).
+     */
+    std::vector<double> currentGradient;
+
+    /**
+     * @brief Gradient of the previous evaluation (negated).
+     */
+    std::vector<double> previousGradient;
+
+    /**
+     * @brief Norm of the previous gradient.
+     */
+    double normPreviousGradient = Inf;
+
+    /**
+     * @brief Value of the last evaluation (negated).
+     */
+    double currentBestValue = Inf;
+
+    /**
+     * @brief Value of the previous evaluation (negated).
+     */
+    double previousBestValue = Inf;
+  };
+
+  /**
+   * @brief States of the starts (only used if there are several starts)
+   */
+  std::vector<startState_t> _startStates;
+
   public: 
   /**
   * @brief Initial Delta.
@@ -55,6 +99,14 @@ class Rprop : public Optimizer
   */
    double _etaPlus;
   /**
+  * @brief [Internal Use] Uniform random number generator, for the starting points.
+  */
+   korali::distribution::univariate::Uniform* _uniformGenerator;
+  /**
+  * @brief [Internal Use] Normal random number generator, for the starting points.
+  */
+   korali::distribution::univariate::Normal* _normalGenerator;
+  /**
   * @brief [Internal Use] Current value of parameters.
   */
    std::vector<double> _currentVariable;
@@ -130,6 +182,24 @@ class Rprop : public Optimizer
   void applyVariableDefaults() override;
   
 
+  /**
+   * @brief Takes the function value and gradient of an evaluation, negated for maximization, and updates the parameters
+   * @param evaluation The value of the objective function at the current set of parameters
+   * @param gradient The gradient of the objective function at the current set of parameters
+   */
+  void processStartEvaluation(const double evaluation, const std::vector<double> &gradient) override;
+
+  /**
+   * @brief Returns the current value of the loaded start, undoing the negation for minimization
+   * @return The value used to select the reported start
+   */
+  double getStartValue() const override { return -_currentBestValue; }
+
+  void resetStartState(const std::vector<double> &startingPoint) override;
+  void swapStartState(const size_t startId) override;
+  void getStartState(const size_t startId, knlohmann::json &js) const override;
+  void setStartState(const size_t startId, const knlohmann::json &js) override;
+  const std::vector<double> &updateStartParameters() override;
   void setInitialConfiguration() override;
   void finalize() override;
   void runGeneration() override;
@@ -0,0 +1,365 @@
+#include "engine.hpp"
+#include "modules/solver/optimizer/VDCMAES/VDCMAES.hpp"
+#include "sample/sample.hpp"
+
+#include <Eigen/Dense>
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
+namespace korali
+{
+namespace solver
+{
+namespace optimizer
+{
+;
+
+void VDCMAES::setInitialConfiguration()
+{
+  _variableCount = _k->_variables.size();
+
+  if (_variableCount < 3) KORALI_LOG_ERROR("VDCMAES requires at least 3 variables (is %zu).\n", _variableCount);
+  if (_diagonalCovariance) KORALI_LOG_ERROR("'Diagonal Covariance' is not applicable to VDCMAES.\n");
+
+  // Configuring the CMA-ES internals, which calls back initCovariance() for the restricted representation
+  CMAES::setInitialConfiguration();
+}
+
+void VDCMAES::initCovariance()
+{
+  // Setting Sigma
+  _trace = 0.0;
+  for (size_t i = 0; i < _variableCount; ++i) _trace += _k->_variables[i]->_initialStandardDeviation * _k->_variables[i]->_initialStandardDeviation;
+  _sigma = sqrt(_trace / _variableCount);
+
+  // The family is singular at v = 0, so v starts from a random direction, and D is chosen to keep the initial variance of every variable
+  _varianceDirection.resize(_variableCount);
+  for (size_t i = 0; i < _variableCount; ++i)
+  {
+    _varianceDirection[i] = _normalGenerator->getRandomNumber() / std::sqrt((double)_variableCount);
+    _axisLengths[i] = _k->_variables[i]->_initialStandardDeviation * sqrt(_variableCount / _trace) / std::sqrt(1.0 + _varianceDirection[i] * _varianceDirection[i]);
+  }
+
+  _constraintCorrectionDirections.clear();
+  _constraintCorrectionFactors.clear();
+
+  // There is no eigensystem to update
+  _isEigensystemUpdated = true;
+
+  updateCovarianceStatistics();
+}
+
+void VDCMAES::multiplyVarianceDirection(std::vector<double> &x, const double exponent) const
+{
+  // (I + vv^T)^p only scales the component along v, by (1 + |v|^2)^p
+  double v2 = 0.0;
+  double dot = 0.0;
+  for (size_t d = 0; d < _variableCount; ++d)
+  {
+    v2 += _varianceDirection[d] * _varianceDirection[d];
+    dot += _varianceDirection[d] * x[d];
+  }
+  if (v2 == 0.0) return;
+
+  const double scale = (std::pow(1.0 + v2, exponent) - 1.0) * dot / v2;
+  for (size_t d = 0; d < _variableCount; ++d) x[d] += scale * _varianceDirection[d];
+}
+
+void VDCMAES::sampleSingle(size_t sampleIdx, const std::vector<double> &randomNumbers)
+{
+  std::vector<double> y(randomNumbers.begin(), randomNumbers.begin() + _variableCount);
+
+  multiplyVarianceDirection(y, 0.5);
+  for (size_t d = 0; d < _variableCount; ++d) y[d] *= _axisLengths[d];
+
+  // Contracting the step along the constraint normals, if any
+  for (size_t k = 0; k < _constraintCorrectionDirections.size(); k++)
+  {
+    const auto &n = _constraintCorrectionDirections[k];
+
+    double dot = 0.0;
+    for (size_t d = 0; d < _variableCount; ++d) dot += n[d] * y[d];
+    for (size_t d = 0; d < _variableCount; ++d) y[d] -= _constraintCorrectionFactors[k] * dot * n[d];
+  }
+
+  for (size_t d = 0; d < _variableCount; ++d)
+  {
+    _bDZMatrix[sampleIdx * _variableCount + d] = y[d];
+    _samplePopulation[sampleIdx][d] = _currentMean[d] + _sigma * y[d];
+  }
+
+  if (_hasDiscreteVariables) applyDiscreteMutations(sampleIdx);
+}
+
+void VDCMAES::sampleBatch(const std::vector<double> &randomNumbers)
+{
+  for (size_t i = 0; i < _currentPopulationSize; ++i)
+  {
+    std::vector<double> rands(randomNumbers.begin() + i * _variableCount, randomNumbers.begin() + (i + 1) * _variableCount);
+    sampleSingle(i, rands);
+  }
+}
+
+void VDCMAES::whitenMeanUpdate()
+{
+  std::vector<double> x = _meanUpdate;
+
+  // Undoing the constraint contractions, in reverse order
+  for (size_t k = _constraintCorrectionDirections.size(); k-- > 0;)
+  {
+    const auto &n = _constraintCorrectionDirections[k];
+    const double gamma = _constraintCorrectionFactors[k];
+
+    double dot = 0.0;
+    for (size_t d = 0; d < _variableCount; ++d) dot += n[d] * x[d];
+    for (size_t d = 0; d < _variableCount; ++d) x[d] += gamma / (1.0 - gamma) * dot * n[d];
+  }
+
+  for (size_t d = 0; d < _variableCount; ++d) x[d] /= _axisLengths[d];
+  multiplyVarianceDirection(x, -0.5);
+
+  _auxiliarBDZMatrix = x;
+}
+
+void VDCMAES::computeNaturalGradient(const std::vector<std::vector<double>> &steps, const std::vector<double> &weights, const double baselineWeight, std::vector<double> &diagonalGradient, std::vector<double> &directionGradient) const
+{
+  const size_t N = _variableCount;
+  Eigen::Map<const Eigen::VectorXd> v(_varianceDirection.data(), N);
+  const double v2 = v.squaredNorm();
+  const double gamma = 1.0 + v2;
+
+  // Gradient of the update with respect to the relative change of D (gd) and the change of v (gv), under the Fisher metric
+  Eigen::VectorXd gd = Eigen::VectorXd::Constant(N, -baselineWeight);
+  Eigen::VectorXd gv = -baselineWeight / gamma * v;
+  for (size_t i = 0; i < steps.size(); i++)
+  {
+    Eigen::Map<const Eigen::VectorXd> y(steps[i].data(), N);
+    const double vy = v.dot(y);
+    gd += weights[i] * (y.cwiseProduct(y) - vy / gamma * v.cwiseProduct(y));
+    gv += weights[i] * vy / gamma * (y - vy / gamma * v);
+  }
+
+  // The Fisher matrix is a 2x2 block per variable, plus a rank-two correction along (v^2, 0) and (0, v). Solving it with the Woodbury identity takes linear time.
+  // D and v become redundant when v aligns with a coordinate axis, where the Fisher matrix is singular. It is damped relative to its curvature along v (2|v|^2 / (1 + |v|^2)^2), which leaves the update of a long axis unaffected.
+  const double damping = 0.1;
+  const Eigen::VectorXd u = v.cwiseProduct(v);
+  const double c = v2 / gamma + damping * 2.0 * v2 / (gamma * gamma);
+  auto solveBlocks = [&](const Eigen::VectorXd &xd, const Eigen::VectorXd &xv, Eigen::VectorXd &yd, Eigen::VectorXd &yv) {
+    yd.resize(N);
+    yv.resize(N);
+    for (size_t d = 0; d < N; ++d)
+    {
+      const double a = 1.0 + (1.0 + u[d]) * (1.0 - u[d] / gamma) + u[d] * u[d] / gamma + damping;
+      const double b = v[d] * (1.0 + 1.0 / gamma);
+      const double det = a * c - b * b;
+      yd[d] = (c * xd[d] - b * xv[d]) / det;
+      yv[d] = (a * xv[d] - b * xd[d]) / det;
+    }
+  };
+
+  const Eigen::VectorXd zero = Eigen::VectorXd::Zero(N);
+  Eigen::VectorXd pgd, pgv, pud, puv, pvd, pvv;
+  solveBlocks(gd, gv, pgd, pgv);
+  solveBlocks(u, zero, pud, puv);
+  solveBlocks(zero, v, pvd, pvv);
+
+  Eigen::Matrix2d W;
+  W << -1.0 / gamma, -1.0 / gamma, -1.0 / gamma, (1.0 - v2) / (gamma * gamma);
+
+  Eigen::Matrix2d UPU;
+  UPU << u.dot(pud), u.dot(pvd), v.dot(puv), v.dot(pvv);
+
+  const Eigen::Vector2d UPg(u.dot(pgd), v.dot(pgv));
+  const Eigen::Matrix2d capacitance = Eigen::Matrix2d::Identity() + W * UPU;
+  const Eigen::Vector2d s = capacitance.inverse() * (W * UPg);
+
+  diagonalGradient.resize(N);
+  directionGradient.resize(N);
+  Eigen::Map<Eigen::VectorXd>(diagonalGradient.data(), N) = pgd - s[0] * pud - s[1] * pvd;
+  Eigen::Map<Eigen::VectorXd>(directionGradient.data(), N) = pgv - s[0] * puv - s[1] * pvv;
+}
+
+void VDCMAES::adaptC(int hsig)
+{
+  // The family has 2N parameters instead of N^2/2, so it can learn faster than the full covariance matrix
+  const double cfactor = std::max((_variableCount - 5.0) / 6.0, 0.5);
+  const double ccov1 = cfactor * 2.0 / (std::pow(_variableCount + 1.3, 2) + _effectiveMu);
+  const double ccovmu = std::min(1.0 - ccov1, cfactor * 2.0 * (_effectiveMu - 2. + 1. / _effectiveMu) / (std::pow(_variableCount + 2.0, 2) + _effectiveMu));
+
+  // Rank-one update with the evolution path, and rank-mu update with the steps of the mu best samples, all divided by D
+  std::vector<std::vector<double>> steps(_currentMuValue + 1, std::vector<double>(_variableCount));
+  std::vector<double> weights(_currentMuValue + 1);
+
+  for (size_t d = 0; d < _variableCount; ++d) steps[0][d] = _evolutionPath[d] / _axisLengths[d];
+  weights[0] = ccov1;
+
+  double weightSum = 0.0;
+  for (size_t k = 0; k < _currentMuValue; ++k)
+  {
+    for (size_t d = 0; d < _variableCount; ++d) steps[k + 1][d] = (_samplePopulation[_sortingIndex[k]][d] - _previousMean[d]) / (_sigma * _axisLengths[d]);
+    weights[k + 1] = ccovmu * _muWeights[k];
+    weightSum += _muWeights[k];
+  }
+
+  const double baselineWeight = ccov1 + ccovmu * weightSum - ccov1 * (1 - hsig) * _cumulativeCovariance * (2. - _cumulativeCovariance);
+
+  std::vector<double> diagonalGradient;
+  std::vector<double> directionGradient;
+  computeNaturalGradient(steps, weights, baselineWeight, diagonalGradient, directionGradient);
+
+  // D is updated multiplicatively, so that it stays positive
+  for (size_t d = 0; d < _variableCount; ++d)
+  {
+    _axisLengths[d] *= std::exp(diagonalGradient[d]);
+    _varianceDirection[d] += directionGradient[d];
+  }
+
+  // Constraint contractions only apply to the generation they were computed for
+  _constraintCorrectionDirections.clear();
+  _constraintCorrectionFactors.clear();
+
+  updateCovarianceStatistics();
+}
+
+double VDCMAES::getCovarianceDiagonal(size_t d) const
+{
+  return _axisLengths[d] * _axisLengths[d] * (1.0 + _varianceDirection[d] * _varianceDirection[d]);
+}
+
+void VDCMAES::applyCovarianceCorrections(const std::vector<std::vector<double>> &normals, const std::vector<double> &downdates)
+{
+  std::vector<std::vector<double>> directions;
+  std::vector<double> factors;
+
+  for (size_t k = 0; k < normals.size(); k++)
+  {
+    double norm = 0.0;
+    for (size_t d = 0; d < _variableCount; ++d) norm += normals[k][d] * normals[k][d];
+    norm = std::sqrt(norm);
+
+    std::vector<double> n(_variableCount);
+    for (size_t d = 0; d < _variableCount; ++d) n[d] = normals[k][d] / norm;
+
+    // Variance of the (already contracted) distribution along the normal
+    std::vector<double> u = n;
+    for (size_t l = directions.size(); l-- > 0;)
+    {
+      double dot = 0.0;
+      for (size_t d = 0; d < _variableCount; ++d) dot += directions[l][d] * u[d];
+      for (size_t d = 0; d < _variableCount; ++d) u[d] -= factors[l] * dot * directions[l][d];
+    }
+    for (size_t d = 0; d < _variableCount; ++d) u[d] *= _axisLengths[d];
+    multiplyVarianceDirection(u, 0.5);
+
+    double variance = 0.0;
+    for (size_t d = 0; d < _variableCount; ++d) variance += u[d] * u[d];
+
+    const double remaining = 1.0 - downdates[k] / variance;
+    if (remaining <= 0.0)
+    {
+      _k->_logger->logWarning("Detailed", "Constraint correction would remove all the variance along a constraint normal (no update possible).\n");
+      return;
+    }
+
+    directions.push_back(n);
+    factors.push_back(1.0 - std::sqrt(remaining));
+  }
+
+  _constraintCorrectionDirections = directions;
+  _constraintCorrectionFactors = factors;
+}
+
+void VDCMAES::updateCovarianceStatistics()
+{
+  _minimumDiagonalCovarianceMatrixElement = +std::numeric_limits<double>::infinity();
+  _maximumDiagonalCovarianceMatrixElement = -std::numeric_limits<double>::infinity();
+  for (size_t d = 0; d < _variableCount; ++d)
+  {
+    _minimumDiagonalCovarianceMatrixElement = std::min(_minimumDiagonalCovarianceMatrixElement, getCovarianceDiagonal(d));
+    _maximumDiagonalCovarianceMatrixElement = std::max(_maximumDiagonalCovarianceMatrixElement, getCovarianceDiagonal(d));
+  }
+
+  // The eigenvalues are not computed, their range is approximated by the range of the variances
+  _minimumCovarianceEigenvalue = _minimumDiagonalCovarianceMatrixElement;
+  _maximumCovarianceEigenvalue = _maximumDiagonalCovarianceMatrixElement;
+}
+
+void VDCMAES::setConfiguration(knlohmann::json& js) 
+{
+ if (isDefined(js, "Results"))  eraseValue(js, "Results");
+
+ if (isDefined(js, "Variance Direction"))
+ {
+ try { _varianceDirection = js["Variance Direction"].get<std::vector<double>>();
+} catch (const std::exception& e)
+ { KORALI_LOG_ERROR(" + Object: [ VDCMAES ] \n + Key:    ['Variance Direction']\n%s", e.what()); } 
+   eraseValue(js, "Variance Direction");
+ }
+
+ if (isDefined(js, "Constraint Correction Directions"))
+ {
+ try { _constraintCorrectionDirections = js["Constraint Correction Directions"].get<std::vector<std::vector<double>>>();
+} catch (const std::exception& e)
+ { KORALI_LOG_ERROR(" + Object: [ VDCMAES ] \n + Key:    ['Constraint Correction Directions']\n%s", e.what()); } 
+   eraseValue(js, "Constraint Correction Directions");
+ }
+
+ if (isDefined(js, "Constraint Correction Factors"))
+ {
+ try { _constraintCorrectionFactors = js["Constraint Correction Factors"].get<std::vector<double>>();
+} catch (const std::exception& e)
+ { KORALI_LOG_ERROR(" + Object: [ VDCMAES ] \n + Key:    ['Constraint Correction Factors']\n%s", e.what()); } 
+   eraseValue(js, "Constraint Correction Factors");
+ }
+
+ if (isDefined(_k->_js.getJson(), "Variables"))
+ for (size_t i = 0; i < _k->_js["Variables"].size(); i++) { 
+ } 
+ CMAES::setConfiguration(js);
+ _type = "optimizer/VDCMAES";
+ if(isDefined(js, "Type")) eraseValue(js, "Type");
+ if(isEmpty(js) == false) KORALI_LOG_ERROR(" + Unrecognized settings for Korali module: VDCMAES: \n%s\n", js.dump(2).c_str());
+} 
+
+void VDCMAES::getConfiguration(knlohmann::json& js) 
+{
+
+ js["Type"] = _type;
+   js["Variance Direction"] = _varianceDirection;
+   js["Constraint Correction Directions"] = _constraintCorrectionDirections;
+   js["Constraint Correction Factors"] = _constraintCorrectionFactors;
+ for (size_t i = 0; i <  _k->_variables.size(); i++) { 
+ } 
+ CMAES::getConfiguration(js);
+} 
+
+void VDCMAES::applyModuleDefaults(knlohmann::json& js) 
+{
+
+ std::string defaultString = "{}";
+ knlohmann::json defaultJs = knlohmann::json::parse(defaultString);
+ mergeJson(js, defaultJs); 
+ CMAES::applyModuleDefaults(js);
+} 
+
+void VDCMAES::applyVariableDefaults() 
+{
+
+ CMAES::applyVariableDefaults();
+} 
+
+bool VDCMAES::checkTermination()
+{
+ bool hasFinished = false;
+
+ hasFinished = hasFinished || CMAES::checkTermination();
+ return hasFinished;
+}
+
+;
+
+} //optimizer
+} //solver
+} //korali
+;
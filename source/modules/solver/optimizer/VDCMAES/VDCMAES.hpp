@@ -0,0 +1,146 @@
+/** \namespace optimizer
+* @brief Namespace declaration for modules of type: optimizer.
+*/
+
+/** \file
+* @brief Header file for module: VDCMAES.
+*/
+
+/** \dir solver/optimizer/VDCMAES
+* @brief Contains code, documentation, and scripts for module: VDCMAES.
+*/
+
+#pragma once
+
+#include "modules/solver/optimizer/CMAES/CMAES.hpp"
+#include <vector>
+
+namespace korali
+{
+namespace solver
+{
+namespace optimizer
+{
+;
+
+/**
+* @brief Class declaration for module: VDCMAES.
+*/
+class VDCMAES : public CMAES
+{
+  public: 
+  /**
+  * @brief [Internal Use] Vector v of the covariance matrix D(I + vv^T)D, where the diagonal matrix D is stored in the axis lengths.
+  */
+   std::vector<double> _varianceDirection;
+  /**
+  * @brief [Internal Use] Normalized approximations of the constraint normals, along which the samples of the current generation are contracted.
+  */
+   std::vector<std::vector<double>> _constraintCorrectionDirections;
+  /**
+  * @brief [Internal Use] Contraction applied to the samples along each constraint correction direction.
+  */
+   std::vector<double> _constraintCorrectionFactors;
+  
+ 
+  /**
+  * @brief Determines whether the module can trigger termination of an experiment run.
+  * @return True, if it should trigger termination; false, otherwise.
+  */
+  bool checkTermination() override;
+  /**
+  * @brief Obtains the entire current state and configuration of the module.
+  * @param js JSON object onto which to save the serialized state of the module.
+  */
+  void getConfiguration(knlohmann::json& js) override;
+  /**
+  * @brief Sets the entire state and configuration of the module, given a JSON object.
+  * @param js JSON object from which to deserialize the state of the module.
+  */
+  void setConfiguration(knlohmann::json& js) override;
+  /**
+  * @brief Applies the module's default configuration upon its creation.
+  * @param js JSON object containing user configuration. The defaults will not override any currently defined settings.
+  */
+  void applyModuleDefaults(knlohmann::json& js) override;
+  /**
+  * @brief Applies the module's default variable configuration to each variable in the Experiment upon creation.
+  */
+  void applyVariableDefaults() override;
+  
+
+  /**
+   * @brief Multiplies a vector, in place, by a power of the matrix I + vv^T.
+   * @param x Vector to transform
+   * @param exponent Exponent of the matrix (1/2 for sampling, -1/2 for whitening)
+   */
+  void multiplyVarianceDirection(std::vector<double> &x, const double exponent) const;
+
+  /**
+   * @brief Computes the natural gradient of the covariance update with respect to D (relative to its value) and v, by projecting the update onto the family D(I + vv^T)D under the (damped) Fisher metric.
+   * @param steps Steps of the samples, divided by sigma and D
+   * @param weights Weight (including the learning rate) of each step
+   * @param baselineWeight Weight of the current covariance matrix, subtracted from the update
+   * @param diagonalGradient Relative change of D
+   * @param directionGradient Change of v
+   */
+  void computeNaturalGradient(const std::vector<std::vector<double>> &steps, const std::vector<double> &weights, const double baselineWeight, std::vector<double> &diagonalGradient, std::vector<double> &directionGradient) const;
+
+  /**
+   * @brief Updates the extreme values of the covariance diagonal, used for the output and the termination criteria.
+   */
+  void updateCovarianceStatistics();
+
+  /**
+   * @brief Generates a single sample from the covariance matrix D(I + vv^T)D.
+   * @param sampleIdx Index of the sample to generate
+   * @param randomNumbers Random numbers to generate the sample
+   */
+  void sampleSingle(size_t sampleIdx, const std::vector<double> &randomNumbers) override;
+
+  /**
+   * @brief Generates the whole current population.
+   * @param randomNumbers Random numbers to generate the samples, stored contiguously per sample
+   */
+  void sampleBatch(const std::vector<double> &randomNumbers) override;
+
+  /**
+   * @brief Updates D and v along the natural gradient of the rank-one and rank-mu updates.
+   * @param hsig Sign
+   */
+  void adaptC(int hsig) override;
+
+  /**
+   * @brief Transforms the mean update back to the isotropic space of the random numbers, and stores it in _auxiliarBDZMatrix.
+   */
+  void whitenMeanUpdate() override;
+
+  /**
+   * @brief Returns a diagonal element of the covariance matrix (without the sigma scaling).
+   * @param d Index of the variable
+   * @return The variance of the variable
+   */
+  double getCovarianceDiagonal(size_t d) const override;
+
+  /**
+   * @brief Contracts the samples of the current generation along the normal approximations of the violated constraints. Method for CCMA-ES.
+   * @param normals Normal approximations of the violated constraints
+   * @param downdates Variance to remove along each (normalized) normal
+   */
+  void applyCovarianceCorrections(const std::vector<std::vector<double>> &normals, const std::vector<double> &downdates) override;
+
+  /**
+   * @brief Initializes sigma, D and v.
+   */
+  void initCovariance() override;
+
+  /**
+   * @brief Configures VD-CMA-ES.
+   */
+  void setInitialConfiguration() override;
+};
+
+} //optimizer
+} //solver
+} //korali
+;
@@ -1,7 +1,15 @@
 #include "engine.hpp"
+#include "auxiliar/fs.hpp"
 #include "modules/solver/optimizer/gridSearch/gridSearch.hpp"
 #include "sample/sample.hpp"
 
+#include <cmath>
+#include <fcntl.h>
+#include <limits>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
 namespace korali
 {
 namespace solver
@@ -10,17 +18,33 @@ namespace optimizer
 {
 ;
 
+GridSearch::~GridSearch()
+{
+  closeObjectiveFile();
+}
+
 void GridSearch::setInitialConfiguration()
 {
   _variableCount = _k->_variables.size();
 
+  if (_topSampleCount == 0) KORALI_LOG_ERROR("Top Sample Count must be larger than 0.\n");
+
+  // We assume i = _index[0] + _index[1]*_values[0].size() + _index[2]*_values[0].size()*_values[1].size() + ..., so the helper holds the stride of each variable
+  _indexHelper.resize(_variableCount);
   _numberOfValues = 1;
   for (size_t i = 0; i < _variableCount; i++)
-    _numberOfValues *= _k->_variables[i]->_values.size();
+  {
+    const size_t valueCount = _k->_variables[i]->_values.size();
+    if (valueCount > 0 && _numberOfValues > std::numeric_limits<size_t>::max() / valueCount)
+      KORALI_LOG_ERROR("The number of grid points exceeds the range of the grid index (at variable \'%s\').\n", _k->_variables[i]->_name.c_str());
+
+    _indexHelper[i] = _numberOfValues;
+    _numberOfValues *= valueCount;
+  }
 
   if (_numberOfValues > _maxModelEvaluations)
   {
-    _k->_logger->logWarning("Normal", "%lu > %lu. More evaluations required than the maximum specified.\n", _numberOfValues, _maxModelEvaluations);
+    _k->_logger->logWarning("Normal", "%lu > %lu. More evaluations required than the maximum specified. Only the first %lu grid points will be evaluated.\n", _numberOfValues, _maxModelEvaluations, _maxModelEvaluations);
     _numberOfValues = _maxModelEvaluations;
   }
 
@@ -28,67 +52,202 @@ void GridSearch::setInitialConfiguration()
   _modelEvaluationCount = 0;
 
   _maxModelEvaluations = _numberOfValues;
+  _nextGridIndex = 0;
 
-  _objective.resize(_numberOfValues);
   _bestEverVariables.resize(_variableCount);
+  _topValues.clear();
+  _topIndices.clear();
+
+  // Only the memory storage keeps the objective of every grid point in the state of the solver. As in the mapped file, grid points not evaluated yet hold zero.
+  if (_objectiveStorage == "Memory")
+    _objective.assign(_numberOfValues, 0.0);
+  else
+    _objective.clear();
+}
 
-  // We assume i = _index[0] + _index[1]*_sample[0].size() + _index[1]*_sample[0].size()*_sample[1].size() + .....
-  _indexHelper.resize(_variableCount);
-  for (size_t i = 0; i < _variableCount; i++)
+void GridSearch::decodeGridIndex(const size_t gridIndex, std::vector<size_t> &digits) const
+{
+  digits.resize(_variableCount);
+  for (size_t d = 0; d < _variableCount; d++) digits[d] = (gridIndex / _indexHelper[d]) % _k->_variables[d]->_values.size();
+}
+
+void GridSearch::incrementGridIndex(std::vector<size_t> &digits) const
+{
+  // Mixed-radix increment: the first variable runs fastest, and every overflow carries into the next one
+  for (size_t d = 0; d < _variableCount; d++)
   {
-    if (i == 0 || i == 1)
-      _indexHelper[i] = _k->_variables[0]->_values.size();
-    else
-      _indexHelper[i] = _indexHelper[i - 1] * _k->_variables[i - 1]->_values.size();
+    if (++digits[d] < _k->_variables[d]->_values.size()) return;
+    digits[d] = 0;
   }
 }
 
-void GridSearch::runGeneration()
+std::vector<double> GridSearch::getGridPoint(const std::vector<size_t> &digits) const
 {
-  if (_k->_currentGeneration == 1) setInitialConfiguration();
+  std::vector<double> point(_variableCount);
+  for (size_t d = 0; d < _variableCount; d++) point[d] = _k->_variables[d]->_values[digits[d]];
+  return point;
+}
+
+bool GridSearch::isBetterGridPoint(const double value, const size_t gridIndex, const double otherValue, const size_t otherGridIndex)
+{
+  // Ties are resolved in favor of the lowest index, regardless of the completion order
+  return value > otherValue || (value == otherValue && gridIndex < otherGridIndex);
+}
 
-  // Create Sample
-  std::vector<Sample> samples(_numberOfValues);
-  std::vector<double> sampleData(_variableCount);
+void GridSearch::swapTopSamples(const size_t a, const size_t b)
+{
+  std::swap(_topValues[a], _topValues[b]);
+  std::swap(_topIndices[a], _topIndices[b]);
+}
 
-  size_t rest, index;
-  for (size_t i = 0; i < _numberOfValues; i++)
+void GridSearch::siftTopSampleUp(size_t position)
+{
+  while (position > 0)
   {
-    rest = i;
-    for (int d = _variableCount - 1; d >= 0; d--)
-    {
-      // We assume i = _index[0] + _index[1]*_sample[0].size() + _index[1]*_sample[0].size()*_sample[1].size() + .....
-      if (d == 0)
-        index = rest % _indexHelper[d];
-      else
-        index = rest / _indexHelper[d];
-
-      rest -= index * _indexHelper[d];
-
-      sampleData[d] = _k->_variables[d]->_values[index];
-    }
-    _k->_logger->logInfo("Detailed", "Running sample %zu/%zu with values:\n         ", i + 1, _numberOfValues);
-    for (auto &x : sampleData) _k->_logger->logData("Detailed", " %f   ", x);
-    _k->_logger->logData("Detailed", "\n");
-
-    samples[i]["Module"] = "Problem";
-    samples[i]["Operation"] = "Evaluate";
-    samples[i]["Parameters"] = sampleData;
-    samples[i]["Sample Id"] = i;
-    KORALI_START(samples[i]);
-    _modelEvaluationCount++;
+    const size_t parent = (position - 1) / 2;
+    if (isBetterGridPoint(_topValues[position], _topIndices[position], _topValues[parent], _topIndices[parent])) return;
+    swapTopSamples(position, parent);
+    position = parent;
   }
-  KORALI_WAITALL(samples);
-  for (size_t i = 0; i < _numberOfValues; i++)
+}
+
+void GridSearch::siftTopSampleDown(size_t position)
+{
+  const size_t count = _topValues.size();
+  while (true)
+  {
+    size_t worst = position;
+    for (size_t child = 2 * position + 1; child <= 2 * position + 2 && child < count; child++)
+      if (isBetterGridPoint(_topValues[worst], _topIndices[worst], _topValues[child], _topIndices[child])) worst = child;
+
+    if (worst == position) return;
+    swapTopSamples(position, worst);
+    position = worst;
+  }
+}
+
+void GridSearch::updateTopSamples(const size_t gridIndex, double value)
+{
+  // Failed evaluations never rank above a valid one
+  if (std::isnan(value)) value = -Inf;
+
+  // The top samples form a heap with the worst of them at the root
+  if (_topValues.size() < _topSampleCount)
   {
-    _objective[i] = KORALI_GET(double, samples[i], "F(x)");
+    _topValues.push_back(value);
+    _topIndices.push_back(gridIndex);
+    siftTopSampleUp(_topValues.size() - 1);
+    return;
   }
 
-  std::vector<double>::iterator maximum = std::max_element(_objective.begin(), _objective.end());
-  size_t maxIndex = std::distance(_objective.begin(), maximum);
+  // Most grid points do not enter the top samples, so rejecting them only costs a comparison with the worst one
+  if (isBetterGridPoint(value, gridIndex, _topValues[0], _topIndices[0]) == false) return;
+
+  _topValues[0] = value;
+  _topIndices[0] = gridIndex;
+  siftTopSampleDown(0);
+}
+
+void GridSearch::openObjectiveFile(const bool isNewFile)
+{
+  std::string filePath = _objectiveFile;
+  if (filePath.empty())
+  {
+    if (!dirExists(_k->_fileOutputPath)) mkdir(_k->_fileOutputPath);
+    filePath = _k->_fileOutputPath + "/objective.bin";
+  }
+
+  int fd = open(filePath.c_str(), isNewFile ? (O_RDWR | O_CREAT | O_TRUNC) : O_RDWR, 0644);
+  if (fd == -1) KORALI_LOG_ERROR("Could not open objective file %s.\n", filePath.c_str());
+
+  // The file is extended without writing it, so that the grid points not evaluated yet take no disk space
+  _objectiveMapSize = std::max(_numberOfValues, (size_t)1) * sizeof(double);
+  struct stat fileStat;
+  if (fstat(fd, &fileStat) != 0 || (isNewFile == false && (size_t)fileStat.st_size != _objectiveMapSize))
+  {
+    close(fd);
+    KORALI_LOG_ERROR("Objective file %s does not match the size of the grid (%lu points).\n", filePath.c_str(), _numberOfValues);
+  }
+  if (isNewFile && ftruncate(fd, _objectiveMapSize) != 0)
+  {
+    close(fd);
+    KORALI_LOG_ERROR("Could not resize objective file %s to %lu bytes.\n", filePath.c_str(), _objectiveMapSize);
+  }
+
+  void *map = mmap(NULL, _objectiveMapSize, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+  close(fd);
+  if (map == MAP_FAILED) KORALI_LOG_ERROR("Could not map objective file %s (%lu bytes).\n", filePath.c_str(), _objectiveMapSize);
+
+  _objectiveMap = (double *)map;
+}
+
+void GridSearch::closeObjectiveFile()
+{
+  if (_objectiveMap == NULL) return;
+
+  msync(_objectiveMap, _objectiveMapSize, MS_SYNC);
+  munmap(_objectiveMap, _objectiveMapSize);
+  _objectiveMap = NULL;
+}
+
+void GridSearch::runGeneration()
+{
+  if (_k->_currentGeneration == 1) setInitialConfiguration();
+
+  // When resuming, the file already holds the objective of the grid points evaluated before
+  if (_objectiveStorage == "Mapped File" && _objectiveMap == NULL) openObjectiveFile(_k->_currentGeneration == 1);
+
+  // Each generation evaluates the next range of grid points, so that a restart resumes from the next grid index
+  const size_t firstGridIndex = _nextGridIndex;
+  const size_t remainingCount = _numberOfValues - _nextGridIndex;
+  const size_t sampleCount = _evaluationsPerGeneration == 0 ? remainingCount : std::min(_evaluationsPerGeneration, remainingCount);
+
+  // Samples are prepared in order of their index, so the grid point of each one is decoded with a single mixed-radix increment
+  std::vector<size_t> digits;
+  decodeGridIndex(firstGridIndex, digits);
+  size_t digitsGridIndex = firstGridIndex;
+
+  auto prepareSample = [&](size_t i, Sample &sample) {
+    const size_t gridIndex = firstGridIndex + i;
+    if (gridIndex != digitsGridIndex) decodeGridIndex(gridIndex, digits);
+
+    sample["Module"] = "Problem";
+    sample["Operation"] = "Evaluate";
+    sample["Parameters"] = getGridPoint(digits);
+    sample["Sample Id"] = gridIndex;
+    _modelEvaluationCount++;
+
+    incrementGridIndex(digits);
+    digitsGridIndex = gridIndex + 1;
+  };
+
+  // Keeping only the best grid points as results arrive
+  auto reduceSample = [&](size_t i, Sample &sample) {
+    const size_t gridIndex = firstGridIndex + i;
+    const double value = KORALI_GET(double, sample, "F(x)");
+
+    if (_objectiveStorage == "Memory") _objective[gridIndex] = value;
+    if (_objectiveStorage == "Mapped File") _objectiveMap[gridIndex] = value;
+
+    updateTopSamples(gridIndex, value);
+  };
 
-  _bestEverVariables = KORALI_GET(std::vector<double>, samples[maxIndex], "Parameters");
-  _bestEverValue = KORALI_GET(double, samples[maxIndex], "F(x)");
+  KORALI_MAP(sampleCount, prepareSample, reduceSample);
+
+  _nextGridIndex += sampleCount;
+
+  // The objective of the evaluated grid points must be on disk before the state that refers to them
+  if (_objectiveMap != NULL) msync(_objectiveMap, _objectiveMapSize, MS_SYNC);
+
+  if (_topValues.empty()) return;
+
+  size_t bestPosition = 0;
+  for (size_t k = 1; k < _topValues.size(); k++)
+    if (isBetterGridPoint(_topValues[k], _topIndices[k], _topValues[bestPosition], _topIndices[bestPosition])) bestPosition = k;
+
+  decodeGridIndex(_topIndices[bestPosition], digits);
+  _bestEverVariables = getGridPoint(digits);
+  _bestEverValue = _topValues[bestPosition];
 }
 
 void GridSearch::printGenerationBefore()
@@ -97,6 +256,7 @@ void GridSearch::printGenerationBefore()
 
 void GridSearch::printGenerationAfter()
 {
+  _k->_logger->logInfo("Normal", "Evaluated %lu/%lu grid points.\n", _nextGridIndex, _numberOfValues);
   _k->_logger->logInfo("Minimal", "Found Maximum with Objective %+6.3e at:\n", _bestEverValue);
   for (size_t i = 0; i < _bestEverVariables.size(); i++)
     _k->_logger->logData("Normal", " %+6.3e", _bestEverVariables[i]);
@@ -105,9 +265,29 @@ void GridSearch::printGenerationAfter()
 
 void GridSearch::finalize()
 {
+  closeObjectiveFile();
+
+  // Sorting the top samples, best first
+  std::vector<size_t> order(_topValues.size());
+  for (size_t k = 0; k < order.size(); k++) order[k] = k;
+  std::sort(order.begin(), order.end(), [&](size_t a, size_t b) { return isBetterGridPoint(_topValues[a], _topIndices[a], _topValues[b], _topIndices[b]); });
+
+  std::vector<size_t> digits;
+  knlohmann::json topSamplesJs = knlohmann::json::array();
+  for (size_t k : order)
+  {
+    decodeGridIndex(_topIndices[k], digits);
+    knlohmann::json sampleJs;
+    sampleJs["Parameters"] = getGridPoint(digits);
+    sampleJs["F(x)"] = _topValues[k];
+    sampleJs["Grid Index"] = _topIndices[k];
+    topSamplesJs.push_back(sampleJs);
+  }
+
   // Updating Results
   (*_k)["Results"]["Best Sample"]["Parameters"] = _bestEverVariables;
   (*_k)["Results"]["Best Sample"]["F(x)"] = _bestEverValue;
+  (*_k)["Results"]["Top Samples"] = topSamplesJs;
 }
 
 void GridSearch::setConfiguration(knlohmann::json& js) 
@@ -138,6 +318,73 @@ void GridSearch::setConfiguration(knlohmann::json& js)
    eraseValue(js, "Index Helper");
  }
 
+ if (isDefined(js, "Next Grid Index"))
+ {
+ try { _nextGridIndex = js["Next Grid Index"].get<size_t>();
+} catch (const std::exception& e)
+ { KORALI_LOG_ERROR(" + Object: [ gridSearch ] \n + Key:    ['Next Grid Index']\n%s", e.what()); } 
+   eraseValue(js, "Next Grid Index");
+ }
+
+ if (isDefined(js, "Top Values"))
+ {
+ try { _topValues = js["Top Values"].get<std::vector<double>>();
+} catch (const std::exception& e)
+ { KORALI_LOG_ERROR(" + Object: [ gridSearch ] \n + Key:    ['Top Values']\n%s", e.what()); } 
+   eraseValue(js, "Top Values");
+ }
+
+ if (isDefined(js, "Top Indices"))
+ {
+ try { _topIndices = js["Top Indices"].get<std::vector<size_t>>();
+} catch (const std::exception& e)
+ { KORALI_LOG_ERROR(" + Object: [ gridSearch ] \n + Key:    ['Top Indices']\n%s", e.what()); } 
+   eraseValue(js, "Top Indices");
+ }
+
+ if (isDefined(js, "Evaluations Per Generation"))
+ {
+ try { _evaluationsPerGeneration = js["Evaluations Per Generation"].get<size_t>();
+} catch (const std::exception& e)
+ { KORALI_LOG_ERROR(" + Object: [ gridSearch ] \n + Key:    ['Evaluations Per Generation']\n%s", e.what()); } 
+   eraseValue(js, "Evaluations Per Generation");
+ }
+  else   KORALI_LOG_ERROR(" + No value provided for mandatory setting: ['Evaluations Per Generation'] required by gridSearch.\n"); 
+
+ if (isDefined(js, "Top Sample Count"))
+ {
+ try { _topSampleCount = js["Top Sample Count"].get<size_t>();
+} catch (const std::exception& e)
+ { KORALI_LOG_ERROR(" + Object: [ gridSearch ] \n + Key:    ['Top Sample Count']\n%s", e.what()); } 
+   eraseValue(js, "Top Sample Count");
+ }
+  else   KORALI_LOG_ERROR(" + No value provided for mandatory setting: ['Top Sample Count'] required by gridSearch.\n"); 
+
+ if (isDefined(js, "Objective Storage"))
+ {
+ try { _objectiveStorage = js["Objective Storage"].get<std::string>();
+} catch (const std::exception& e)
+ { KORALI_LOG_ERROR(" + Object: [ gridSearch ] \n + Key:    ['Objective Storage']\n%s", e.what()); } 
+{
+ bool validOption = false; 
+ if (_objectiveStorage == "None") validOption = true; 
+ if (_objectiveStorage == "Memory") validOption = true; 
+ if (_objectiveStorage == "Mapped File") validOption = true; 
+ if (validOption == false) KORALI_LOG_ERROR(" + Unrecognized value (%s) provided for mandatory setting: ['Objective Storage'] required by gridSearch.\n", _objectiveStorage.c_str()); 
+}
+   eraseValue(js, "Objective Storage");
+ }
+  else   KORALI_LOG_ERROR(" + No value provided for mandatory setting: ['Objective Storage'] required by gridSearch.\n"); 
+
+ if (isDefined(js, "Objective File"))
+ {
+ try { _objectiveFile = js["Objective File"].get<std::string>();
+} catch (const std::exception& e)
+ { KORALI_LOG_ERROR(" + Object: [ gridSearch ] \n + Key:    ['Objective File']\n%s", e.what()); } 
+   eraseValue(js, "Objective File");
+ }
+  else   KORALI_LOG_ERROR(" + No value provided for mandatory setting: ['Objective File'] required by gridSearch.\n"); 
+
  if (isDefined(_k->_js.getJson(), "Variables"))
  for (size_t i = 0; i < _k->_js["Variables"].size(); i++) { 
  } 
@@ -151,9 +398,16 @@ void GridSearch::getConfiguration(knlohmann::json& js)
 {
 
  js["Type"] = _type;
+   js["Evaluations Per Generation"] = _evaluationsPerGeneration;
+   js["Top Sample Count"] = _topSampleCount;
+   js["Objective Storage"] = _objectiveStorage;
+   js["Objective File"] = _objectiveFile;
    js["Number Of Values"] = _numberOfValues;
    js["Objective"] = _objective;
    js["Index Helper"] = _indexHelper;
+   js["Next Grid Index"] = _nextGridIndex;
+   js["Top Values"] = _topValues;
+   js["Top Indices"] = _topIndices;
  for (size_t i = 0; i <  _k->_variables.size(); i++) { 
  } 
  Optimizer::getConfiguration(js);
@@ -162,7 +416,7 @@ void GridSearch::getConfiguration(knlohmann::json& js)
 void GridSearch::applyModuleDefaults(knlohmann::json& js) 
 {
 
- std::string defaultString = "{}";
+ std::string defaultString = "{\"Evaluations Per Generation\": 0, \"Top Sample Count\": 1, \"Objective Storage\": \"Memory\", \"Objective File\": \"\", \"Next Grid Index\": 0, \"Top Values\": [], \"Top Indices\": []}";
  knlohmann::json defaultJs = knlohmann::json::parse(defaultString);
  mergeJson(js, defaultJs); 
  Optimizer::applyModuleDefaults(js);
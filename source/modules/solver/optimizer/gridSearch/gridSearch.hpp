@@ -27,8 +27,102 @@ namespace optimizer
 */
 class GridSearch : public Optimizer
 {
+  private:
+  /**
+   * @brief Objective of every grid point, mapped from the objective file. Used by the mapped file storage only.
+   */
+  double *_objectiveMap = NULL;
+
+  /**
+   * @brief Size (in bytes) of the mapped objective file.
+   */
+  size_t _objectiveMapSize = 0;
+
+  /**
+   * @brief Decodes the index of each variable's value from the linear index of a grid point.
+   * @param gridIndex Linear index of the grid point
+   * @param digits Index of the value of each variable
+   */
+  void decodeGridIndex(const size_t gridIndex, std::vector<size_t> &digits) const;
+
+  /**
+   * @brief Advances the value indices to the next grid point, in the order of the linear index.
+   * @param digits Index of the value of each variable
+   */
+  void incrementGridIndex(std::vector<size_t> &digits) const;
+
+  /**
+   * @brief Returns the variable values of a grid point.
+   * @param digits Index of the value of each variable
+   * @return The values of the variables
+   */
+  std::vector<double> getGridPoint(const std::vector<size_t> &digits) const;
+
+  /**
+   * @brief Compares two evaluated grid points.
+   * @param value Objective of the first grid point
+   * @param gridIndex Linear index of the first grid point
+   * @param otherValue Objective of the second grid point
+   * @param otherGridIndex Linear index of the second grid point
+   * @return True, if the first grid point has a larger objective, or an equal one and a lower index.
+   */
+  static bool isBetterGridPoint(const double value, const size_t gridIndex, const double otherValue, const size_t otherGridIndex);
+
+  /**
+   * @brief Exchanges two of the top samples.
+   * @param a Position of the first top sample
+   * @param b Position of the second top sample
+   */
+  void swapTopSamples(const size_t a, const size_t b);
+
+  /**
+   * @brief Moves a top sample up the heap of top samples (worst at the root), until its parent is worse.
+   * @param position Position of the top sample
+   */
+  void siftTopSampleUp(size_t position);
+
+  /**
+   * @brief Moves a top sample down the heap of top samples (worst at the root), until its children are better.
+   * @param position Position of the top sample
+   */
+  void siftTopSampleDown(size_t position);
+
+  /**
+   * @brief Adds an evaluated grid point to the top samples, if it ranks among them.
+   * @param gridIndex Linear index of the grid point
+   * @param value Objective of the grid point
+   */
+  void updateTopSamples(const size_t gridIndex, double value);
+
+  /**
+   * @brief Maps the objective file into memory.
+   * @param isNewFile If true, the file is (re)created. Otherwise, it must exist and match the size of the grid.
+   */
+  void openObjectiveFile(const bool isNewFile);
+
+  /**
+   * @brief Writes the mapped objective file to disk and unmaps it.
+   */
+  void closeObjectiveFile();
+
   public: 
   /**
+  * @brief Number of grid points evaluated per generation (by default all of them). The state saved after every generation allows resuming the search from the next grid point.
+  */
+   size_t _evaluationsPerGeneration;
+  /**
+  * @brief Number of best grid points kept during the search, and reported in the results.
+  */
+   size_t _topSampleCount;
+  /**
+  * @brief Determines where the objective of every grid point is stored.
+  */
+   std::string _objectiveStorage;
+  /**
+  * @brief Path of the objective file, for the mapped file storage (by default objective.bin in the file output path).
+  */
+   std::string _objectiveFile;
+  /**
   * @brief [Internal Use] Total number of parameter to evaluate (samples per generation).
   */
    size_t _numberOfValues;
@@ -37,9 +131,21 @@ class GridSearch : public Optimizer
   */
    std::vector<double> _objective;
   /**
-  * @brief [Internal Use] Holds helper to calculate cartesian indices from linear index.
+  * @brief [Internal Use] Holds helper to calculate cartesian indices from linear index (the stride of each variable).
   */
    std::vector<size_t> _indexHelper;
+  /**
+  * @brief [Internal Use] Linear index of the next grid point to evaluate.
+  */
+   size_t _nextGridIndex;
+  /**
+  * @brief [Internal Use] Objective of the best grid points evaluated so far, as a heap with the worst of them first.
+  */
+   std::vector<double> _topValues;
+  /**
+  * @brief [Internal Use] Linear index of the best grid points evaluated so far, in the order of the Top Values.
+  */
+   std::vector<size_t> _topIndices;
   
  
   /**
@@ -68,6 +174,11 @@ class GridSearch : public Optimizer
   void applyVariableDefaults() override;
   
 
+  /**
+   * @brief Unmaps the objective file, if mapped.
+   */
+  ~GridSearch();
+
   void finalize() override;
   void setInitialConfiguration() override;
   void runGeneration() override;
@@ -1,4 +1,8 @@
+#include "engine.hpp"
 #include "modules/solver/optimizer/optimizer.hpp"
+#include "sample/sample.hpp"
+
+#include <algorithm>
 
 namespace korali
 {
@@ -29,6 +33,147 @@ bool Optimizer::isSampleFeasible(const std::vector<double> &sample)
   return true;
 }
 
+std::vector<double> Optimizer::getStartingPoint(const size_t startId, korali::distribution::univariate::Uniform *uniformGenerator, korali::distribution::univariate::Normal *normalGenerator)
+{
+  std::vector<double> x(_k->_variables.size());
+
+  for (size_t i = 0; i < x.size(); i++)
+  {
+    const auto variable = _k->_variables[i];
+
+    if (startId == 0)
+      x[i] = variable->_initialValue;
+    else if (std::isfinite(variable->_lowerBound) && std::isfinite(variable->_upperBound))
+      x[i] = variable->_lowerBound + uniformGenerator->getRandomNumber() * (variable->_upperBound - variable->_lowerBound);
+    else if (std::isfinite(variable->_initialStandardDeviation))
+      x[i] = std::clamp(variable->_initialValue + variable->_initialStandardDeviation * normalGenerator->getRandomNumber(), variable->_lowerBound, variable->_upperBound);
+    else
+      KORALI_LOG_ERROR("Variable \'%s\' requires either finite bounds or an Initial Standard Deviation to draw the starting points of multiple starts.\n", variable->_name.c_str());
+  }
+
+  return x;
+}
+
+void Optimizer::exchangeStartState(const size_t startId)
+{
+  if (_numberOfStarts > 1) swapStartState(startId);
+}
+
+void Optimizer::initializeStarts(korali::distribution::univariate::Uniform *uniformGenerator, korali::distribution::univariate::Normal *normalGenerator)
+{
+  if (_numberOfStarts == 0) KORALI_LOG_ERROR("Number Of Starts must be larger than 0.\n");
+
+  // Every start begins at its own point, with a fresh optimizer state
+  for (size_t s = 0; s < _numberOfStarts; s++)
+  {
+    exchangeStartState(s);
+    resetStartState(getStartingPoint(s, uniformGenerator, normalGenerator));
+    exchangeStartState(s);
+  }
+
+  _currentStart = 0;
+  exchangeStartState(_currentStart);
+  _areStartsInitialized = true;
+}
+
+void Optimizer::runMultiStartGeneration()
+{
+  // When resuming, only the loaded start was restored with the configuration of the solver
+  if (_numberOfStarts > 1 && _areStartsInitialized == false) restoreStartStates();
+
+  // The reported start goes back with the others
+  exchangeStartState(_currentStart);
+
+  // Updating the parameters of every start, and evaluating them concurrently
+  std::vector<Sample> samples(_numberOfStarts);
+  for (size_t s = 0; s < _numberOfStarts; s++)
+  {
+    exchangeStartState(s);
+
+    samples[s]["Module"] = "Problem";
+    samples[s]["Operation"] = "Evaluate With Gradients";
+    samples[s]["Parameters"] = updateStartParameters();
+    samples[s]["Sample Id"] = s;
+    KORALI_START(samples[s]);
+
+    exchangeStartState(s);
+  }
+
+  // Waiting for samples to finish
+  KORALI_WAITALL(samples);
+
+  // Processing results
+  std::vector<double> startValues(_numberOfStarts);
+  for (size_t s = 0; s < _numberOfStarts; s++)
+  {
+    const auto evaluation = KORALI_GET(double, samples[s], "F(x)");
+    const auto gradient = KORALI_GET(std::vector<double>, samples[s], "Gradient");
+
+    exchangeStartState(s);
+    processStartEvaluation(evaluation, gradient);
+    startValues[s] = getStartValue();
+    exchangeStartState(s);
+  }
+
+  // Reporting the start with the best current value
+  _currentStart = std::max_element(startValues.begin(), startValues.end()) - startValues.begin();
+  exchangeStartState(_currentStart);
+
+  if (_numberOfStarts > 1) storeStartStates();
+}
+
+void Optimizer::storeStartStates()
+{
+  _storedStartStates = knlohmann::json::array();
+  for (size_t s = 0; s < _numberOfStarts; s++)
+  {
+    _storedStartStates.push_back(knlohmann::json());
+    if (s != _currentStart) getStartState(s, _storedStartStates[s]);
+  }
+}
+
+void Optimizer::restoreStartStates()
+{
+  if (_storedStartStates.is_array() == false || _storedStartStates.size() != _numberOfStarts)
+    KORALI_LOG_ERROR("The stored results do not hold the states of the %lu starts, the run cannot be resumed with a different Number Of Starts.\n", _numberOfStarts);
+
+  for (size_t s = 0; s < _numberOfStarts; s++)
+    if (s != _currentStart) setStartState(s, _storedStartStates[s]);
+
+  _areStartsInitialized = true;
+}
+
+void Optimizer::resetStartState(const std::vector<double> &startingPoint)
+{
+  KORALI_LOG_ERROR("Solver does not support multiple starts.\n");
+}
+
+void Optimizer::swapStartState(const size_t startId)
+{
+  KORALI_LOG_ERROR("Solver does not support multiple starts.\n");
+}
+
+const std::vector<double> &Optimizer::updateStartParameters()
+{
+  KORALI_LOG_ERROR("Solver does not support multiple starts.\n");
+  return _bestEverVariables;
+}
+
+void Optimizer::processStartEvaluation(const double evaluation, const std::vector<double> &gradient)
+{
+  KORALI_LOG_ERROR("Solver does not support multiple starts.\n");
+}
+
+void Optimizer::getStartState(const size_t startId, knlohmann::json &js) const
+{
+  KORALI_LOG_ERROR("Solver does not support multiple starts.\n");
+}
+
+void Optimizer::setStartState(const size_t startId, const knlohmann::json &js)
+{
+  KORALI_LOG_ERROR("Solver does not support multiple starts.\n");
+}
+
 void Optimizer::setConfiguration(knlohmann::json& js) 
 {
  if (isDefined(js, "Results"))  eraseValue(js, "Results");
@@ -73,6 +218,30 @@ void Optimizer::setConfiguration(knlohmann::json& js)
    eraseValue(js, "Infeasible Sample Count");
  }
 
+ if (isDefined(js, "Current Start"))
+ {
+ try { _currentStart = js["Current Start"].get<size_t>();
+} catch (const std::exception& e)
+ { KORALI_LOG_ERROR(" + Object: [ optimizer ] \n + Key:    ['Current Start']\n%s", e.what()); } 
+   eraseValue(js, "Current Start");
+ }
+
+ if (isDefined(js, "Stored Start States"))
+ {
+ _storedStartStates = js["Stored Start States"].get<knlohmann::json>();
+
+   eraseValue(js, "Stored Start States");
+ }
+
+ if (isDefined(js, "Number Of Starts"))
+ {
+ try { _numberOfStarts = js["Number Of Starts"].get<size_t>();
+} catch (const std::exception& e)
+ { KORALI_LOG_ERROR(" + Object: [ optimizer ] \n + Key:    ['Number Of Starts']\n%s", e.what()); } 
+   eraseValue(js, "Number Of Starts");
+ }
+  else   KORALI_LOG_ERROR(" + No value provided for mandatory setting: ['Number Of Starts'] required by optimizer.\n"); 
+
  if (isDefined(js, "Termination Criteria", "Max Value"))
  {
  try { _maxValue = js["Termination Criteria"]["Max Value"].get<double>();
@@ -176,6 +345,7 @@ void Optimizer::getConfiguration(knlohmann::json& js)
 {
 
  js["Type"] = _type;
+   js["Number Of Starts"] = _numberOfStarts;
    js["Termination Criteria"]["Max Value"] = _maxValue;
    js["Termination Criteria"]["Min Value Difference Threshold"] = _minValueDifferenceThreshold;
    js["Termination Criteria"]["Max Infeasible Resamplings"] = _maxInfeasibleResamplings;
@@ -184,6 +354,8 @@ void Optimizer::getConfiguration(knlohmann::json& js)
    js["Best Ever Value"] = _bestEverValue;
    js["Best Ever Variables"] = _bestEverVariables;
    js["Infeasible Sample Count"] = _infeasibleSampleCount;
+   js["Current Start"] = _currentStart;
+   js["Stored Start States"] = _storedStartStates;
  for (size_t i = 0; i <  _k->_variables.size(); i++) { 
    _k->_js["Variables"][i]["Lower Bound"] = _k->_variables[i]->_lowerBound;
    _k->_js["Variables"][i]["Upper Bound"] = _k->_variables[i]->_upperBound;
@@ -199,7 +371,7 @@ void Optimizer::getConfiguration(knlohmann::json& js)
 void Optimizer::applyModuleDefaults(knlohmann::json& js) 
 {
 
- std::string defaultString = "{\"Termination Criteria\": {\"Max Value\": Infinity, \"Min Value Difference Threshold\": -Infinity, \"Max Infeasible Resamplings\": 1000000}}";
+ std::string defaultString = "{\"Number Of Starts\": 1, \"Current Start\": 0, \"Stored Start States\": [], \"Termination Criteria\": {\"Max Value\": Infinity, \"Min Value Difference Threshold\": -Infinity, \"Max Infeasible Resamplings\": 1000000}}";
  knlohmann::json defaultJs = knlohmann::json::parse(defaultString);
  mergeJson(js, defaultJs); 
  Solver::applyModuleDefaults(js);
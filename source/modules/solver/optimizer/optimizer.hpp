@@ -12,6 +12,8 @@
 
 #pragma once
 
+#include "modules/distribution/univariate/normal/normal.hpp"
+#include "modules/distribution/univariate/uniform/uniform.hpp"
 #include "modules/solver/solver.hpp"
 
 namespace korali
@@ -25,8 +27,34 @@ namespace solver
 */
 class Optimizer : public Solver
 {
+  private:
+  /**
+   * @brief Whether the states of the starts have been initialized in this run, either from their starting points or from the stored results.
+   */
+  bool _areStartsInitialized = false;
+
+  /**
+   * @brief Stores the states of the starts that are not loaded into the results, so that the run can be resumed.
+   */
+  void storeStartStates();
+
+  /**
+   * @brief Restores the states of the starts that are not loaded from the stored results, when resuming a run.
+   */
+  void restoreStartStates();
+
+  /**
+   * @brief Exchanges the state of the optimizer with the stored state of a start, if there are several starts
+   * @param startId Index of the start
+   */
+  void exchangeStartState(const size_t startId);
+
   public: 
   /**
+  * @brief Number of independent starts, advanced in lock-step, whose evaluations run concurrently (only relevant for Adam, AdaBelief, MADGRAD and Rprop). The first start begins at the initial values of the variables, the others are drawn uniformly within the variable bounds or, if these are not finite, around the initial values with their initial standard deviation. The best start is reported.
+  */
+   size_t _numberOfStarts;
+  /**
   * @brief [Internal Use] Best model evaluation from current generation.
   */
    double _currentBestValue;
@@ -47,6 +75,14 @@ class Optimizer : public Solver
   */
    size_t _infeasibleSampleCount;
   /**
+  * @brief [Internal Use] Index of the start whose state is loaded, the one with the best current value after every generation (only relevant for multi-start optimizers).
+  */
+   size_t _currentStart;
+  /**
+  * @brief [Internal Use] States of the starts that are not loaded, stored after every generation so that a multi-start run can be resumed (null for the loaded start).
+  */
+   knlohmann::json _storedStartStates;
+  /**
   * @brief [Termination Criteria] Specifies the maximum target fitness to stop maximization.
   */
    double _maxValue;
@@ -92,6 +128,72 @@ class Optimizer : public Solver
    * @return True, if feasible; false, otherwise.
    */
   bool isSampleFeasible(const std::vector<double> &sample);
+
+  /**
+   * @brief Determines the starting point of one of the independent starts of a multi-start optimizer. The first start begins at the initial values, the others are drawn within the bounds of the variables.
+   * @param startId Index of the start
+   * @param uniformGenerator Uniform random number generator in [0,1]
+   * @param normalGenerator Standard normal random number generator, used for variables without finite bounds
+   * @return The starting point
+   */
+  std::vector<double> getStartingPoint(const size_t startId, korali::distribution::univariate::Uniform *uniformGenerator, korali::distribution::univariate::Normal *normalGenerator);
+
+  /**
+   * @brief Initializes the state of every start at its starting point, and loads the first one. Used by the multi-start optimizers.
+   * @param uniformGenerator Uniform random number generator in [0,1]
+   * @param normalGenerator Standard normal random number generator, used for variables without finite bounds
+   */
+  void initializeStarts(korali::distribution::univariate::Uniform *uniformGenerator, korali::distribution::univariate::Normal *normalGenerator);
+
+  /**
+   * @brief Advances every start by one step in lock-step, evaluating their parameters concurrently, and loads the start with the best current value, which is the one reported and checked by the termination criteria.
+   */
+  void runMultiStartGeneration();
+
+  /**
+   * @brief [Multi-start hook] Resets the loaded state to a new start at the given point.
+   * @param startingPoint Starting point of the start
+   */
+  virtual void resetStartState(const std::vector<double> &startingPoint);
+
+  /**
+   * @brief [Multi-start hook] Exchanges the loaded state with the stored state of a start. Called only if there are several starts.
+   * @param startId Index of the start
+   */
+  virtual void swapStartState(const size_t startId);
+
+  /**
+   * @brief [Multi-start hook] Updates the parameters of the loaded start before its evaluation.
+   * @return The parameters to evaluate (with gradients)
+   */
+  virtual const std::vector<double> &updateStartParameters();
+
+  /**
+   * @brief [Multi-start hook] Processes the evaluation of the loaded start.
+   * @param evaluation The value of the objective function at the parameters of the start
+   * @param gradient The gradient of the objective function at the parameters of the start
+   */
+  virtual void processStartEvaluation(const double evaluation, const std::vector<double> &gradient);
+
+  /**
+   * @brief [Multi-start hook] Returns the current value of the loaded start, larger is better.
+   * @return The value used to select the reported start
+   */
+  virtual double getStartValue() const { return _currentBestValue; }
+
+  /**
+   * @brief [Multi-start hook] Writes the stored state of a start (not the loaded one) into a JSON object.
+   * @param startId Index of the start
+   * @param js JSON object to write the state to
+   */
+  virtual void getStartState(const size_t startId, knlohmann::json &js) const;
+
+  /**
+   * @brief [Multi-start hook] Reads the stored state of a start (not the loaded one) from a JSON object.
+   * @param startId Index of the start
+   * @param js JSON object holding the state
+   */
+  virtual void setStartState(const size_t startId, const knlohmann::json &js);
 };
 
 } //solver
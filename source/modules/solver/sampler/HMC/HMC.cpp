@@ -4,6 +4,7 @@
 #include "modules/problem/problem.hpp"
 #include "modules/solver/sampler/HMC/HMC.hpp"
 
+#include <algorithm>
 #include <chrono>
 #include <limits>
 #include <numeric>
@@ -22,6 +23,25 @@ namespace sampler
 {
 ;
 
+/**
+ * @brief Pointer to the sampler whose chain coroutine is being created
+ */
+HMC *__chainSampler;
+
+/**
+ * @brief Thread wrapper to run the generation of a chain
+ */
+void __chainWrapper()
+{
+  auto sampler = __chainSampler;
+  sampler->runChainCoroutine();
+}
+
+HMC::~HMC()
+{
+  co_pool_destroy(_chainStackPool);
+}
+
 void HMC::setInitialConfiguration()
 {
   _variableCount = _k->_variables.size();
@@ -58,6 +78,10 @@ void HMC::setInitialConfiguration()
   if (_initialSlowAdaptionInterval < 0) KORALI_LOG_ERROR("Initial Slow Adaption Interval must be greater equal 0 (is %zu).\n", _initialSlowAdaptionInterval);
   if (_finalFastAdaptionInterval < 0) KORALI_LOG_ERROR("Final Fast Adaption Interval must be greater equal 0 (is %zu).\n", _finalFastAdaptionInterval);
 
+  if (_chainCount < 1) KORALI_LOG_ERROR("Chain Count must be larger 0 (is %zu).\n", _chainCount);
+  if (_chainCount > 1 && (_metricType == Metric::Riemannian || _metricType == Metric::Riemannian_Const))
+    KORALI_LOG_ERROR("Chain Count larger 1 requires a metric that is shared by all chains, i.e. Version 'Static' or 'Euclidean' (is %s).\n", _version.c_str());
+
   // Check adaption intervals
   if (_metricType == Metric::Euclidean && _useAdaptiveStepSize)
   {
@@ -135,6 +159,42 @@ void HMC::setInitialConfiguration()
   else
     _integrator = std::make_unique<LeapfrogExplicit>(_hamiltonian);
 
+  // Initializing the chains after the first one, dispersed around the initial mean
+  const size_t extraChainCount = _chainCount - 1;
+  _chainPositionLeaders.resize(extraChainCount);
+  _chainLeaderEvaluations.assign(extraChainCount, 0.);
+  _chainPositionCandidates.assign(extraChainCount, std::vector<double>(_variableCount));
+  _chainMomentumLeaders.assign(extraChainCount, std::vector<double>(_variableCount));
+  _chainMomentumCandidates.assign(extraChainCount, std::vector<double>(_variableCount));
+  _chainAcceptanceProbabilities.assign(extraChainCount, 0.);
+  _chainDepths.assign(extraChainCount, 0);
+  _chainHamiltonians.resize(extraChainCount);
+  _chainIntegrators.resize(extraChainCount);
+
+  for (size_t c = 0; c < extraChainCount; c++)
+  {
+    _chainPositionLeaders[c].resize(_variableCount);
+    for (size_t i = 0; i < _variableCount; i++)
+      _chainPositionLeaders[c][i] = _k->_variables[i]->_initialMean + _k->_variables[i]->_initialStandardDeviation * _normalGenerator->getRandomNumber();
+
+    if (_useDiagonalMetric == true || _metricType == Metric::Static)
+      _chainHamiltonians[c] = std::make_shared<HamiltonianEuclideanDiag>(_variableCount, _normalGenerator, _k);
+    else
+      _chainHamiltonians[c] = std::make_shared<HamiltonianEuclideanDense>(_variableCount, _multivariateGenerator, _metric, _k);
+
+    _chainIntegrators[c] = std::make_unique<LeapfrogExplicit>(_chainHamiltonians[c]);
+  }
+
+  // Each chain evaluates its positions in its own sample slot, returning to the scheduler while the sample runs
+  _chainSamples = std::vector<Sample>(_chainCount);
+  if (_chainCount > 1)
+    for (size_t c = 0; c < _chainCount; c++)
+    {
+      auto &hamiltonian = (c == 0) ? _hamiltonian : _chainHamiltonians[c - 1];
+      hamiltonian->_sample = &_chainSamples[c];
+      hamiltonian->_sampleEvaluator = [this](Sample &sample) { evaluateChainSample(sample); };
+    }
+
   // Initialize common variables
   _acceptanceCount = 0;
   _proposedSampleCount = 0;
@@ -156,6 +216,96 @@ void HMC::setInitialConfiguration()
 void HMC::runGeneration()
 {
   if (_k->_currentGeneration == 1) setInitialConfiguration();
+
+  if (_chainCount == 1)
+  {
+    runChainGeneration();
+    updateState();
+    return;
+  }
+
+  // Loads the state of a chain and resumes it, until it either starts a sample or finishes its generation
+  auto resumeChain = [this](const size_t chainIdx) {
+    _activeChain = chainIdx;
+    swapChainState(chainIdx);
+    co_switch(_chainThreads[chainIdx]);
+    swapChainState(chainIdx);
+  };
+
+  if (_chainStackPool == NULL)
+  {
+    _chainStackPool = co_pool_create(1 << 22);
+    if (_chainStackPool == NULL) KORALI_LOG_ERROR("Unable to create the stack pool of the chain coroutines.\n");
+  }
+
+  _schedulerThread = co_active();
+  _chainThreads.resize(_chainCount);
+  _chainStacks.resize(_chainCount);
+  _isChainRunning.assign(_chainCount, true);
+
+  // Launching all chains, each one runs up to its first evaluation. Their stacks are reused from previous generations.
+  for (size_t c = 0; c < _chainCount; c++)
+  {
+    __chainSampler = this;
+    _chainThreads[c] = co_pool_acquire(_chainStackPool, __chainWrapper, &_chainStacks[c]);
+    if (_chainThreads[c] == NULL) KORALI_LOG_ERROR("Unable to map the coroutine stack of chain %zu.\n", c);
+    resumeChain(c);
+  }
+
+  // Resuming each chain as soon as its sample has finished
+  while (std::find(_isChainRunning.begin(), _isChainRunning.end(), true) != _isChainRunning.end())
+  {
+    const size_t chainIdx = KORALI_WAITANY(_chainSamples);
+    resumeChain(chainIdx);
+  }
+
+  for (size_t c = 0; c < _chainCount; c++)
+  {
+    co_pool_release(_chainStackPool, _chainStacks[c]);
+    _chainThreads[c] = NULL;
+    _chainStacks[c] = NULL;
+  }
+
+  // The step size and metric adaptation is shared by all chains
+  updateState();
+}
+
+void HMC::runChainCoroutine()
+{
+  runChainGeneration();
+  _isChainRunning[_activeChain] = false;
+  co_switch(_schedulerThread);
+
+  KORALI_LOG_ERROR("Resuming a finished chain\n");
+}
+
+void HMC::evaluateChainSample(Sample &sample)
+{
+  KORALI_START(sample);
+
+  // Launching the sample may already have returned to the scheduler, which only resumes the chain once the sample is
+  // finalized. Yielding again would leave the chain waiting for a sample that never finishes.
+  if (_k->_overrideEngine == false && sample._state != SampleState::uninitialized) co_switch(_schedulerThread);
+}
+
+void HMC::swapChainState(const size_t chainIdx)
+{
+  if (chainIdx == 0) return;
+
+  const size_t slot = chainIdx - 1;
+  std::swap(_positionLeader, _chainPositionLeaders[slot]);
+  std::swap(_leaderEvaluation, _chainLeaderEvaluations[slot]);
+  std::swap(_positionCandidate, _chainPositionCandidates[slot]);
+  std::swap(_momentumLeader, _chainMomentumLeaders[slot]);
+  std::swap(_momentumCandidate, _chainMomentumCandidates[slot]);
+  std::swap(_acceptanceProbability, _chainAcceptanceProbabilities[slot]);
+  std::swap(_currentDepth, _chainDepths[slot]);
+  std::swap(_hamiltonian, _chainHamiltonians[slot]);
+  std::swap(_integrator, _chainIntegrators[slot]);
+}
+
+void HMC::runChainGeneration()
+{
   _hamiltonian->updateHamiltonian(_positionLeader, _metric, _inverseMetric);
 
   // Samples Momentum Candidate from N(0, metric)
@@ -192,8 +342,6 @@ void HMC::runGeneration()
   }
 
   saveSample();
-
-  updateState();
 }
 
 void HMC::runGenerationHMC(const double logUniSample)
@@ -409,6 +557,8 @@ void HMC::saveSample()
   // Store samples after burn in period
   if (_burnIn <= _chainLength)
   {
+    // With several chains, the last generation may produce more samples than needed
+    if (_sampleDatabase.size() >= _maxSamples) return;
     _sampleDatabase.push_back(_positionLeader);
     _sampleEvaluationDatabase.push_back(_leaderEvaluation);
   }
@@ -481,12 +631,13 @@ void HMC::updateStepSize()
 void HMC::updateState()
 {
   _modelEvaluationCount = _hamiltonian->_modelEvaluationCount;
+  for (const auto &hamiltonian : _chainHamiltonians) _modelEvaluationCount += hamiltonian->_modelEvaluationCount;
 
   // Update Acceptance Rate
   if (_useNUTS)
-    _acceptanceRate = (double)_acceptanceCountNUTS / ((double)_chainLength + 1);
+    _acceptanceRate = (double)_acceptanceCountNUTS / ((double)(_chainLength + 1) * _chainCount);
   else
-    _acceptanceRate = (double)_acceptanceCount / ((double)(_chainLength + 1));
+    _acceptanceRate = (double)_acceptanceCount / ((double)(_chainLength + 1) * _chainCount);
 
   // Update Step Size, Dual Step Size, H Bar and apply step size jitter
   updateStepSize();
@@ -688,7 +839,7 @@ void HMC::printGenerationAfter()
   _k->_logger->logInfo("Minimal", "Database Entries %ld\n", _sampleDatabase.size());
   _k->_logger->logInfo("Normal", "Acceptance Rate Proposals: %.2f%%\n", 100. * _acceptanceRate);
   _k->_logger->logInfo("Normal", "Running Acceptance Rate: %.2f%%\n", 100. * _runningAcceptanceRate);
-  _k->_logger->logInfo("Detailed", "Num Model Evaluations: %zu\n", _hamiltonian->_modelEvaluationCount);
+  _k->_logger->logInfo("Detailed", "Num Model Evaluations: %zu\n", _modelEvaluationCount);
 
   _k->_logger->logInfo("Detailed", "Current Leader:\n");
   for (size_t d = 0; d < _variableCount; ++d) _k->_logger->logData("Detailed", "         %s = %+6.3e\n", _k->_variables[d]->_name.c_str(), _positionLeader[d]);
@@ -896,6 +1047,22 @@ void HMC::setConfiguration(knlohmann::json& js)
    eraseValue(js, "Position Candidate");
  }
 
+ if (isDefined(js, "Chain Position Leaders"))
+ {
+ try { _chainPositionLeaders = js["Chain Position Leaders"].get<std::vector<std::vector<double>>>();
+} catch (const std::exception& e)
+ { KORALI_LOG_ERROR(" + Object: [ HMC ] \n + Key:    ['Chain Position Leaders']\n%s", e.what()); } 
+   eraseValue(js, "Chain Position Leaders");
+ }
+
+ if (isDefined(js, "Chain Leader Evaluations"))
+ {
+ try { _chainLeaderEvaluations = js["Chain Leader Evaluations"].get<std::vector<double>>();
+} catch (const std::exception& e)
+ { KORALI_LOG_ERROR(" + Object: [ HMC ] \n + Key:    ['Chain Leader Evaluations']\n%s", e.what()); } 
+   eraseValue(js, "Chain Leader Evaluations");
+ }
+
  if (isDefined(js, "Momentum Leader"))
  {
  try { _momentumLeader = js["Momentum Leader"].get<std::vector<double>>();
@@ -1173,6 +1340,15 @@ void HMC::setConfiguration(knlohmann::json& js)
  }
   else   KORALI_LOG_ERROR(" + No value provided for mandatory setting: ['Initial Slow Adaption Interval'] required by HMC.\n"); 
 
+ if (isDefined(js, "Chain Count"))
+ {
+ try { _chainCount = js["Chain Count"].get<size_t>();
+} catch (const std::exception& e)
+ { KORALI_LOG_ERROR(" + Object: [ HMC ] \n + Key:    ['Chain Count']\n%s", e.what()); } 
+   eraseValue(js, "Chain Count");
+ }
+  else   KORALI_LOG_ERROR(" + No value provided for mandatory setting: ['Chain Count'] required by HMC.\n"); 
+
  if (isDefined(js, "Termination Criteria", "Max Samples"))
  {
  try { _maxSamples = js["Termination Criteria"]["Max Samples"].get<size_t>();
@@ -1234,6 +1410,7 @@ void HMC::getConfiguration(knlohmann::json& js)
    js["Initial Fast Adaption Interval"] = _initialFastAdaptionInterval;
    js["Final Fast Adaption Interval"] = _finalFastAdaptionInterval;
    js["Initial Slow Adaption Interval"] = _initialSlowAdaptionInterval;
+   js["Chain Count"] = _chainCount;
    js["Termination Criteria"]["Max Samples"] = _maxSamples;
    js["Metric Type"] = _metricType;
  if(_normalGenerator != NULL) _normalGenerator->getConfiguration(js["Normal Generator"]);
@@ -1251,6 +1428,8 @@ void HMC::getConfiguration(knlohmann::json& js)
    js["Candidate Evaluation"] = _candidateEvaluation;
    js["Position Leader"] = _positionLeader;
    js["Position Candidate"] = _positionCandidate;
+   js["Chain Position Leaders"] = _chainPositionLeaders;
+   js["Chain Leader Evaluations"] = _chainLeaderEvaluations;
    js["Momentum Leader"] = _momentumLeader;
    js["Momentum Candidate"] = _momentumCandidate;
    js["Log Dual Step Size"] = _logDualStepSize;
@@ -1272,7 +1451,7 @@ void HMC::getConfiguration(knlohmann::json& js)
 void HMC::applyModuleDefaults(knlohmann::json& js) 
 {
 
- std::string defaultString = "{\"Burn In\": 300, \"Use Diagonal Metric\": true, \"Step Size\": 0.1, \"Num Integration Steps\": 4, \"Max Integration Steps\": 100, \"Use Adaptive Step Size\": true, \"Target Acceptance Rate\": 0.65, \"Acceptance Rate Learning Rate\": 0.85, \"Target Integration Time\": 1.0, \"Use NUTS\": true, \"Acceptance Count NUTS\": 0.0, \"Adaptive Step Size Speed Constant\": 0.05, \"Adaptive Step Size Stabilization Constant\": 10.0, \"Adaptive Step Size Schedule Constant\": 0.75, \"Max Depth\": 5, \"Version\": \"Euclidean\", \"Inverse Regularization Parameter\": 1.0, \"Max Fixed Point Iterations\": 8, \"Step Size Jitter\": 0.0, \"Initial Fast Adaption Interval\": 75, \"Final Fast Adaption Interval\": 50, \"Initial Slow Adaption Interval\": 25, \"Termination Criteria\": {\"Max Samples\": 500}, \"Uniform Generator\": {\"Type\": \"Univariate/Uniform\", \"Minimum\": 0.0, \"Maximum\": 1.0}, \"Normal Generator\": {\"Type\": \"Univariate/Normal\", \"Mean\": 0.0, \"Standard Deviation\": 1.0}, \"Multivariate Generator\": {\"Type\": \"Multivariate/Normal\"}}";
+ std::string defaultString = "{\"Burn In\": 300, \"Use Diagonal Metric\": true, \"Step Size\": 0.1, \"Num Integration Steps\": 4, \"Max Integration Steps\": 100, \"Use Adaptive Step Size\": true, \"Target Acceptance Rate\": 0.65, \"Acceptance Rate Learning Rate\": 0.85, \"Target Integration Time\": 1.0, \"Use NUTS\": true, \"Acceptance Count NUTS\": 0.0, \"Adaptive Step Size Speed Constant\": 0.05, \"Adaptive Step Size Stabilization Constant\": 10.0, \"Adaptive Step Size Schedule Constant\": 0.75, \"Max Depth\": 5, \"Version\": \"Euclidean\", \"Inverse Regularization Parameter\": 1.0, \"Max Fixed Point Iterations\": 8, \"Step Size Jitter\": 0.0, \"Initial Fast Adaption Interval\": 75, \"Final Fast Adaption Interval\": 50, \"Initial Slow Adaption Interval\": 25, \"Chain Count\": 1, \"Termination Criteria\": {\"Max Samples\": 500}, \"Uniform Generator\": {\"Type\": \"Univariate/Uniform\", \"Minimum\": 0.0, \"Maximum\": 1.0}, \"Normal Generator\": {\"Type\": \"Univariate/Normal\", \"Mean\": 0.0, \"Standard Deviation\": 1.0}, \"Multivariate Generator\": {\"Type\": \"Multivariate/Normal\"}}";
  knlohmann::json defaultJs = knlohmann::json::parse(defaultString);
  mergeJson(js, defaultJs); 
  Sampler::applyModuleDefaults(js);
@@ -17,6 +17,7 @@
 #include "modules/distribution/univariate/normal/normal.hpp"
 #include "modules/distribution/univariate/uniform/uniform.hpp"
 #include "modules/solver/sampler/sampler.hpp"
+#include "auxiliar/libco/copool.h"
 #include <string>
 #include <vector>
 
@@ -72,6 +73,93 @@ class HMC : public Sampler
   std::shared_ptr<Hamiltonian> _hamiltonian;
   std::unique_ptr<Leapfrog> _integrator;
 
+  /**
+   * @brief Candidate positions of the chains after the first one.
+   */
+  std::vector<std::vector<double>> _chainPositionCandidates;
+
+  /**
+   * @brief Momentum leaders of the chains after the first one.
+   */
+  std::vector<std::vector<double>> _chainMomentumLeaders;
+
+  /**
+   * @brief Momentum candidates of the chains after the first one.
+   */
+  std::vector<std::vector<double>> _chainMomentumCandidates;
+
+  /**
+   * @brief Acceptance probabilities of the chains after the first one.
+   */
+  std::vector<double> _chainAcceptanceProbabilities;
+
+  /**
+   * @brief Current NUTS tree depths of the chains after the first one.
+   */
+  std::vector<size_t> _chainDepths;
+
+  /**
+   * @brief Hamiltonians of the chains after the first one. Each one holds the evaluation and gradient at its chain's position.
+   */
+  std::vector<std::shared_ptr<Hamiltonian>> _chainHamiltonians;
+
+  /**
+   * @brief Integrators of the chains after the first one.
+   */
+  std::vector<std::unique_ptr<Leapfrog>> _chainIntegrators;
+
+  /**
+   * @brief Sample slots of the chains, one in flight per chain.
+   */
+  std::vector<Sample> _chainSamples;
+
+  /**
+   * @brief Coroutines running the generation of each chain.
+   */
+  std::vector<cothread_t> _chainThreads;
+
+  /**
+   * @brief Stacks of the chain coroutines, taken from the stack pool for one generation.
+   */
+  std::vector<void *> _chainStacks;
+
+  /**
+   * @brief Pool of the stacks of the chain coroutines, reused by every generation.
+   */
+  co_pool *_chainStackPool = NULL;
+
+  /**
+   * @brief Indicates which chains have not finished their current generation.
+   */
+  std::vector<bool> _isChainRunning;
+
+  /**
+   * @brief Coroutine that schedules the chains, to which they return while their sample is evaluated.
+   */
+  cothread_t _schedulerThread;
+
+  /**
+   * @brief Index of the chain whose state is currently loaded.
+   */
+  size_t _activeChain;
+
+  /**
+   * @brief Exchanges the state of the first chain (held in the solver's variables) with the stored state of another chain. Calling it twice restores the original state.
+   * @param chainIdx Index of the chain (nothing is done for the first chain).
+   */
+  void swapChainState(const size_t chainIdx);
+
+  /**
+   * @brief Starts the sample of the active chain and returns to the scheduler until the sample has finished.
+   * @param sample Sample of the active chain.
+   */
+  void evaluateChainSample(Sample &sample);
+
+  /**
+   * @brief Advances the chain whose state is currently loaded by one step, and saves its new sample.
+   */
+  void runChainGeneration();
+
   /**
    * @brief Updates internal state such as mean, Metric and InverseMetric.
    */
@@ -211,6 +299,10 @@ class HMC : public Sampler
   */
    size_t _initialSlowAdaptionInterval;
   /**
+  * @brief Number of chains advanced concurrently. Each chain keeps one gradient evaluation in flight, and a chain resumes as soon as its own evaluation finishes. The chains share the step size and metric adaptation, and their samples are pooled into the database.
+  */
+   size_t _chainCount;
+  /**
   * @brief [Internal Use] Metric Type can be set to 'Static', 'Euclidean' or 'Riemannian'.
   */
    Metric _metricType;
@@ -275,6 +367,14 @@ class HMC : public Sampler
   */
    std::vector<double> _positionCandidate;
   /**
+  * @brief [Internal Use] Position leaders of the chains after the first one (the first chain is stored in Position Leader).
+  */
+   std::vector<std::vector<double>> _chainPositionLeaders;
+  /**
+  * @brief [Internal Use] Evaluations of the position leaders of the chains after the first one.
+  */
+   std::vector<double> _chainLeaderEvaluations;
+  /**
   * @brief [Internal Use] Latest momentum sample.
   */
    std::vector<double> _momentumLeader;
@@ -350,6 +450,16 @@ class HMC : public Sampler
   void applyVariableDefaults() override;
   
 
+  /**
+   * @brief Unmaps the stacks of the chain coroutines.
+   */
+  ~HMC();
+
+  /**
+   * @brief Entry point of the coroutine of the active chain. Runs its generation and returns to the scheduler.
+   */
+  void runChainCoroutine();
+
   /**
    * @brief Configures HMC.
    */
@@ -11,6 +11,8 @@
 #include "modules/problem/sampling/sampling.hpp"
 #include "sample/sample.hpp"
 
+#include <functional>
+
 namespace korali
 {
 namespace solver
@@ -142,22 +144,44 @@ class Hamiltonian
   virtual double innerProduct(const std::vector<double> &leftMomentum, const std::vector<double> &rightMomentum, const std::vector<double> &inverseMetric) const = 0;
 
   /**
-  * @brief Updates current position of hamiltonian.
-  * @param position Current position.
-  * @param metric Current metric.
-  * @param inverseMetric Inverse of current metric.
+  * @brief Evaluates the model at the given position. The evaluation uses the sample slot assigned by the solver, if any, and the solver's evaluator, if any.
+  * @param position Position to evaluate.
+  * @param localSample Sample to use if no sample slot has been assigned.
+  * @return Reference to the evaluated sample.
   */
-  virtual void updateHamiltonian(const std::vector<double> &position, std::vector<double> &metric, std::vector<double> &inverseMetric)
+  korali::Sample &evaluatePosition(const std::vector<double> &position, korali::Sample &localSample)
   {
-    auto sample = korali::Sample();
+    korali::Sample &sample = _sample == nullptr ? localSample : *_sample;
+    sample._js.getJson() = knlohmann::json();
+    sample._buffers.clear();
+
     sample["Sample Id"] = _modelEvaluationCount;
     sample["Module"] = "Problem";
     sample["Operation"] = "Evaluate";
     sample["Parameters"] = position;
 
-    KORALI_START(sample);
-    KORALI_WAIT(sample);
+    if (_sampleEvaluator)
+      _sampleEvaluator(sample);
+    else
+    {
+      KORALI_START(sample);
+      KORALI_WAIT(sample);
+    }
+
     _modelEvaluationCount++;
+    return sample;
+  }
+
+  /**
+  * @brief Updates current position of hamiltonian.
+  * @param position Current position.
+  * @param metric Current metric.
+  * @param inverseMetric Inverse of current metric.
+  */
+  virtual void updateHamiltonian(const std::vector<double> &position, std::vector<double> &metric, std::vector<double> &inverseMetric)
+  {
+    korali::Sample localSample;
+    korali::Sample &sample = evaluatePosition(position, localSample);
     _currentEvaluation = KORALI_GET(double, sample, "logP(x)");
 
     if (samplingProblemPtr != nullptr)
@@ -251,6 +275,16 @@ class Hamiltonian
   * @brief State Space Dimension needed for Leapfrog integrator.
   */
   size_t _stateSpaceDim;
+
+  /**
+  * @brief Sample slot used for the model evaluations (if NULL, a local sample is used).
+  */
+  korali::Sample *_sample = nullptr;
+
+  /**
+  * @brief Function that starts a sample and returns once it has finished (if empty, the sample is started and waited for directly).
+  */
+  std::function<void(korali::Sample &)> _sampleEvaluator;
 };
 
 } // namespace sampler
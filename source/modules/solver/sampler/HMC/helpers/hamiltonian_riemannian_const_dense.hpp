@@ -181,15 +181,8 @@ class HamiltonianRiemannianConstDense : public HamiltonianRiemannian
   */
   void updateHamiltonian(const std::vector<double> &position, std::vector<double> &metric, std::vector<double> &inverseMetric) override
   {
-    auto sample = korali::Sample();
-    sample["Sample Id"] = _modelEvaluationCount;
-    sample["Module"] = "Problem";
-    sample["Operation"] = "Evaluate";
-    sample["Parameters"] = position;
-
-    KORALI_START(sample);
-    KORALI_WAIT(sample);
-    _modelEvaluationCount++;
+    korali::Sample localSample;
+    korali::Sample &sample = evaluatePosition(position, localSample);
     _currentEvaluation = KORALI_GET(double, sample, "logP(x)");
 
     if (samplingProblemPtr != nullptr)
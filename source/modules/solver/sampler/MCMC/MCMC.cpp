@@ -5,6 +5,7 @@
 #include "sample/sample.hpp"
 
 #include <chrono>
+#include <cmath>
 #include <limits>
 #include <numeric>
 
@@ -31,14 +32,19 @@ void MCMC::setInitialConfiguration()
   if (_burnIn < 0) KORALI_LOG_ERROR("Burn In must be larger equal 0 (is %zu).\n", _burnIn);
   if (_rejectionLevels < 1) KORALI_LOG_ERROR("Rejection Levels must be larger 0 (is %zu).\n", _rejectionLevels);
   if (_nonAdaptionPeriod < 0) KORALI_LOG_ERROR("Non Adaption Period must be larger equal 0 (is %zu).\n", _nonAdaptionPeriod);
+  if (_chainCount < 1) KORALI_LOG_ERROR("Chain Count must be larger 0 (is %zu).\n", _chainCount);
+  if (_chainInteraction == "Differential Evolution" && _chainCount < 3) KORALI_LOG_ERROR("Differential Evolution requires a Chain Count of at least 3 (is %zu).\n", _chainCount);
+  if (_chainInteraction == "Differential Evolution" && _differentialEvolutionScaling < 0.0) KORALI_LOG_ERROR("Differential Evolution Scaling must be larger equal 0.0 (is %lf).\n", _differentialEvolutionScaling);
+  if (_chainInteraction == "Parallel Tempering" && _temperingRatio <= 1.0) KORALI_LOG_ERROR("Tempering Ratio must be larger 1.0 (is %lf).\n", _temperingRatio);
 
-  // Allocating MCMC memory
-  _chainCandidate.resize(_rejectionLevels);
-  for (size_t i = 0; i < _rejectionLevels; i++) _chainCandidate[i].resize(_variableCount);
+  // Allocating MCMC memory, the candidates are stored chain by chain, one per rejection level
+  _chainCandidate.resize(_chainCount * _rejectionLevels);
+  for (size_t i = 0; i < _chainCount * _rejectionLevels; i++) _chainCandidate[i].resize(_variableCount);
 
   _choleskyDecompositionCovariance.resize(_variableCount * _variableCount);
-  _chainLeader.resize(_variableCount);
-  _chainCandidatesEvaluations.resize(_rejectionLevels);
+  _chainLeaders.resize(_chainCount);
+  _chainLeadersEvaluations.resize(_chainCount);
+  _chainCandidatesEvaluations.resize(_chainCount * _rejectionLevels);
   _rejectionAlphas.resize(_rejectionLevels);
   _chainMean.resize(_variableCount);
   _chainCovariancePlaceholder.resize(_variableCount * _variableCount);
@@ -47,63 +53,114 @@ void MCMC::setInitialConfiguration()
 
   std::fill(std::begin(_choleskyDecompositionCovariance), std::end(_choleskyDecompositionCovariance), 0.0);
   std::fill(std::begin(_choleskyDecompositionChainCovariance), std::end(_choleskyDecompositionChainCovariance), 0.0);
+  std::fill(std::begin(_chainCovariance), std::end(_chainCovariance), 0.0);
 
-  for (size_t i = 0; i < _variableCount; i++) _chainLeader[i] = _k->_variables[i]->_initialMean;
   for (size_t i = 0; i < _variableCount; i++) _choleskyDecompositionCovariance[i * _variableCount + i] = _k->_variables[i]->_initialStandardDeviation;
 
+  // The first chain starts at the initial mean, the others are dispersed around it so that they explore (and interact) from the start
+  for (size_t c = 0; c < _chainCount; c++)
+  {
+    _chainLeaders[c].resize(_variableCount);
+    for (size_t i = 0; i < _variableCount; i++)
+    {
+      _chainLeaders[c][i] = _k->_variables[i]->_initialMean;
+      if (c > 0) _chainLeaders[c][i] += _k->_variables[i]->_initialStandardDeviation * _normalGenerator->getRandomNumber();
+    }
+    _chainLeadersEvaluations[c] = -std::numeric_limits<double>::infinity();
+  }
+
   // Init Generation
   _acceptanceCount = 0;
   _proposedSampleCount = 0;
   _chainLength = 0;
-  _chainLeaderEvaluation = -std::numeric_limits<double>::infinity();
   _acceptanceRate = 1.0;
+  _swapProposalCount = 0;
+  _swapAcceptanceCount = 0;
 }
 
 void MCMC::runGeneration()
 {
   if (_k->_currentGeneration == 1) setInitialConfiguration();
 
-  bool _sampleAccepted = false;
+  // Generating the candidates of all chains and rejection levels at once. The delayed rejection levels are evaluated speculatively, since each one only depends on the candidate of the previous level.
+  for (size_t c = 0; c < _chainCount; c++)
+    for (size_t i = 0; i < _rejectionLevels; i++) generateCandidate(c, i);
 
-  for (size_t i = 0; i < _rejectionLevels && _sampleAccepted == false; i++)
+  std::vector<Sample> samples(_chainCount * _rejectionLevels);
+  for (size_t j = 0; j < samples.size(); j++)
   {
-    generateCandidate(i);
-
-    auto sample = Sample();
-
     _modelEvaluationCount++;
-    sample["Parameters"] = _chainCandidate[i];
-    sample["Sample Id"] = _sampleDatabase.size();
-    sample["Module"] = "Problem";
-    sample["Operation"] = "Evaluate";
-    KORALI_START(sample);
-    KORALI_WAIT(sample);
+    samples[j]["Parameters"] = _chainCandidate[j];
+    samples[j]["Sample Id"] = j;
+    samples[j]["Module"] = "Problem";
+    samples[j]["Operation"] = "Evaluate";
+    KORALI_START(samples[j]);
+  }
 
-    double evaluation = KORALI_GET(double, sample, "logP(x)");
+  KORALI_WAITALL(samples);
 
-    _chainCandidatesEvaluations[i] = evaluation;
+  for (size_t j = 0; j < samples.size(); j++) _chainCandidatesEvaluations[j] = KORALI_GET(double, samples[j], "logP(x)");
 
-    // Processing Result
-    double denom;
-    double _rejectionAlpha = recursiveAlpha(denom, _chainLeaderEvaluation, &_chainCandidatesEvaluations[0], i);
+  // Processing the results of every chain, in order of its rejection levels
+  std::vector<double> temperedEvaluations(_rejectionLevels);
+  for (size_t c = 0; c < _chainCount; c++)
+  {
+    const double inverseTemperature = getChainInverseTemperature(c);
+    const double temperedLeaderEvaluation = inverseTemperature * _chainLeadersEvaluations[c];
+    for (size_t i = 0; i < _rejectionLevels; i++) temperedEvaluations[i] = inverseTemperature * _chainCandidatesEvaluations[c * _rejectionLevels + i];
 
-    if (_rejectionAlpha == 1.0 || _rejectionAlpha > _uniformGenerator->getRandomNumber())
+    for (size_t i = 0; i < _rejectionLevels; i++)
     {
-      _acceptanceCount++;
-      _sampleAccepted = true;
-      _chainLeaderEvaluation = _chainCandidatesEvaluations[i];
-      _chainLeader = _chainCandidate[i];
+      double denom;
+      double _rejectionAlpha = recursiveAlpha(denom, temperedLeaderEvaluation, &temperedEvaluations[0], i);
+
+      if (_rejectionAlpha == 1.0 || _rejectionAlpha > _uniformGenerator->getRandomNumber())
+      {
+        _acceptanceCount++;
+        _chainLeadersEvaluations[c] = _chainCandidatesEvaluations[c * _rejectionLevels + i];
+        _chainLeaders[c] = _chainCandidate[c * _rejectionLevels + i];
+        break;
+      }
     }
   }
 
+  if (_chainInteraction == "Parallel Tempering") swapChains();
+
+  // Storing the samples of every chain (only the untempered one for parallel tempering), which are pooled for the adaptation
+  const size_t storedChainCount = (_chainInteraction == "Parallel Tempering") ? 1 : _chainCount;
   if ((_chainLength >= _burnIn) && (_k->_currentGeneration % _leap == 0))
-  {
-    _sampleDatabase.push_back(_chainLeader);
-    _sampleEvaluationDatabase.push_back(_chainLeaderEvaluation);
-  }
+    for (size_t c = 0; c < storedChainCount && _sampleDatabase.size() < _maxSamples; c++)
+    {
+      _sampleDatabase.push_back(_chainLeaders[c]);
+      _sampleEvaluationDatabase.push_back(_chainLeadersEvaluations[c]);
+      updateChainStatistics(_chainLeaders[c]);
+    }
 
-  updateState();
   _chainLength++;
+  updateState();
+}
+
+double MCMC::getChainInverseTemperature(size_t chainIdx) const
+{
+  if (_chainInteraction != "Parallel Tempering") return 1.0;
+  return std::pow(_temperingRatio, -(double)chainIdx);
+}
+
+void MCMC::swapChains()
+{
+  // Proposing to swap the states of every pair of neighbouring temperatures, from the hottest to the coldest
+  for (size_t c = _chainCount - 1; c > 0; c--)
+  {
+    _swapProposalCount++;
+
+    const double logAlpha = (getChainInverseTemperature(c - 1) - getChainInverseTemperature(c)) * (_chainLeadersEvaluations[c] - _chainLeadersEvaluations[c - 1]);
+    if (logAlpha >= 0.0 || std::log(_uniformGenerator->getRandomNumber()) < logAlpha)
+    {
+      _swapAcceptanceCount++;
+      std::swap(_chainLeaders[c], _chainLeaders[c - 1]);
+      std::swap(_chainLeadersEvaluations[c], _chainLeadersEvaluations[c - 1]);
+    }
+  }
 }
 
 void MCMC::choleskyDecomp(const std::vector<double> &inC, std::vector<double> &outL) const
@@ -173,55 +230,69 @@ double MCMC::recursiveAlpha(double &denominator, const double leaderLoglikelihoo
   }
 }
 
-void MCMC::generateCandidate(size_t sampleIdx)
+void MCMC::generateCandidate(size_t chainIdx, size_t level)
 {
   _proposedSampleCount++;
 
-  if (sampleIdx == 0)
-    for (size_t d = 0; d < _variableCount; ++d) _chainCandidate[sampleIdx][d] = _chainLeader[d];
-  else
-    for (size_t d = 0; d < _variableCount; ++d) _chainCandidate[sampleIdx][d] = _chainCandidate[sampleIdx - 1][d];
+  auto &candidate = _chainCandidate[chainIdx * _rejectionLevels + level];
+  const auto &origin = (level == 0) ? _chainLeaders[chainIdx] : _chainCandidate[chainIdx * _rejectionLevels + level - 1];
+  for (size_t d = 0; d < _variableCount; ++d) candidate[d] = origin[d];
 
-  if ((_useAdaptiveSampling == false) || (_sampleDatabase.size() <= _nonAdaptionPeriod + _burnIn))
-    for (size_t d = 0; d < _variableCount; ++d)
-      for (size_t e = 0; e < _variableCount; ++e) _chainCandidate[sampleIdx][d] += _choleskyDecompositionCovariance[d * _variableCount + e] * _normalGenerator->getRandomNumber();
-  else
-    for (size_t d = 0; d < _variableCount; ++d)
-      for (size_t e = 0; e < _variableCount; ++e) _chainCandidate[sampleIdx][d] += _choleskyDecompositionChainCovariance[d * _variableCount + e] * _normalGenerator->getRandomNumber();
+  const bool isAdapted = (_useAdaptiveSampling == true) && (_sampleDatabase.size() > _nonAdaptionPeriod + _burnIn);
+  const auto &choleskyDecomposition = isAdapted ? _choleskyDecompositionChainCovariance : _choleskyDecompositionCovariance;
+
+  // The first stage of differential evolution moves along the difference of two other chains, plus a small jitter from the proposal to keep the chain irreducible (ter Braak 2006)
+  double proposalScaling = 1.0;
+  if (_chainInteraction == "Differential Evolution" && level == 0)
+  {
+    size_t a = _uniformGenerator->getRandomNumber() * (_chainCount - 1);
+    if (a >= chainIdx) a++;
+    size_t b = _uniformGenerator->getRandomNumber() * (_chainCount - 2);
+    if (b >= std::min(chainIdx, a)) b++;
+    if (b >= std::max(chainIdx, a)) b++;
+
+    const double gamma = (_differentialEvolutionScaling > 0.0) ? _differentialEvolutionScaling : 2.38 / std::sqrt(2.0 * _variableCount);
+    for (size_t d = 0; d < _variableCount; ++d) candidate[d] += gamma * (_chainLeaders[a][d] - _chainLeaders[b][d]);
+    proposalScaling = 0.01;
+  }
+
+  for (size_t d = 0; d < _variableCount; ++d)
+    for (size_t e = 0; e < _variableCount; ++e) candidate[d] += proposalScaling * choleskyDecomposition[d * _variableCount + e] * _normalGenerator->getRandomNumber();
 }
 
-void MCMC::updateState()
+void MCMC::updateChainStatistics(const std::vector<double> &sample)
 {
-  _acceptanceRate = ((double)_acceptanceCount / (double)_chainLength);
+  const double sampleCount = _sampleDatabase.size();
 
-  if (_sampleDatabase.size() == 0) return;
-  if (_sampleDatabase.size() == 1)
+  if (sampleCount == 1)
   {
-    for (size_t d = 0; d < _variableCount; d++) _chainMean[d] = _chainLeader[d];
+    for (size_t d = 0; d < _variableCount; d++) _chainMean[d] = sample[d];
     return;
   }
 
   for (size_t d = 0; d < _variableCount; d++)
-    for (size_t e = 0; e < d; e++)
+    for (size_t e = 0; e <= d; e++)
     {
-      _chainCovariancePlaceholder[d * _variableCount + e] = (_chainMean[d] - _chainLeader[d]) * (_chainMean[e] - _chainLeader[e]);
-      _chainCovariancePlaceholder[e * _variableCount + d] = (_chainMean[d] - _chainLeader[d]) * (_chainMean[e] - _chainLeader[e]);
+      _chainCovariancePlaceholder[d * _variableCount + e] = (_chainMean[d] - sample[d]) * (_chainMean[e] - sample[e]);
+      _chainCovariancePlaceholder[e * _variableCount + d] = _chainCovariancePlaceholder[d * _variableCount + e];
     }
-  for (size_t d = 0; d < _variableCount; d++) _chainCovariancePlaceholder[d * _variableCount + d] = (_chainMean[d] - _chainLeader[d]) * (_chainMean[d] - _chainLeader[d]);
 
   // Chain Mean
-  for (size_t d = 0; d < _variableCount; d++) _chainMean[d] = (_chainMean[d] * (_sampleDatabase.size() - 1) + _chainLeader[d]) / _sampleDatabase.size();
+  for (size_t d = 0; d < _variableCount; d++) _chainMean[d] = (_chainMean[d] * (sampleCount - 1) + sample[d]) / sampleCount;
 
   for (size_t d = 0; d < _variableCount; d++)
-    for (size_t e = 0; e < d; e++)
+    for (size_t e = 0; e <= d; e++)
     {
-      _chainCovariance[d * _variableCount + e] = (_sampleDatabase.size() - 2.0) / (_sampleDatabase.size() - 1.0) * _chainCovariance[d * _variableCount + e] + (_chainCovarianceScaling / _sampleDatabase.size()) * _chainCovariancePlaceholder[d * _variableCount + e];
-      _chainCovariance[e * _variableCount + d] = (_sampleDatabase.size() - 2.0) / (_sampleDatabase.size() - 1.0) * _chainCovariance[d * _variableCount + e] + (_chainCovarianceScaling / _sampleDatabase.size()) * _chainCovariancePlaceholder[d * _variableCount + e];
+      _chainCovariance[d * _variableCount + e] = (sampleCount - 2.0) / (sampleCount - 1.0) * _chainCovariance[d * _variableCount + e] + (_chainCovarianceScaling / sampleCount) * _chainCovariancePlaceholder[d * _variableCount + e];
+      _chainCovariance[e * _variableCount + d] = _chainCovariance[d * _variableCount + e];
     }
-  for (size_t d = 0; d < _variableCount; d++)
-    _chainCovariance[d * _variableCount + d] = (_sampleDatabase.size() - 2.0) / (_sampleDatabase.size() - 1.0) * _chainCovariance[d * _variableCount + d] + (_chainCovarianceScaling / _sampleDatabase.size()) * _chainCovariancePlaceholder[d * _variableCount + d];
+}
 
-  if ((_useAdaptiveSampling == true) && (_sampleDatabase.size() > _nonAdaptionPeriod)) choleskyDecomp(_chainCovariance, _choleskyDecompositionChainCovariance);
+void MCMC::updateState()
+{
+  _acceptanceRate = ((double)_acceptanceCount / (double)(_chainLength * _chainCount));
+
+  if ((_useAdaptiveSampling == true) && (_sampleDatabase.size() > 1) && (_sampleDatabase.size() > _nonAdaptionPeriod)) choleskyDecomp(_chainCovariance, _choleskyDecompositionChainCovariance);
 }
 
 void MCMC::printGenerationBefore() { return; }
@@ -232,9 +303,13 @@ void MCMC::printGenerationAfter()
 
   _k->_logger->logInfo("Normal", "Accepted Samples: %zu\n", _acceptanceCount);
   _k->_logger->logInfo("Normal", "Acceptance Rate Proposals: %.2f%%\n", 100 * _acceptanceRate);
+  if (_chainInteraction == "Parallel Tempering" && _swapProposalCount > 0) _k->_logger->logInfo("Normal", "Acceptance Rate Swaps: %.2f%%\n", 100.0 * _swapAcceptanceCount / _swapProposalCount);
 
-  _k->_logger->logInfo("Detailed", "Current Sample:\n");
-  for (size_t d = 0; d < _variableCount; d++) _k->_logger->logData("Detailed", "         %s = %+6.3e\n", _k->_variables[d]->_name.c_str(), _chainLeader[d]);
+  for (size_t c = 0; c < _chainCount; c++)
+  {
+    _k->_logger->logInfo("Detailed", "Current Sample (Chain %zu):\n", c);
+    for (size_t d = 0; d < _variableCount; d++) _k->_logger->logData("Detailed", "         %s = %+6.3e\n", _k->_variables[d]->_name.c_str(), _chainLeaders[c][d]);
+  }
 
   _k->_logger->logInfo("Detailed", "Current Chain Mean:\n");
   for (size_t d = 0; d < _variableCount; d++) _k->_logger->logData("Detailed", "         %s = %+6.3e\n", _k->_variables[d]->_name.c_str(), _chainMean[d]);
@@ -292,20 +367,20 @@ void MCMC::setConfiguration(knlohmann::json& js)
    eraseValue(js, "Cholesky Decomposition Chain Covariance");
  }
 
- if (isDefined(js, "Chain Leader"))
+ if (isDefined(js, "Chain Leaders"))
  {
- try { _chainLeader = js["Chain Leader"].get<std::vector<double>>();
+ try { _chainLeaders = js["Chain Leaders"].get<std::vector<std::vector<double>>>();
 } catch (const std::exception& e)
- { KORALI_LOG_ERROR(" + Object: [ MCMC ] \n + Key:    ['Chain Leader']\n%s", e.what()); } 
-   eraseValue(js, "Chain Leader");
+ { KORALI_LOG_ERROR(" + Object: [ MCMC ] \n + Key:    ['Chain Leaders']\n%s", e.what()); } 
+   eraseValue(js, "Chain Leaders");
  }
 
- if (isDefined(js, "Chain Leader Evaluation"))
+ if (isDefined(js, "Chain Leaders Evaluations"))
  {
- try { _chainLeaderEvaluation = js["Chain Leader Evaluation"].get<double>();
+ try { _chainLeadersEvaluations = js["Chain Leaders Evaluations"].get<std::vector<double>>();
 } catch (const std::exception& e)
- { KORALI_LOG_ERROR(" + Object: [ MCMC ] \n + Key:    ['Chain Leader Evaluation']\n%s", e.what()); } 
-   eraseValue(js, "Chain Leader Evaluation");
+ { KORALI_LOG_ERROR(" + Object: [ MCMC ] \n + Key:    ['Chain Leaders Evaluations']\n%s", e.what()); } 
+   eraseValue(js, "Chain Leaders Evaluations");
  }
 
  if (isDefined(js, "Chain Candidate"))
@@ -324,6 +399,22 @@ void MCMC::setConfiguration(knlohmann::json& js)
    eraseValue(js, "Chain Candidates Evaluations");
  }
 
+ if (isDefined(js, "Swap Proposal Count"))
+ {
+ try { _swapProposalCount = js["Swap Proposal Count"].get<size_t>();
+} catch (const std::exception& e)
+ { KORALI_LOG_ERROR(" + Object: [ MCMC ] \n + Key:    ['Swap Proposal Count']\n%s", e.what()); } 
+   eraseValue(js, "Swap Proposal Count");
+ }
+
+ if (isDefined(js, "Swap Acceptance Count"))
+ {
+ try { _swapAcceptanceCount = js["Swap Acceptance Count"].get<size_t>();
+} catch (const std::exception& e)
+ { KORALI_LOG_ERROR(" + Object: [ MCMC ] \n + Key:    ['Swap Acceptance Count']\n%s", e.what()); } 
+   eraseValue(js, "Swap Acceptance Count");
+ }
+
  if (isDefined(js, "Rejection Alphas"))
  {
  try { _rejectionAlphas = js["Rejection Alphas"].get<std::vector<double>>();
@@ -458,6 +549,49 @@ void MCMC::setConfiguration(knlohmann::json& js)
  }
   else   KORALI_LOG_ERROR(" + No value provided for mandatory setting: ['Chain Covariance Scaling'] required by MCMC.\n"); 
 
+ if (isDefined(js, "Chain Count"))
+ {
+ try { _chainCount = js["Chain Count"].get<size_t>();
+} catch (const std::exception& e)
+ { KORALI_LOG_ERROR(" + Object: [ MCMC ] \n + Key:    ['Chain Count']\n%s", e.what()); } 
+   eraseValue(js, "Chain Count");
+ }
+  else   KORALI_LOG_ERROR(" + No value provided for mandatory setting: ['Chain Count'] required by MCMC.\n"); 
+
+ if (isDefined(js, "Chain Interaction"))
+ {
+ try { _chainInteraction = js["Chain Interaction"].get<std::string>();
+} catch (const std::exception& e)
+ { KORALI_LOG_ERROR(" + Object: [ MCMC ] \n + Key:    ['Chain Interaction']\n%s", e.what()); } 
+{
+ bool validOption = false; 
+ if (_chainInteraction == "Independent") validOption = true; 
+ if (_chainInteraction == "Differential Evolution") validOption = true; 
+ if (_chainInteraction == "Parallel Tempering") validOption = true; 
+ if (validOption == false) KORALI_LOG_ERROR(" + Unrecognized value (%s) provided for mandatory setting: ['Chain Interaction'] required by MCMC.\n", _chainInteraction.c_str()); 
+}
+   eraseValue(js, "Chain Interaction");
+ }
+  else   KORALI_LOG_ERROR(" + No value provided for mandatory setting: ['Chain Interaction'] required by MCMC.\n"); 
+
+ if (isDefined(js, "Differential Evolution Scaling"))
+ {
+ try { _differentialEvolutionScaling = js["Differential Evolution Scaling"].get<double>();
+} catch (const std::exception& e)
+ { KORALI_LOG_ERROR(" + Object: [ MCMC ] \n + Key:    ['Differential Evolution Scaling']\n%s", e.what()); } 
+   eraseValue(js, "Differential Evolution Scaling");
+ }
+  else   KORALI_LOG_ERROR(" + No value provided for mandatory setting: ['Differential Evolution Scaling'] required by MCMC.\n"); 
+
+ if (isDefined(js, "Tempering Ratio"))
+ {
+ try { _temperingRatio = js["Tempering Ratio"].get<double>();
+} catch (const std::exception& e)
+ { KORALI_LOG_ERROR(" + Object: [ MCMC ] \n + Key:    ['Tempering Ratio']\n%s", e.what()); } 
+   eraseValue(js, "Tempering Ratio");
+ }
+  else   KORALI_LOG_ERROR(" + No value provided for mandatory setting: ['Tempering Ratio'] required by MCMC.\n"); 
+
  if (isDefined(js, "Termination Criteria", "Max Samples"))
  {
  try { _maxSamples = js["Termination Criteria"]["Max Samples"].get<size_t>();
@@ -504,15 +638,21 @@ void MCMC::getConfiguration(knlohmann::json& js)
    js["Use Adaptive Sampling"] = _useAdaptiveSampling;
    js["Non Adaption Period"] = _nonAdaptionPeriod;
    js["Chain Covariance Scaling"] = _chainCovarianceScaling;
+   js["Chain Count"] = _chainCount;
+   js["Chain Interaction"] = _chainInteraction;
+   js["Differential Evolution Scaling"] = _differentialEvolutionScaling;
+   js["Tempering Ratio"] = _temperingRatio;
    js["Termination Criteria"]["Max Samples"] = _maxSamples;
  if(_normalGenerator != NULL) _normalGenerator->getConfiguration(js["Normal Generator"]);
  if(_uniformGenerator != NULL) _uniformGenerator->getConfiguration(js["Uniform Generator"]);
    js["Cholesky Decomposition Covariance"] = _choleskyDecompositionCovariance;
    js["Cholesky Decomposition Chain Covariance"] = _choleskyDecompositionChainCovariance;
-   js["Chain Leader"] = _chainLeader;
-   js["Chain Leader Evaluation"] = _chainLeaderEvaluation;
+   js["Chain Leaders"] = _chainLeaders;
+   js["Chain Leaders Evaluations"] = _chainLeadersEvaluations;
    js["Chain Candidate"] = _chainCandidate;
    js["Chain Candidates Evaluations"] = _chainCandidatesEvaluations;
+   js["Swap Proposal Count"] = _swapProposalCount;
+   js["Swap Acceptance Count"] = _swapAcceptanceCount;
    js["Rejection Alphas"] = _rejectionAlphas;
    js["Acceptance Rate"] = _acceptanceRate;
    js["Acceptance Count"] = _acceptanceCount;
@@ -533,7 +673,7 @@ void MCMC::getConfiguration(knlohmann::json& js)
 void MCMC::applyModuleDefaults(knlohmann::json& js) 
 {
 
- std::string defaultString = "{\"Burn In\": 0, \"Leap\": 1, \"Rejection Levels\": 1, \"Use Adaptive Sampling\": false, \"Non Adaption Period\": 0, \"Chain Covariance Scaling\": 1.0, \"Termination Criteria\": {\"Max Samples\": 5000}, \"Uniform Generator\": {\"Type\": \"Univariate/Uniform\", \"Minimum\": 0.0, \"Maximum\": 1.0}, \"Normal Generator\": {\"Type\": \"Univariate/Normal\", \"Mean\": 0.0, \"Standard Deviation\": 1.0}}";
+ std::string defaultString = "{\"Burn In\": 0, \"Leap\": 1, \"Rejection Levels\": 1, \"Use Adaptive Sampling\": false, \"Non Adaption Period\": 0, \"Chain Covariance Scaling\": 1.0, \"Chain Count\": 1, \"Chain Interaction\": \"Independent\", \"Differential Evolution Scaling\": 0.0, \"Tempering Ratio\": 2.0, \"Termination Criteria\": {\"Max Samples\": 5000}, \"Uniform Generator\": {\"Type\": \"Univariate/Uniform\", \"Minimum\": 0.0, \"Maximum\": 1.0}, \"Normal Generator\": {\"Type\": \"Univariate/Normal\", \"Mean\": 0.0, \"Standard Deviation\": 1.0}}";
  knlohmann::json defaultJs = knlohmann::json::parse(defaultString);
  mergeJson(js, defaultJs); 
  Sampler::applyModuleDefaults(js);
@@ -56,6 +56,22 @@ class MCMC : public Sampler
   */
    double _chainCovarianceScaling;
   /**
+  * @brief Number of chains advanced in lock-step. The candidates of all chains, and of all their rejection levels, are evaluated in parallel. The samples of all chains are pooled into the database and the Chain Covariance.
+  */
+   size_t _chainCount;
+  /**
+  * @brief Determines how the chains interact.
+  */
+   std::string _chainInteraction;
+  /**
+  * @brief Scaling of the difference between chains in the Differential Evolution proposal. If 0 (default) is specified, it is set to $2.38/sqrt(2N)$, where $N$ is the number of variables.
+  */
+   double _differentialEvolutionScaling;
+  /**
+  * @brief Ratio between the temperatures of neighbouring chains, for Parallel Tempering (must be larger 1.0). The first chain has temperature 1.0.
+  */
+   double _temperingRatio;
+  /**
   * @brief [Internal Use] Normal random number generator.
   */
    korali::distribution::univariate::Normal* _normalGenerator;
@@ -72,15 +88,15 @@ class MCMC : public Sampler
   */
    std::vector<double> _choleskyDecompositionChainCovariance;
   /**
-  * @brief [Internal Use] Variables of the newest sample in the Markov chain.
+  * @brief [Internal Use] Variables of the newest sample in each Markov chain.
   */
-   std::vector<double> _chainLeader;
+   std::vector<std::vector<double>> _chainLeaders;
   /**
-  * @brief [Internal Use] The logLikelihood of the newest sample in the Markov chain.
+  * @brief [Internal Use] The logLikelihood of the newest sample in each Markov chain.
   */
-   double _chainLeaderEvaluation;
+   std::vector<double> _chainLeadersEvaluations;
   /**
-  * @brief [Internal Use] Candidate variables to be accepted or rejected after comparison with the Chain Leader.
+  * @brief [Internal Use] Candidate variables to be accepted or rejected after comparison with the Chain Leaders, stored chain by chain (one per rejection level).
   */
    std::vector<std::vector<double>> _chainCandidate;
   /**
@@ -88,6 +104,14 @@ class MCMC : public Sampler
   */
    std::vector<double> _chainCandidatesEvaluations;
   /**
+  * @brief [Internal Use] Number of swaps proposed between neighbouring chains (Parallel Tempering).
+  */
+   size_t _swapProposalCount;
+  /**
+  * @brief [Internal Use] Number of swaps accepted between neighbouring chains (Parallel Tempering).
+  */
+   size_t _swapAcceptanceCount;
+  /**
   * @brief [Internal Use] Placeholder for recursive calculation of delayed rejection schemes.
   */
    std::vector<double> _rejectionAlphas;
@@ -170,15 +194,34 @@ class MCMC : public Sampler
   double recursiveAlpha(double &denominator, const double leaderLoglikelihood, const double *loglikelihoods, size_t N) const;
 
   /**
-   * @brief Updates internal state such as mean and covariance of chain.
+   * @brief Updates internal state such as the acceptance rate and the decomposition of the chain covariance.
    */
   void updateState();
 
+  /**
+   * @brief Updates the mean and covariance of the chain with a sample stored in the database. The samples of all chains are pooled.
+   * @param sample Sample just stored in the database
+   */
+  void updateChainStatistics(const std::vector<double> &sample);
+
   /**
    * @brief Generate new sample.
-   * @param sampleIdx Id of the sample to generate a candidate for
+   * @param chainIdx Id of the chain to generate a candidate for
+   * @param level Rejection level of the candidate
+   */
+  void generateCandidate(size_t chainIdx, size_t level);
+
+  /**
+   * @brief Returns the inverse temperature of a chain (1.0 for all chains, unless using parallel tempering).
+   * @param chainIdx Id of the chain
+   * @return The inverse temperature
+   */
+  double getChainInverseTemperature(size_t chainIdx) const;
+
+  /**
+   * @brief Proposes to swap the states of neighbouring chains. Method for parallel tempering.
    */
-  void generateCandidate(size_t sampleIdx);
+  void swapChains();
 
   /**
    * @brief Cholesky decomposition of chain covariance matrix.
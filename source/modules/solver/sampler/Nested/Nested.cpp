@@ -4,11 +4,8 @@
 #include "modules/solver/sampler/Nested/Nested.hpp"
 #include "sample/sample.hpp"
 
-#include <gsl/gsl_eigen.h>
-#include <gsl/gsl_linalg.h>
-#include <gsl/gsl_matrix.h>
-#include <gsl/gsl_randist.h>
-#include <gsl/gsl_vector.h>
+#include <Eigen/Dense>
+#include <gsl/gsl_sf_gamma.h>
 
 #include <algorithm> //sort
 #include <chrono>
@@ -17,6 +14,8 @@
 #include <numeric>
 #include <random> // std::default_random_engine
 
+using namespace Eigen;
+
 namespace korali
 {
 namespace solver
@@ -25,6 +24,11 @@ namespace sampler
 {
 ;
 
+/**
+ * @brief Row-major matrix, to map the flat (row-major) live sample storage
+ */
+typedef Matrix<double, Dynamic, Dynamic, RowMajor> RowMatrix;
+
 void ellipse_t::initSphere()
 {
   num = 0;
@@ -109,8 +113,7 @@ void Nested::setInitialConfiguration()
   _liveLogPriors.resize(_numberLivePoints);
   _liveLogPriorWeights.resize(_numberLivePoints);
   _liveSamplesRank.resize(_numberLivePoints);
-  _liveSamples.resize(_numberLivePoints);
-  for (size_t i = 0; i < _numberLivePoints; i++) _liveSamples[i].resize(_variableCount);
+  _liveSamples.resize(_numberLivePoints * _variableCount);
 
   _numberDeadSamples = 0;
   _deadLogLikelihoods.resize(0);
@@ -211,7 +214,7 @@ void Nested::runFirstGeneration()
 {
   for (size_t i = 0; i < _numberLivePoints; i++)
     for (size_t d = 0; d < _variableCount; d++)
-      _liveSamples[i][d] = _uniformGenerator->getRandomNumber();
+      _liveSamples[i * _variableCount + d] = _uniformGenerator->getRandomNumber();
 
   std::vector<double> sample;
   std::vector<Sample> samples(_numberLivePoints);
@@ -221,7 +224,7 @@ void Nested::runFirstGeneration()
   {
     samples[c]["Module"] = "Problem";
     samples[c]["Operation"] = "Evaluate";
-    sample = _liveSamples[c];
+    sample.assign(_liveSamples.begin() + c * _variableCount, _liveSamples.begin() + (c + 1) * _variableCount);
     priorTransform(sample);
     samples[c]["Parameters"] = sample;
     samples[c]["Sample Id"] = c;
@@ -337,7 +340,7 @@ bool Nested::processGeneration()
     }
 
     // Replace worst sample from live samples by candidate
-    _liveSamples[sampleIdx] = _candidates[c];
+    std::copy_n(_candidates[c].begin(), _variableCount, _liveSamples.begin() + sampleIdx * _variableCount);
     _liveLogPriors[sampleIdx] = _candidateLogPriors[c];
     _liveLogPriorWeights[sampleIdx] = _candidateLogPriorWeights[c];
     _liveLogLikelihoods[sampleIdx] = _candidateLogLikelihoods[c];
@@ -451,46 +454,65 @@ void Nested::generateCandidatesFromMultiEllipse()
   double totalVol = 0.;
   for (auto &ellipse : _ellipseVector) totalVol += ellipse.volume;
 
+  // Randomly select the ellipse of every candidate
+  std::vector<size_t> candidateEllipse(_batchSize);
   for (size_t i = 0; i < _batchSize; i++)
   {
-    // randomly select ellipse
     double cumVol = 0.;
     double rnd_ellipse = _uniformGenerator->getRandomNumber() * totalVol;
 
-    ellipse_t *ellipse_ptr = NULL;
-    for (auto &ellipse : _ellipseVector)
+    candidateEllipse[i] = _ellipseVector.size() - 1;
+    for (size_t e = 0; e < _ellipseVector.size(); ++e)
     {
-      cumVol += ellipse.volume;
+      cumVol += _ellipseVector[e].volume;
       if (rnd_ellipse < cumVol)
       {
-        ellipse_ptr = &ellipse;
+        candidateEllipse[i] = e;
         break;
       }
     }
+  }
 
-    // SM - Only add a check if you can create a unit test to trigger it
-    //    if (ellipse_ptr == NULL)
-    //      KORALI_LOG_ERROR("Failed to assign ellipse vector.");
+  std::vector<size_t> pending(_batchSize);
+  std::iota(pending.begin(), pending.end(), 0);
 
-    bool accept = false;
-    while (accept == false)
+  std::vector<double> proposals;
+  std::vector<double> distances;
+  std::vector<size_t> overlap;
+
+  // Sampling all pending candidates at once, until every candidate is accepted
+  while (pending.empty() == false)
+  {
+    const size_t proposalCount = pending.size();
+    proposals.resize(proposalCount * _variableCount);
+    for (size_t i = 0; i < proposalCount; i++)
     {
-      // sample from ellipse
-      generateSampleFromEllipse(*ellipse_ptr, _candidates[i]);
+      const size_t c = pending[i];
+      generateSampleFromEllipse(_ellipseVector[candidateEllipse[c]], _candidates[c]);
+      std::copy_n(_candidates[c].begin(), _variableCount, proposals.begin() + i * _variableCount);
+    }
 
-      // check for overlaps
-      size_t overlap = 0;
-      for (auto &ellipse : _ellipseVector)
-      {
-        double dist = mahalanobisDistance(_candidates[i], ellipse);
-        if (dist <= 1.) overlap++;
-      }
+    // Check for overlaps, with one batched distance evaluation per ellipse
+    overlap.assign(proposalCount, 0);
+    for (auto &ellipse : _ellipseVector)
+    {
+      mahalanobisDistances(ellipse, proposals, distances);
+      for (size_t i = 0; i < proposalCount; i++)
+        if (distances[i] <= 1.) overlap[i]++;
+    }
 
-      // accept / reject
+    // Accept / reject
+    size_t rejectedCount = 0;
+    for (size_t i = 0; i < proposalCount; i++)
+    {
+      const size_t c = pending[i];
+      bool accept = false;
       double rnd = _uniformGenerator->getRandomNumber();
-      if (rnd < 1. / ((double)overlap)) accept = true;
-      if (insideUnitCube(_candidates[i]) == false) accept = false;
+      if (rnd < 1. / ((double)overlap[i])) accept = true;
+      if (insideUnitCube(_candidates[c]) == false) accept = false;
+      if (accept == false) pending[rejectedCount++] = c;
     }
+    pending.resize(rejectedCount);
   }
 }
 
@@ -502,8 +524,8 @@ void Nested::updateBox()
   for (size_t i = 0; i < _numberLivePoints; i++)
     for (size_t d = 0; d < _variableCount; d++)
     {
-      _boxLowerBound[d] = std::min(_boxLowerBound[d], _liveSamples[i][d]);
-      _boxUpperBound[d] = std::max(_boxUpperBound[d], _liveSamples[i][d]);
+      _boxLowerBound[d] = std::min(_boxLowerBound[d], _liveSamples[i * _variableCount + d]);
+      _boxUpperBound[d] = std::max(_boxUpperBound[d], _liveSamples[i * _variableCount + d]);
     }
 }
 
@@ -524,7 +546,7 @@ void Nested::sortLiveSamplesAscending()
 void Nested::updateDeadSamples(size_t sampleIdx)
 {
   _numberDeadSamples++;
-  _deadSamples.push_back(_liveSamples[sampleIdx]);
+  _deadSamples.emplace_back(_liveSamples.begin() + sampleIdx * _variableCount, _liveSamples.begin() + (sampleIdx + 1) * _variableCount);
   priorTransform(_deadSamples.back());
 
   _deadLogPriors.push_back(_liveLogPriors[sampleIdx]);
@@ -617,15 +639,6 @@ void Nested::generatePosterior()
   (*_k)["Results"]["Posterior Sample LogLikelihood Database"] = posteriorSamplesLogLikelihoodDatabase;
 }
 
-double Nested::l2distance(const std::vector<double> &sampleOne, const std::vector<double> &sampleTwo) const
-{
-  double dist = 0.;
-  // Calculate L2 distance
-  for (size_t d = 0; d < _variableCount; ++d) dist += (sampleOne[d] - sampleTwo[d]) * (sampleOne[d] - sampleTwo[d]);
-  dist = std::sqrt(dist);
-  return dist;
-}
-
 bool Nested::updateEllipse(ellipse_t &ellipse) const
 {
   if (ellipse.num == 0) return false;
@@ -688,84 +701,70 @@ void Nested::initEllipseVector()
   std::iota(first->sampleIdx.begin(), first->sampleIdx.end(), 0);
 }
 
+void Nested::getEllipseSamples(const ellipse_t &ellipse, std::vector<double> &samples) const
+{
+  samples.resize(ellipse.num * _variableCount);
+
+  // Gather the live samples of the ellipse into a contiguous matrix
+#pragma omp parallel for
+  for (size_t i = 0; i < ellipse.num; ++i)
+    std::copy_n(_liveSamples.begin() + ellipse.sampleIdx[i] * _variableCount, _variableCount, samples.begin() + i * _variableCount);
+}
+
 void Nested::updateEllipseMean(ellipse_t &ellipse) const
 {
   std::fill(ellipse.mean.begin(), ellipse.mean.end(), 0.);
+  if (ellipse.num == 0) return;
 
-  for (size_t i = 0; i < ellipse.num; ++i)
-    for (size_t d = 0; d < _variableCount; ++d)
-    {
-      size_t sidx = ellipse.sampleIdx[i];
-      ellipse.mean[d] += _liveSamples[sidx][d];
-    }
+  std::vector<double> samples;
+  getEllipseSamples(ellipse, samples);
 
-  if (ellipse.num > 0)
-    for (size_t d = 0; d < _variableCount; ++d)
-      ellipse.mean[d] /= ((double)ellipse.num);
+  Map<const RowMatrix> X(samples.data(), ellipse.num, _variableCount);
+  Map<VectorXd>(ellipse.mean.data(), _variableCount) = X.colwise().mean().transpose();
 }
 
 bool Nested::updateEllipseCov(ellipse_t &ellipse) const
 {
   double weight = 1. / (ellipse.num - 1.);
 
+  Map<RowMatrix> cov(ellipse.cov.data(), _variableCount, _variableCount);
+  Map<const VectorXd> mean(ellipse.mean.data(), _variableCount);
+
+  std::vector<double> samples;
+  getEllipseSamples(ellipse, samples);
+  Map<const RowMatrix> X(samples.data(), ellipse.num, _variableCount);
+
   if (ellipse.num <= ellipse.dim)
   {
     // update variance
-    std::fill(ellipse.cov.begin(), ellipse.cov.end(), 0.);
-    std::fill(ellipse.invCov.begin(), ellipse.invCov.end(), 0.);
-    for (size_t d = 0; d < _variableCount; ++d)
-    {
-      double c = 0.;
-      for (size_t k = 0; k < ellipse.num; ++k)
-      {
-        size_t sidx = ellipse.sampleIdx[k];
-        c += (_liveSamples[sidx][d] - ellipse.mean[d]) * (_liveSamples[sidx][d] - ellipse.mean[d]);
-        ellipse.cov[d * _variableCount + d] = (ellipse.num == 1) ? 1. : weight * c;
-        ellipse.invCov[d * _variableCount + d] = (ellipse.num == 1) ? 1. : 1. / (weight * c);
-      }
-    }
+    cov.setZero();
+    if (ellipse.num == 1)
+      cov.setIdentity();
+    else if (ellipse.num > 1)
+      cov.diagonal() = weight * (X.rowwise() - mean.transpose()).colwise().squaredNorm().transpose();
+
+    // Samples sharing a coordinate have no variance along it, so the variances are floored to keep the cholesky factor below defined
+    cov.diagonal() = cov.diagonal().cwiseMax(1e-12);
   }
   else
   {
-    // update covariance
-    for (size_t i = 0; i < _variableCount; ++i)
-    {
-      for (size_t j = i; j < _variableCount; ++j)
-      {
-        double c = 0.;
-        for (size_t k = 0; k < ellipse.num; ++k)
-        {
-          size_t sidx = ellipse.sampleIdx[k];
-          c += (_liveSamples[sidx][i] - ellipse.mean[i]) * (_liveSamples[sidx][j] - ellipse.mean[j]);
-        }
-        ellipse.cov[j * _variableCount + i] = ellipse.cov[i * _variableCount + j] = weight * c;
-      }
-    }
-
-    // update inverse covariance
-    gsl_matrix_view cov = gsl_matrix_view_array(ellipse.cov.data(), _variableCount, _variableCount);
-
-    gsl_matrix *matLU = gsl_matrix_alloc(_variableCount, _variableCount);
-    gsl_matrix_memcpy(matLU, &cov.matrix);
-
-    int signal;
-    gsl_permutation *perm = gsl_permutation_alloc(_variableCount);
-    gsl_linalg_LU_decomp(matLU, perm, &signal);
-
-    std::fill(ellipse.invCov.begin(), ellipse.invCov.end(), 0.);
-    gsl_matrix_view invCov = gsl_matrix_view_array(ellipse.invCov.data(), _variableCount, _variableCount);
-
-    gsl_linalg_LU_invert(matLU, perm, &invCov.matrix);
-    gsl_permutation_free(perm);
-    gsl_matrix_free(matLU);
+    // update covariance (a single matrix product, multi-threaded by Eigen with OpenMP)
+    const RowMatrix centered = X.rowwise() - mean.transpose();
+    cov.noalias() = weight * centered.transpose() * centered;
+  }
 
-    // SM - Only add a check if you can create a unit test to trigger it
-    //    if (status != 0)
-    //    {
-    //      _k->_logger->logWarning("Normal", "Covariance inversion failed during ellipsoid covariance update.\n");
-    //      return false;
-    //    }
+  // Cache the cholesky factor (LL^T = cov), used for sampling and for the Mahalanobis distances
+  Map<RowMatrix> axes(ellipse.axes.data(), _variableCount, _variableCount);
+  LLT<RowMatrix> llt(cov);
+  if (llt.info() != Success)
+  {
+    _k->_logger->logWarning("Normal", "Cholesky Decomposition failed during ellipsoid covariance update.\n");
+    return false;
   }
+  axes = llt.matrixL();
+
+  // update inverse covariance
+  Map<RowMatrix>(ellipse.invCov.data(), _variableCount, _variableCount) = llt.solve(RowMatrix::Identity(_variableCount, _variableCount));
 
   return true;
 }
@@ -774,95 +773,33 @@ bool Nested::updateEllipseVolume(ellipse_t &ellipse) const
 {
   if (ellipse.num == 0) return false;
 
-  gsl_matrix_view cov = gsl_matrix_view_array(ellipse.cov.data(), _variableCount, _variableCount);
-
-  gsl_matrix *matLU = gsl_matrix_alloc(_variableCount, _variableCount);
-  gsl_matrix_memcpy(matLU, &cov.matrix);
-
-  // SM - Only add a check if you can create a unit test to trigger it
-  //  if (status != 0)
-  //  {
-  //    _k->_logger->logWarning("Normal", "Memcpy failed during Ellipsoid volume update.\n");
-  //    gsl_matrix_free(matLU);
-  //    return false;
-  //  }
-
-  int signal;
-  gsl_permutation *perm = gsl_permutation_alloc(_variableCount);
-  gsl_linalg_LU_decomp(matLU, perm, &signal);
-  gsl_permutation_free(perm);
+  Map<RowMatrix> cov(ellipse.cov.data(), _variableCount, _variableCount);
+  Map<RowMatrix> invCov(ellipse.invCov.data(), _variableCount, _variableCount);
+  Map<RowMatrix> axes(ellipse.axes.data(), _variableCount, _variableCount);
+  Map<VectorXd> evals(ellipse.evals.data(), _variableCount);
+  Map<RowMatrix> paxes(ellipse.paxes.data(), _variableCount, _variableCount);
 
-  ellipse.det = gsl_linalg_LU_det(matLU, signal);
-  gsl_matrix_free(matLU);
+  // The determinant follows from the cached cholesky factor
+  ellipse.det = axes.diagonal().prod();
+  ellipse.det *= ellipse.det;
 
-  gsl_vector_view evals = gsl_vector_view_array(ellipse.evals.data(), _variableCount);
-  gsl_matrix_view paxes = gsl_matrix_view_array(ellipse.paxes.data(), _variableCount, _variableCount);
-
-  gsl_matrix *matEigen = gsl_matrix_alloc(_variableCount, _variableCount);
-  gsl_matrix_memcpy(matEigen, &cov.matrix);
-
-  // SM - Only add a check if you can create a unit test to trigger it
-  //  if (status != 0)
-  //  {
-  //    _k->_logger->logWarning("Normal", "Memcpy failed during Ellipsoid volume update.\n");
-  //    gsl_matrix_free(matEigen);
-  //    return false;
-  //  }
-
-  gsl_eigen_symmv_workspace *workEigen = gsl_eigen_symmv_alloc(_variableCount);
-  gsl_eigen_symmv(matEigen, &evals.vector, &paxes.matrix, workEigen);
-  gsl_matrix_free(matEigen);
-  gsl_eigen_symmv_free(workEigen);
-
-  // SM - Only add a check if you can create a unit test to trigger it
-  //  if (status != 0)
-  //  {
-  //    _k->_logger->logWarning("Normal", "Eigenvalue Decomposition failed during Ellipsoid volume update.\n");
-  //    return false;
-  //  }
-
-  gsl_eigen_symmv_sort(&evals.vector, &paxes.matrix, GSL_EIGEN_SORT_ABS_DESC);
-
-  // SM - Only add a check if you can create a unit test to trigger it
-  //  if (status != 0)
-  //  {
-  //    _k->_logger->logWarning("Normal", "Eigenvalue sorting failed during Ellipsoid volume update.\n");
-  //    return false;
-  //  }
-
-  // Calculate axes from cholesky decomposition
-  gsl_matrix_view axes = gsl_matrix_view_array(ellipse.axes.data(), _variableCount, _variableCount);
-
-  /* On output the diagonal and lower triangular part of the
-   * input matrix A contain the matrix L, while the upper triangular part
-   * contains the original matrix. */
-
-  gsl_matrix_memcpy(&axes.matrix, &cov.matrix);
-
-  // SM - Only add a check if you can create a unit test to trigger it
-  //  if (status != 0)
-  //  {
-  //    _k->_logger->logWarning("Normal", "Memcpy failed during Ellipsoid volume update.\n");
-  //    return false;
-  //  }
-
-  gsl_linalg_cholesky_decomp1(&axes.matrix); // LL^T = A
+  SelfAdjointEigenSolver<RowMatrix> eigenSolver(cov);
+  if (eigenSolver.info() != Success)
+  {
+    _k->_logger->logWarning("Normal", "Eigenvalue Decomposition failed during ellipsoid volume update.\n");
+    return false;
+  }
 
-  // SM - Only add a check if you can create a unit test to trigger it
-  //  if (status != 0)
-  //  {
-  //    _k->_logger->logWarning("Normal", "Cholesky Decomposition failed during Ellipsoid volume update.\n");
-  //    return false;
-  //  }
+  // Sort eigenvalues (and principal axes) descending
+  evals = eigenSolver.eigenvalues().reverse();
+  paxes = eigenSolver.eigenvectors().rowwise().reverse();
 
   // Find scaling s.t. all samples are bounded by ellipse
-  double res, max = Lowest;
-  for (size_t i = 0; i < ellipse.num; ++i)
-  {
-    size_t six = ellipse.sampleIdx[i];
-    res = mahalanobisDistance(_liveSamples[six], ellipse);
-    if (res > max) max = res;
-  }
+  std::vector<double> samples;
+  std::vector<double> distances;
+  getEllipseSamples(ellipse, samples);
+  mahalanobisDistances(ellipse, samples, distances);
+  double max = *std::max_element(distances.begin(), distances.end());
 
   ellipse.pointVolume = std::exp(_logVolume) * (double)ellipse.num / ((double)_numberLivePoints);
 
@@ -872,34 +809,39 @@ bool Nested::updateEllipseVolume(ellipse_t &ellipse) const
   double enlargementFactor = vol > ellipse.pointVolume ? _ellipsoidalScaling * max : std::pow((ellipse.pointVolume * ellipse.pointVolume) / (K * K * ellipse.det), 1. / ((double)_variableCount));
   ellipse.volume = std::pow(enlargementFactor, _variableCount / 2.) * sqrt(ellipse.det) * K;
 
-  gsl_matrix_view invCov = gsl_matrix_view_array(ellipse.invCov.data(), _variableCount, _variableCount);
-
   // resize volume
-  gsl_matrix_scale(&cov.matrix, enlargementFactor);
-  gsl_matrix_scale(&invCov.matrix, 1. / enlargementFactor);
-  gsl_vector_scale(&evals.vector, enlargementFactor);
-  gsl_matrix_scale(&axes.matrix, sqrt(enlargementFactor));
+  cov *= enlargementFactor;
+  invCov *= 1. / enlargementFactor;
+  evals *= enlargementFactor;
+  axes *= sqrt(enlargementFactor);
 
   return true; // all good
 }
 
 double Nested::mahalanobisDistance(const std::vector<double> &sample, const ellipse_t &ellipse) const
 {
-  std::vector<double> dif(_variableCount);
-  for (size_t d = 0; d < _variableCount; ++d) dif[d] = sample[d] - ellipse.mean[d];
+  Map<const RowMatrix> axes(ellipse.axes.data(), _variableCount, _variableCount);
+  Map<const VectorXd> x(sample.data(), _variableCount);
+  Map<const VectorXd> mean(ellipse.mean.data(), _variableCount);
 
-  double tmp;
-  double dist = 0.;
-  // Calculate Mahalanobis distance between sample and ellipsoid
-  for (size_t i = 0; i < _variableCount; ++i)
-  {
-    tmp = 0.;
-    for (size_t j = 0; j < _variableCount; ++j)
-      tmp += dif[j] * ellipse.invCov[i + _variableCount * j];
-    tmp *= dif[i];
-    dist += tmp;
-  }
-  return dist;
+  // Calculate Mahalanobis distance between sample and ellipsoid, with the cholesky factor (|L^-1 (x - mean)|^2)
+  const VectorXd z = axes.triangularView<Lower>().solve(x - mean);
+  return z.squaredNorm();
+}
+
+void Nested::mahalanobisDistances(const ellipse_t &ellipse, const std::vector<double> &samples, std::vector<double> &distances) const
+{
+  const size_t sampleCount = samples.size() / _variableCount;
+  distances.resize(sampleCount);
+
+  Map<const RowMatrix> axes(ellipse.axes.data(), _variableCount, _variableCount);
+  Map<const RowMatrix> X(samples.data(), sampleCount, _variableCount);
+  Map<const VectorXd> mean(ellipse.mean.data(), _variableCount);
+
+  // One triangular solve for all samples: Z = L^-1 (X - mean)^T
+  Matrix<double, Dynamic, Dynamic, ColMajor> Z = (X.rowwise() - mean.transpose()).transpose();
+  axes.triangularView<Lower>().solveInPlace(Z);
+  Map<VectorXd>(distances.data(), sampleCount) = Z.colwise().squaredNorm().transpose();
 }
 
 bool Nested::kmeansClustering(const ellipse_t &parent, size_t maxIter, ellipse_t &childOne, ellipse_t &childTwo) const
@@ -915,73 +857,84 @@ bool Nested::kmeansClustering(const ellipse_t &parent, size_t maxIter, ellipse_t
     childTwo.mean[d] = parent.mean[d] - parent.paxes[d * _variableCount + ax] * parent.evals[ax];
   }
 
-  size_t nOne, nTwo, idxOne, idxTwo;
+  std::vector<double> samples;
+  getEllipseSamples(parent, samples);
+  Map<const RowMatrix> X(samples.data(), parent.num, _variableCount);
+  Map<VectorXd> meanOne(childOne.mean.data(), _variableCount);
+  Map<VectorXd> meanTwo(childTwo.mean.data(), _variableCount);
+
+  const VectorXd sampleSum = X.colwise().sum().transpose();
+  VectorXd projections(parent.num);
+  VectorXd isTwo(parent.num);
+
+  size_t nOne = 0;
+  size_t nTwo = 0;
   std::vector<int8_t> clusterFlag(parent.num, 0);
 
-  bool ok = true;
   size_t iter = 0;
   size_t diffs = 1;
 
   // Iterate until no sample updates cluster assignment
   while ((diffs > 0) && (iter++ < maxIter))
   {
+    // A sample is closer to mean one iff its projection on (mean two - mean one) is below the projection of their midpoint
+    const VectorXd direction = meanTwo - meanOne;
+    const double threshold = 0.5 * (meanTwo.squaredNorm() - meanOne.squaredNorm());
+    projections.noalias() = X * direction;
+
     diffs = 0;
-    nOne = 0;
     nTwo = 0;
 
     // assign samples to means
+#pragma omp parallel for reduction(+ \
+                                   : diffs, nTwo)
     for (size_t i = 0; i < parent.num; ++i)
     {
-      size_t six = parent.sampleIdx[i];
-
-      // measure distances to cluster means
-      double d1 = l2distance(_liveSamples[six], childOne.mean);
-      double d2 = l2distance(_liveSamples[six], childTwo.mean);
-
-      int8_t flag = (d1 < d2) ? 1 : 2;
+      int8_t flag = (projections[i] < threshold) ? 1 : 2;
 
       // count updates
       if (clusterFlag[i] != flag) diffs++;
       // assign cluster
       clusterFlag[i] = flag;
 
-      if (flag == 1)
-        nOne++;
-      else
-        nTwo++;
+      isTwo[i] = (flag == 2) ? 1. : 0.;
+      nTwo += flag - 1;
     }
+    nOne = parent.num - nTwo;
 
-    childOne.num = nOne;
-    childOne.sampleIdx.resize(nOne);
-
-    childTwo.num = nTwo;
-    childTwo.sampleIdx.resize(nTwo);
+    // update means of ellipsoids
+    const VectorXd sumTwo = X.transpose() * isTwo;
+    if (nOne > 0)
+      meanOne = (sampleSum - sumTwo) / ((double)nOne);
+    else
+      meanOne.setZero();
+    if (nTwo > 0)
+      meanTwo = sumTwo / ((double)nTwo);
+    else
+      meanTwo.setZero();
+  }
 
-    idxOne = 0;
-    idxTwo = 0;
+  // SM - Only add a check if you can create a unit test to trigger it
+  //  if (iter >= maxIter) _k->_logger->logWarning("Normal", "K-Means Clustering did not terminate in %zu steps.\n", maxIter);
 
-    for (size_t i = 0; i < parent.num; ++i)
-    {
-      if (clusterFlag[i] == 1)
-        childOne.sampleIdx[idxOne++] = parent.sampleIdx[i];
-      else /* clusterFlag[i] == 2 */
-        childTwo.sampleIdx[idxTwo++] = parent.sampleIdx[i];
-    }
+  childOne.num = nOne;
+  childOne.sampleIdx.resize(nOne);
 
-    // update means of ellipsoids
-    updateEllipseMean(childOne);
-    updateEllipseMean(childTwo);
+  childTwo.num = nTwo;
+  childTwo.sampleIdx.resize(nTwo);
 
-    ok = ok & updateEllipseCov(childOne);
-    ok = ok & updateEllipseCov(childTwo);
+  size_t idxOne = 0;
+  size_t idxTwo = 0;
 
-    if (ok == false) break;
+  for (size_t i = 0; i < parent.num; ++i)
+  {
+    if (clusterFlag[i] == 1)
+      childOne.sampleIdx[idxOne++] = parent.sampleIdx[i];
+    else /* clusterFlag[i] == 2 */
+      childTwo.sampleIdx[idxTwo++] = parent.sampleIdx[i];
   }
 
-  // SM - Only add a check if you can create a unit test to trigger it
-  //  if (iter >= maxIter) _k->_logger->logWarning("Normal", "K-Means Clustering did not terminate in %zu steps.\n", maxIter);
-
-  return ok;
+  return (nOne > 0) && (nTwo > 0);
 }
 
 void Nested::updateEffectiveSamples()
@@ -1266,7 +1219,7 @@ void Nested::setConfiguration(knlohmann::json& js)
 
  if (isDefined(js, "Live Samples"))
  {
- try { _liveSamples = js["Live Samples"].get<std::vector<std::vector<double>>>();
+ try { _liveSamples = js["Live Samples"].get<std::vector<double>>();
 } catch (const std::exception& e)
  { KORALI_LOG_ERROR(" + Object: [ Nested ] \n + Key:    ['Live Samples']\n%s", e.what()); } 
    eraseValue(js, "Live Samples");
@@ -89,7 +89,7 @@ struct ellipse_t
   std::vector<double> invCov;
 
   /**
-   * @brief Axes of the ellipse.
+   * @brief Axes of the ellipse (lower cholesky factor of the covariance).
    */
   std::vector<double> axes;
 
@@ -214,13 +214,6 @@ class Nested : public Sampler
    */
   void generatePosterior();
 
-  /*
-   * @brief Calculate L2 distance between two vectors.
-   * @param sampleOne Vector one
-   * @param sampleTwo Vector two
-   */
-  double l2distance(const std::vector<double> &sampleOne, const std::vector<double> &sampleTwo) const;
-
   /*
    * @brief Updates bounding Ellipse (mean, cov and volume).
    * @param ellipse Ellipse to be updated.
@@ -237,39 +230,6 @@ class Nested : public Sampler
    */
   void initEllipseVector();
 
-  /*
-   * @brief Applies k-means clustering (k=2) and fills cluster vectors with samples.
-   * @param parent Parent ellipse to be split.
-   * @param childOne Cluster one
-   * @param childTwo Cluster two
-   */
-  bool kmeansClustering(const ellipse_t &parent, size_t maxIter, ellipse_t &childOne, ellipse_t &childTwo) const;
-
-  /*
-   * @brief Udates the mean vector of ellipse argument.
-   * @param ellipse Ellipse to be updated.
-   */
-  void updateEllipseMean(ellipse_t &ellipse) const;
-
-  /*
-   * @brief Udates the covariance matrix of input ellipse.
-   * @param ellipse Ellipse to be updated.
-   */
-  bool updateEllipseCov(ellipse_t &ellipse) const;
-
-  /*
-   * @brief Updates volume and the axes of the ellipse.
-   * @param ellipse Ellipse to be updated.
-   */
-  bool updateEllipseVolume(ellipse_t &ellipse) const;
-
-  /*
-   * @brief Calculates Mahalanobis metric of sample and ellipse.
-   * @param sample Sample.
-   * @param ellipse Ellipse.
-   */
-  double mahalanobisDistance(const std::vector<double> &sample, const ellipse_t &ellipse) const;
-
   /*
    * @brief Calculate effective number of samples.
    * @return the number of effective samples
@@ -420,9 +380,9 @@ class Nested : public Sampler
   */
    std::vector<double> _candidateLogPriorWeights;
   /**
-  * @brief [Internal Use] Samples to be processed and replaced in ascending order.
+  * @brief [Internal Use] Samples to be processed and replaced in ascending order, stored row-major (one row per sample).
   */
-   std::vector<std::vector<double>> _liveSamples;
+   std::vector<double> _liveSamples;
   /**
   * @brief [Internal Use] Loglikelihood evaluations of live samples.
   */
@@ -527,6 +487,54 @@ class Nested : public Sampler
   void applyVariableDefaults() override;
   
 
+  /*
+   * @brief Applies k-means clustering (k=2) and fills cluster vectors with samples.
+   * @param parent Parent ellipse to be split.
+   * @param childOne Cluster one
+   * @param childTwo Cluster two
+   */
+  bool kmeansClustering(const ellipse_t &parent, size_t maxIter, ellipse_t &childOne, ellipse_t &childTwo) const;
+
+  /*
+   * @brief Gathers the live samples of an ellipse into a contiguous (row-major) matrix.
+   * @param ellipse Ellipse whose samples are gathered.
+   * @param samples Matrix of samples, one row per sample.
+   */
+  void getEllipseSamples(const ellipse_t &ellipse, std::vector<double> &samples) const;
+
+  /*
+   * @brief Udates the mean vector of ellipse argument.
+   * @param ellipse Ellipse to be updated.
+   */
+  void updateEllipseMean(ellipse_t &ellipse) const;
+
+  /*
+   * @brief Udates the covariance matrix of input ellipse and its cholesky factor (axes).
+   * @param ellipse Ellipse to be updated.
+   */
+  bool updateEllipseCov(ellipse_t &ellipse) const;
+
+  /*
+   * @brief Updates volume and the axes of the ellipse.
+   * @param ellipse Ellipse to be updated.
+   */
+  bool updateEllipseVolume(ellipse_t &ellipse) const;
+
+  /*
+   * @brief Calculates Mahalanobis metric of sample and ellipse (based on the cholesky factor of the ellipse).
+   * @param sample Sample.
+   * @param ellipse Ellipse.
+   */
+  double mahalanobisDistance(const std::vector<double> &sample, const ellipse_t &ellipse) const;
+
+  /*
+   * @brief Calculates Mahalanobis metric of many samples and an ellipse, with a single triangular solve.
+   * @param ellipse Ellipse.
+   * @param samples Matrix of samples, one row per sample.
+   * @param distances Mahalanobis metric of every sample.
+   */
+  void mahalanobisDistances(const ellipse_t &ellipse, const std::vector<double> &samples, std::vector<double> &distances) const;
+
   /**
    * @brief Configures Sampler.
    */
@@ -1,21 +1,23 @@
 #include "engine.hpp"
+#include "modules/conduit/conduit.hpp"
 #include "modules/experiment/experiment.hpp"
 #include "modules/solver/sampler/TMCMC/TMCMC.hpp"
 #include "sample/sample.hpp"
+#include <algorithm>
 #include <chrono>
 #include <limits>
+#include <map>
 #include <numeric>
 
+#include <Eigen/Dense>
 #include <gsl/gsl_cdf.h>
-#include <gsl/gsl_eigen.h>
-#include <gsl/gsl_linalg.h>
-#include <gsl/gsl_matrix.h>
 #include <gsl/gsl_multimin.h>
-#include <gsl/gsl_randist.h>
 #include <gsl/gsl_sort_vector.h>
 #include <gsl/gsl_statistics.h>
 #include <math.h>
 
+using namespace Eigen;
+
 namespace korali
 {
 namespace solver
@@ -24,6 +26,11 @@ namespace sampler
 {
 ;
 
+/**
+ * @brief Row-major matrix, to map the flat (row-major) chain and sample storage
+ */
+typedef Matrix<double, Dynamic, Dynamic, RowMajor> RowMatrix;
+
 void TMCMC::setInitialConfiguration()
 {
   knlohmann::json problemConfig = (*_k)["Problem"];
@@ -35,16 +42,14 @@ void TMCMC::setInitialConfiguration()
   // Allocating TMCMC memory
   _chainLeadersLogPriors.resize(_populationSize);
   _chainLeadersLogLikelihoods.resize(_populationSize);
-  _chainLeaders.resize(_populationSize);
-  for (size_t i = 0; i < _populationSize; i++) _chainLeaders[i].resize(_variableCount);
+  _chainLeaders.resize(_populationSize * _variableCount);
 
   _meanTheta.resize(_variableCount);
   _covarianceMatrix.resize(_variableCount * _variableCount);
 
   _chainCandidatesLogPriors.resize(_populationSize);
   _chainCandidatesLogLikelihoods.resize(_populationSize);
-  _chainCandidates.resize(_populationSize);
-  for (size_t i = 0; i < _populationSize; i++) _chainCandidates[i].resize(_variableCount);
+  _chainCandidates.resize(_populationSize * _variableCount);
 
   _chainLengths.resize(_populationSize);
   _currentChainStep.resize(_populationSize);
@@ -63,18 +68,12 @@ void TMCMC::setInitialConfiguration()
     _chainCandidatesErrors.resize(_populationSize, -1);
     _chainLeadersErrors.resize(_populationSize, -1);
     _sampleErrorDatabase.resize(_populationSize, -1);
-    _chainCandidatesGradients.resize(_populationSize);
-    for (size_t i = 0; i < _populationSize; i++) _chainCandidatesGradients[i].resize(_variableCount);
-    _chainLeadersGradients.resize(_populationSize);
-    for (size_t i = 0; i < _populationSize; i++) _chainLeadersGradients[i].resize(_variableCount);
-    _sampleGradientDatabase.resize(_populationSize);
-    for (size_t i = 0; i < _populationSize; i++) _sampleGradientDatabase[i].resize(_variableCount);
-    _chainCandidatesCovariance.resize(_populationSize);
-    for (size_t i = 0; i < _populationSize; i++) _chainCandidatesCovariance[i].resize(_variableCount * _variableCount);
-    _chainLeadersCovariance.resize(_populationSize);
-    for (size_t i = 0; i < _populationSize; i++) _chainLeadersCovariance[i].resize(_variableCount * _variableCount);
-    _sampleCovarianceDatabase.resize(_populationSize);
-    for (size_t i = 0; i < _populationSize; i++) _sampleCovarianceDatabase[i].resize(_variableCount);
+    _chainCandidatesGradients.resize(_populationSize * _variableCount);
+    _chainLeadersGradients.resize(_populationSize * _variableCount);
+    _sampleGradientDatabase.resize(_populationSize * _variableCount);
+    _chainCandidatesCovariance.resize(_populationSize * _variableCount * _variableCount);
+    _chainLeadersCovariance.resize(_populationSize * _variableCount * _variableCount);
+    _sampleCovarianceDatabase.resize(_populationSize * _variableCount * _variableCount);
 
     _upperExtendedBoundaries.resize(_variableCount);
     _lowerExtendedBoundaries.resize(_variableCount);
@@ -127,7 +126,7 @@ void TMCMC::runGeneration()
           _chainPendingEvaluation[c] = true;
           samples[c]["Module"] = "Problem";
           samples[c]["Operation"] = "Evaluate";
-          samples[c]["Parameters"] = _chainCandidates[c];
+          samples[c]["Parameters"] = std::vector<double>(_chainCandidates.begin() + c * _variableCount, _chainCandidates.begin() + (c + 1) * _variableCount);
           samples[c]["Sample Id"] = c;
           _currentChainStep[c]++;
           _modelEvaluationCount++;
@@ -194,41 +193,33 @@ void TMCMC::prepareGeneration()
       std::fill(_chainCandidatesErrors.begin(), _chainCandidatesErrors.end(), -1);
 
     // annealing
-    for (size_t i = 0; i < _populationSize; ++i)
-    {
-      gsl_matrix_view covLeader = gsl_matrix_view_array(&_chainLeadersCovariance[i][0], _variableCount, _variableCount);
-      gsl_matrix_scale(&covLeader.matrix, _previousAnnealingExponent / _annealingExponent);
-
-      gsl_vector_view gradLeader = gsl_vector_view_array(&_chainLeadersGradients[i][0], _variableCount);
-      gsl_vector_scale(&gradLeader.vector, _annealingExponent / _previousAnnealingExponent);
-    }
+    Map<VectorXd>(_chainLeadersCovariance.data(), _chainLeadersCovariance.size()) *= _previousAnnealingExponent / _annealingExponent;
+    Map<VectorXd>(_chainLeadersGradients.data(), _chainLeadersGradients.size()) *= _annealingExponent / _previousAnnealingExponent;
   }
 
   std::fill(_currentChainStep.begin(), _currentChainStep.end(), 0);
   std::fill(_chainPendingEvaluation.begin(), _chainPendingEvaluation.end(), false);
 
-  std::vector<double> zeroMean(_variableCount, 0.0);
-  _multivariateGenerator->_meanVector = zeroMean;
-  _multivariateGenerator->_sigma = _covarianceMatrix;
-
-  /* Cholesky Decomp */
-  gsl_matrix_view sigma = gsl_matrix_view_array(&_multivariateGenerator->_sigma[0], _variableCount, _variableCount);
-  gsl_linalg_cholesky_decomp(&sigma.matrix);
-
-  _multivariateGenerator->updateDistribution();
-
-  for (size_t i = 0; i < _populationSize; i++)
+  if (_k->_currentGeneration == 1)
   {
-    if (_k->_currentGeneration == 1)
-    {
+    for (size_t i = 0; i < _populationSize; i++)
       for (size_t d = 0; d < _variableCount; d++)
-        _chainCandidates[i][d] = _k->_distributions[_k->_variables[d]->_distributionIndex]->getRandomNumber();
-    }
-    else
-    {
-      generateCandidate(i);
-    }
+        _chainCandidates[i * _variableCount + d] = _k->_distributions[_k->_variables[d]->_distributionIndex]->getRandomNumber();
+    return;
   }
+
+  /* Cholesky Decomp, once for all chains. The factor is not part of the state, so it is computed here also when resuming. */
+  Map<const RowMatrix> covariance(_covarianceMatrix.data(), _variableCount, _variableCount);
+  const LLT<MatrixXd> covarianceCholesky(covariance);
+  if (covarianceCholesky.info() != Success) KORALI_LOG_ERROR("The covariance of the chain leaders is not positive definite (generation %zu). Try increasing the Population Size or the Covariance Scaling.\n", _k->_currentGeneration);
+
+  _covarianceCholeskyFactor.resize(_variableCount * _variableCount);
+  Map<RowMatrix>(_covarianceCholeskyFactor.data(), _variableCount, _variableCount) = covarianceCholesky.matrixL();
+
+  if (_version == "TMCMC")
+    generateCandidates();
+  else
+    for (size_t i = 0; i < _populationSize; i++) generateCandidate(i);
 }
 
 void TMCMC::processCandidate(const size_t sampleId)
@@ -238,14 +229,15 @@ void TMCMC::processCandidate(const size_t sampleId)
 
   if (P > U || _k->_currentGeneration == 1)
   {
-    _chainLeaders[sampleId] = _chainCandidates[sampleId];
+    const size_t D = _variableCount;
+    std::copy_n(&_chainCandidates[sampleId * D], D, &_chainLeaders[sampleId * D]);
     _chainLeadersLogPriors[sampleId] = _chainCandidatesLogPriors[sampleId];
     _chainLeadersLogLikelihoods[sampleId] = _chainCandidatesLogLikelihoods[sampleId];
     if (_version == "mTMCMC")
     {
       _chainLeadersErrors[sampleId] = _chainCandidatesErrors[sampleId];
-      _chainLeadersGradients[sampleId] = _chainCandidatesGradients[sampleId];
-      _chainLeadersCovariance[sampleId] = _chainCandidatesCovariance[sampleId];
+      std::copy_n(&_chainCandidatesGradients[sampleId * D], D, &_chainLeadersGradients[sampleId * D]);
+      std::copy_n(&_chainCandidatesCovariance[sampleId * D * D], D * D, &_chainLeadersCovariance[sampleId * D * D]);
     }
 
     if (_currentChainStep[sampleId] > _currentBurnIn) _acceptedSamplesCount++;
@@ -310,58 +302,53 @@ void TMCMC::processGeneration()
   for (size_t i = 0; i < _populationSize; i++) sum_weight2 += weight[i] * weight[i];
 
   /* Update mean and covariance */
-  for (size_t i = 0; i < _variableCount; i++)
-  {
-    _meanTheta[i] = 0;
-    for (size_t j = 0; j < _populationSize; j++) _meanTheta[i] += _sampleDatabase[j][i] * weight[j];
-  }
+  const size_t D = _variableCount;
+  Map<const RowMatrix> samples(_sampleDatabase.data(), _populationSize, D);
+  Map<const VectorXd> weights(weight.data(), _populationSize);
+  Map<VectorXd> mean(_meanTheta.data(), D);
+  mean.noalias() = samples.transpose() * weights;
 
-  for (size_t i = 0; i < _variableCount; i++)
-  {
-    for (size_t j = i; j < _variableCount; ++j)
-    {
-      double s = 0.0;
-      for (size_t k = 0; k < _populationSize; ++k)
-        s += weight[k] * (_sampleDatabase[k][i] - _meanTheta[i]) * (_sampleDatabase[k][j] - _meanTheta[j]);
-      _covarianceMatrix[i * _variableCount + j] = _covarianceMatrix[j * _variableCount + i] = _covarianceScaling * s / (1.0 - sum_weight2);
-    }
-  }
+  // The weighted reduction over all samples is a single (blocked, and OpenMP parallel) product of the centered samples, scaled by the square root of their weights
+  const RowMatrix weightedSamples = (samples.rowwise() - mean.transpose()).array().colwise() * weights.array().sqrt();
+  Map<RowMatrix> covarianceMatrix(_covarianceMatrix.data(), D, D);
+  covarianceMatrix.noalias() = (_covarianceScaling / (1.0 - sum_weight2)) * weightedSamples.transpose() * weightedSamples;
 
   /* Resampling - Init new chains */
   std::fill(std::begin(_chainLengths), std::end(_chainLengths), 0);
 
-  size_t leaderChainLen;
+  size_t maxLength = _maxChainLength;
+  if (_balanceChainLengths) maxLength = getBalancedChainLength(numselections, getGenerationBurnIn(_k->_currentGeneration + 1));
+
+  // Splitting the chains longer than the maximum length into sub-chains of (almost) equal length
+  std::vector<std::pair<size_t, size_t>> chains; // (Leader sample, chain length)
   size_t zeroCount = 0;
-  size_t leaderId = 0;
   for (size_t i = 0; i < _populationSize; i++)
   {
     if (numselections[i] == 0) zeroCount++;
-    while (numselections[i] > 0)
-    {
-      _chainLeaders[leaderId] = _sampleDatabase[i];
-      _chainLeadersLogPriors[leaderId] = _sampleLogPriorDatabase[i];
-      _chainLeadersLogLikelihoods[leaderId] = _sampleLogLikelihoodDatabase[i];
-      if (_version == "mTMCMC")
-      {
-        _chainLeadersErrors[leaderId] = _sampleErrorDatabase[i];
-        _chainLeadersGradients[leaderId] = _sampleGradientDatabase[i];
-        _chainLeadersCovariance[leaderId] = _sampleCovarianceDatabase[i];
-      }
 
-      if (numselections[i] > _maxChainLength)
-      {
-        /* uniform splitting of chains */
-        size_t rest = (numselections[i] % _maxChainLength != 0);
-        leaderChainLen = _maxChainLength - rest;
-      }
-      else
-      {
-        leaderChainLen = numselections[i];
-      }
-      _chainLengths[leaderId] = leaderChainLen;
-      numselections[i] -= leaderChainLen;
-      leaderId++;
+    const size_t subChainCount = (numselections[i] + maxLength - 1) / maxLength;
+    for (size_t j = 0; j < subChainCount; j++)
+      chains.push_back(std::make_pair(i, numselections[i] / subChainCount + (j < numselections[i] % subChainCount)));
+  }
+
+  // The longest chains are dispatched first, so that they do not define the tail of the generation
+  std::stable_sort(chains.begin(), chains.end(), [](const std::pair<size_t, size_t> &a, const std::pair<size_t, size_t> &b) { return a.second > b.second; });
+
+  size_t leaderId = 0;
+  for (const auto &chain : chains)
+  {
+    const size_t i = chain.first;
+    std::copy_n(&_sampleDatabase[i * D], D, &_chainLeaders[leaderId * D]);
+    _chainLeadersLogPriors[leaderId] = _sampleLogPriorDatabase[i];
+    _chainLeadersLogLikelihoods[leaderId] = _sampleLogLikelihoodDatabase[i];
+    if (_version == "mTMCMC")
+    {
+      _chainLeadersErrors[leaderId] = _sampleErrorDatabase[i];
+      std::copy_n(&_sampleGradientDatabase[i * D], D, &_chainLeadersGradients[leaderId * D]);
+      std::copy_n(&_sampleCovarianceDatabase[i * D * D], D * D, &_chainLeadersCovariance[leaderId * D * D]);
     }
+    _chainLengths[leaderId] = chain.second;
+    leaderId++;
   }
 
   /* Anneal gradients and proposal */
@@ -369,11 +356,8 @@ void TMCMC::processGeneration()
     for (size_t i = 0; i < _populationSize; ++i)
     {
       if (_chainLeadersErrors[i] != 0) continue;
-      gsl_vector_view gradLeader = gsl_vector_view_array(&_chainLeadersGradients[i][0], _variableCount);
-      gsl_vector_scale(&gradLeader.vector, _annealingExponent / _previousAnnealingExponent);
-
-      gsl_matrix_view covLeader = gsl_matrix_view_array(&_chainLeadersCovariance[i][0], _variableCount, _variableCount);
-      gsl_matrix_scale(&covLeader.matrix, _annealingExponent / _previousAnnealingExponent);
+      Map<VectorXd>(&_chainLeadersGradients[i * D], D) *= _annealingExponent / _previousAnnealingExponent;
+      Map<VectorXd>(&_chainLeadersCovariance[i * D * D], D * D) *= _annealingExponent / _previousAnnealingExponent;
     }
 
   /* Update acceptance statistics */
@@ -402,8 +386,8 @@ void TMCMC::calculateGradients(std::vector<Sample> &samples)
   {
     size_t finishedId = KORALI_WAITANY(samples);
 
-    _chainCandidatesGradients[finishedId] = KORALI_GET(std::vector<double>, samples[finishedId], "logLikelihood Gradient");
-    for (size_t d = 0; d < _variableCount; ++d) _chainCandidatesGradients[finishedId][d] *= _annealingExponent;
+    const auto gradient = KORALI_GET(std::vector<double>, samples[finishedId], "logLikelihood Gradient");
+    for (size_t d = 0; d < _variableCount; ++d) _chainCandidatesGradients[finishedId * _variableCount + d] = gradient[d] * _annealingExponent;
   }
 }
 
@@ -420,175 +404,100 @@ void TMCMC::calculateProposals(std::vector<Sample> &samples)
     numFIMCalculations++;
   }
 
-  size_t Nth = _variableCount;
-  gsl_vector *ccpy0 = gsl_vector_alloc(Nth);
-  gsl_vector *ccpy1 = gsl_vector_alloc(Nth);
+  const size_t D = _variableCount;
+  const double chi2inv = gsl_cdf_chisq_Pinv(0.68, D);
+
+  // Workspaces shared by all chains
+  SelfAdjointEigenSolver<MatrixXd> eigenSolver(D);
+  MatrixXd fisherInformation(D, D);
+  VectorXd eigenvalues(D);
 
   for (size_t c = 0; c < numFIMCalculations; c++)
   {
     size_t finishedId = KORALI_WAITANY(samples);
-    // printf("%s\n", samples[finishedId]._js.getJson().dump(2).c_str());
-
-    // reset
-    std::fill(_chainCandidatesCovariance[finishedId].begin(), _chainCandidatesCovariance[finishedId].end(), 0.0);
-
-    std::vector<double> FIM = KORALI_GET(std::vector<double>, samples[finishedId], "Fisher Information");
-    gsl_matrix_view FIMview = gsl_matrix_view_array(&FIM[0], Nth, Nth);
-
-    // scale FIM
-    gsl_matrix_scale(&FIMview.matrix, _annealingExponent);
-
-    // invert FIM
-    gsl_permutation *perm = gsl_permutation_alloc(Nth);
-
-    int s;
-    gsl_linalg_LU_decomp(&FIMview.matrix, perm, &s);
-
-    // SM - Only add a check if you can create a unit test to trigger it
-    //    if (status != GSL_SUCCESS)
-    //    {
-    //      _chainCandidatesErrors[finishedId] = 1;
-    //      gsl_permutation_free(perm);
-    //      _numLUDecompositionFailuresProposal++;
-    //      continue;
-    //    }
-
-    gsl_matrix *FIMinv = gsl_matrix_alloc(Nth, Nth);
-    gsl_linalg_LU_invert(&FIMview.matrix, perm, FIMinv);
-    gsl_permutation_free(perm);
-
-    // SM - Only add a check if you can create a unit test to trigger it
-    //    if (status != GSL_SUCCESS)
-    //    {
-    //      _chainCandidatesErrors[finishedId] = 2;
-    //      gsl_matrix_free(FIMinv);
-    //      _numInversionFailuresProposal++;
-    //      continue;
-    //    }
-
-    // eigenvalue decomposition
-    gsl_vector *Evals = gsl_vector_alloc(Nth);
-    gsl_matrix *Evecs = gsl_matrix_alloc(Nth, Nth);
-    gsl_eigen_symmv_workspace *work = gsl_eigen_symmv_alloc(Nth);
-    gsl_eigen_symmv(FIMinv, Evals, Evecs, work);
-    gsl_eigen_symmv_free(work);
-
-    // SM - Only add a check if you can create a unit test to trigger it
-    //    if (status != GSL_SUCCESS)
-    //    {
-    //      _chainCandidatesErrors[finishedId] = 3;
-    //      gsl_matrix_free(FIMinv);
-    //      gsl_vector_free(Evals);
-    //      gsl_matrix_free(Evecs);
-    //      _numEigenDecompositionFailuresProposal++;
-    //      continue;
-    //    }
-
-    gsl_vector_min(Evals);
-
-    // SM - Only add a check if you can create a unit test to trigger it
-    //    if (minEval <= 0.0)
-    //    {
-    //      //printf("minEval %lf\n", minEval);
-    //      _chainCandidatesErrors[finishedId] = 4;
-    //      gsl_matrix_free(FIMinv);
-    //      gsl_vector_free(Evals);
-    //      gsl_matrix_free(Evecs);
-    //      _numNegativeDefiniteProposals++;
-    //      continue;
-    //    }
 
-    // correction
-    double correction = false;
-    double distToUpper, distToLower;
-    double len, chi2inv = gsl_cdf_chisq_Pinv(0.68, Nth);
+    // The inverse of the (scaled) FIM has the same eigenvectors, with inverted eigenvalues
+    const auto FIM = KORALI_GET(std::vector<double>, samples[finishedId], "Fisher Information");
+    fisherInformation = _annealingExponent * Map<const RowMatrix>(FIM.data(), D, D);
+    eigenSolver.compute(fisherInformation);
+    eigenvalues = eigenSolver.eigenvalues().cwiseInverse();
+    const MatrixXd &eigenvectors = eigenSolver.eigenvectors();
 
-    gsl_vector_const_view candidate = gsl_vector_const_view_array(&_chainCandidates[finishedId][0], Nth);
+    // correction
+    bool correction = false;
+    const double *candidate = &_chainCandidates[finishedId * D];
 
-    for (size_t d = 0; d < Nth; ++d)
+    for (size_t d = 0; d < D; ++d)
     {
-      gsl_vector_memcpy(ccpy0, &candidate.vector);
-      gsl_vector_memcpy(ccpy1, &candidate.vector);
-
-      double scale = sqrt(gsl_vector_get(Evals, d) * chi2inv);
-      double scaleBefore = scale;
-
-      gsl_vector_const_view evec = gsl_matrix_const_column(Evecs, d);
-      gsl_blas_daxpy(+1.0 * scale, &evec.vector, ccpy0);
-      gsl_blas_daxpy(-1.0 * scale, &evec.vector, ccpy1);
+      const double scaleBefore = std::sqrt(eigenvalues[d] * chi2inv);
+      double scale = scaleBefore;
 
       // measure overshoot & undershoot in all dims
-      for (size_t e = 0; e < Nth; ++e)
+      for (size_t e = 0; e < D; ++e)
       {
-        distToUpper = _upperExtendedBoundaries[e] - _chainCandidates[finishedId][e];
-        distToLower = _chainCandidates[finishedId][e] - _lowerExtendedBoundaries[e];
-
-        len = gsl_vector_get(ccpy0, e) - _upperExtendedBoundaries[e];
-        if (len > 0.) scale = std::min(scale, std::abs(1.0 / gsl_vector_get(&evec.vector, e) * distToUpper));
-
-        len = _lowerExtendedBoundaries[e] - gsl_vector_get(ccpy0, e);
-        if (len > 0.) scale = std::min(scale, std::abs(1.0 / gsl_vector_get(&evec.vector, e) * distToLower));
-
-        len = gsl_vector_get(ccpy1, e) - _upperExtendedBoundaries[e];
-        if (len > 0.) scale = std::min(scale, std::abs(1.0 / gsl_vector_get(&evec.vector, e) * distToUpper));
+        const double evec = eigenvectors(e, d);
+        const double distToUpper = _upperExtendedBoundaries[e] - candidate[e];
+        const double distToLower = candidate[e] - _lowerExtendedBoundaries[e];
 
-        len = _lowerExtendedBoundaries[e] - gsl_vector_get(ccpy1, e);
-        if (len > 0.) scale = std::min(scale, std::abs(1.0 / gsl_vector_get(&evec.vector, e) * distToLower));
+        for (const double end : {candidate[e] + scaleBefore * evec, candidate[e] - scaleBefore * evec})
+        {
+          if (end > _upperExtendedBoundaries[e]) scale = std::min(scale, std::abs(distToUpper / evec));
+          if (end < _lowerExtendedBoundaries[e]) scale = std::min(scale, std::abs(distToLower / evec));
+        }
       }
 
       // scale evals
-      gsl_vector_set(Evals, d, scale * scale / chi2inv);
+      eigenvalues[d] = scale * scale / chi2inv;
       if (scaleBefore != scale) correction = true;
     }
 
     if (correction) _numCovarianceCorrections++;
 
     // construct & store
-    for (size_t d = 0; d < Nth; ++d)
-    {
-      gsl_vector_view evec = gsl_matrix_column(Evecs, d);
-      gsl_vector_scale(&evec.vector, sqrt(gsl_vector_get(Evals, d)));
-    }
+    Map<RowMatrix> candidateCovariance(&_chainCandidatesCovariance[finishedId * D * D], D, D);
+    candidateCovariance.noalias() = eigenvectors * eigenvalues.asDiagonal() * eigenvectors.transpose();
+  }
+}
 
-    gsl_matrix_view candidatecov = gsl_matrix_view_array(&_chainCandidatesCovariance[finishedId][0], Nth, Nth);
-    gsl_blas_dgemm(CblasNoTrans, CblasTrans, 1.0, Evecs, Evecs, 0.0, &candidatecov.matrix);
+void TMCMC::generateCandidates()
+{
+  const size_t D = _variableCount;
 
-    gsl_matrix_free(Evecs);
-    gsl_vector_free(Evals);
-    gsl_matrix_free(FIMinv);
-  }
+  // Drawing the random numbers of all chains at once, and correlating them with a single (blocked) matrix product
+  _multivariateGenerator->getStandardNormalVector(_chainCandidates.data(), _chainCount * D);
 
-  gsl_vector_free(ccpy0);
-  gsl_vector_free(ccpy1);
+  Map<RowMatrix> candidates(_chainCandidates.data(), _chainCount, D);
+  Map<const RowMatrix> leaders(_chainLeaders.data(), _chainCount, D);
+  Map<const RowMatrix> choleskyFactor(_covarianceCholeskyFactor.data(), D, D);
+  candidates = leaders + candidates * choleskyFactor.transpose();
 }
 
 void TMCMC::generateCandidate(const size_t sampleId)
 {
+  const size_t D = _variableCount;
+  Map<VectorXd> candidate(&_chainCandidates[sampleId * D], D);
+  Map<const VectorXd> leader(&_chainLeaders[sampleId * D], D);
+  Map<const RowMatrix> choleskyFactor(_covarianceCholeskyFactor.data(), D, D);
+
   if (_version == "TMCMC")
   {
-    _multivariateGenerator->getRandomVector(&_chainCandidates[sampleId][0], _variableCount);
-    for (size_t d = 0; d < _variableCount; d++) _chainCandidates[sampleId][d] += _chainLeaders[sampleId][d];
+    _multivariateGenerator->getStandardNormalVector(candidate.data(), D);
+    candidate = leader + choleskyFactor.triangularView<Lower>() * candidate;
   }
   else /* "mTMCMC" */
   {
     // TODO: refine error treatment granularity
     if (_chainLeadersErrors[sampleId] == 0)
     {
-      _multivariateGenerator->_meanVector = _chainLeaders[sampleId];
-      for (size_t i = 0; i < _variableCount * _variableCount; ++i) _multivariateGenerator->_sigma[i] = _chainLeadersCovariance[sampleId][i] * _stepSize;
+      Map<const RowMatrix> leaderCovariance(&_chainLeadersCovariance[sampleId * D * D], D, D);
+      Map<const VectorXd> leaderGradient(&_chainLeadersGradients[sampleId * D], D);
 
       /* Cholesky Decomp */
-      gsl_matrix_view sigma = gsl_matrix_view_array(&_multivariateGenerator->_sigma[0], _variableCount, _variableCount);
-      int status = gsl_linalg_cholesky_decomp(&sigma.matrix);
-      if (status == GSL_SUCCESS)
+      const LLT<MatrixXd> proposalCholesky(_stepSize * leaderCovariance);
+      if (proposalCholesky.info() == Success)
       {
-        _multivariateGenerator->updateDistribution();
-        _multivariateGenerator->getRandomVector(&_chainCandidates[sampleId][0], _variableCount);
-
-        gsl_vector_view candidate = gsl_vector_view_array(&_chainCandidates[sampleId][0], _variableCount);
-        gsl_vector_const_view leaderGrad = gsl_vector_const_view_array(&_chainLeadersGradients[sampleId][0], _variableCount);
-        gsl_matrix_const_view leaderCov = gsl_matrix_const_view_array(&_chainLeadersCovariance[sampleId][0], _variableCount, _variableCount);
-        gsl_blas_dgemv(CblasNoTrans, 0.5 * _stepSize, &leaderCov.matrix, &leaderGrad.vector, 1.0, &candidate.vector);
+        _multivariateGenerator->getStandardNormalVector(candidate.data(), D);
+        candidate = leader + proposalCholesky.matrixL() * candidate + 0.5 * _stepSize * leaderCovariance * leaderGradient;
       }
 
       // SM - Only add a check if you can create a unit test to trigger it
@@ -600,30 +509,24 @@ void TMCMC::generateCandidate(const size_t sampleId)
     }
     if (_chainLeadersErrors[sampleId] != 0) /* error */
     {
-      _multivariateGenerator->_meanVector = _chainLeaders[sampleId];
-      _multivariateGenerator->_sigma = _covarianceMatrix;
-
-      /* Cholesky Decomp */
-      gsl_matrix_view sigma = gsl_matrix_view_array(&_multivariateGenerator->_sigma[0], _variableCount, _variableCount);
-      gsl_linalg_cholesky_decomp(&sigma.matrix);
-
-      _multivariateGenerator->updateDistribution();
-      _multivariateGenerator->getRandomVector(&_chainCandidates[sampleId][0], _variableCount);
+      _multivariateGenerator->getStandardNormalVector(candidate.data(), D);
+      candidate = leader + choleskyFactor.triangularView<Lower>() * candidate;
     }
   }
 }
 
 void TMCMC::updateDatabase(const size_t sampleId)
 {
-  _sampleDatabase.push_back(_chainLeaders[sampleId]);
+  const size_t D = _variableCount;
+  _sampleDatabase.insert(_sampleDatabase.end(), &_chainLeaders[sampleId * D], &_chainLeaders[sampleId * D] + D);
   _sampleLogPriorDatabase.push_back(_chainLeadersLogPriors[sampleId]);
   _sampleLogLikelihoodDatabase.push_back(_chainLeadersLogLikelihoods[sampleId]);
 
   if (_version == "mTMCMC")
   {
     _sampleErrorDatabase.push_back(_chainLeadersErrors[sampleId]);
-    _sampleGradientDatabase.push_back(_chainLeadersGradients[sampleId]);
-    _sampleCovarianceDatabase.push_back(_chainLeadersCovariance[sampleId]);
+    _sampleGradientDatabase.insert(_sampleGradientDatabase.end(), &_chainLeadersGradients[sampleId * D], &_chainLeadersGradients[sampleId * D] + D);
+    _sampleCovarianceDatabase.insert(_sampleCovarianceDatabase.end(), &_chainLeadersCovariance[sampleId * D * D], &_chainLeadersCovariance[sampleId * D * D] + D * D);
   }
 }
 
@@ -641,38 +544,20 @@ double TMCMC::calculateAcceptanceProbability(const size_t sampleId)
       // TODO: refine error treatment granularity
       if ((_chainLeadersErrors[sampleId] == 0) && (_chainCandidatesErrors[sampleId] == 0))
       {
-        gsl_vector_const_view leader = gsl_vector_const_view_array(&_chainLeaders[sampleId][0], _variableCount);
-        gsl_vector_const_view candidate = gsl_vector_const_view_array(&_chainCandidates[sampleId][0], _variableCount);
-
-        gsl_vector *meanLeader = gsl_vector_alloc(_variableCount);
-        gsl_vector_memcpy(meanLeader, &leader.vector);
-
-        gsl_vector *meanCandidate = gsl_vector_alloc(_variableCount);
-        gsl_vector_memcpy(meanCandidate, &candidate.vector);
-
-        gsl_vector_const_view gradLeader = gsl_vector_const_view_array(&_chainLeadersGradients[sampleId][0], _variableCount);
-        gsl_vector_const_view gradCandidate = gsl_vector_const_view_array(&_chainCandidatesGradients[sampleId][0], _variableCount);
-
-        gsl_matrix_const_view covLeader = gsl_matrix_const_view_array(&_chainLeadersCovariance[sampleId][0], _variableCount, _variableCount);
-
-        gsl_blas_dgemv(CblasNoTrans, 0.5 * _stepSize, &covLeader.matrix, &gradLeader.vector, 1.0, meanLeader);
-        gsl_blas_dgemv(CblasNoTrans, 0.5 * _stepSize, &covLeader.matrix, &gradCandidate.vector, 1.0, meanCandidate);
+        const size_t D = _variableCount;
+        Map<const VectorXd> leader(&_chainLeaders[sampleId * D], D);
+        Map<const VectorXd> candidate(&_chainCandidates[sampleId * D], D);
+        Map<const VectorXd> gradLeader(&_chainLeadersGradients[sampleId * D], D);
+        Map<const VectorXd> gradCandidate(&_chainCandidatesGradients[sampleId * D], D);
+        Map<const RowMatrix> covLeader(&_chainLeadersCovariance[sampleId * D * D], D, D);
 
-        gsl_matrix *cholCovLeader = gsl_matrix_alloc(_variableCount, _variableCount);
-        gsl_matrix_memcpy(cholCovLeader, &covLeader.matrix);
-        gsl_matrix_scale(cholCovLeader, _stepSize);
-        gsl_linalg_cholesky_decomp1(cholCovLeader);
+        const VectorXd meanLeader = leader + 0.5 * _stepSize * covLeader * gradLeader;
+        const VectorXd meanCandidate = candidate + 0.5 * _stepSize * covLeader * gradCandidate;
 
-        gsl_vector *work = gsl_vector_alloc(_variableCount);
-
-        double logpCandidate, logpLeader;
-        gsl_ran_multivariate_gaussian_log_pdf(&candidate.vector, meanLeader, cholCovLeader, &logpCandidate, work);
-        gsl_ran_multivariate_gaussian_log_pdf(&leader.vector, meanCandidate, cholCovLeader, &logpLeader, work);
-
-        gsl_vector_free(work);
-        gsl_matrix_free(cholCovLeader);
-        gsl_vector_free(meanLeader);
-        gsl_vector_free(meanCandidate);
+        // Both proposal densities share their covariance, so their normalization constants cancel out
+        const LLT<MatrixXd> cholCovLeader(_stepSize * covLeader);
+        const double logpCandidate = -0.5 * cholCovLeader.matrixL().solve(candidate - meanLeader).squaredNorm();
+        const double logpLeader = -0.5 * cholCovLeader.matrixL().solve(leader - meanCandidate).squaredNorm();
 
         P = exp((_chainCandidatesLogLikelihoods[sampleId] - _chainLeadersLogLikelihoods[sampleId]) * _annealingExponent + (logpLeader - logpCandidate) + (_chainCandidatesLogPriors[sampleId] - _chainLeadersLogPriors[sampleId]));
       }
@@ -785,18 +670,56 @@ void TMCMC::minSearch(double const *loglike, size_t Ns, double exponent, double
 
 void TMCMC::setBurnIn()
 {
-  if (_k->_currentGeneration <= 1)
-    _currentBurnIn = 0;
-  else if (_k->_currentGeneration - 2 < _perGenerationBurnIn.size())
-    _currentBurnIn = _perGenerationBurnIn[_k->_currentGeneration - 2];
-  else
-    _currentBurnIn = _burnIn;
+  _currentBurnIn = getGenerationBurnIn(_k->_currentGeneration);
+}
+
+size_t TMCMC::getGenerationBurnIn(const size_t generation) const
+{
+  if (generation <= 1) return 0;
+  if (generation - 2 < _perGenerationBurnIn.size()) return _perGenerationBurnIn[generation - 2];
+  return _burnIn;
+}
+
+size_t TMCMC::getBalancedChainLength(const std::vector<unsigned int> &numSelections, const size_t burnIn) const
+{
+  size_t workerCount = 1;
+  if (_k->_overrideEngine == false) workerCount = std::max(_k->_engine->_conduit->getWorkerCount(), (size_t)1);
+
+  // Most samples share the same number of selections, the candidate lengths are evaluated once per distinct number
+  std::map<size_t, size_t> selectionCounts;
+  for (const auto n : numSelections)
+    if (n > 0) selectionCounts[n]++;
+
+  const size_t longestChain = selectionCounts.empty() ? 1 : selectionCounts.rbegin()->first;
+
+  // The makespan is bounded below by the total work shared among the workers, and by the longest (sequential) chain
+  size_t bestLength = 1;
+  double bestMakespan = Inf;
+  for (size_t length = 1; length <= std::min(_maxChainLength, longestChain); length++)
+  {
+    size_t evaluationCount = 0;
+    for (const auto &entry : selectionCounts) evaluationCount += entry.second * (entry.first + (entry.first + length - 1) / length * burnIn);
+
+    // Among equal makespans, longer chains (fewer burn in steps and leaders) are preferred
+    const double makespan = std::max((double)evaluationCount / (double)workerCount, (double)(length + burnIn));
+    if (makespan <= bestMakespan)
+    {
+      bestMakespan = makespan;
+      bestLength = length;
+    }
+  }
+
+  return bestLength;
 }
 
 void TMCMC::finalize()
 {
-  // Setting results
-  (*_k)["Results"]["Posterior Sample Database"] = _sampleDatabase;
+  // Setting results, with one entry per sample
+  std::vector<std::vector<double>> posteriorSamples(_sampleDatabase.size() / _variableCount);
+  for (size_t i = 0; i < posteriorSamples.size(); i++)
+    posteriorSamples[i].assign(_sampleDatabase.begin() + i * _variableCount, _sampleDatabase.begin() + (i + 1) * _variableCount);
+
+  (*_k)["Results"]["Posterior Sample Database"] = posteriorSamples;
   (*_k)["Results"]["Posterior Sample LogPrior Database"] = _sampleLogPriorDatabase;
   (*_k)["Results"]["Posterior Sample LogLikelihood Database"] = _sampleLogLikelihoodDatabase;
   (*_k)["Results"]["Log Evidence"] = _currentAccumulatedLogEvidence;
@@ -898,7 +821,7 @@ void TMCMC::setConfiguration(knlohmann::json& js)
 
  if (isDefined(js, "Chain Candidates"))
  {
- try { _chainCandidates = js["Chain Candidates"].get<std::vector<std::vector<double>>>();
+ try { _chainCandidates = js["Chain Candidates"].get<std::vector<double>>();
 } catch (const std::exception& e)
  { KORALI_LOG_ERROR(" + Object: [ TMCMC ] \n + Key:    ['Chain Candidates']\n%s", e.what()); } 
    eraseValue(js, "Chain Candidates");
@@ -922,7 +845,7 @@ void TMCMC::setConfiguration(knlohmann::json& js)
 
  if (isDefined(js, "Chain Candidates Gradients"))
  {
- try { _chainCandidatesGradients = js["Chain Candidates Gradients"].get<std::vector<std::vector<double>>>();
+ try { _chainCandidatesGradients = js["Chain Candidates Gradients"].get<std::vector<double>>();
 } catch (const std::exception& e)
  { KORALI_LOG_ERROR(" + Object: [ TMCMC ] \n + Key:    ['Chain Candidates Gradients']\n%s", e.what()); } 
    eraseValue(js, "Chain Candidates Gradients");
@@ -938,7 +861,7 @@ void TMCMC::setConfiguration(knlohmann::json& js)
 
  if (isDefined(js, "Chain Candidates Covariance"))
  {
- try { _chainCandidatesCovariance = js["Chain Candidates Covariance"].get<std::vector<std::vector<double>>>();
+ try { _chainCandidatesCovariance = js["Chain Candidates Covariance"].get<std::vector<double>>();
 } catch (const std::exception& e)
  { KORALI_LOG_ERROR(" + Object: [ TMCMC ] \n + Key:    ['Chain Candidates Covariance']\n%s", e.what()); } 
    eraseValue(js, "Chain Candidates Covariance");
@@ -946,7 +869,7 @@ void TMCMC::setConfiguration(knlohmann::json& js)
 
  if (isDefined(js, "Chain Leaders"))
  {
- try { _chainLeaders = js["Chain Leaders"].get<std::vector<std::vector<double>>>();
+ try { _chainLeaders = js["Chain Leaders"].get<std::vector<double>>();
 } catch (const std::exception& e)
  { KORALI_LOG_ERROR(" + Object: [ TMCMC ] \n + Key:    ['Chain Leaders']\n%s", e.what()); } 
    eraseValue(js, "Chain Leaders");
@@ -970,7 +893,7 @@ void TMCMC::setConfiguration(knlohmann::json& js)
 
  if (isDefined(js, "Chain Leaders Gradients"))
  {
- try { _chainLeadersGradients = js["Chain Leaders Gradients"].get<std::vector<std::vector<double>>>();
+ try { _chainLeadersGradients = js["Chain Leaders Gradients"].get<std::vector<double>>();
 } catch (const std::exception& e)
  { KORALI_LOG_ERROR(" + Object: [ TMCMC ] \n + Key:    ['Chain Leaders Gradients']\n%s", e.what()); } 
    eraseValue(js, "Chain Leaders Gradients");
@@ -986,7 +909,7 @@ void TMCMC::setConfiguration(knlohmann::json& js)
 
  if (isDefined(js, "Chain Leaders Covariance"))
  {
- try { _chainLeadersCovariance = js["Chain Leaders Covariance"].get<std::vector<std::vector<double>>>();
+ try { _chainLeadersCovariance = js["Chain Leaders Covariance"].get<std::vector<double>>();
 } catch (const std::exception& e)
  { KORALI_LOG_ERROR(" + Object: [ TMCMC ] \n + Key:    ['Chain Leaders Covariance']\n%s", e.what()); } 
    eraseValue(js, "Chain Leaders Covariance");
@@ -1122,7 +1045,7 @@ void TMCMC::setConfiguration(knlohmann::json& js)
 
  if (isDefined(js, "Sample Database"))
  {
- try { _sampleDatabase = js["Sample Database"].get<std::vector<std::vector<double>>>();
+ try { _sampleDatabase = js["Sample Database"].get<std::vector<double>>();
 } catch (const std::exception& e)
  { KORALI_LOG_ERROR(" + Object: [ TMCMC ] \n + Key:    ['Sample Database']\n%s", e.what()); } 
    eraseValue(js, "Sample Database");
@@ -1146,7 +1069,7 @@ void TMCMC::setConfiguration(knlohmann::json& js)
 
  if (isDefined(js, "Sample Gradient Database"))
  {
- try { _sampleGradientDatabase = js["Sample Gradient Database"].get<std::vector<std::vector<double>>>();
+ try { _sampleGradientDatabase = js["Sample Gradient Database"].get<std::vector<double>>();
 } catch (const std::exception& e)
  { KORALI_LOG_ERROR(" + Object: [ TMCMC ] \n + Key:    ['Sample Gradient Database']\n%s", e.what()); } 
    eraseValue(js, "Sample Gradient Database");
@@ -1162,7 +1085,7 @@ void TMCMC::setConfiguration(knlohmann::json& js)
 
  if (isDefined(js, "Sample Covariance Database"))
  {
- try { _sampleCovarianceDatabase = js["Sample Covariance Database"].get<std::vector<std::vector<double>>>();
+ try { _sampleCovarianceDatabase = js["Sample Covariance Database"].get<std::vector<double>>();
 } catch (const std::exception& e)
  { KORALI_LOG_ERROR(" + Object: [ TMCMC ] \n + Key:    ['Sample Covariance Database']\n%s", e.what()); } 
    eraseValue(js, "Sample Covariance Database");
@@ -1265,6 +1188,15 @@ void TMCMC::setConfiguration(knlohmann::json& js)
  }
   else   KORALI_LOG_ERROR(" + No value provided for mandatory setting: ['Max Chain Length'] required by TMCMC.\n"); 
 
+ if (isDefined(js, "Balance Chain Lengths"))
+ {
+ try { _balanceChainLengths = js["Balance Chain Lengths"].get<int>();
+} catch (const std::exception& e)
+ { KORALI_LOG_ERROR(" + Object: [ TMCMC ] \n + Key:    ['Balance Chain Lengths']\n%s", e.what()); } 
+   eraseValue(js, "Balance Chain Lengths");
+ }
+  else   KORALI_LOG_ERROR(" + No value provided for mandatory setting: ['Balance Chain Lengths'] required by TMCMC.\n"); 
+
  if (isDefined(js, "Burn In"))
  {
  try { _burnIn = js["Burn In"].get<size_t>();
@@ -1359,6 +1291,7 @@ void TMCMC::getConfiguration(knlohmann::json& js)
    js["Version"] = _version;
    js["Population Size"] = _populationSize;
    js["Max Chain Length"] = _maxChainLength;
+   js["Balance Chain Lengths"] = _balanceChainLengths;
    js["Burn In"] = _burnIn;
    js["Per Generation Burn In"] = _perGenerationBurnIn;
    js["Target Coefficient Of Variation"] = _targetCoefficientOfVariation;
@@ -1422,7 +1355,7 @@ void TMCMC::getConfiguration(knlohmann::json& js)
 void TMCMC::applyModuleDefaults(knlohmann::json& js) 
 {
 
- std::string defaultString = "{\"Multinomial Generator\": {\"Type\": \"Specific/Multinomial\"}, \"Multivariate Generator\": {\"Type\": \"Multivariate/Normal\"}, \"Uniform Generator\": {\"Type\": \"Univariate/Uniform\", \"Minimum\": 0.0, \"Maximum\": 1.0}, \"Version\": \"TMCMC\", \"Max Chain Length\": 1, \"Burn In\": 0, \"Per Generation Burn In\": [], \"Target Coefficient Of Variation\": 1.0, \"Covariance Scaling\": 0.04, \"Min Annealing Exponent Update\": 1e-05, \"Max Annealing Exponent Update\": 1.0, \"Domain Extension Factor\": 0.2, \"Step Size\": 0.1, \"Termination Criteria\": {\"Target Annealing Exponent\": 1.0}}";
+ std::string defaultString = "{\"Multinomial Generator\": {\"Type\": \"Specific/Multinomial\"}, \"Multivariate Generator\": {\"Type\": \"Multivariate/Normal\"}, \"Uniform Generator\": {\"Type\": \"Univariate/Uniform\", \"Minimum\": 0.0, \"Maximum\": 1.0}, \"Version\": \"TMCMC\", \"Max Chain Length\": 1, \"Balance Chain Lengths\": false, \"Burn In\": 0, \"Per Generation Burn In\": [], \"Target Coefficient Of Variation\": 1.0, \"Covariance Scaling\": 0.04, \"Min Annealing Exponent Update\": 1e-05, \"Max Annealing Exponent Update\": 1.0, \"Domain Extension Factor\": 0.2, \"Step Size\": 0.1, \"Termination Criteria\": {\"Target Annealing Exponent\": 1.0}}";
  knlohmann::json defaultJs = knlohmann::json::parse(defaultString);
  mergeJson(js, defaultJs); 
  Sampler::applyModuleDefaults(js);
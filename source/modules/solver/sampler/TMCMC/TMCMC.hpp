@@ -58,6 +58,11 @@ typedef struct fparam_s
 */
 class TMCMC : public Sampler
 {
+  /**
+   * @brief Cholesky factor (lower triangular, row-major) of the proposal covariance, shared by all chains of a generation.
+   */
+  std::vector<double> _covarianceCholeskyFactor;
+
   public: 
   /**
   * @brief Indicates which variant of the TMCMC algorithm to use.
@@ -72,6 +77,10 @@ class TMCMC : public Sampler
   */
    size_t _maxChainLength;
   /**
+  * @brief If true, chains are split further (below Max Chain Length) into sub-chains seeded from the same leader, such that the estimated makespan of each generation (given the number of workers and the burn in steps of the sub-chains) is minimal.
+  */
+   int _balanceChainLengths;
+  /**
   * @brief Specifies the number of additional TMCMC steps per chain per generation (except for generation 0 and 1).
   */
    size_t _burnIn;
@@ -128,9 +137,9 @@ class TMCMC : public Sampler
   */
    std::vector<int> _chainPendingGradient;
   /**
-  * @brief [Internal Use] All candidates of all chains to evaluate in order to advance the markov chains.
+  * @brief [Internal Use] All candidates of all chains to evaluate in order to advance the markov chains (row-major, one row of Variable Count entries per chain).
   */
-   std::vector<std::vector<double>> _chainCandidates;
+   std::vector<double> _chainCandidates;
   /**
   * @brief [Internal Use] The loglikelihoods of the chain candidates.
   */
@@ -140,21 +149,21 @@ class TMCMC : public Sampler
   */
    std::vector<double> _chainCandidatesLogPriors;
   /**
-  * @brief [Internal Use] Candidate gradient of statistical model wrt. sample variables.
+  * @brief [Internal Use] Candidate gradient of statistical model wrt. sample variables (row-major, one row per chain).
   */
-   std::vector<std::vector<double>> _chainCandidatesGradients;
+   std::vector<double> _chainCandidatesGradients;
   /**
   * @brief [Internal Use] Shows if covariance calculation successfully terminated for candidate (only relevant for mTMCMC).
   */
    std::vector<int> _chainCandidatesErrors;
   /**
-  * @brief [Internal Use] Candidates covariance of normal proposal distribution.
+  * @brief [Internal Use] Candidates covariance of normal proposal distribution (row-major, one Variable Count x Variable Count matrix per chain).
   */
-   std::vector<std::vector<double>> _chainCandidatesCovariance;
+   std::vector<double> _chainCandidatesCovariance;
   /**
-  * @brief [Internal Use] Leading parameters of all chains to be accepted.
+  * @brief [Internal Use] Leading parameters of all chains to be accepted (row-major, one row of Variable Count entries per chain).
   */
-   std::vector<std::vector<double>> _chainLeaders;
+   std::vector<double> _chainLeaders;
   /**
   * @brief [Internal Use] The loglikelihoods of the chain leaders.
   */
@@ -164,17 +173,17 @@ class TMCMC : public Sampler
   */
    std::vector<double> _chainLeadersLogPriors;
   /**
-  * @brief [Internal Use] Leader gradient of statistical model wrt. sample variables.
+  * @brief [Internal Use] Leader gradient of statistical model wrt. sample variables (row-major, one row per chain).
   */
-   std::vector<std::vector<double>> _chainLeadersGradients;
+   std::vector<double> _chainLeadersGradients;
   /**
   * @brief [Internal Use] Shows if covariance calculation successfully terminated for leader (only relevant for mTMCMC).
   */
    std::vector<int> _chainLeadersErrors;
   /**
-  * @brief [Internal Use] Leader covariance of normal proposal distribution.
+  * @brief [Internal Use] Leader covariance of normal proposal distribution (row-major, one Variable Count x Variable Count matrix per chain).
   */
-   std::vector<std::vector<double>> _chainLeadersCovariance;
+   std::vector<double> _chainLeadersCovariance;
   /**
   * @brief [Internal Use] Number of finished chains.
   */
@@ -240,9 +249,9 @@ class TMCMC : public Sampler
   */
    std::vector<double> _meanTheta;
   /**
-  * @brief [Internal Use] Parameters stored in the database (taken from the chain leaders).
+  * @brief [Internal Use] Parameters stored in the database (taken from the chain leaders, row-major, one row of Variable Count entries per sample).
   */
-   std::vector<std::vector<double>> _sampleDatabase;
+   std::vector<double> _sampleDatabase;
   /**
   * @brief [Internal Use] LogLikelihood Evaluation of the parameters stored in the database.
   */
@@ -252,17 +261,17 @@ class TMCMC : public Sampler
   */
    std::vector<double> _sampleLogPriorDatabase;
   /**
-  * @brief [Internal Use] Gradients stored in the database (taken from the chain leaders, only mTMCMC).
+  * @brief [Internal Use] Gradients stored in the database (taken from the chain leaders, only mTMCMC, row-major, one row per sample).
   */
-   std::vector<std::vector<double>> _sampleGradientDatabase;
+   std::vector<double> _sampleGradientDatabase;
   /**
   * @brief [Internal Use] Shows if covariance calculation successfully terminated for sample (only relevant for mTMCMC).
   */
    std::vector<int> _sampleErrorDatabase;
   /**
-  * @brief [Internal Use] Gradients stored in the database (taken from the chain leaders, only mTMCMC).
+  * @brief [Internal Use] Covariances stored in the database (taken from the chain leaders, only mTMCMC, row-major, one matrix per sample).
   */
-   std::vector<std::vector<double>> _sampleCovarianceDatabase;
+   std::vector<double> _sampleCovarianceDatabase;
   /**
   * @brief [Internal Use] Calculated upper domain boundaries (only relevant for mTMCMC).
   */
@@ -332,6 +341,21 @@ class TMCMC : public Sampler
    */
   void setBurnIn();
 
+  /**
+   * @brief Returns the burn in steps per chain of a generation.
+   * @param generation Generation number.
+   * @return Number of burn in steps.
+   */
+  size_t getGenerationBurnIn(const size_t generation) const;
+
+  /**
+   * @brief Finds the chain length that minimizes the estimated makespan of the next generation, given the number of workers.
+   * @param numSelections Number of times each sample has been selected as a chain leader.
+   * @param burnIn Burn in steps per chain of the next generation.
+   * @return Length up to which chains are kept whole (longer ones are split).
+   */
+  size_t getBalancedChainLength(const std::vector<unsigned int> &numSelections, const size_t burnIn) const;
+
   /**
    * @brief Prepare Generation before evaluation.
    */
@@ -342,6 +366,11 @@ class TMCMC : public Sampler
    */
   void processGeneration();
 
+  /**
+   * @brief Generates the first candidates of all chains of a generation at once (TMCMC only).
+   */
+  void generateCandidates();
+
   /**
    * @brief Helper function for annealing exponent update/
    * @param fj Pointer to exponentiated probability values.
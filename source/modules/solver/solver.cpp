@@ -1,4 +1,6 @@
+#include "engine.hpp"
 #include "modules/solver/solver.hpp"
+#include <algorithm>
 
 namespace korali
 {
@@ -19,6 +21,57 @@ void Solver::printGenerationAfter(){};
  */
 void Solver::setInitialConfiguration(){};
 
+void Solver::mapSamples(const size_t sampleCount, const std::function<void(size_t, Sample &)> &prepare, const std::function<void(size_t, Sample &)> &reduce)
+{
+  // If the engine is overridden, samples are evaluated directly, one at a time
+  if (_k->_overrideEngine == true)
+  {
+    for (size_t i = 0; i < sampleCount; i++)
+    {
+      Sample sample;
+      prepare(i, sample);
+      _k->_overrideFunction(sample);
+      reduce(i, sample);
+    }
+    return;
+  }
+
+  // The window of in-flight samples is sized after the number of workers and the samples each of them receives per message
+  const size_t workerCount = _k->_engine->_conduit->getWorkerCount();
+  const size_t batchSize = std::max(_k->_engine->_conduit->_batchSize, (size_t)1);
+  const size_t windowSize = std::min(sampleCount, std::max(_samplesInFlightPerWorker, (size_t)1) * workerCount * batchSize);
+
+  std::vector<Sample> samples(windowSize);
+  std::vector<size_t> sampleIndexes(windowSize);
+  size_t nextSample = 0;
+
+  // Filling the window
+  for (; nextSample < windowSize; nextSample++)
+  {
+    sampleIndexes[nextSample] = nextSample;
+    prepare(nextSample, samples[nextSample]);
+    KORALI_START(samples[nextSample]);
+  }
+
+  // Reducing samples as they finish, and reusing their slots for the next ones
+  for (size_t finishedSamples = 0; finishedSamples < sampleCount; finishedSamples++)
+  {
+    size_t slot = KORALI_WAITANY(samples);
+    reduce(sampleIndexes[slot], samples[slot]);
+
+    if (nextSample < sampleCount)
+    {
+      samples[slot]._js.getJson() = knlohmann::json();
+      samples[slot]._buffers.clear();
+
+      sampleIndexes[slot] = nextSample;
+      prepare(nextSample, samples[slot]);
+      KORALI_START(samples[slot]);
+      nextSample++;
+    }
+  }
+}
+
 void Solver::setConfiguration(knlohmann::json& js) 
 {
  if (isDefined(js, "Results"))  eraseValue(js, "Results");
@@ -39,6 +92,15 @@ void Solver::setConfiguration(knlohmann::json& js)
    eraseValue(js, "Model Evaluation Count");
  }
 
+ if (isDefined(js, "Samples In Flight Per Worker"))
+ {
+ try { _samplesInFlightPerWorker = js["Samples In Flight Per Worker"].get<size_t>();
+} catch (const std::exception& e)
+ { KORALI_LOG_ERROR(" + Object: [ solver ] \n + Key:    ['Samples In Flight Per Worker']\n%s", e.what()); } 
+   eraseValue(js, "Samples In Flight Per Worker");
+ }
+  else   KORALI_LOG_ERROR(" + No value provided for mandatory setting: ['Samples In Flight Per Worker'] required by solver.\n"); 
+
  if (isDefined(js, "Termination Criteria", "Max Model Evaluations"))
  {
  try { _maxModelEvaluations = js["Termination Criteria"]["Max Model Evaluations"].get<size_t>();
@@ -67,6 +129,7 @@ void Solver::getConfiguration(knlohmann::json& js)
 {
 
  js["Type"] = _type;
+   js["Samples In Flight Per Worker"] = _samplesInFlightPerWorker;
    js["Termination Criteria"]["Max Model Evaluations"] = _maxModelEvaluations;
    js["Termination Criteria"]["Max Generations"] = _maxGenerations;
    js["Variable Count"] = _variableCount;
@@ -77,7 +140,7 @@ void Solver::getConfiguration(knlohmann::json& js)
 void Solver::applyModuleDefaults(knlohmann::json& js) 
 {
 
- std::string defaultString = "{\"Termination Criteria\": {\"Max Model Evaluations\": 1000000000, \"Max Generations\": 10000000000}, \"Variable Count\": 0, \"Model Evaluation Count\": 0}";
+ std::string defaultString = "{\"Termination Criteria\": {\"Max Model Evaluations\": 1000000000, \"Max Generations\": 10000000000}, \"Samples In Flight Per Worker\": 4, \"Variable Count\": 0, \"Model Evaluation Count\": 0}";
  knlohmann::json defaultJs = knlohmann::json::parse(defaultString);
  mergeJson(js, defaultJs); 
  Module::applyModuleDefaults(js);
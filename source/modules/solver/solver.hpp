@@ -16,6 +16,7 @@
 #include "modules/experiment/experiment.hpp"
 #include "modules/module.hpp"
 #include "sample/sample.hpp"
+#include <functional>
 #include <string>
 #include <vector>
 
@@ -70,6 +71,11 @@ namespace korali
  */
 #define KORALI_LISTEN(SAMPLES) _k->_engine->_conduit->listen(SAMPLES);
 
+/**
+ * @brief Macro to evaluate a (possibly very large) set of samples, keeping a bounded number of them in flight.
+ */
+#define KORALI_MAP(COUNT, PREPARE, REDUCE) mapSamples(COUNT, PREPARE, REDUCE);
+
 /**
 * @brief Class declaration for module: Solver.
 */
@@ -77,6 +83,10 @@ class Solver : public Module
 {
   public: 
   /**
+  * @brief For solvers that stream large sets of samples, specifies how many samples per worker are kept in flight at any time. Finished samples are processed and replaced as results arrive, so memory usage depends on the number of workers instead of the size of the set.
+  */
+   size_t _samplesInFlightPerWorker;
+  /**
   * @brief [Internal Use] Number of variables.
   */
    size_t _variableCount;
@@ -120,6 +130,14 @@ class Solver : public Module
   void applyVariableDefaults() override;
   
 
+  /**
+   * @brief Evaluates a set of samples keeping at most (Samples In Flight Per Worker) x (number of workers) of them in flight. Finished samples are reduced and their slots refilled with the next ones as results arrive, so memory does not grow with the size of the set.
+   * @param sampleCount Number of samples in the set
+   * @param prepare Function that configures the sample with the given index (from 0 to sampleCount-1) before it starts
+   * @param reduce Function that processes the finished sample with the given index. It is called once per sample, in order of completion.
+   */
+  void mapSamples(const size_t sampleCount, const std::function<void(size_t, Sample &)> &prepare, const std::function<void(size_t, Sample &)> &reduce);
+
   /**
    * @brief Prints solver information before the execution of the current generation.
    */
@@ -19,6 +19,8 @@ Sample::Sample()
 {
   _self = this;
   _state = SampleState::uninitialized;
+  _sampleThread = NULL;
+  _sampleStack = NULL;
 }
 
 void Sample::run(size_t functionPosition)
@@ -68,6 +70,97 @@ Sample::~Sample()
   _js.getJson().clear();
 }
 
+bool SampleBuffers::empty() const
+{
+  return _double.empty() && _float.empty();
+}
+
+void SampleBuffers::clear()
+{
+  _double.clear();
+  _float.clear();
+}
+
+void SampleBuffers::swap(SampleBuffers &other)
+{
+  _double.swap(other._double);
+  _float.swap(other._float);
+}
+
+knlohmann::json SampleBuffers::getHeader() const
+{
+  auto header = knlohmann::json::array();
+
+  for (const auto &b : _double)
+  {
+    knlohmann::json entry;
+    entry["Name"] = b.first;
+    entry["Type"] = "double";
+    entry["Size"] = b.second.size();
+    header.push_back(entry);
+  }
+
+  for (const auto &b : _float)
+  {
+    knlohmann::json entry;
+    entry["Name"] = b.first;
+    entry["Type"] = "float";
+    entry["Size"] = b.second.size();
+    header.push_back(entry);
+  }
+
+  return header;
+}
+
+void SampleBuffers::allocate(const knlohmann::json &header)
+{
+  clear();
+
+  for (const auto &entry : header)
+  {
+    const std::string name = entry["Name"].get<std::string>();
+    const size_t size = entry["Size"].get<size_t>();
+
+    if (entry["Type"] == "double")
+      _double[name].resize(size);
+    else if (entry["Type"] == "float")
+      _float[name].resize(size);
+    else
+      KORALI_LOG_ERROR("Unrecognized type '%s' for sample buffer '%s'.\n", entry["Type"].dump().c_str(), name.c_str());
+  }
+}
+
+std::vector<double> &Sample::doubleBuffer(const std::string &key) { return _self->_buffers._double[key]; }
+std::vector<float> &Sample::floatBuffer(const std::string &key) { return _self->_buffers._float[key]; }
+
+pybind11::array_t<double> Sample::getDoubleBuffer(const std::string &key)
+{
+  if (_self->_buffers._double.count(key) == 0) KORALI_LOG_ERROR("Requesting non existing double buffer '%s' from sample.\n", key.c_str());
+  auto &buffer = _self->_buffers._double[key];
+
+  // The no-op capsule makes numpy reference the buffer's memory instead of copying it
+  return pybind11::array_t<double>(buffer.size(), buffer.data(), pybind11::capsule(buffer.data(), [](void *) {}));
+}
+
+void Sample::setDoubleBuffer(const std::string &key, const pybind11::array_t<double, pybind11::array::c_style | pybind11::array::forcecast> &val)
+{
+  _self->_buffers._double[key].assign(val.data(), val.data() + val.size());
+}
+
+pybind11::array_t<float> Sample::getFloatBuffer(const std::string &key)
+{
+  if (_self->_buffers._float.count(key) == 0) KORALI_LOG_ERROR("Requesting non existing float buffer '%s' from sample.\n", key.c_str());
+  auto &buffer = _self->_buffers._float[key];
+
+  // The no-op capsule makes numpy reference the buffer's memory instead of copying it
+  return pybind11::array_t<float>(buffer.size(), buffer.data(), pybind11::capsule(buffer.data(), [](void *) {}));
+}
+
+void Sample::setFloatBuffer(const std::string &key, const pybind11::array_t<float, pybind11::array::c_style | pybind11::array::forcecast> &val)
+{
+  _self->_buffers._float[key].assign(val.data(), val.data() + val.size());
+}
+
 bool Sample::contains(const std::string &key) { return _self->_js.contains(key); }
 knlohmann::json &Sample::operator[](const std::string &key) { return _self->_js[key]; }
 knlohmann::json &Sample::operator[](const unsigned long int &key) { return _self->_js[key]; }
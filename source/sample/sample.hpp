@@ -8,8 +8,11 @@
 #include "auxiliar/libco/libco.h"
 #include "auxiliar/logger.hpp"
 #include "auxiliar/py2json.hpp"
+#include <map>
+#include <pybind11/numpy.h>
 #include <queue>
 #include <string>
+#include <vector>
 
 #undef _POSIX_C_SOURCE
 #undef _XOPEN_SOURCE
@@ -49,6 +52,64 @@ enum class SampleState
   finished = 5
 };
 
+/**
+* \class SampleBuffers
+* @brief Named contiguous numerical buffers attached to a sample. Conduits ship them as raw bytes next to the sample's JSON, bypassing its serialization.
+*/
+class SampleBuffers
+{
+  public:
+  /**
+  * @brief Double precision buffers, indexed by name.
+  */
+  std::map<std::string, std::vector<double>> _double;
+
+  /**
+  * @brief Single precision buffers, indexed by name.
+  */
+  std::map<std::string, std::vector<float>> _float;
+
+  /**
+  * @brief Checks whether there are no buffers stored.
+  * @return True, if there are no buffers; false, otherwise.
+  */
+  bool empty() const;
+
+  /**
+  * @brief Removes all buffers.
+  */
+  void clear();
+
+  /**
+  * @brief Exchanges the contents with another buffer set. Only pointers are swapped, no data is copied.
+  * @param other The buffer set to exchange contents with.
+  */
+  void swap(SampleBuffers &other);
+
+  /**
+  * @brief Produces a small JSON description (name, type, and size) of the stored buffers, in the order in which their bytes are transferred.
+  * @return The JSON description of the buffers.
+  */
+  knlohmann::json getHeader() const;
+
+  /**
+  * @brief Replaces the stored buffers with uninitialized ones, with names and sizes given by a header.
+  * @param header A JSON description produced by getHeader()
+  */
+  void allocate(const knlohmann::json &header);
+
+  /**
+  * @brief Applies a function to the (pointer, size in bytes) pair of every buffer, in the order given by getHeader().
+  * @param f Function to apply
+  */
+  template <typename F>
+  void forEachBuffer(F &&f)
+  {
+    for (auto &b : _double) f((void *)b.second.data(), b.second.size() * sizeof(double));
+    for (auto &b : _float) f((void *)b.second.data(), b.second.size() * sizeof(float));
+  }
+};
+
 /**
 * \class Sample
 * @brief Contains input/output data to computational models.
@@ -78,6 +139,11 @@ class Sample
   */
   cothread_t _sampleThread;
 
+  /**
+  * @brief Stack (taken from the conduit's pool) the sample's coroutine runs on.
+  */
+  void *_sampleStack;
+
   /**
   * @brief User-Level thread (coroutine) containing the CPU execution state of the calling worker.
   */
@@ -94,9 +160,9 @@ class Sample
   KoraliJson _js;
 
   /**
-   * @brief Container for sending big raw data
+   * @brief Named numerical buffers that travel along with the sample as raw bytes, instead of being encoded in its JSON.
    */
-  std::vector<std::vector<float>> _rawData;
+  SampleBuffers _buffers;
 
   /**
   * @brief Constructs Sample. Stores its own pointer, sets ID to zero, state as uninitialized, and isAllocated to false.
@@ -162,6 +228,48 @@ class Sample
   */
   void setItem(const pybind11::object key, const pybind11::object val);
 
+  /**
+  * @brief Accesses (and creates, if not existing) a named double precision buffer.
+  * @param key Name of the buffer.
+  * @return Reference to the buffer.
+  */
+  std::vector<double> &doubleBuffer(const std::string &key);
+
+  /**
+  * @brief Accesses (and creates, if not existing) a named single precision buffer.
+  * @param key Name of the buffer.
+  * @return Reference to the buffer.
+  */
+  std::vector<float> &floatBuffer(const std::string &key);
+
+  /**
+  * @brief Gets a numpy view (no copy) of a named double precision buffer. The view is valid while the sample is alive and the buffer is not resized.
+  * @param key Name of the buffer.
+  * @return Numpy array referencing the buffer's memory.
+  */
+  pybind11::array_t<double> getDoubleBuffer(const std::string &key);
+
+  /**
+  * @brief Sets the contents of a named double precision buffer from a numpy array.
+  * @param key Name of the buffer.
+  * @param val Array with the values to store.
+  */
+  void setDoubleBuffer(const std::string &key, const pybind11::array_t<double, pybind11::array::c_style | pybind11::array::forcecast> &val);
+
+  /**
+  * @brief Gets a numpy view (no copy) of a named single precision buffer. The view is valid while the sample is alive and the buffer is not resized.
+  * @param key Name of the buffer.
+  * @return Numpy array referencing the buffer's memory.
+  */
+  pybind11::array_t<float> getFloatBuffer(const std::string &key);
+
+  /**
+  * @brief Sets the contents of a named single precision buffer from a numpy array.
+  * @param key Name of the buffer.
+  * @param val Array with the values to store.
+  */
+  void setFloatBuffer(const std::string &key, const pybind11::array_t<float, pybind11::array::c_style | pybind11::array::forcecast> &val);
+
   /**
   * @brief Gets and dequeues a pending message, if exists.
   * @param message The message (json object) to overwrite, if a message exists.
@@ -51,3 +51,33 @@ k = korali.Engine()
 k.run(e)
 
 checkEvals(e, 10)
+
+# Testing the search in several generations, keeping the top samples
+values = np.linspace(-10, 10, 1000).tolist()
+
+e = korali.Experiment()
+e["Problem"]["Type"] = "Optimization"
+e["Problem"]["Objective Function"] = evalmodel
+
+e["Variables"][0]["Name"] = "X"
+e["Variables"][0]["Values"] = values
+
+e["Solver"]["Type"] = "Optimizer/GridSearch"
+e["Solver"]["Evaluations Per Generation"] = 100
+e["Solver"]["Top Sample Count"] = 5
+e["Solver"]["Objective Storage"] = "Memory"
+e["Solver"]["Termination Criteria"]["Max Generations"] = 20
+
+e["Console Output"]["Verbosity"] = "Detailed"
+e["File Output"]["Enabled"] = False
+
+k = korali.Engine()
+k.run(e)
+
+checkMin(e, 0.23246, 1e-2)
+checkEvals(e, 1000)
+
+topValues = [s["F(x)"] for s in e["Results"]["Top Samples"]]
+assert len(topValues) == 5, "Expected 5 top samples, got {0}".format(len(topValues))
+assert topValues == sorted(topValues, reverse=True), "Top samples are not sorted"
+assert np.isclose(topValues[0], e["Solver"]["Best Ever Value"])
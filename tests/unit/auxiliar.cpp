@@ -1,6 +1,12 @@
 #include "gtest/gtest.h"
 #include "korali.hpp"
+#include "auxiliar/cbor.hpp"
+#include "auxiliar/libco/copool.h"
 #include "auxiliar/jsonInterface.hpp"
+#include "auxiliar/resultWriter.hpp"
+#include "auxiliar/shmRing.hpp"
+#include <chrono>
+#include <thread>
 
 namespace
 {
@@ -32,4 +38,172 @@ namespace
   ASSERT_NO_THROW(safeLogMinus(2.0, 1.0));
  }
 
+ TEST(Auxiliar, ResultWriter)
+ {
+  resultWriter writer;
+  knlohmann::json js;
+
+  // Writing snapshots in the background, and checking the last one is on disk after flushing
+  for (size_t i = 0; i < 4; i++)
+  {
+   js["Generation"] = i;
+   ASSERT_NO_THROW(writer.write("_resultWriterTest.json", "_resultWriterLatest", knlohmann::json(js), false));
+  }
+  ASSERT_NO_THROW(writer.flush());
+
+  knlohmann::json readJs;
+  ASSERT_TRUE(loadJsonFromFile(readJs, "_resultWriterLatest"));
+  ASSERT_EQ(readJs["Generation"].get<size_t>(), 3);
+  remove("_resultWriterTest.json");
+  remove("_resultWriterLatest");
+
+  // Errors from the background thread are reported to the caller
+  ASSERT_NO_THROW(writer.write("_nonExistentPath/_resultWriterTest.json", "", knlohmann::json(js), false));
+  ASSERT_ANY_THROW(writer.flush());
+  ASSERT_NE(resultWriter::writeFile("_nonExistentPath/_resultWriterTest.json", "", js, false), "");
+ }
+
+ TEST(Auxiliar, Cbor)
+ {
+  knlohmann::json js;
+  js["String"] = "Value";
+  js["Negative"] = -5;
+  js["Large"] = 1ul << 40;
+  js["Boolean"] = true;
+  js["Null"] = nullptr;
+  js["Double"] = 0.1;
+  js["Short Array"] = std::vector<double>({0.5, 1.5});
+  js["Long Array"] = std::vector<double>(100, 0.123456789012345);
+  js["Mixed Array"] = std::vector<knlohmann::json>(20, "Text");
+  js["Matrix"] = std::vector<std::vector<double>>(3, std::vector<double>(20, -2.25));
+
+  // Encoding and decoding must preserve every value
+  std::string data = dumpCbor(js);
+  ASSERT_TRUE(isCbor(data[0]));
+  ASSERT_FALSE(isCbor('{'));
+  ASSERT_EQ(parseCbor((const uint8_t *)data.data(), data.size()), js);
+
+  // Long floating point arrays are stored as raw blocks, smaller than their text representation
+  ASSERT_LT(data.size(), js.dump().size());
+
+  // Truncated documents are reported
+  ASSERT_ANY_THROW(parseCbor((const uint8_t *)data.data(), data.size() / 2));
+
+  // Binary result files are detected when loading
+  ASSERT_EQ(resultWriter::writeFile("_cborTest.cbor", "", js, true), "");
+  knlohmann::json readJs;
+  ASSERT_TRUE(loadJsonFromFile(readJs, "_cborTest.cbor"));
+  ASSERT_EQ(readJs, js);
+  remove("_cborTest.cbor");
+ }
+
+ cothread_t _poolTestCaller;
+ size_t _poolTestRunCount;
+
+ void poolTestEntry()
+ {
+  while (true)
+  {
+   _poolTestRunCount++;
+   co_switch(_poolTestCaller);
+  }
+ }
+
+ TEST(Auxiliar, CoPool)
+ {
+  // Stacks beyond what a cothread can take are refused
+  ASSERT_EQ(co_pool_create((size_t)1 << 40), (co_pool *)NULL);
+
+  co_pool *pool = co_pool_create(65536);
+  ASSERT_NE(pool, (co_pool *)NULL);
+  _poolTestCaller = co_active();
+  _poolTestRunCount = 0;
+
+  // Running two cothreads at once, on different stacks
+  void *stackA = NULL;
+  void *stackB = NULL;
+  cothread_t threadA = co_pool_acquire(pool, poolTestEntry, &stackA);
+  cothread_t threadB = co_pool_acquire(pool, poolTestEntry, &stackB);
+  ASSERT_NE(threadA, (cothread_t)NULL);
+  ASSERT_NE(threadB, (cothread_t)NULL);
+  ASSERT_NE(stackA, (void *)NULL);
+  ASSERT_NE(stackA, stackB);
+
+  co_switch(threadA);
+  co_switch(threadB);
+  co_switch(threadA);
+  ASSERT_EQ(_poolTestRunCount, 3u);
+
+  // A released stack is reused by the next cothread, most recently released first
+  co_pool_release(pool, stackA);
+  co_pool_release(pool, stackB);
+  void *stackC = NULL;
+  cothread_t threadC = co_pool_acquire(pool, poolTestEntry, &stackC);
+  ASSERT_EQ(stackC, stackB);
+  co_switch(threadC);
+  ASSERT_EQ(_poolTestRunCount, 4u);
+
+  void *stackD = NULL;
+  co_pool_acquire(pool, poolTestEntry, &stackD);
+  ASSERT_EQ(stackD, stackA);
+
+  // Once the free stacks are used up, a new one is mapped
+  void *stackE = NULL;
+  cothread_t threadE = co_pool_acquire(pool, poolTestEntry, &stackE);
+  ASSERT_NE(stackE, stackA);
+  ASSERT_NE(stackE, stackB);
+  co_switch(threadE);
+  ASSERT_EQ(_poolTestRunCount, 5u);
+
+  co_pool_destroy(pool);
+ }
+
+ TEST(Auxiliar, ShmRing)
+ {
+  shmRing ring;
+  ASSERT_NO_THROW(ring.create(60));
+  ASSERT_TRUE(ring.empty());
+
+  // A stream much longer than the (rounded up) capacity of 64 bytes wraps around the ring many times
+  const size_t count = 4096;
+  std::vector<uint32_t> input(count);
+  for (size_t i = 0; i < count; i++) input[i] = (uint32_t)(i * 2654435761u);
+
+  // The consumer starts late, so that the producer fills the ring and sleeps on the space doorbell
+  std::vector<uint32_t> output(count);
+  std::thread consumer([&]() {
+   std::this_thread::sleep_for(std::chrono::milliseconds(50));
+   for (size_t i = 0; i < count; i += 7) ring.read(&output[i], std::min((size_t)7, count - i) * sizeof(uint32_t));
+  });
+
+  for (size_t i = 0; i < count; i += 5) ring.write(&input[i], std::min((size_t)5, count - i) * sizeof(uint32_t));
+  consumer.join();
+  ASSERT_EQ(output, input);
+  ASSERT_TRUE(ring.empty());
+
+  // The producer starts late, so that the consumer finds the ring empty and sleeps on the data doorbell
+  uint64_t value = 0;
+  std::thread producer([&]() {
+   std::this_thread::sleep_for(std::chrono::milliseconds(50));
+   uint64_t message = 42;
+   ring.write(&message, sizeof(uint64_t));
+  });
+
+  ring.read(&value, sizeof(uint64_t));
+  producer.join();
+  ASSERT_EQ(value, 42u);
+
+  // Sleeping outside of read() is only allowed while the ring is empty
+  ASSERT_TRUE(ring.announceSleep());
+  ring.withdrawSleep();
+  value = 7;
+  ring.write(&value, sizeof(uint64_t));
+  ASSERT_FALSE(ring.announceSleep());
+  ring.withdrawSleep();
+  ring.read(&value, sizeof(uint64_t));
+  ASSERT_EQ(value, 7u);
+
+  ring.destroy();
+ }
+
 } // namespace
@@ -3,6 +3,7 @@
 #include "modules/conduit/distributed/distributed.hpp"
 #include "modules/conduit/concurrent/concurrent.hpp"
 #include "modules/conduit/sequential/sequential.hpp"
+#include <unistd.h>
 
 namespace korali { namespace conduit {
 extern void _workerWrapper();
@@ -65,7 +66,90 @@ namespace
   _workerWrapper();
  }
 
- TEST(Conduit, ConcurrentConduit)
+/**
+ * @brief Objective of the conduit runs, with a maximum at x = 10. It also returns a payload much larger than a small shared memory ring.
+ */
+ void conduitTestModel(Sample &s)
+ {
+  auto x = s["Parameters"][0].get<double>();
+  s["F(x)"] = -(x - 10.0) * (x - 10.0);
+  s["Payload"] = std::vector<double>(512, x);
+ }
+
+ /**
+ * @brief Slow version of the conduit test objective, so that the engine runs out of messages and blocks while waiting
+ */
+ void conduitTestSlowModel(Sample &s)
+ {
+  usleep(2000);
+  conduitTestModel(s);
+ }
+
+ /**
+ * @brief Vectorized version of the conduit test objective, evaluating a whole batch of samples in one call
+ */
+ void conduitTestVectorizedModel(Sample &s)
+ {
+  auto x = s["Parameters"].get<std::vector<std::vector<double>>>();
+  std::vector<double> f(x.size());
+  for (size_t i = 0; i < x.size(); i++) f[i] = -(x[i][0] - 10.0) * (x[i][0] - 10.0);
+  s["F(x)"] = f;
+ }
+
+ /**
+ * @brief Test fixture providing valid conduit configurations, and a grid search to run them with
+ */
+ class ConduitTest : public ::testing::Test
+ {
+  protected:
+  /**
+  * @brief Returns a valid configuration for a type of conduit, with all its defaults applied
+  */
+  knlohmann::json getDefaultConduitJs(const std::string &type)
+  {
+   knlohmann::json conduitJs;
+   conduitJs["Type"] = type;
+   auto conduit = Module::getModule(conduitJs, NULL);
+   conduit->applyModuleDefaults(conduitJs);
+   delete conduit;
+   return conduitJs;
+  }
+
+  /**
+  * @brief Runs a grid search over the given number of points with the given conduit, and checks that every result reached its own grid point
+  */
+  void runGridSearch(const knlohmann::json &conduitJs, const size_t pointCount, const std::function<void(Sample &)> &model = conduitTestModel, const bool isVectorized = false)
+  {
+   std::vector<double> values(pointCount);
+   for (size_t i = 0; i < pointCount; i++) values[i] = (double)i;
+
+   Experiment e;
+   e["Problem"]["Type"] = "Optimization";
+   e["Problem"]["Objective Function"] = model;
+   e["Problem"]["Vectorized Model"] = isVectorized;
+   e["Variables"][0]["Name"] = "X";
+   e["Variables"][0]["Values"] = values;
+   e["Solver"]["Type"] = "Optimizer/GridSearch";
+   e["Solver"]["Top Sample Count"] = pointCount;
+   e["File Output"]["Enabled"] = false;
+   e["Console Output"]["Verbosity"] = "Silent";
+
+   Engine k;
+   k["Conduit"] = conduitJs;
+   ASSERT_NO_THROW(k.run(e));
+
+   auto topSamples = e["Results"]["Top Samples"];
+   ASSERT_EQ(topSamples.size(), pointCount);
+   for (auto &sample : topSamples)
+   {
+    auto x = sample["Parameters"][0].get<double>();
+    ASSERT_EQ(x, values[sample["Grid Index"].get<size_t>()]);
+    ASSERT_EQ(sample["F(x)"].get<double>(), -(x - 10.0) * (x - 10.0));
+   }
+  }
+ };
+
+ TEST_F(ConduitTest, ConcurrentConduit)
  {
   knlohmann::json conduitJs;
   conduitJs["Type"] = "Concurrent";
@@ -80,19 +164,105 @@ namespace
   // Defaults should be applied without a problem
   ASSERT_NO_THROW(conduit->applyModuleDefaults(conduitJs));
 
+  // Covering variable functions (no effect)
+  ASSERT_NO_THROW(conduit->applyVariableDefaults());
+
+  // Testing correct configuration
+  auto baseConduitJs = getDefaultConduitJs("Concurrent");
+  conduitJs = baseConduitJs;
+  conduitJs["Concurrent Jobs"] = 16;
+  ASSERT_NO_THROW(conduit->setConfiguration(conduitJs));
+
   // Testing wrong value type (string) for the concurrent jobs parameter
+  conduitJs = baseConduitJs;
   conduitJs["Concurrent Jobs"] = "16";
   ASSERT_ANY_THROW(conduit->setConfiguration(conduitJs));
 
-  // Covering variable functions (no effect)
-  ASSERT_NO_THROW(conduit->applyVariableDefaults());
+  // Testing unrecognized transport
+  conduitJs = baseConduitJs;
+  conduitJs["Transport"] = "Carrier Pigeon";
+  ASSERT_ANY_THROW(conduit->setConfiguration(conduitJs));
 
-  // Testing correct configuration value type
-  conduitJs["Concurrent Jobs"] = 16;
+  // Testing shared memory transport
+  conduitJs = baseConduitJs;
+  conduitJs["Transport"] = "Shared Memory";
+  ASSERT_NO_THROW(conduit->setConfiguration(conduitJs));
+
+  // Testing unrecognized wait policy
+  conduitJs = baseConduitJs;
+  conduitJs["Wait Policy"] = "Sleep Forever";
+  ASSERT_ANY_THROW(conduit->setConfiguration(conduitJs));
+
+  // Testing spin then block wait policy
+  conduitJs = baseConduitJs;
+  conduitJs["Wait Policy"] = "Spin Then Block";
+  ASSERT_NO_THROW(conduit->setConfiguration(conduitJs));
+
+  // Testing wrong value type (string) for the stack size
+  conduitJs = baseConduitJs;
+  conduitJs["Stack Size"] = "1M";
+  ASSERT_ANY_THROW(conduit->setConfiguration(conduitJs));
+
+  // Testing wrong value type (string) for the batch size
+  conduitJs = baseConduitJs;
+  conduitJs["Batch Size"] = "8";
+  ASSERT_ANY_THROW(conduit->setConfiguration(conduitJs));
+
+  // Testing batched sample distribution
+  conduitJs = baseConduitJs;
+  conduitJs["Batch Size"] = 8;
   ASSERT_NO_THROW(conduit->setConfiguration(conduitJs));
  }
 
- TEST(Conduit, DistributedConduit)
+ TEST_F(ConduitTest, ConcurrentSharedMemoryRing)
+ {
+  // Messages much larger than the ring wrap around it many times, in both directions
+  auto conduitJs = getDefaultConduitJs("Concurrent");
+  conduitJs["Concurrent Jobs"] = 4;
+  conduitJs["Transport"] = "Shared Memory";
+  conduitJs["Ring Size"] = 64;
+  runGridSearch(conduitJs, 64);
+ }
+
+ TEST_F(ConduitTest, ConcurrentSpinThenBlock)
+ {
+  // The engine blocks after a single idle pass, on the result pipes and on the shared memory doorbells
+  auto conduitJs = getDefaultConduitJs("Concurrent");
+  conduitJs["Concurrent Jobs"] = 4;
+  conduitJs["Wait Policy"] = "Spin Then Block";
+  conduitJs["Spin Count"] = 1;
+  runGridSearch(conduitJs, 32, conduitTestSlowModel);
+
+  conduitJs["Transport"] = "Shared Memory";
+  runGridSearch(conduitJs, 32, conduitTestSlowModel);
+ }
+
+ TEST_F(ConduitTest, StackPoolReuse)
+ {
+  // Many more samples than stacks in flight, so that every pooled stack is released and reused many times
+  auto conduitJs = getDefaultConduitJs("Sequential");
+  conduitJs["Stack Size"] = 65536;
+  runGridSearch(conduitJs, 256);
+
+  conduitJs = getDefaultConduitJs("Concurrent");
+  conduitJs["Concurrent Jobs"] = 2;
+  conduitJs["Stack Size"] = 65536;
+  runGridSearch(conduitJs, 256);
+ }
+
+ TEST_F(ConduitTest, VectorizedBatches)
+ {
+  // The workers receive batches of samples and evaluate each batch with a single model call
+  auto conduitJs = getDefaultConduitJs("Concurrent");
+  conduitJs["Concurrent Jobs"] = 2;
+  conduitJs["Batch Size"] = 4;
+  runGridSearch(conduitJs, 64, conduitTestVectorizedModel, true);
+
+  // Partial batches are sent as well, when the grid does not divide into full batches
+  runGridSearch(conduitJs, 37, conduitTestVectorizedModel, true);
+ }
+
+ TEST_F(ConduitTest, DistributedConduit)
  {
   knlohmann::json conduitJs;
   conduitJs["Type"] = "Distributed";
@@ -107,16 +277,46 @@ namespace
   // Defaults should be applied without a problem
   ASSERT_NO_THROW(conduit->applyModuleDefaults(conduitJs));
 
-  // Testing wrong value type (string) for the concurrent jobs parameter
-  conduitJs["Ranks Per Worker"] = "16";
-  ASSERT_ANY_THROW(conduit->setConfiguration(conduitJs));
-
   // Covering variable functions (no effect)
   ASSERT_NO_THROW(conduit->applyVariableDefaults());
 
-  // Testing correct configuration value type
+  // Testing correct configuration
+  auto baseConduitJs = getDefaultConduitJs("Distributed");
+  conduitJs = baseConduitJs;
   conduitJs["Ranks Per Worker"] = 16;
   ASSERT_NO_THROW(conduit->setConfiguration(conduitJs));
+
+  // Testing wrong value type (string) for the ranks per worker
+  conduitJs = baseConduitJs;
+  conduitJs["Ranks Per Worker"] = "16";
+  ASSERT_ANY_THROW(conduit->setConfiguration(conduitJs));
+
+  // Testing unrecognized wait policy
+  conduitJs = baseConduitJs;
+  conduitJs["Wait Policy"] = "Sleep Forever";
+  ASSERT_ANY_THROW(conduit->setConfiguration(conduitJs));
+
+  // Testing spin then block wait policy
+  conduitJs = baseConduitJs;
+  conduitJs["Wait Policy"] = "Spin Then Block";
+  ASSERT_NO_THROW(conduit->setConfiguration(conduitJs));
+
+  // Testing unrecognized scheduling
+  conduitJs = baseConduitJs;
+  conduitJs["Engine Ranks"] = 4;
+  conduitJs["Scheduling"] = "Random";
+  ASSERT_ANY_THROW(conduit->setConfiguration(conduitJs));
+
+  // Testing wrong value type for the prefetch depth
+  conduitJs = baseConduitJs;
+  conduitJs["Prefetch Depth"] = "2";
+  ASSERT_ANY_THROW(conduit->setConfiguration(conduitJs));
+
+  // Testing hierarchical scheduling
+  conduitJs = baseConduitJs;
+  conduitJs["Engine Ranks"] = 4;
+  conduitJs["Scheduling"] = "Hierarchical";
+  ASSERT_NO_THROW(conduit->setConfiguration(conduitJs));
  }
 
 } // namespace
@@ -247,6 +247,41 @@ namespace
   expJs.erase("Variables");
   ASSERT_NO_THROW(e->setConfiguration(expJs));
 
+  expJs = backJs;
+  ASSERT_NO_THROW(e = dynamic_cast<Experiment *>(Module::getModule(expJs, NULL)));
+  expJs["File Output"].erase("Asynchronous");
+  e->initialize();
+  expJs.erase("Variables");
+  ASSERT_ANY_THROW(e->setConfiguration(expJs));
+
+  expJs = backJs;
+  ASSERT_NO_THROW(e = dynamic_cast<Experiment *>(Module::getModule(expJs, NULL)));
+  expJs["File Output"]["Asynchronous"] = "Not a Number";
+  e->initialize();
+  expJs.erase("Variables");
+  ASSERT_ANY_THROW(e->setConfiguration(expJs));
+
+  expJs = backJs;
+  ASSERT_NO_THROW(e = dynamic_cast<Experiment *>(Module::getModule(expJs, NULL)));
+  expJs["File Output"]["Asynchronous"] = true;
+  e->initialize();
+  expJs.erase("Variables");
+  ASSERT_NO_THROW(e->setConfiguration(expJs));
+
+  expJs = backJs;
+  ASSERT_NO_THROW(e = dynamic_cast<Experiment *>(Module::getModule(expJs, NULL)));
+  expJs["File Output"]["Format"] = "XML";
+  e->initialize();
+  expJs.erase("Variables");
+  ASSERT_ANY_THROW(e->setConfiguration(expJs));
+
+  expJs = backJs;
+  ASSERT_NO_THROW(e = dynamic_cast<Experiment *>(Module::getModule(expJs, NULL)));
+  expJs["File Output"]["Format"] = "Binary";
+  e->initialize();
+  expJs.erase("Variables");
+  ASSERT_NO_THROW(e->setConfiguration(expJs));
+
   expJs = backJs;
   ASSERT_NO_THROW(e = dynamic_cast<Experiment *>(Module::getModule(expJs, NULL)));
   expJs.erase("Store Sample Information");
@@ -135,6 +135,57 @@ namespace
 
   ASSERT_ANY_THROW(pObj->evaluateMultiple(s));
 
+  // Evaluating a batch of samples with a vectorized objective function
+  modelFc = [](Sample& s)
+  {
+   auto x = s["Parameters"].get<std::vector<std::vector<double>>>();
+   std::vector<double> f;
+   for (size_t i = 0; i < x.size(); i++) f.push_back(-x[i][0] * x[i][0]);
+   s["F(x)"] = f;
+  };
+
+  Sample s0, s1;
+  s0["Sample Id"] = 0;
+  s0["Parameters"] = std::vector<double>({0.5});
+  s1["Sample Id"] = 1;
+  s1["Parameters"] = std::vector<double>({2.0});
+  std::vector<Sample *> batch({&s0, &s1});
+
+  pObj->_vectorizedModel = false;
+  ASSERT_FALSE(pObj->runBatchOperation("Evaluate", batch));
+
+  pObj->_vectorizedModel = true;
+  ASSERT_FALSE(pObj->runBatchOperation("Evaluate Constraints", batch));
+  ASSERT_TRUE(pObj->runBatchOperation("Evaluate", batch));
+  ASSERT_EQ(s0["F(x)"].get<double>(), -0.25);
+  ASSERT_EQ(s1["F(x)"].get<double>(), -4.0);
+
+  // A single sample is evaluated as a batch of one
+  ASSERT_NO_THROW(pObj->evaluate(s0));
+  ASSERT_EQ(s0["F(x)"].get<double>(), -0.25);
+
+  // Results already present in the samples are overwritten by the model
+  modelFc = [](Sample& s)
+  {
+   auto x = s["Parameters"].get<std::vector<std::vector<double>>>();
+   std::vector<double> f;
+   for (size_t i = 0; i < x.size(); i++) f.push_back(x[i][0]);
+   s["F(x)"] = f;
+  };
+
+  ASSERT_TRUE(pObj->runBatchOperation("Evaluate", batch));
+  ASSERT_EQ(s0["F(x)"].get<double>(), 0.5);
+  ASSERT_EQ(s1["F(x)"].get<double>(), 2.0);
+
+  // Vectorized results must contain one entry per sample
+  modelFc = [](Sample& s)
+  {
+   s["F(x)"] = 1.0;
+  };
+
+  ASSERT_ANY_THROW(pObj->runBatchOperation("Evaluate", batch));
+  pObj->_vectorizedModel = false;
+
   // Testing optional parameters
   problemJs = baseOptJs;
   experimentJs = baseExpJs;
@@ -161,6 +212,16 @@ namespace
   problemJs["Num Objectives"] = 1;
   ASSERT_NO_THROW(pObj->setConfiguration(problemJs));
 
+  problemJs = baseOptJs;
+  experimentJs = baseExpJs;
+  problemJs["Vectorized Model"] = "Not a Number";
+  ASSERT_ANY_THROW(pObj->setConfiguration(problemJs));
+
+  problemJs = baseOptJs;
+  experimentJs = baseExpJs;
+  problemJs["Vectorized Model"] = true;
+  ASSERT_NO_THROW(pObj->setConfiguration(problemJs));
+
   problemJs = baseOptJs;
   experimentJs = baseExpJs;
   problemJs.erase("Objective Function");
@@ -1288,6 +1349,58 @@ namespace
   problemJs["Likelihood Model"] = "Normal";
   ASSERT_NO_THROW(pObj->setConfiguration(problemJs));
 
+  problemJs = baseProbJs;
+  experimentJs = baseExpJs;
+  problemJs["Vectorized Model"] = "Not a Number";
+  ASSERT_ANY_THROW(pObj->setConfiguration(problemJs));
+
+  problemJs = baseProbJs;
+  experimentJs = baseExpJs;
+  problemJs["Vectorized Model"] = true;
+  ASSERT_NO_THROW(pObj->setConfiguration(problemJs));
+
+  // Evaluating a batch of samples with a vectorized computational model
+  size_t modelBatchSize = 0;
+  modelFc = [&modelBatchSize](Sample& s)
+  {
+   auto x = s["Parameters"].get<std::vector<std::vector<double>>>();
+   modelBatchSize = x.size();
+   std::vector<std::vector<double>> refEvals, sdev;
+   for (size_t i = 0; i < x.size(); i++) refEvals.push_back({x[i][0]});
+   for (size_t i = 0; i < x.size(); i++) sdev.push_back({0.1});
+   s["Reference Evaluations"] = refEvals;
+   s["Standard Deviation"] = sdev;
+  };
+
+  _functionVector.clear();
+  _functionVector.push_back(&modelFc);
+
+  Sample s0, s1, s2;
+  s0["Sample Id"] = 0;
+  s0["Parameters"] = std::vector<double>({0.5});
+  s1["Sample Id"] = 1;
+  s1["Parameters"] = std::vector<double>({2.0});
+  s2["Sample Id"] = 2;
+  s2["Parameters"] = std::vector<double>({0.1});
+  std::vector<Sample *> batch({&s0, &s1, &s2});
+
+  ASSERT_FALSE(pObj->runBatchOperation("Evaluate Gradient", batch));
+  ASSERT_TRUE(pObj->runBatchOperation("Evaluate logPosterior", batch));
+
+  // The sample outside of the prior support is not passed to the model
+  ASSERT_EQ(modelBatchSize, 2);
+  ASSERT_EQ(s1["logPosterior"].get<double>(), -std::numeric_limits<double>::infinity());
+  ASSERT_GT(s2["logPosterior"].get<double>(), s0["logPosterior"].get<double>());
+
+  // All samples are passed to the model when only evaluating the likelihood
+  ASSERT_TRUE(pObj->runBatchOperation("Evaluate logLikelihood", batch));
+  ASSERT_EQ(modelBatchSize, 3);
+
+  // A single sample is evaluated as a batch of one
+  ASSERT_NO_THROW(pObj->runOperation("Evaluate", s0));
+  ASSERT_EQ(modelBatchSize, 1);
+  pObj->_vectorizedModel = false;
+
   pObj->_likelihoodModel = "Positive Normal";
   e._variables.push_back(&v);
   pObj->_referenceData = std::vector<double>({0.5, 0.05});
@@ -2,6 +2,8 @@
 #include "korali.hpp"
 #include "modules/solver/executor/executor.hpp"
 #include "modules/problem/propagation/propagation.hpp"
+#include <cmath>
+#include <unistd.h>
 
 namespace
 {
@@ -63,7 +65,89 @@ namespace
    experimentJs = baseExpJs;
    executorJs["Executions Per Generation"] = 1;
    ASSERT_NO_THROW(exec->setConfiguration(executorJs));
+
+   executorJs = baseOptJs;
+   experimentJs = baseExpJs;
+   executorJs["Samples In Flight Per Worker"] = "Not a Number";
+   ASSERT_ANY_THROW(exec->setConfiguration(executorJs));
+
+   executorJs = baseOptJs;
+   experimentJs = baseExpJs;
+   executorJs["Samples In Flight Per Worker"] = 16;
+   ASSERT_NO_THROW(exec->setConfiguration(executorJs));
   }
 
 
+ // Runs longer for lower x, so that concurrent samples finish in reverse order
+ void mapTestObjective(Sample &s)
+ {
+  auto x = s["Parameters"][0].get<double>();
+  usleep((useconds_t)((32.0 - x) * 500));
+  s["F(x)"] = -(x - 10.0) * (x - 10.0);
+ }
+
+ void mapTestIntegrand(Sample &s)
+ {
+  auto x = s["Parameters"][0].get<double>();
+  s["Evaluation"] = x * x;
+ }
+
+  TEST(samplers, mapSamplesOrder)
+  {
+   std::vector<double> values(32);
+   for (size_t i = 0; i < values.size(); i++) values[i] = (double)i;
+
+   // Results that finish out of order must still be reduced with the index of their own sample
+   Experiment e;
+   e["Problem"]["Type"] = "Optimization";
+   e["Problem"]["Objective Function"] = &mapTestObjective;
+   e["Variables"][0]["Name"] = "X";
+   e["Variables"][0]["Values"] = values;
+   e["Solver"]["Type"] = "Optimizer/GridSearch";
+   e["Solver"]["Top Sample Count"] = values.size();
+   e["Solver"]["Samples In Flight Per Worker"] = 2;
+   e["File Output"]["Enabled"] = false;
+   e["Console Output"]["Verbosity"] = "Silent";
+
+   Engine k;
+   k["Conduit"]["Type"] = "Concurrent";
+   k["Conduit"]["Concurrent Jobs"] = 4;
+   ASSERT_NO_THROW(k.run(e));
+
+   auto topSamples = e["Results"]["Top Samples"];
+   ASSERT_EQ(topSamples.size(), values.size());
+   for (auto &sample : topSamples)
+   {
+    auto x = sample["Parameters"][0].get<double>();
+    ASSERT_EQ(x, values[sample["Grid Index"].get<size_t>()]);
+    ASSERT_EQ(sample["F(x)"].get<double>(), -(x - 10.0) * (x - 10.0));
+   }
+   ASSERT_EQ(e["Results"]["Best Sample"]["Parameters"][0].get<double>(), 10.0);
+
+   // The integrator keeps the grid points in evaluation order
+   Experiment ie;
+   ie["Problem"]["Type"] = "Integration";
+   ie["Problem"]["Integrand"] = &mapTestIntegrand;
+   ie["Variables"][0]["Name"] = "X";
+   ie["Variables"][0]["Lower Bound"] = 0.0;
+   ie["Variables"][0]["Upper Bound"] = 1.0;
+   ie["Variables"][0]["Number Of Gridpoints"] = 11;
+   ie["Solver"]["Type"] = "Integrator/Quadrature";
+   ie["Solver"]["Method"] = "Simpson";
+   ie["Solver"]["Executions Per Generation"] = 11;
+   ie["Solver"]["Samples In Flight Per Worker"] = 1;
+   ie["File Output"]["Enabled"] = false;
+   ie["Console Output"]["Verbosity"] = "Silent";
+
+   Engine ik;
+   ik["Conduit"]["Type"] = "Concurrent";
+   ik["Conduit"]["Concurrent Jobs"] = 4;
+   ASSERT_NO_THROW(ik.run(ie));
+
+   auto gridPoints = ie["Solver"]["Grid Points"].get<std::vector<std::vector<float>>>();
+   ASSERT_EQ(gridPoints.size(), 11u);
+   for (size_t i = 0; i < gridPoints.size(); i++) ASSERT_NEAR(gridPoints[i][0], 0.1 * i, 1e-6);
+   ASSERT_NEAR(ie["Results"]["Integral"].get<double>(), 1.0 / 3.0, 1e-6);
+  }
+
 } // namespace
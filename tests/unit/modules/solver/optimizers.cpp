@@ -4,11 +4,15 @@
 #include "modules/solver/optimizer/AdaBelief/AdaBelief.hpp"
 #include "modules/solver/optimizer/DEA/DEA.hpp"
 #include "modules/solver/optimizer/CMAES/CMAES.hpp"
+#include "modules/solver/optimizer/LMCMAES/LMCMAES.hpp"
 #include "modules/solver/optimizer/MOCMAES/MOCMAES.hpp"
 #include "modules/solver/optimizer/MADGRAD/MADGRAD.hpp"
 #include "modules/solver/optimizer/Rprop/Rprop.hpp"
+#include "modules/solver/optimizer/VDCMAES/VDCMAES.hpp"
 #include "modules/solver/optimizer/gridSearch/gridSearch.hpp"
 #include "modules/problem/optimization/optimization.hpp"
+#include <Eigen/Dense>
+#include <numeric>
 
 namespace
 {
@@ -275,6 +279,49 @@ namespace
   v._initialValue = 1.0;
   ASSERT_NO_THROW(opt->setInitialConfiguration());
 
+  // Testing multiple starts, drawn within the variable bounds
+  v._lowerBound = 0.0;
+  v._upperBound = 1.0;
+  optimizerJs = baseOptJs;
+  experimentJs = baseExpJs;
+  optimizerJs["Number Of Starts"] = 4;
+  ASSERT_NO_THROW(opt->setConfiguration(optimizerJs));
+  ASSERT_NO_THROW(opt->setInitialConfiguration());
+
+  // Testing multiple starts without bounds nor initial standard deviation fail
+  v._upperBound = std::numeric_limits<double>::infinity();
+  v._initialStandardDeviation = std::numeric_limits<double>::quiet_NaN();
+  ASSERT_ANY_THROW(opt->setInitialConfiguration());
+
+  // Testing multiple starts around the initial value
+  v._initialStandardDeviation = 0.1;
+  ASSERT_NO_THROW(opt->setInitialConfiguration());
+
+  // Testing the stored state of a start survives a round trip through the results
+  knlohmann::json startStateJs;
+  knlohmann::json restoredStartStateJs;
+  ASSERT_NO_THROW(opt->getStartState(1, startStateJs));
+  ASSERT_NO_THROW(opt->setStartState(1, startStateJs));
+  opt->getStartState(1, restoredStartStateJs);
+  ASSERT_EQ(startStateJs, restoredStartStateJs);
+
+  // Testing zero starts fail
+  optimizerJs = baseOptJs;
+  experimentJs = baseExpJs;
+  optimizerJs["Number Of Starts"] = 0;
+  ASSERT_NO_THROW(opt->setConfiguration(optimizerJs));
+  ASSERT_ANY_THROW(opt->setInitialConfiguration());
+
+  // Testing wrong number of starts type fail
+  optimizerJs = baseOptJs;
+  experimentJs = baseExpJs;
+  optimizerJs["Number Of Starts"] = "Four";
+  ASSERT_ANY_THROW(opt->setConfiguration(optimizerJs));
+
+  optimizerJs = baseOptJs;
+  experimentJs = baseExpJs;
+  ASSERT_NO_THROW(opt->setConfiguration(optimizerJs));
+
   // Testing optional parameters
   optimizerJs = baseOptJs;
   experimentJs = baseExpJs;
@@ -500,6 +547,49 @@ namespace
   v._initialValue = 1.0;
   ASSERT_NO_THROW(opt->setInitialConfiguration());
 
+  // Testing multiple starts, drawn within the variable bounds
+  v._lowerBound = 0.0;
+  v._upperBound = 1.0;
+  optimizerJs = baseOptJs;
+  experimentJs = baseExpJs;
+  optimizerJs["Number Of Starts"] = 4;
+  ASSERT_NO_THROW(opt->setConfiguration(optimizerJs));
+  ASSERT_NO_THROW(opt->setInitialConfiguration());
+
+  // Testing multiple starts without bounds nor initial standard deviation fail
+  v._upperBound = std::numeric_limits<double>::infinity();
+  v._initialStandardDeviation = std::numeric_limits<double>::quiet_NaN();
+  ASSERT_ANY_THROW(opt->setInitialConfiguration());
+
+  // Testing multiple starts around the initial value
+  v._initialStandardDeviation = 0.1;
+  ASSERT_NO_THROW(opt->setInitialConfiguration());
+
+  // Testing the stored state of a start survives a round trip through the results
+  knlohmann::json startStateJs;
+  knlohmann::json restoredStartStateJs;
+  ASSERT_NO_THROW(opt->getStartState(1, startStateJs));
+  ASSERT_NO_THROW(opt->setStartState(1, startStateJs));
+  opt->getStartState(1, restoredStartStateJs);
+  ASSERT_EQ(startStateJs, restoredStartStateJs);
+
+  // Testing zero starts fail
+  optimizerJs = baseOptJs;
+  experimentJs = baseExpJs;
+  optimizerJs["Number Of Starts"] = 0;
+  ASSERT_NO_THROW(opt->setConfiguration(optimizerJs));
+  ASSERT_ANY_THROW(opt->setInitialConfiguration());
+
+  // Testing wrong number of starts type fail
+  optimizerJs = baseOptJs;
+  experimentJs = baseExpJs;
+  optimizerJs["Number Of Starts"] = "Four";
+  ASSERT_ANY_THROW(opt->setConfiguration(optimizerJs));
+
+  optimizerJs = baseOptJs;
+  experimentJs = baseExpJs;
+  ASSERT_NO_THROW(opt->setConfiguration(optimizerJs));
+
   // Testing optional parameters
   optimizerJs = baseOptJs;
   experimentJs = baseExpJs;
@@ -756,6 +846,38 @@ namespace
   opt->_covarianceMatrixAdaptionStrength   = 0.5;
   ASSERT_NO_THROW(opt->setInitialConfiguration());
 
+  opt->_restartPopulationIncreaseFactor = 0.5;
+  ASSERT_ANY_THROW(opt->setInitialConfiguration());
+  opt->_restartPopulationIncreaseFactor = 2.0;
+  ASSERT_NO_THROW(opt->setInitialConfiguration());
+
+  opt->_asynchronousAgeDecay = 0.0;
+  ASSERT_ANY_THROW(opt->setInitialConfiguration());
+  opt->_asynchronousAgeDecay = 2.0;
+  ASSERT_ANY_THROW(opt->setInitialConfiguration());
+  opt->_asynchronousAgeDecay = 0.5;
+  ASSERT_NO_THROW(opt->setInitialConfiguration());
+
+  opt->_evaluationMode = "Asynchronous";
+  ASSERT_ANY_THROW(opt->setInitialConfiguration());
+  opt->_evaluationMode = "Generational";
+  ASSERT_NO_THROW(opt->setInitialConfiguration());
+
+  opt->_surrogateModel = "Linear Quadratic";
+  ASSERT_NO_THROW(opt->setInitialConfiguration());
+  opt->_surrogateRankAgreementThreshold = 1.5;
+  ASSERT_ANY_THROW(opt->setInitialConfiguration());
+  opt->_surrogateRankAgreementThreshold = 0.85;
+  opt->_useGradientInformation = true;
+  ASSERT_ANY_THROW(opt->setInitialConfiguration());
+  opt->_useGradientInformation = false;
+  opt->_surrogateModel = "None";
+  ASSERT_NO_THROW(opt->setInitialConfiguration());
+
+  // Testing the rank correlation of the surrogate
+  ASSERT_DOUBLE_EQ(opt->getKendallTau({ 1.0, 2.0, 3.0 }, { 0.1, 0.2, 0.3 }), 1.0);
+  ASSERT_DOUBLE_EQ(opt->getKendallTau({ 1.0, 2.0, 3.0 }, { 0.3, 0.2, 0.1 }), -1.0);
+
   // Testing optional parameters
   optimizerJs = baseOptJs;
   experimentJs = baseExpJs;
@@ -1685,414 +1807,1068 @@ namespace
 
   optimizerJs = baseOptJs;
   experimentJs = baseExpJs;
-  optimizerJs["Termination Criteria"]["Max Infeasible Resamplings"] = 1;
+  optimizerJs["Restart Strategy"] = "BIPOP";
   ASSERT_NO_THROW(opt->setConfiguration(optimizerJs));
 
   optimizerJs = baseOptJs;
   experimentJs = baseExpJs;
-  optimizerJs["Termination Criteria"].erase("Max Infeasible Resamplings");
-  ASSERT_ANY_THROW(opt->setConfiguration(optimizerJs));
-
-  optimizerJs = baseOptJs;
-  experimentJs = baseExpJs;
-  optimizerJs["Termination Criteria"]["Max Infeasible Resamplings"] = std::vector<double>({1.0});
+  optimizerJs.erase("Restart Strategy");
   ASSERT_ANY_THROW(opt->setConfiguration(optimizerJs));
 
   optimizerJs = baseOptJs;
   experimentJs = baseExpJs;
-  optimizerJs["Termination Criteria"]["Max Condition Covariance Matrix"] = 1.0;
-  ASSERT_NO_THROW(opt->setConfiguration(optimizerJs));
-
-  optimizerJs = baseOptJs;
-  experimentJs = baseExpJs;
-  optimizerJs["Termination Criteria"].erase("Max Condition Covariance Matrix");
+  optimizerJs["Restart Strategy"] = "Not a Strategy";
   ASSERT_ANY_THROW(opt->setConfiguration(optimizerJs));
 
   optimizerJs = baseOptJs;
   experimentJs = baseExpJs;
-  optimizerJs["Termination Criteria"]["Max Condition Covariance Matrix"] = std::vector<double>({1.0});
+  optimizerJs["Restart Strategy"] = 1.0;
   ASSERT_ANY_THROW(opt->setConfiguration(optimizerJs));
 
   optimizerJs = baseOptJs;
   experimentJs = baseExpJs;
-  optimizerJs["Termination Criteria"]["Min Standard Deviation"] = 1.0;
+  optimizerJs["Restart Population Increase Factor"] = 2.0;
   ASSERT_NO_THROW(opt->setConfiguration(optimizerJs));
 
   optimizerJs = baseOptJs;
   experimentJs = baseExpJs;
-  optimizerJs["Termination Criteria"].erase("Min Standard Deviation");
+  optimizerJs.erase("Restart Population Increase Factor");
   ASSERT_ANY_THROW(opt->setConfiguration(optimizerJs));
 
   optimizerJs = baseOptJs;
   experimentJs = baseExpJs;
-  optimizerJs["Termination Criteria"]["Min Standard Deviation"] = std::vector<double>({1.0});
+  optimizerJs["Restart Population Increase Factor"] = std::vector<double>({1.0});
   ASSERT_ANY_THROW(opt->setConfiguration(optimizerJs));
 
   optimizerJs = baseOptJs;
   experimentJs = baseExpJs;
-  optimizerJs["Termination Criteria"]["Max Standard Deviation"] = 1.0;
+  optimizerJs["Max Restarts"] = 1;
   ASSERT_NO_THROW(opt->setConfiguration(optimizerJs));
 
   optimizerJs = baseOptJs;
   experimentJs = baseExpJs;
-  optimizerJs["Termination Criteria"].erase("Max Standard Deviation");
+  optimizerJs.erase("Max Restarts");
   ASSERT_ANY_THROW(opt->setConfiguration(optimizerJs));
 
   optimizerJs = baseOptJs;
   experimentJs = baseExpJs;
-  optimizerJs["Termination Criteria"]["Max Standard Deviation"] = std::vector<double>({1.0});
-  ASSERT_ANY_THROW(opt->setConfiguration(optimizerJs));
- 
-  optimizerJs = baseOptJs;
-  experimentJs = baseExpJs;
-  e["Variables"][0].erase("Granularity");
+  optimizerJs["Max Restarts"] = std::vector<double>({1.0});
   ASSERT_ANY_THROW(opt->setConfiguration(optimizerJs));
 
   optimizerJs = baseOptJs;
   experimentJs = baseExpJs;
-  e["Variables"][0]["Granularity"] = "Not a Number";
-  ASSERT_ANY_THROW(opt->setConfiguration(optimizerJs));
+  optimizerJs["Restart Count"] = 1;
+  ASSERT_NO_THROW(opt->setConfiguration(optimizerJs));
 
   optimizerJs = baseOptJs;
   experimentJs = baseExpJs;
-  e["Variables"][0]["Granularity"] = 1.0;
-  ASSERT_NO_THROW(opt->setConfiguration(optimizerJs));
-
-  // Testing changes in cumulative covariance
-  opt->_initialCumulativeCovariance = -1.0;
-  ASSERT_NO_THROW(opt->initMuWeights(4));
-  ASSERT_NE(opt->_initialCumulativeCovariance, opt->_cumulativeCovariance);
-
-  opt->_initialCumulativeCovariance = 0.5;
-  ASSERT_NO_THROW(opt->initMuWeights(4));
-  ASSERT_EQ(opt->_initialCumulativeCovariance, opt->_cumulativeCovariance);
- }
-
- //////////////// DEA ////////////////////////
-
- TEST(optimizers, DEA)
- {
-  // Creating base experiment
-  Experiment e;
-  auto& experimentJs = e._js.getJson();
-
-  // Creating initial variable
-  Variable v;
-  e._variables.push_back(&v);
-  e["Variables"][0]["Name"] = "Var 1";
-  e["Variables"][0]["Lower Bound"] = 0.0;
-  e["Variables"][0]["Upper Bound"] = 1.0;
-
-  // Creating optimizer configuration Json
-  knlohmann::json optimizerJs;
-  optimizerJs["Type"] = "Optimizer/DEA";
-
-  // Creating module
-  DEA* opt;
-  ASSERT_NO_THROW(opt = dynamic_cast<DEA *>(Module::getModule(optimizerJs, &e)));
-
-  // Defaults should be applied without a problem
-  ASSERT_NO_THROW(opt->applyModuleDefaults(optimizerJs));
-
-  // Covering variable functions (no effect)
-  ASSERT_NO_THROW(opt->applyVariableDefaults());
-
-  // Backup the correct base configuration
-  auto baseOptJs = optimizerJs;
-  auto baseExpJs = experimentJs;
-
-  // Setting up optimizer correctly
-  ASSERT_NO_THROW(opt->setConfiguration(optimizerJs));
-
-  // Testing infinite initial value fail
-  v._lowerBound = 5.0;
-  v._upperBound = -5.0;
-  ASSERT_ANY_THROW(opt->setInitialConfiguration());
-
-  // Testing initial configuration success
-  v._lowerBound = -5.0;
-  v._upperBound = 5.0;
-  ASSERT_NO_THROW(opt->setInitialConfiguration());
+  optimizerJs["Restart Count"] = std::vector<double>({1.0});
+  ASSERT_ANY_THROW(opt->setConfiguration(optimizerJs));
 
-  // Testing optional parameters
   optimizerJs = baseOptJs;
   experimentJs = baseExpJs;
-  optimizerJs["Value Vector"] = std::vector<double>({ 2.0 });
+  optimizerJs["Run Start Generation"] = 1;
   ASSERT_NO_THROW(opt->setConfiguration(optimizerJs));
 
   optimizerJs = baseOptJs;
   experimentJs = baseExpJs;
-  optimizerJs["Value Vector"] = 2.0;
+  optimizerJs["Run Start Generation"] = std::vector<double>({1.0});
   ASSERT_ANY_THROW(opt->setConfiguration(optimizerJs));
 
   optimizerJs = baseOptJs;
   experimentJs = baseExpJs;
-  optimizerJs["Previous Value Vector"] = std::vector<double>({ 2.0 });
+  optimizerJs["Run Start Model Evaluation Count"] = 1;
   ASSERT_NO_THROW(opt->setConfiguration(optimizerJs));
 
   optimizerJs = baseOptJs;
   experimentJs = baseExpJs;
-  optimizerJs["Previous Value Vector"] = 2.0;
+  optimizerJs["Run Start Model Evaluation Count"] = std::vector<double>({1.0});
   ASSERT_ANY_THROW(opt->setConfiguration(optimizerJs));
 
   optimizerJs = baseOptJs;
   experimentJs = baseExpJs;
-  optimizerJs["Sample Population"] = std::vector<std::vector<double>>({{ 2.0 }});
+  optimizerJs["Default Population Size"] = 4;
   ASSERT_NO_THROW(opt->setConfiguration(optimizerJs));
 
   optimizerJs = baseOptJs;
   experimentJs = baseExpJs;
-  optimizerJs["Sample Population"] = 2.0;
+  optimizerJs["Default Population Size"] = std::vector<double>({1.0});
   ASSERT_ANY_THROW(opt->setConfiguration(optimizerJs));
 
   optimizerJs = baseOptJs;
   experimentJs = baseExpJs;
-  optimizerJs["Candidate Population"] = std::vector<std::vector<double>>({{ 2.0 }});
+  optimizerJs["Default Mu Value"] = 2;
   ASSERT_NO_THROW(opt->setConfiguration(optimizerJs));
 
   optimizerJs = baseOptJs;
   experimentJs = baseExpJs;
-  optimizerJs["Candidate Population"] = 2.0;
+  optimizerJs["Default Mu Value"] = std::vector<double>({1.0});
   ASSERT_ANY_THROW(opt->setConfiguration(optimizerJs));
 
   optimizerJs = baseOptJs;
   experimentJs = baseExpJs;
-  optimizerJs["Best Sample Index"] = 2;
+  optimizerJs["Large Population Size"] = 8;
   ASSERT_NO_THROW(opt->setConfiguration(optimizerJs));
 
   optimizerJs = baseOptJs;
   experimentJs = baseExpJs;
-  optimizerJs["Best Sample Index"] = std::vector<std::vector<double>>({{ 2.0 }});
+  optimizerJs["Large Population Size"] = std::vector<double>({1.0});
   ASSERT_ANY_THROW(opt->setConfiguration(optimizerJs));
 
   optimizerJs = baseOptJs;
   experimentJs = baseExpJs;
-  optimizerJs["Previous Best Ever Value"] = 2.0;
+  optimizerJs["Is Small Population Regime"] = 1;
   ASSERT_NO_THROW(opt->setConfiguration(optimizerJs));
 
   optimizerJs = baseOptJs;
   experimentJs = baseExpJs;
-  optimizerJs["Previous Best Ever Value"] = std::vector<std::vector<double>>({{ 2.0 }});
+  optimizerJs["Is Small Population Regime"] = std::vector<double>({1.0});
   ASSERT_ANY_THROW(opt->setConfiguration(optimizerJs));
 
   optimizerJs = baseOptJs;
   experimentJs = baseExpJs;
-  optimizerJs["Current Mean"] = std::vector<double>({ 2.0 });
+  optimizerJs["Large Regime Model Evaluation Count"] = 1;
   ASSERT_NO_THROW(opt->setConfiguration(optimizerJs));
 
   optimizerJs = baseOptJs;
   experimentJs = baseExpJs;
-  optimizerJs["Current Mean"] = 2.0;
+  optimizerJs["Large Regime Model Evaluation Count"] = std::vector<double>({1.0});
   ASSERT_ANY_THROW(opt->setConfiguration(optimizerJs));
 
   optimizerJs = baseOptJs;
   experimentJs = baseExpJs;
-  optimizerJs["Previous Mean"] = std::vector<double>({ 2.0 });
+  optimizerJs["Small Regime Model Evaluation Count"] = 1;
   ASSERT_NO_THROW(opt->setConfiguration(optimizerJs));
 
   optimizerJs = baseOptJs;
   experimentJs = baseExpJs;
-  optimizerJs["Previous Mean"] = 2.0;
+  optimizerJs["Small Regime Model Evaluation Count"] = std::vector<double>({1.0});
   ASSERT_ANY_THROW(opt->setConfiguration(optimizerJs));
 
   optimizerJs = baseOptJs;
   experimentJs = baseExpJs;
-  optimizerJs["Current Best Variables"] = std::vector<double>({ 2.0 });
+  optimizerJs["Evaluation Mode"] = "Asynchronous";
   ASSERT_NO_THROW(opt->setConfiguration(optimizerJs));
 
   optimizerJs = baseOptJs;
   experimentJs = baseExpJs;
-  optimizerJs["Current Best Variables"] = 2.0;
+  optimizerJs.erase("Evaluation Mode");
   ASSERT_ANY_THROW(opt->setConfiguration(optimizerJs));
 
   optimizerJs = baseOptJs;
   experimentJs = baseExpJs;
-  optimizerJs["Max Distances"] = std::vector<double>({ 2.0 });
-  ASSERT_NO_THROW(opt->setConfiguration(optimizerJs));
+  optimizerJs["Evaluation Mode"] = "Not a Mode";
+  ASSERT_ANY_THROW(opt->setConfiguration(optimizerJs));
 
   optimizerJs = baseOptJs;
   experimentJs = baseExpJs;
-  optimizerJs["Max Distances"] = 2.0;
+  optimizerJs["Evaluation Mode"] = 1.0;
   ASSERT_ANY_THROW(opt->setConfiguration(optimizerJs));
 
   optimizerJs = baseOptJs;
   experimentJs = baseExpJs;
-  optimizerJs["Infeasible Sample Count"] = 1;
+  optimizerJs["Asynchronous Quorum"] = 2;
   ASSERT_NO_THROW(opt->setConfiguration(optimizerJs));
 
   optimizerJs = baseOptJs;
   experimentJs = baseExpJs;
-  optimizerJs["Infeasible Sample Count"] = std::vector<double>({ 2.0 });
+  optimizerJs.erase("Asynchronous Quorum");
   ASSERT_ANY_THROW(opt->setConfiguration(optimizerJs));
 
   optimizerJs = baseOptJs;
   experimentJs = baseExpJs;
-  optimizerJs["Current Minimum Step Size"] = 1.0;
-  ASSERT_NO_THROW(opt->setConfiguration(optimizerJs));
-
-  optimizerJs = baseOptJs;
-  experimentJs = baseExpJs;
-  optimizerJs["Current Minimum Step Size"] = std::vector<double>({ 2.0 });
+  optimizerJs["Asynchronous Quorum"] = std::vector<double>({1.0});
   ASSERT_ANY_THROW(opt->setConfiguration(optimizerJs));
 
   optimizerJs = baseOptJs;
   experimentJs = baseExpJs;
-  optimizerJs["Population Size"] = 1;
+  optimizerJs["Asynchronous Age Decay"] = 1.0;
   ASSERT_NO_THROW(opt->setConfiguration(optimizerJs));
 
   optimizerJs = baseOptJs;
   experimentJs = baseExpJs;
-  optimizerJs.erase("Population Size");
+  optimizerJs.erase("Asynchronous Age Decay");
   ASSERT_ANY_THROW(opt->setConfiguration(optimizerJs));
 
   optimizerJs = baseOptJs;
   experimentJs = baseExpJs;
-  optimizerJs["Population Size"] = std::vector<double>({ 2.0 });
+  optimizerJs["Asynchronous Age Decay"] = std::vector<double>({1.0});
   ASSERT_ANY_THROW(opt->setConfiguration(optimizerJs));
 
   optimizerJs = baseOptJs;
   experimentJs = baseExpJs;
-  optimizerJs["Crossover Rate"] = 1.0;
+  optimizerJs["Asynchronous Parameters"] = std::vector<std::vector<double>>({{1.0}, {}});
   ASSERT_NO_THROW(opt->setConfiguration(optimizerJs));
 
   optimizerJs = baseOptJs;
   experimentJs = baseExpJs;
-  optimizerJs.erase("Crossover Rate");
+  optimizerJs["Asynchronous Parameters"] = 1.0;
   ASSERT_ANY_THROW(opt->setConfiguration(optimizerJs));
 
   optimizerJs = baseOptJs;
   experimentJs = baseExpJs;
-  optimizerJs["Crossover Rate"] = std::vector<double>({ 2.0 });
-  ASSERT_ANY_THROW(opt->setConfiguration(optimizerJs));
+  optimizerJs["Surrogate Model"] = "Linear Quadratic";
+  ASSERT_NO_THROW(opt->setConfiguration(optimizerJs));
 
   optimizerJs = baseOptJs;
   experimentJs = baseExpJs;
-  optimizerJs["Mutation Rate"] = 1.0;
-  ASSERT_NO_THROW(opt->setConfiguration(optimizerJs));
+  optimizerJs["Surrogate Model"] = "Gaussian Process";
+  ASSERT_ANY_THROW(opt->setConfiguration(optimizerJs));
 
   optimizerJs = baseOptJs;
   experimentJs = baseExpJs;
-  optimizerJs.erase("Mutation Rate");
+  optimizerJs.erase("Surrogate Rank Agreement Threshold");
   ASSERT_ANY_THROW(opt->setConfiguration(optimizerJs));
 
   optimizerJs = baseOptJs;
   experimentJs = baseExpJs;
-  optimizerJs["Mutation Rate"] = std::vector<double>({ 2.0 });
+  optimizerJs["Surrogate Archive Size"] = std::vector<double>({1.0});
   ASSERT_ANY_THROW(opt->setConfiguration(optimizerJs));
 
   optimizerJs = baseOptJs;
   experimentJs = baseExpJs;
-  optimizerJs["Mutation Rule"] = "Fixed";
+  optimizerJs["Surrogate Archive Values"] = std::vector<double>({1.0});
   ASSERT_NO_THROW(opt->setConfiguration(optimizerJs));
 
   optimizerJs = baseOptJs;
   experimentJs = baseExpJs;
-  optimizerJs.erase("Mutation Rule");
+  optimizerJs["Surrogate Coefficients"] = 1.0;
   ASSERT_ANY_THROW(opt->setConfiguration(optimizerJs));
 
   optimizerJs = baseOptJs;
   experimentJs = baseExpJs;
-  optimizerJs["Mutation Rule"] = 1.0;
-  ASSERT_ANY_THROW(opt->setConfiguration(optimizerJs));
+  optimizerJs["Sample Generations"] = std::vector<size_t>({1, 1});
+  ASSERT_NO_THROW(opt->setConfiguration(optimizerJs));
 
   optimizerJs = baseOptJs;
   experimentJs = baseExpJs;
-  optimizerJs["Parent Selection Rule"] = "Best";
-  ASSERT_NO_THROW(opt->setConfiguration(optimizerJs));
+  optimizerJs["Sample Generations"] = 1.0;
+  ASSERT_ANY_THROW(opt->setConfiguration(optimizerJs));
 
   optimizerJs = baseOptJs;
   experimentJs = baseExpJs;
-  optimizerJs.erase("Parent Selection Rule");
-  ASSERT_ANY_THROW(opt->setConfiguration(optimizerJs));
+  optimizerJs["Candidate Generations"] = std::vector<size_t>({1, 1});
+  ASSERT_NO_THROW(opt->setConfiguration(optimizerJs));
 
   optimizerJs = baseOptJs;
   experimentJs = baseExpJs;
-  optimizerJs["Parent Selection Rule"] = 1.0;
+  optimizerJs["Candidate Generations"] = 1.0;
   ASSERT_ANY_THROW(opt->setConfiguration(optimizerJs));
 
   optimizerJs = baseOptJs;
   experimentJs = baseExpJs;
-  optimizerJs["Accept Rule"] = "Best";
+  optimizerJs["Termination Criteria"]["Max Infeasible Resamplings"] = 1;
   ASSERT_NO_THROW(opt->setConfiguration(optimizerJs));
 
   optimizerJs = baseOptJs;
   experimentJs = baseExpJs;
-  optimizerJs.erase("Accept Rule");
+  optimizerJs["Termination Criteria"].erase("Max Infeasible Resamplings");
   ASSERT_ANY_THROW(opt->setConfiguration(optimizerJs));
 
   optimizerJs = baseOptJs;
   experimentJs = baseExpJs;
-  optimizerJs["Accept Rule"] = 1.0;
+  optimizerJs["Termination Criteria"]["Max Infeasible Resamplings"] = std::vector<double>({1.0});
   ASSERT_ANY_THROW(opt->setConfiguration(optimizerJs));
 
   optimizerJs = baseOptJs;
   experimentJs = baseExpJs;
-  optimizerJs["Fix Infeasible"] = 1;
+  optimizerJs["Termination Criteria"]["Max Condition Covariance Matrix"] = 1.0;
   ASSERT_NO_THROW(opt->setConfiguration(optimizerJs));
 
   optimizerJs = baseOptJs;
   experimentJs = baseExpJs;
-  optimizerJs.erase("Fix Infeasible");
+  optimizerJs["Termination Criteria"].erase("Max Condition Covariance Matrix");
   ASSERT_ANY_THROW(opt->setConfiguration(optimizerJs));
 
   optimizerJs = baseOptJs;
   experimentJs = baseExpJs;
-  optimizerJs["Fix Infeasible"] = "Not a Number";
+  optimizerJs["Termination Criteria"]["Max Condition Covariance Matrix"] = std::vector<double>({1.0});
   ASSERT_ANY_THROW(opt->setConfiguration(optimizerJs));
 
   optimizerJs = baseOptJs;
   experimentJs = baseExpJs;
-  optimizerJs["Termination Criteria"]["Max Infeasible Resamplings"] = 1;
+  optimizerJs["Termination Criteria"]["Min Standard Deviation"] = 1.0;
   ASSERT_NO_THROW(opt->setConfiguration(optimizerJs));
 
   optimizerJs = baseOptJs;
   experimentJs = baseExpJs;
-  optimizerJs["Termination Criteria"].erase("Max Infeasible Resamplings");
+  optimizerJs["Termination Criteria"].erase("Min Standard Deviation");
   ASSERT_ANY_THROW(opt->setConfiguration(optimizerJs));
 
   optimizerJs = baseOptJs;
   experimentJs = baseExpJs;
-  optimizerJs["Termination Criteria"]["Max Infeasible Resamplings"] = "Not a Number";
+  optimizerJs["Termination Criteria"]["Min Standard Deviation"] = std::vector<double>({1.0});
   ASSERT_ANY_THROW(opt->setConfiguration(optimizerJs));
 
   optimizerJs = baseOptJs;
   experimentJs = baseExpJs;
-  optimizerJs["Termination Criteria"]["Min Value"] = 1.0;
+  optimizerJs["Termination Criteria"]["Max Standard Deviation"] = 1.0;
   ASSERT_NO_THROW(opt->setConfiguration(optimizerJs));
 
   optimizerJs = baseOptJs;
   experimentJs = baseExpJs;
-  optimizerJs["Termination Criteria"].erase("Min Value");
+  optimizerJs["Termination Criteria"].erase("Max Standard Deviation");
   ASSERT_ANY_THROW(opt->setConfiguration(optimizerJs));
 
   optimizerJs = baseOptJs;
   experimentJs = baseExpJs;
-  optimizerJs["Termination Criteria"]["Min Value"] = "Not a Number";
+  optimizerJs["Termination Criteria"]["Max Standard Deviation"] = std::vector<double>({1.0});
   ASSERT_ANY_THROW(opt->setConfiguration(optimizerJs));
-
+ 
   optimizerJs = baseOptJs;
   experimentJs = baseExpJs;
-  optimizerJs["Termination Criteria"]["Min Step Size"] = 1.0;
-  ASSERT_NO_THROW(opt->setConfiguration(optimizerJs));
+  e["Variables"][0].erase("Granularity");
+  ASSERT_ANY_THROW(opt->setConfiguration(optimizerJs));
 
   optimizerJs = baseOptJs;
   experimentJs = baseExpJs;
-  optimizerJs["Termination Criteria"].erase("Min Step Size");
+  e["Variables"][0]["Granularity"] = "Not a Number";
   ASSERT_ANY_THROW(opt->setConfiguration(optimizerJs));
 
   optimizerJs = baseOptJs;
   experimentJs = baseExpJs;
-  optimizerJs["Termination Criteria"]["Min Step Size"] = "Not a Number";
-  ASSERT_ANY_THROW(opt->setConfiguration(optimizerJs));
+  e["Variables"][0]["Granularity"] = 1.0;
+  ASSERT_NO_THROW(opt->setConfiguration(optimizerJs));
 
+  // Testing changes in cumulative covariance
+  opt->_initialCumulativeCovariance = -1.0;
+  ASSERT_NO_THROW(opt->initMuWeights(4));
+  ASSERT_NE(opt->_initialCumulativeCovariance, opt->_cumulativeCovariance);
 
-  // Testing termination criteria
-  e._currentGeneration = 2;
-  opt->_infeasibleSampleCount  = 0;
-  opt->_minValue  = 0.0;
-  opt->_minStepSize  = 1.0;
-  opt->_bestEverValue = -1.0;
-  opt->_currentMinimumStepSize  = 2.0;
+  opt->_initialCumulativeCovariance = 0.5;
+  ASSERT_NO_THROW(opt->initMuWeights(4));
+  ASSERT_EQ(opt->_initialCumulativeCovariance, opt->_cumulativeCovariance);
+ }
+
+ //////////////// LMCMAES ////////////////////////
+
+ TEST(optimizers, LMCMAES)
+ {
+  // Creating base experiment
+  Experiment e;
+  auto& experimentJs = e._js.getJson();
+
+  // Creating initial variables
+  Variable v1, v2;
+  e._variables.push_back(&v1);
+  e._variables.push_back(&v2);
+  for (size_t i = 0; i < 2; i++)
+  {
+   e["Variables"][i]["Name"] = "Var " + std::to_string(i);
+   e["Variables"][i]["Lower Bound"] = 0.0;
+   e["Variables"][i]["Upper Bound"] = 1.0;
+  }
+  e["Problem"]["Type"] = "Optimization";
+
+  // Creating optimizer configuration Json
+  knlohmann::json optimizerJs;
+  optimizerJs["Type"] = "Optimizer/LMCMAES";
+  optimizerJs["Population Size"] = 4;
+
+  // Creating module
+  LMCMAES* opt;
+  ASSERT_NO_THROW(opt = dynamic_cast<LMCMAES *>(Module::getModule(optimizerJs, &e)));
+
+  // Defaults should be applied without a problem
+  ASSERT_NO_THROW(opt->applyModuleDefaults(optimizerJs));
+
+  // Covering variable functions (no effect)
+  ASSERT_NO_THROW(opt->applyVariableDefaults());
+
+  // Backup the correct base configuration
+  auto baseOptJs = optimizerJs;
+  auto baseExpJs = experimentJs;
+  ASSERT_NO_THROW(opt->setConfiguration(optimizerJs));
+
+  // Testing initial configuration failures
+  e._variables.pop_back();
+  ASSERT_ANY_THROW(opt->setInitialConfiguration());
+  e._variables.push_back(&v2);
+
+  opt->_diagonalCovariance = true;
+  ASSERT_ANY_THROW(opt->setInitialConfiguration());
+  opt->_diagonalCovariance = false;
+
+  // The dense covariance matrix should not be allocated
+  ASSERT_NO_THROW(opt->setInitialConfiguration());
+  ASSERT_EQ(opt->_memorySize, 6);
+  ASSERT_EQ(opt->_covarianceMatrix.size(), 0);
+  ASSERT_EQ(opt->_activeDirectionCount, 0);
+
+  // Testing that the inverse transformation undoes the sampling transformation
+  opt->_directionVectors[0] = std::vector<double>({1.0, -2.0});
+  opt->_directionVectors[1] = std::vector<double>({0.5, 3.0});
+  opt->_activeDirectionCount = 2;
+
+  std::vector<double> x({0.3, -0.7});
+  ASSERT_NO_THROW(opt->multiplyDirections(x, false));
+  ASSERT_NO_THROW(opt->solveDirections(x));
+  ASSERT_NEAR(x[0], 0.3, 1e-12);
+  ASSERT_NEAR(x[1], -0.7, 1e-12);
+
+  // Testing that whitening the step of a sample recovers its random numbers, also after constraint corrections
+  std::vector<double> rands({0.3, -0.7, 1.1, 0.2, -0.4, 0.9, 0.0, -1.3});
+  ASSERT_NO_THROW(opt->sampleBatch(rands));
+  ASSERT_NO_THROW(opt->applyCovarianceCorrections({{1.0, 1.0}}, {0.1}));
+  ASSERT_EQ(opt->_constraintCorrectionFactors.size(), 1);
+  ASSERT_NO_THROW(opt->sampleSingle(1, std::vector<double>({1.1, 0.2})));
+
+  opt->_meanUpdate = std::vector<double>({opt->_bDZMatrix[2], opt->_bDZMatrix[3]});
+  ASSERT_NO_THROW(opt->whitenMeanUpdate());
+  ASSERT_NEAR(opt->_auxiliarBDZMatrix[0], 1.1, 1e-12);
+  ASSERT_NEAR(opt->_auxiliarBDZMatrix[1], 0.2, 1e-12);
+
+  // Corrections removing all the variance along the normal are rejected
+  ASSERT_NO_THROW(opt->applyCovarianceCorrections({{1.0, 0.0}}, {1e6}));
+  ASSERT_EQ(opt->_constraintCorrectionFactors.size(), 1);
+
+  // Adapting the direction vectors
+  ASSERT_NO_THROW(opt->adaptC(1));
+  ASSERT_EQ(opt->_activeDirectionCount, 3);
+  ASSERT_EQ(opt->_constraintCorrectionFactors.size(), 0);
+  ASSERT_GT(opt->getCovarianceDiagonal(0), 0.0);
+
+  // Testing optional parameters
+  optimizerJs = baseOptJs;
+  experimentJs = baseExpJs;
+  optimizerJs["Memory Size"] = 2;
+  ASSERT_NO_THROW(opt->setConfiguration(optimizerJs));
+
+  optimizerJs = baseOptJs;
+  experimentJs = baseExpJs;
+  optimizerJs["Memory Size"] = "Not a Number";
+  ASSERT_ANY_THROW(opt->setConfiguration(optimizerJs));
+
+  optimizerJs = baseOptJs;
+  experimentJs = baseExpJs;
+  optimizerJs.erase("Memory Size");
+  ASSERT_ANY_THROW(opt->setConfiguration(optimizerJs));
+
+  optimizerJs = baseOptJs;
+  experimentJs = baseExpJs;
+  optimizerJs["Direction Vectors"] = std::vector<std::vector<double>>({{1.0, 0.0}});
+  ASSERT_NO_THROW(opt->setConfiguration(optimizerJs));
+
+  optimizerJs = baseOptJs;
+  experimentJs = baseExpJs;
+  optimizerJs["Direction Vectors"] = 1.0;
+  ASSERT_ANY_THROW(opt->setConfiguration(optimizerJs));
+
+  optimizerJs = baseOptJs;
+  experimentJs = baseExpJs;
+  optimizerJs["Active Direction Count"] = 1;
+  ASSERT_NO_THROW(opt->setConfiguration(optimizerJs));
+
+  optimizerJs = baseOptJs;
+  experimentJs = baseExpJs;
+  optimizerJs["Active Direction Count"] = std::vector<double>({1.0});
+  ASSERT_ANY_THROW(opt->setConfiguration(optimizerJs));
+
+  optimizerJs = baseOptJs;
+  experimentJs = baseExpJs;
+  optimizerJs["Covariance Diagonal Estimate"] = std::vector<double>({1.0, 1.0});
+  ASSERT_NO_THROW(opt->setConfiguration(optimizerJs));
+
+  optimizerJs = baseOptJs;
+  experimentJs = baseExpJs;
+  optimizerJs["Covariance Diagonal Estimate"] = 1.0;
+  ASSERT_ANY_THROW(opt->setConfiguration(optimizerJs));
+
+  optimizerJs = baseOptJs;
+  experimentJs = baseExpJs;
+  optimizerJs["Constraint Correction Directions"] = std::vector<std::vector<double>>({{1.0, 0.0}});
+  ASSERT_NO_THROW(opt->setConfiguration(optimizerJs));
+
+  optimizerJs = baseOptJs;
+  experimentJs = baseExpJs;
+  optimizerJs["Constraint Correction Directions"] = 1.0;
+  ASSERT_ANY_THROW(opt->setConfiguration(optimizerJs));
+
+  optimizerJs = baseOptJs;
+  experimentJs = baseExpJs;
+  optimizerJs["Constraint Correction Factors"] = std::vector<double>({0.5});
+  ASSERT_NO_THROW(opt->setConfiguration(optimizerJs));
+
+  optimizerJs = baseOptJs;
+  experimentJs = baseExpJs;
+  optimizerJs["Constraint Correction Factors"] = 1.0;
+  ASSERT_ANY_THROW(opt->setConfiguration(optimizerJs));
+ }
+
+ //////////////// VDCMAES ////////////////////////
+
+ TEST(optimizers, VDCMAES)
+ {
+  // Creating base experiment
+  Experiment e;
+  auto& experimentJs = e._js.getJson();
+
+  // Creating initial variables
+  Variable v1, v2, v3;
+  e._variables.push_back(&v1);
+  e._variables.push_back(&v2);
+  e._variables.push_back(&v3);
+  for (size_t i = 0; i < 3; i++)
+  {
+   e["Variables"][i]["Name"] = "Var " + std::to_string(i);
+   e["Variables"][i]["Lower Bound"] = 0.0;
+   e["Variables"][i]["Upper Bound"] = 1.0;
+  }
+  e["Problem"]["Type"] = "Optimization";
+
+  // Creating optimizer configuration Json
+  knlohmann::json optimizerJs;
+  optimizerJs["Type"] = "Optimizer/VDCMAES";
+  optimizerJs["Population Size"] = 4;
+
+  // Creating module
+  VDCMAES* opt;
+  ASSERT_NO_THROW(opt = dynamic_cast<VDCMAES *>(Module::getModule(optimizerJs, &e)));
+
+  // Defaults should be applied without a problem
+  ASSERT_NO_THROW(opt->applyModuleDefaults(optimizerJs));
+
+  // Covering variable functions (no effect)
+  ASSERT_NO_THROW(opt->applyVariableDefaults());
+
+  // Backup the correct base configuration
+  auto baseOptJs = optimizerJs;
+  auto baseExpJs = experimentJs;
+  ASSERT_NO_THROW(opt->setConfiguration(optimizerJs));
+
+  // Testing initial configuration failures
+  e._variables.pop_back();
+  ASSERT_ANY_THROW(opt->setInitialConfiguration());
+  e._variables.push_back(&v3);
+
+  opt->_diagonalCovariance = true;
+  ASSERT_ANY_THROW(opt->setInitialConfiguration());
+  opt->_diagonalCovariance = false;
+
+  // The dense covariance matrix should not be allocated, and the initial variance of every variable is kept
+  ASSERT_NO_THROW(opt->setInitialConfiguration());
+  ASSERT_EQ(opt->_covarianceMatrix.size(), 0);
+  for (size_t d = 0; d < 3; d++) ASSERT_NEAR(opt->_sigma * opt->_sigma * opt->getCovarianceDiagonal(d), 0.09, 1e-12);
+
+  // Testing that the whitening transformation undoes the sampling transformation
+  opt->_varianceDirection = std::vector<double>({0.4, -0.9, 0.2});
+  opt->_axisLengths = std::vector<double>({1.0, 0.5, 2.0});
+
+  std::vector<double> x({0.3, -0.7, 1.2});
+  ASSERT_NO_THROW(opt->multiplyVarianceDirection(x, 0.5));
+  ASSERT_NO_THROW(opt->multiplyVarianceDirection(x, -0.5));
+  ASSERT_NEAR(x[0], 0.3, 1e-12);
+  ASSERT_NEAR(x[1], -0.7, 1e-12);
+  ASSERT_NEAR(x[2], 1.2, 1e-12);
+
+  // Testing that whitening the step of a sample recovers its random numbers, also after constraint corrections
+  std::vector<double> rands({0.3, -0.7, 1.1, 0.2, -0.4, 0.9, 0.0, -1.3, 0.5, 0.8, -0.1, 0.6});
+  ASSERT_NO_THROW(opt->sampleBatch(rands));
+  ASSERT_NO_THROW(opt->applyCovarianceCorrections({{1.0, 1.0, 0.0}}, {0.1}));
+  ASSERT_EQ(opt->_constraintCorrectionFactors.size(), 1);
+  ASSERT_NO_THROW(opt->sampleSingle(1, std::vector<double>({0.2, -0.4, 0.9})));
+
+  opt->_meanUpdate = std::vector<double>({opt->_bDZMatrix[3], opt->_bDZMatrix[4], opt->_bDZMatrix[5]});
+  ASSERT_NO_THROW(opt->whitenMeanUpdate());
+  ASSERT_NEAR(opt->_auxiliarBDZMatrix[0], 0.2, 1e-12);
+  ASSERT_NEAR(opt->_auxiliarBDZMatrix[1], -0.4, 1e-12);
+  ASSERT_NEAR(opt->_auxiliarBDZMatrix[2], 0.9, 1e-12);
+
+  // Corrections removing all the variance along the normal are rejected
+  ASSERT_NO_THROW(opt->applyCovarianceCorrections({{1.0, 0.0, 0.0}}, {1e6}));
+  ASSERT_EQ(opt->_constraintCorrectionFactors.size(), 1);
+
+  // Testing the natural gradient against the projection of the update onto the family, solved with dense matrices
+  std::vector<std::vector<double>> steps({{0.5, -1.2, 0.3}, {1.4, 0.2, -0.8}, {-0.6, 0.9, 1.1}});
+  std::vector<double> weights({0.05, 0.2, 0.1});
+  std::vector<double> diagonalGradient, directionGradient;
+  ASSERT_NO_THROW(opt->computeNaturalGradient(steps, weights, 0.3, diagonalGradient, directionGradient));
+
+  Eigen::Vector3d v(0.4, -0.9, 0.2);
+  Eigen::Matrix3d S = Eigen::Matrix3d::Identity() + v * v.transpose();
+  Eigen::Matrix3d Si = S.inverse();
+  Eigen::Matrix3d G = -0.3 * S;
+  for (size_t i = 0; i < steps.size(); i++) G += weights[i] * Eigen::Vector3d(steps[i].data()) * Eigen::Vector3d(steps[i].data()).transpose();
+
+  std::vector<Eigen::Matrix3d> tangents;
+  for (size_t d = 0; d < 3; d++) tangents.push_back(Eigen::Matrix3d(Eigen::Vector3d::Unit(d).asDiagonal()) * S + S * Eigen::Matrix3d(Eigen::Vector3d::Unit(d).asDiagonal()));
+  for (size_t d = 0; d < 3; d++) tangents.push_back(Eigen::Vector3d::Unit(d) * v.transpose() + v * Eigen::Vector3d::Unit(d).transpose());
+
+  Eigen::MatrixXd fisher(6, 6);
+  Eigen::VectorXd gradient(6);
+  for (size_t a = 0; a < 6; a++)
+  {
+   gradient[a] = 0.5 * (Si * tangents[a] * Si * G).trace();
+   for (size_t b = 0; b < 6; b++) fisher(a, b) = 0.5 * (Si * tangents[a] * Si * tangents[b]).trace();
+  }
+  // The Fisher matrix is damped by 0.1 along D, and by 0.1 times its curvature along v
+  for (size_t d = 0; d < 3; d++)
+  {
+   fisher(d, d) += 0.1;
+   fisher(3 + d, 3 + d) += 0.1 * 2.0 * v.squaredNorm() / std::pow(1.0 + v.squaredNorm(), 2);
+  }
+  Eigen::VectorXd naturalGradient = fisher.ldlt().solve(gradient);
+
+  for (size_t d = 0; d < 3; d++)
+  {
+   ASSERT_NEAR(diagonalGradient[d], naturalGradient[d], 1e-9);
+   ASSERT_NEAR(directionGradient[d], naturalGradient[3 + d], 1e-9);
+  }
+
+  // Adapting D and v
+  for (size_t i = 0; i < 4; i++) opt->_sortingIndex[i] = i;
+  opt->_previousMean = opt->_currentMean;
+  ASSERT_NO_THROW(opt->adaptC(1));
+  ASSERT_EQ(opt->_constraintCorrectionFactors.size(), 0);
+  ASSERT_GT(opt->getCovarianceDiagonal(0), 0.0);
+  ASSERT_GE(opt->_maximumDiagonalCovarianceMatrixElement, opt->_minimumDiagonalCovarianceMatrixElement);
+
+  // Testing optional parameters
+  optimizerJs = baseOptJs;
+  experimentJs = baseExpJs;
+  optimizerJs["Variance Direction"] = std::vector<double>({1.0, 0.0, 0.0});
+  ASSERT_NO_THROW(opt->setConfiguration(optimizerJs));
+
+  optimizerJs = baseOptJs;
+  experimentJs = baseExpJs;
+  optimizerJs["Variance Direction"] = 1.0;
+  ASSERT_ANY_THROW(opt->setConfiguration(optimizerJs));
+
+  optimizerJs = baseOptJs;
+  experimentJs = baseExpJs;
+  optimizerJs["Constraint Correction Directions"] = std::vector<std::vector<double>>({{1.0, 0.0, 0.0}});
+  ASSERT_NO_THROW(opt->setConfiguration(optimizerJs));
+
+  optimizerJs = baseOptJs;
+  experimentJs = baseExpJs;
+  optimizerJs["Constraint Correction Directions"] = 1.0;
+  ASSERT_ANY_THROW(opt->setConfiguration(optimizerJs));
+
+  optimizerJs = baseOptJs;
+  experimentJs = baseExpJs;
+  optimizerJs["Constraint Correction Factors"] = std::vector<double>({0.5});
+  ASSERT_NO_THROW(opt->setConfiguration(optimizerJs));
+
+  optimizerJs = baseOptJs;
+  experimentJs = baseExpJs;
+  optimizerJs["Constraint Correction Factors"] = 1.0;
+  ASSERT_ANY_THROW(opt->setConfiguration(optimizerJs));
+ }
+
+ //////////////// DEA ////////////////////////
+
+ TEST(optimizers, DEA)
+ {
+  // Creating base experiment
+  Experiment e;
+  auto& experimentJs = e._js.getJson();
+
+  // Creating initial variable
+  Variable v;
+  e._variables.push_back(&v);
+  e["Variables"][0]["Name"] = "Var 1";
+  e["Variables"][0]["Lower Bound"] = 0.0;
+  e["Variables"][0]["Upper Bound"] = 1.0;
+
+  // Creating optimizer configuration Json
+  knlohmann::json optimizerJs;
+  optimizerJs["Type"] = "Optimizer/DEA";
+
+  // Creating module
+  DEA* opt;
+  ASSERT_NO_THROW(opt = dynamic_cast<DEA *>(Module::getModule(optimizerJs, &e)));
+
+  // Defaults should be applied without a problem
+  ASSERT_NO_THROW(opt->applyModuleDefaults(optimizerJs));
+
+  // Covering variable functions (no effect)
+  ASSERT_NO_THROW(opt->applyVariableDefaults());
+
+  // Backup the correct base configuration
+  auto baseOptJs = optimizerJs;
+  auto baseExpJs = experimentJs;
+
+  // Setting up optimizer correctly
+  ASSERT_NO_THROW(opt->setConfiguration(optimizerJs));
+
+  // Testing infinite initial value fail
+  v._lowerBound = 5.0;
+  v._upperBound = -5.0;
+  ASSERT_ANY_THROW(opt->setInitialConfiguration());
+
+  // Testing initial configuration success
+  v._lowerBound = -5.0;
+  v._upperBound = 5.0;
+  ASSERT_NO_THROW(opt->setInitialConfiguration());
+
+  // The populations of the results hold one sample per row, initialized inside the bounds
+  ASSERT_EQ(opt->_samplePopulation.size(), opt->_populationSize);
+  ASSERT_EQ(opt->_candidatePopulation.size(), opt->_populationSize);
+  for (size_t i = 0; i < opt->_populationSize; i++)
+  {
+    ASSERT_EQ(opt->_samplePopulation[i].size(), 1);
+    ASSERT_GE(opt->_samplePopulation[i][0], -5.0);
+    ASSERT_LE(opt->_samplePopulation[i][0], 5.0);
+  }
+
+  // Testing population too small for the mutation
+  opt->_populationSize = 3;
+  ASSERT_ANY_THROW(opt->setInitialConfiguration());
+  opt->_parentSelectionRule = "Best";
+  ASSERT_NO_THROW(opt->setInitialConfiguration());
+  opt->_populationSize = 2;
+  ASSERT_ANY_THROW(opt->setInitialConfiguration());
+  opt->_populationSize = 200;
+  opt->_parentSelectionRule = "Random";
+
+  // Testing that the asynchronous mode only accepts the greedy rule
+  opt->_evaluationMode = "Asynchronous";
+  opt->_acceptRule = "Greedy";
+  ASSERT_NO_THROW(opt->setInitialConfiguration());
+  opt->_acceptRule = "Best";
+  ASSERT_ANY_THROW(opt->setInitialConfiguration());
+  opt->_acceptRule = "Improved";
+  ASSERT_ANY_THROW(opt->setInitialConfiguration());
+  opt->_acceptRule = "Iterative";
+  ASSERT_ANY_THROW(opt->setInitialConfiguration());
+  opt->_evaluationMode = "Generational";
+  ASSERT_NO_THROW(opt->setInitialConfiguration());
+  opt->_acceptRule = "Greedy";
+
+  // Testing optional parameters
+  optimizerJs = baseOptJs;
+  experimentJs = baseExpJs;
+  optimizerJs["Value Vector"] = std::vector<double>({ 2.0 });
+  ASSERT_NO_THROW(opt->setConfiguration(optimizerJs));
+
+  optimizerJs = baseOptJs;
+  experimentJs = baseExpJs;
+  optimizerJs["Value Vector"] = 2.0;
+  ASSERT_ANY_THROW(opt->setConfiguration(optimizerJs));
+
+  optimizerJs = baseOptJs;
+  experimentJs = baseExpJs;
+  optimizerJs["Previous Value Vector"] = std::vector<double>({ 2.0 });
+  ASSERT_NO_THROW(opt->setConfiguration(optimizerJs));
+
+  optimizerJs = baseOptJs;
+  experimentJs = baseExpJs;
+  optimizerJs["Previous Value Vector"] = 2.0;
+  ASSERT_ANY_THROW(opt->setConfiguration(optimizerJs));
+
+  optimizerJs = baseOptJs;
+  experimentJs = baseExpJs;
+  optimizerJs["Sample Population"] = std::vector<std::vector<double>>({{ 2.0 }});
+  ASSERT_NO_THROW(opt->setConfiguration(optimizerJs));
+
+  optimizerJs = baseOptJs;
+  experimentJs = baseExpJs;
+  optimizerJs["Sample Population"] = 2.0;
+  ASSERT_ANY_THROW(opt->setConfiguration(optimizerJs));
+
+  optimizerJs = baseOptJs;
+  experimentJs = baseExpJs;
+  optimizerJs["Candidate Population"] = std::vector<std::vector<double>>({{ 2.0 }});
+  ASSERT_NO_THROW(opt->setConfiguration(optimizerJs));
+
+  optimizerJs = baseOptJs;
+  experimentJs = baseExpJs;
+  optimizerJs["Candidate Population"] = 2.0;
+  ASSERT_ANY_THROW(opt->setConfiguration(optimizerJs));
+
+  optimizerJs = baseOptJs;
+  experimentJs = baseExpJs;
+  optimizerJs["Best Sample Index"] = 2;
+  ASSERT_NO_THROW(opt->setConfiguration(optimizerJs));
+
+  optimizerJs = baseOptJs;
+  experimentJs = baseExpJs;
+  optimizerJs["Best Sample Index"] = std::vector<std::vector<double>>({{ 2.0 }});
+  ASSERT_ANY_THROW(opt->setConfiguration(optimizerJs));
+
+  optimizerJs = baseOptJs;
+  experimentJs = baseExpJs;
+  optimizerJs["Previous Best Ever Value"] = 2.0;
+  ASSERT_NO_THROW(opt->setConfiguration(optimizerJs));
+
+  optimizerJs = baseOptJs;
+  experimentJs = baseExpJs;
+  optimizerJs["Previous Best Ever Value"] = std::vector<std::vector<double>>({{ 2.0 }});
+  ASSERT_ANY_THROW(opt->setConfiguration(optimizerJs));
+
+  optimizerJs = baseOptJs;
+  experimentJs = baseExpJs;
+  optimizerJs["Current Mean"] = std::vector<double>({ 2.0 });
+  ASSERT_NO_THROW(opt->setConfiguration(optimizerJs));
+
+  optimizerJs = baseOptJs;
+  experimentJs = baseExpJs;
+  optimizerJs["Current Mean"] = 2.0;
+  ASSERT_ANY_THROW(opt->setConfiguration(optimizerJs));
+
+  optimizerJs = baseOptJs;
+  experimentJs = baseExpJs;
+  optimizerJs["Previous Mean"] = std::vector<double>({ 2.0 });
+  ASSERT_NO_THROW(opt->setConfiguration(optimizerJs));
+
+  optimizerJs = baseOptJs;
+  experimentJs = baseExpJs;
+  optimizerJs["Previous Mean"] = 2.0;
+  ASSERT_ANY_THROW(opt->setConfiguration(optimizerJs));
+
+  optimizerJs = baseOptJs;
+  experimentJs = baseExpJs;
+  optimizerJs["Current Best Variables"] = std::vector<double>({ 2.0 });
+  ASSERT_NO_THROW(opt->setConfiguration(optimizerJs));
+
+  optimizerJs = baseOptJs;
+  experimentJs = baseExpJs;
+  optimizerJs["Current Best Variables"] = 2.0;
+  ASSERT_ANY_THROW(opt->setConfiguration(optimizerJs));
+
+  optimizerJs = baseOptJs;
+  experimentJs = baseExpJs;
+  optimizerJs["Max Distances"] = std::vector<double>({ 2.0 });
+  ASSERT_NO_THROW(opt->setConfiguration(optimizerJs));
+
+  optimizerJs = baseOptJs;
+  experimentJs = baseExpJs;
+  optimizerJs["Max Distances"] = 2.0;
+  ASSERT_ANY_THROW(opt->setConfiguration(optimizerJs));
+
+  optimizerJs = baseOptJs;
+  experimentJs = baseExpJs;
+  optimizerJs["Infeasible Sample Count"] = 1;
+  ASSERT_NO_THROW(opt->setConfiguration(optimizerJs));
+
+  optimizerJs = baseOptJs;
+  experimentJs = baseExpJs;
+  optimizerJs["Infeasible Sample Count"] = std::vector<double>({ 2.0 });
+  ASSERT_ANY_THROW(opt->setConfiguration(optimizerJs));
+
+  optimizerJs = baseOptJs;
+  experimentJs = baseExpJs;
+  optimizerJs["Current Minimum Step Size"] = 1.0;
+  ASSERT_NO_THROW(opt->setConfiguration(optimizerJs));
+
+  optimizerJs = baseOptJs;
+  experimentJs = baseExpJs;
+  optimizerJs["Current Minimum Step Size"] = std::vector<double>({ 2.0 });
+  ASSERT_ANY_THROW(opt->setConfiguration(optimizerJs));
+
+  optimizerJs = baseOptJs;
+  experimentJs = baseExpJs;
+  optimizerJs["Population Size"] = 1;
+  ASSERT_NO_THROW(opt->setConfiguration(optimizerJs));
+
+  optimizerJs = baseOptJs;
+  experimentJs = baseExpJs;
+  optimizerJs.erase("Population Size");
+  ASSERT_ANY_THROW(opt->setConfiguration(optimizerJs));
+
+  optimizerJs = baseOptJs;
+  experimentJs = baseExpJs;
+  optimizerJs["Population Size"] = std::vector<double>({ 2.0 });
+  ASSERT_ANY_THROW(opt->setConfiguration(optimizerJs));
+
+  optimizerJs = baseOptJs;
+  experimentJs = baseExpJs;
+  optimizerJs["Crossover Rate"] = 1.0;
+  ASSERT_NO_THROW(opt->setConfiguration(optimizerJs));
+
+  optimizerJs = baseOptJs;
+  experimentJs = baseExpJs;
+  optimizerJs.erase("Crossover Rate");
+  ASSERT_ANY_THROW(opt->setConfiguration(optimizerJs));
+
+  optimizerJs = baseOptJs;
+  experimentJs = baseExpJs;
+  optimizerJs["Crossover Rate"] = std::vector<double>({ 2.0 });
+  ASSERT_ANY_THROW(opt->setConfiguration(optimizerJs));
+
+  optimizerJs = baseOptJs;
+  experimentJs = baseExpJs;
+  optimizerJs["Mutation Rate"] = 1.0;
+  ASSERT_NO_THROW(opt->setConfiguration(optimizerJs));
+
+  optimizerJs = baseOptJs;
+  experimentJs = baseExpJs;
+  optimizerJs.erase("Mutation Rate");
+  ASSERT_ANY_THROW(opt->setConfiguration(optimizerJs));
+
+  optimizerJs = baseOptJs;
+  experimentJs = baseExpJs;
+  optimizerJs["Mutation Rate"] = std::vector<double>({ 2.0 });
+  ASSERT_ANY_THROW(opt->setConfiguration(optimizerJs));
+
+  optimizerJs = baseOptJs;
+  experimentJs = baseExpJs;
+  optimizerJs["Mutation Rule"] = "Fixed";
+  ASSERT_NO_THROW(opt->setConfiguration(optimizerJs));
+
+  optimizerJs = baseOptJs;
+  experimentJs = baseExpJs;
+  optimizerJs.erase("Mutation Rule");
+  ASSERT_ANY_THROW(opt->setConfiguration(optimizerJs));
+
+  optimizerJs = baseOptJs;
+  experimentJs = baseExpJs;
+  optimizerJs["Mutation Rule"] = 1.0;
+  ASSERT_ANY_THROW(opt->setConfiguration(optimizerJs));
+
+  optimizerJs = baseOptJs;
+  experimentJs = baseExpJs;
+  optimizerJs["Parent Selection Rule"] = "Best";
+  ASSERT_NO_THROW(opt->setConfiguration(optimizerJs));
+
+  optimizerJs = baseOptJs;
+  experimentJs = baseExpJs;
+  optimizerJs.erase("Parent Selection Rule");
+  ASSERT_ANY_THROW(opt->setConfiguration(optimizerJs));
+
+  optimizerJs = baseOptJs;
+  experimentJs = baseExpJs;
+  optimizerJs["Parent Selection Rule"] = 1.0;
+  ASSERT_ANY_THROW(opt->setConfiguration(optimizerJs));
+
+  optimizerJs = baseOptJs;
+  experimentJs = baseExpJs;
+  optimizerJs["Accept Rule"] = "Best";
+  ASSERT_NO_THROW(opt->setConfiguration(optimizerJs));
+
+  optimizerJs = baseOptJs;
+  experimentJs = baseExpJs;
+  optimizerJs.erase("Accept Rule");
+  ASSERT_ANY_THROW(opt->setConfiguration(optimizerJs));
+
+  optimizerJs = baseOptJs;
+  experimentJs = baseExpJs;
+  optimizerJs["Accept Rule"] = 1.0;
+  ASSERT_ANY_THROW(opt->setConfiguration(optimizerJs));
+
+  optimizerJs = baseOptJs;
+  experimentJs = baseExpJs;
+  optimizerJs["Fix Infeasible"] = 1;
+  ASSERT_NO_THROW(opt->setConfiguration(optimizerJs));
+
+  optimizerJs = baseOptJs;
+  experimentJs = baseExpJs;
+  optimizerJs.erase("Fix Infeasible");
+  ASSERT_ANY_THROW(opt->setConfiguration(optimizerJs));
+
+  optimizerJs = baseOptJs;
+  experimentJs = baseExpJs;
+  optimizerJs["Fix Infeasible"] = "Not a Number";
+  ASSERT_ANY_THROW(opt->setConfiguration(optimizerJs));
+
+  optimizerJs = baseOptJs;
+  experimentJs = baseExpJs;
+  optimizerJs["Evaluation Mode"] = "Asynchronous";
+  ASSERT_NO_THROW(opt->setConfiguration(optimizerJs));
+
+  optimizerJs = baseOptJs;
+  experimentJs = baseExpJs;
+  optimizerJs.erase("Evaluation Mode");
+  ASSERT_ANY_THROW(opt->setConfiguration(optimizerJs));
+
+  optimizerJs = baseOptJs;
+  experimentJs = baseExpJs;
+  optimizerJs["Evaluation Mode"] = "Not a Mode";
+  ASSERT_ANY_THROW(opt->setConfiguration(optimizerJs));
+
+  optimizerJs = baseOptJs;
+  experimentJs = baseExpJs;
+  optimizerJs["Evaluation Mode"] = 1.0;
+  ASSERT_ANY_THROW(opt->setConfiguration(optimizerJs));
+
+  optimizerJs = baseOptJs;
+  experimentJs = baseExpJs;
+  optimizerJs["Asynchronous Quorum"] = 2;
+  ASSERT_NO_THROW(opt->setConfiguration(optimizerJs));
+
+  optimizerJs = baseOptJs;
+  experimentJs = baseExpJs;
+  optimizerJs.erase("Asynchronous Quorum");
+  ASSERT_ANY_THROW(opt->setConfiguration(optimizerJs));
+
+  optimizerJs = baseOptJs;
+  experimentJs = baseExpJs;
+  optimizerJs["Asynchronous Quorum"] = std::vector<double>({1.0});
+  ASSERT_ANY_THROW(opt->setConfiguration(optimizerJs));
+
+  optimizerJs = baseOptJs;
+  experimentJs = baseExpJs;
+  optimizerJs["Asynchronous Candidate Indexes"] = std::vector<size_t>({0, 2});
+  ASSERT_NO_THROW(opt->setConfiguration(optimizerJs));
+
+  optimizerJs = baseOptJs;
+  experimentJs = baseExpJs;
+  optimizerJs["Asynchronous Candidate Indexes"] = 1.0;
+  ASSERT_ANY_THROW(opt->setConfiguration(optimizerJs));
+
+  optimizerJs = baseOptJs;
+  experimentJs = baseExpJs;
+  optimizerJs["Sample Value Vector"] = std::vector<double>({1.0});
+  ASSERT_NO_THROW(opt->setConfiguration(optimizerJs));
+
+  optimizerJs = baseOptJs;
+  experimentJs = baseExpJs;
+  optimizerJs["Sample Value Vector"] = 1.0;
+  ASSERT_ANY_THROW(opt->setConfiguration(optimizerJs));
+
+  optimizerJs = baseOptJs;
+  experimentJs = baseExpJs;
+  optimizerJs["Termination Criteria"]["Max Infeasible Resamplings"] = 1;
+  ASSERT_NO_THROW(opt->setConfiguration(optimizerJs));
+
+  optimizerJs = baseOptJs;
+  experimentJs = baseExpJs;
+  optimizerJs["Termination Criteria"].erase("Max Infeasible Resamplings");
+  ASSERT_ANY_THROW(opt->setConfiguration(optimizerJs));
+
+  optimizerJs = baseOptJs;
+  experimentJs = baseExpJs;
+  optimizerJs["Termination Criteria"]["Max Infeasible Resamplings"] = "Not a Number";
+  ASSERT_ANY_THROW(opt->setConfiguration(optimizerJs));
+
+  optimizerJs = baseOptJs;
+  experimentJs = baseExpJs;
+  optimizerJs["Termination Criteria"]["Min Value"] = 1.0;
+  ASSERT_NO_THROW(opt->setConfiguration(optimizerJs));
+
+  optimizerJs = baseOptJs;
+  experimentJs = baseExpJs;
+  optimizerJs["Termination Criteria"].erase("Min Value");
+  ASSERT_ANY_THROW(opt->setConfiguration(optimizerJs));
+
+  optimizerJs = baseOptJs;
+  experimentJs = baseExpJs;
+  optimizerJs["Termination Criteria"]["Min Value"] = "Not a Number";
+  ASSERT_ANY_THROW(opt->setConfiguration(optimizerJs));
+
+  optimizerJs = baseOptJs;
+  experimentJs = baseExpJs;
+  optimizerJs["Termination Criteria"]["Min Step Size"] = 1.0;
+  ASSERT_NO_THROW(opt->setConfiguration(optimizerJs));
+
+  optimizerJs = baseOptJs;
+  experimentJs = baseExpJs;
+  optimizerJs["Termination Criteria"].erase("Min Step Size");
+  ASSERT_ANY_THROW(opt->setConfiguration(optimizerJs));
+
+  optimizerJs = baseOptJs;
+  experimentJs = baseExpJs;
+  optimizerJs["Termination Criteria"]["Min Step Size"] = "Not a Number";
+  ASSERT_ANY_THROW(opt->setConfiguration(optimizerJs));
+
+
+  // Testing termination criteria
+  e._currentGeneration = 2;
+  opt->_infeasibleSampleCount  = 0;
+  opt->_minValue  = 0.0;
+  opt->_minStepSize  = 1.0;
+  opt->_bestEverValue = -1.0;
+  opt->_currentMinimumStepSize  = 2.0;
 
   opt->_bestEverValue = -1.0;
   ASSERT_FALSE(opt->checkTermination());
@@ -2109,6 +2885,25 @@ namespace
 
  //////////////// MOCMAES ////////////////////////
 
+ // Hypervolume by inclusion-exclusion over every subset of the points (only for a few points)
+ double getBruteForceHypervolume(const std::vector<std::vector<double>> &points, const std::vector<double> &reference)
+ {
+  double volume = 0.0;
+  for (size_t subset = 1; subset < ((size_t)1 << points.size()); subset++)
+  {
+   double boxVolume = 1.0;
+   for (size_t k = 0; k < reference.size(); k++)
+   {
+    double minValue = std::numeric_limits<double>::infinity();
+    for (size_t i = 0; i < points.size(); i++)
+     if ((subset >> i) & 1) minValue = std::min(minValue, points[i][k]);
+    boxVolume *= std::max(minValue - reference[k], 0.0);
+   }
+   volume += __builtin_popcountl(subset) % 2 == 1 ? boxVolume : -boxVolume;
+  }
+  return volume;
+ }
+
  TEST(optimizers, MOCMAES)
  {
   // Creating base experiment
@@ -2189,6 +2984,50 @@ namespace
   // Testing initial configuration success
   ASSERT_NO_THROW(opt->setInitialConfiguration());
 
+  // Testing non-dominated sorting: fronts first, then hypervolume contributions
+  std::vector<std::vector<double>> values({ { 1.0, 0.0 }, { 0.0, 1.0 }, { 0.9, 0.9 }, { 0.5, 0.5 }, { 0.4, 0.6 }, { 0.2, 0.2 } });
+  std::vector<int> sortedIndices;
+  ASSERT_NO_THROW(sortedIndices = opt->sortSampleIndices(values));
+  ASSERT_EQ(sortedIndices[5], 0);
+  ASSERT_EQ(sortedIndices[2], 5);
+  ASSERT_GT(std::min(sortedIndices[3], sortedIndices[4]), 0);
+  ASSERT_LT(std::max(sortedIndices[3], sortedIndices[4]), std::min(sortedIndices[0], sortedIndices[1]));
+
+  // Testing hypervolume of a staircase
+  ASSERT_DOUBLE_EQ(opt->getHypervolume({ { 1.0, 2.0 }, { 2.0, 1.0 } }, { 0.0, 0.0 }), 3.0);
+  ASSERT_DOUBLE_EQ(opt->getHypervolume({ { 1.0, 1.0, 2.0 }, { 2.0, 1.0, 1.0 }, { 1.0, 2.0, 1.0 } }, { 0.0, 0.0, 0.0 }), 4.0);
+
+  // Testing the order of the contributions in three dimensions, against removing the smallest brute-force contribution every time
+  std::vector<std::vector<double>> front({ { 1.0, 0.2, 0.1 }, { 0.2, 1.0, 0.3 }, { 0.1, 0.3, 1.0 }, { 0.7, 0.6, 0.2 }, { 0.5, 0.5, 0.6 }, { 0.3, 0.8, 0.5 }, { 0.8, 0.1, 0.6 }, { 0.4, 0.2, 0.9 } });
+  std::vector<double> reference(3, 0.0);
+  ASSERT_NEAR(opt->getHypervolume(front, reference), getBruteForceHypervolume(front, reference), 1e-12);
+
+  std::vector<size_t> remaining(front.size());
+  std::iota(remaining.begin(), remaining.end(), 0);
+  std::vector<size_t> expectedOrder;
+  while (remaining.empty() == false)
+  {
+   std::vector<std::vector<double>> points;
+   for (size_t j : remaining) points.push_back(front[j]);
+   const double volume = getBruteForceHypervolume(points, reference);
+
+   std::vector<double> contributions(remaining.size());
+   for (size_t i = 0; i < remaining.size(); i++)
+   {
+    auto others = points;
+    others.erase(others.begin() + i);
+    contributions[i] = volume - getBruteForceHypervolume(others, reference);
+   }
+
+   const size_t minPos = std::min_element(contributions.begin(), contributions.end()) - contributions.begin();
+   expectedOrder.push_back(remaining[minPos]);
+   remaining.erase(remaining.begin() + minPos);
+  }
+
+  opt->_numObjectives = 3;
+  ASSERT_EQ(opt->sortByHypervolumeContribution(front, reference), expectedOrder);
+  opt->_numObjectives = 2;
+
   // Testing optional parameters
   optimizerJs = baseOptJs;
   experimentJs = baseExpJs;
@@ -2776,6 +3615,49 @@ namespace
    v._initialValue = 1.0;
    ASSERT_NO_THROW(opt->setInitialConfiguration());
 
+   // Testing multiple starts, drawn within the variable bounds
+   v._lowerBound = 0.0;
+   v._upperBound = 1.0;
+   optimizerJs = baseOptJs;
+   experimentJs = baseExpJs;
+   optimizerJs["Number Of Starts"] = 4;
+   ASSERT_NO_THROW(opt->setConfiguration(optimizerJs));
+   ASSERT_NO_THROW(opt->setInitialConfiguration());
+
+   // Testing multiple starts without bounds nor initial standard deviation fail
+   v._upperBound = std::numeric_limits<double>::infinity();
+   v._initialStandardDeviation = std::numeric_limits<double>::quiet_NaN();
+   ASSERT_ANY_THROW(opt->setInitialConfiguration());
+
+   // Testing multiple starts around the initial value
+   v._initialStandardDeviation = 0.1;
+   ASSERT_NO_THROW(opt->setInitialConfiguration());
+
+   // Testing the stored state of a start survives a round trip through the results
+   knlohmann::json startStateJs;
+   knlohmann::json restoredStartStateJs;
+   ASSERT_NO_THROW(opt->getStartState(1, startStateJs));
+   ASSERT_NO_THROW(opt->setStartState(1, startStateJs));
+   opt->getStartState(1, restoredStartStateJs);
+   ASSERT_EQ(startStateJs, restoredStartStateJs);
+
+   // Testing zero starts fail
+   optimizerJs = baseOptJs;
+   experimentJs = baseExpJs;
+   optimizerJs["Number Of Starts"] = 0;
+   ASSERT_NO_THROW(opt->setConfiguration(optimizerJs));
+   ASSERT_ANY_THROW(opt->setInitialConfiguration());
+
+   // Testing wrong number of starts type fail
+   optimizerJs = baseOptJs;
+   experimentJs = baseExpJs;
+   optimizerJs["Number Of Starts"] = "Four";
+   ASSERT_ANY_THROW(opt->setConfiguration(optimizerJs));
+
+   optimizerJs = baseOptJs;
+   experimentJs = baseExpJs;
+   ASSERT_NO_THROW(opt->setConfiguration(optimizerJs));
+
    // Testing optional parameters
    optimizerJs = baseOptJs;
    experimentJs = baseExpJs;
@@ -2986,6 +3868,49 @@ namespace
     v._initialValue = 1.0;
     ASSERT_NO_THROW(opt->setInitialConfiguration());
 
+    // Testing multiple starts, drawn within the variable bounds
+    v._lowerBound = 0.0;
+    v._upperBound = 1.0;
+    optimizerJs = baseOptJs;
+    experimentJs = baseExpJs;
+    optimizerJs["Number Of Starts"] = 4;
+    ASSERT_NO_THROW(opt->setConfiguration(optimizerJs));
+    ASSERT_NO_THROW(opt->setInitialConfiguration());
+
+    // Testing multiple starts without bounds nor initial standard deviation fail
+    v._upperBound = std::numeric_limits<double>::infinity();
+    v._initialStandardDeviation = std::numeric_limits<double>::quiet_NaN();
+    ASSERT_ANY_THROW(opt->setInitialConfiguration());
+
+    // Testing multiple starts around the initial value
+    v._initialStandardDeviation = 0.1;
+    ASSERT_NO_THROW(opt->setInitialConfiguration());
+
+    // Testing the stored state of a start survives a round trip through the results
+    knlohmann::json startStateJs;
+    knlohmann::json restoredStartStateJs;
+    ASSERT_NO_THROW(opt->getStartState(1, startStateJs));
+    ASSERT_NO_THROW(opt->setStartState(1, startStateJs));
+    opt->getStartState(1, restoredStartStateJs);
+    ASSERT_EQ(startStateJs, restoredStartStateJs);
+
+    // Testing zero starts fail
+    optimizerJs = baseOptJs;
+    experimentJs = baseExpJs;
+    optimizerJs["Number Of Starts"] = 0;
+    ASSERT_NO_THROW(opt->setConfiguration(optimizerJs));
+    ASSERT_ANY_THROW(opt->setInitialConfiguration());
+
+    // Testing wrong number of starts type fail
+    optimizerJs = baseOptJs;
+    experimentJs = baseExpJs;
+    optimizerJs["Number Of Starts"] = "Four";
+    ASSERT_ANY_THROW(opt->setConfiguration(optimizerJs));
+
+    optimizerJs = baseOptJs;
+    experimentJs = baseExpJs;
+    ASSERT_NO_THROW(opt->setConfiguration(optimizerJs));
+
     // Testing optional parameters
     optimizerJs = baseOptJs;
     experimentJs = baseExpJs;
@@ -3263,7 +4188,101 @@ namespace
     // Testing initial configuration success
     ASSERT_NO_THROW(opt->setInitialConfiguration());
 
+    // Testing top sample count fail
+    opt->_topSampleCount = 0;
+    ASSERT_ANY_THROW(opt->setInitialConfiguration());
+    opt->_topSampleCount = 1;
+
+    // Testing mandatory parameters
+    optimizerJs = baseOptJs;
+    experimentJs = baseExpJs;
+    optimizerJs.erase("Evaluations Per Generation");
+    ASSERT_ANY_THROW(opt->setConfiguration(optimizerJs));
+
+    optimizerJs = baseOptJs;
+    experimentJs = baseExpJs;
+    optimizerJs["Evaluations Per Generation"] = "Not a Number";
+    ASSERT_ANY_THROW(opt->setConfiguration(optimizerJs));
+
+    optimizerJs = baseOptJs;
+    experimentJs = baseExpJs;
+    optimizerJs["Evaluations Per Generation"] = 1000;
+    ASSERT_NO_THROW(opt->setConfiguration(optimizerJs));
+
+    optimizerJs = baseOptJs;
+    experimentJs = baseExpJs;
+    optimizerJs.erase("Top Sample Count");
+    ASSERT_ANY_THROW(opt->setConfiguration(optimizerJs));
+
+    optimizerJs = baseOptJs;
+    experimentJs = baseExpJs;
+    optimizerJs["Top Sample Count"] = "Not a Number";
+    ASSERT_ANY_THROW(opt->setConfiguration(optimizerJs));
+
+    optimizerJs = baseOptJs;
+    experimentJs = baseExpJs;
+    optimizerJs["Top Sample Count"] = 10;
+    ASSERT_NO_THROW(opt->setConfiguration(optimizerJs));
+
+    // The objective of every grid point is kept in memory by default
+    ASSERT_EQ(baseOptJs["Objective Storage"].get<std::string>(), "Memory");
+
+    optimizerJs = baseOptJs;
+    experimentJs = baseExpJs;
+    optimizerJs.erase("Objective Storage");
+    ASSERT_ANY_THROW(opt->setConfiguration(optimizerJs));
+
+    optimizerJs = baseOptJs;
+    experimentJs = baseExpJs;
+    optimizerJs["Objective Storage"] = "Undefined";
+    ASSERT_ANY_THROW(opt->setConfiguration(optimizerJs));
+
+    optimizerJs = baseOptJs;
+    experimentJs = baseExpJs;
+    optimizerJs["Objective Storage"] = "Mapped File";
+    ASSERT_NO_THROW(opt->setConfiguration(optimizerJs));
+
+    optimizerJs = baseOptJs;
+    experimentJs = baseExpJs;
+    optimizerJs.erase("Objective File");
+    ASSERT_ANY_THROW(opt->setConfiguration(optimizerJs));
+
+    optimizerJs = baseOptJs;
+    experimentJs = baseExpJs;
+    optimizerJs["Objective File"] = 1.0;
+    ASSERT_ANY_THROW(opt->setConfiguration(optimizerJs));
+
     // Testing optional parameters
+    optimizerJs = baseOptJs;
+    experimentJs = baseExpJs;
+    optimizerJs["Next Grid Index"] = 1;
+    ASSERT_NO_THROW(opt->setConfiguration(optimizerJs));
+
+    optimizerJs = baseOptJs;
+    experimentJs = baseExpJs;
+    optimizerJs["Next Grid Index"] = "Not a Number";
+    ASSERT_ANY_THROW(opt->setConfiguration(optimizerJs));
+
+    optimizerJs = baseOptJs;
+    experimentJs = baseExpJs;
+    optimizerJs["Top Values"] = std::vector<double>({ 2.0 });
+    ASSERT_NO_THROW(opt->setConfiguration(optimizerJs));
+
+    optimizerJs = baseOptJs;
+    experimentJs = baseExpJs;
+    optimizerJs["Top Values"] = 2.0;
+    ASSERT_ANY_THROW(opt->setConfiguration(optimizerJs));
+
+    optimizerJs = baseOptJs;
+    experimentJs = baseExpJs;
+    optimizerJs["Top Indices"] = std::vector<size_t>({ 2 });
+    ASSERT_NO_THROW(opt->setConfiguration(optimizerJs));
+
+    optimizerJs = baseOptJs;
+    experimentJs = baseExpJs;
+    optimizerJs["Top Indices"] = 2.0;
+    ASSERT_ANY_THROW(opt->setConfiguration(optimizerJs));
+
     optimizerJs = baseOptJs;
     experimentJs = baseExpJs;
     optimizerJs["Number Of Values"] = 1;
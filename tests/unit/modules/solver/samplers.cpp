@@ -7,6 +7,9 @@
 #include "modules/solver/sampler/HMC/HMC.hpp"
 #include "modules/solver/sampler/MCMC/MCMC.hpp"
 #include "modules/solver/sampler/TMCMC/TMCMC.hpp"
+#include <numeric>
+#include <random>
+#include <unistd.h>
 
 namespace
 {
@@ -204,12 +207,12 @@ namespace
 
    samplerJs = baseOptJs;
    experimentJs = baseExpJs;
-   samplerJs["Chain Leader Evaluation"] = "Not a Number";
+   samplerJs["Chain Leaders Evaluations"] = "Not a Number";
    ASSERT_ANY_THROW(sampler->setConfiguration(samplerJs));
 
    samplerJs = baseOptJs;
    experimentJs = baseExpJs;
-   samplerJs["Chain Leader Evaluation"] = 0.0;
+   samplerJs["Chain Leaders Evaluations"] = std::vector<double>({0.0});
    ASSERT_NO_THROW(sampler->setConfiguration(samplerJs));
 
    samplerJs = baseOptJs;
@@ -274,12 +277,32 @@ namespace
 
    samplerJs = baseOptJs;
    experimentJs = baseExpJs;
-   samplerJs["Chain Leader"] = "Not a Number";
+   samplerJs["Chain Leaders"] = "Not a Number";
    ASSERT_ANY_THROW(sampler->setConfiguration(samplerJs));
 
    samplerJs = baseOptJs;
    experimentJs = baseExpJs;
-   samplerJs["Chain Leader"] = std::vector<double>({0.0});
+   samplerJs["Chain Leaders"] = std::vector<std::vector<double>>({{0.0}});
+   ASSERT_NO_THROW(sampler->setConfiguration(samplerJs));
+
+   samplerJs = baseOptJs;
+   experimentJs = baseExpJs;
+   samplerJs["Swap Proposal Count"] = "Not a Number";
+   ASSERT_ANY_THROW(sampler->setConfiguration(samplerJs));
+
+   samplerJs = baseOptJs;
+   experimentJs = baseExpJs;
+   samplerJs["Swap Proposal Count"] = 0;
+   ASSERT_NO_THROW(sampler->setConfiguration(samplerJs));
+
+   samplerJs = baseOptJs;
+   experimentJs = baseExpJs;
+   samplerJs["Swap Acceptance Count"] = "Not a Number";
+   ASSERT_ANY_THROW(sampler->setConfiguration(samplerJs));
+
+   samplerJs = baseOptJs;
+   experimentJs = baseExpJs;
+   samplerJs["Swap Acceptance Count"] = 0;
    ASSERT_NO_THROW(sampler->setConfiguration(samplerJs));
 
    samplerJs = baseOptJs;
@@ -432,6 +455,71 @@ namespace
    samplerJs["Chain Covariance Scaling"] = 1.0;
    ASSERT_NO_THROW(sampler->setConfiguration(samplerJs));
 
+   samplerJs = baseOptJs;
+   experimentJs = baseExpJs;
+   samplerJs.erase("Chain Count");
+   ASSERT_ANY_THROW(sampler->setConfiguration(samplerJs));
+
+   samplerJs = baseOptJs;
+   experimentJs = baseExpJs;
+   samplerJs["Chain Count"] = "Not a Number";
+   ASSERT_ANY_THROW(sampler->setConfiguration(samplerJs));
+
+   samplerJs = baseOptJs;
+   experimentJs = baseExpJs;
+   samplerJs["Chain Count"] = 4;
+   ASSERT_NO_THROW(sampler->setConfiguration(samplerJs));
+
+   samplerJs = baseOptJs;
+   experimentJs = baseExpJs;
+   samplerJs.erase("Chain Interaction");
+   ASSERT_ANY_THROW(sampler->setConfiguration(samplerJs));
+
+   samplerJs = baseOptJs;
+   experimentJs = baseExpJs;
+   samplerJs["Chain Interaction"] = "Undefined";
+   ASSERT_ANY_THROW(sampler->setConfiguration(samplerJs));
+
+   samplerJs = baseOptJs;
+   experimentJs = baseExpJs;
+   samplerJs["Chain Interaction"] = "Differential Evolution";
+   ASSERT_NO_THROW(sampler->setConfiguration(samplerJs));
+
+   samplerJs = baseOptJs;
+   experimentJs = baseExpJs;
+   samplerJs["Chain Interaction"] = "Parallel Tempering";
+   ASSERT_NO_THROW(sampler->setConfiguration(samplerJs));
+
+   samplerJs = baseOptJs;
+   experimentJs = baseExpJs;
+   samplerJs.erase("Differential Evolution Scaling");
+   ASSERT_ANY_THROW(sampler->setConfiguration(samplerJs));
+
+   samplerJs = baseOptJs;
+   experimentJs = baseExpJs;
+   samplerJs["Differential Evolution Scaling"] = "Not a Number";
+   ASSERT_ANY_THROW(sampler->setConfiguration(samplerJs));
+
+   samplerJs = baseOptJs;
+   experimentJs = baseExpJs;
+   samplerJs["Differential Evolution Scaling"] = 0.5;
+   ASSERT_NO_THROW(sampler->setConfiguration(samplerJs));
+
+   samplerJs = baseOptJs;
+   experimentJs = baseExpJs;
+   samplerJs.erase("Tempering Ratio");
+   ASSERT_ANY_THROW(sampler->setConfiguration(samplerJs));
+
+   samplerJs = baseOptJs;
+   experimentJs = baseExpJs;
+   samplerJs["Tempering Ratio"] = "Not a Number";
+   ASSERT_ANY_THROW(sampler->setConfiguration(samplerJs));
+
+   samplerJs = baseOptJs;
+   experimentJs = baseExpJs;
+   samplerJs["Tempering Ratio"] = 2.0;
+   ASSERT_NO_THROW(sampler->setConfiguration(samplerJs));
+
    samplerJs = baseOptJs;
    experimentJs = baseExpJs;
    samplerJs["Termination Criteria"].erase("Max Samples");
@@ -583,6 +671,15 @@ namespace
    e["Problem"]["Type"] = "Bayesian/Reference";
    ASSERT_NO_THROW(sampler->setInitialConfiguration());
 
+   // Test chain length balancing (with a single worker, no splitting pays off)
+   e._overrideEngine = true;
+   sampler->_maxChainLength = 16;
+   ASSERT_EQ(sampler->getBalancedChainLength(std::vector<unsigned int>({4, 0, 0, 1}), 2), 4);
+   sampler->_maxChainLength = 2;
+   ASSERT_EQ(sampler->getBalancedChainLength(std::vector<unsigned int>({4, 0, 0, 1}), 0), 2);
+   sampler->_maxChainLength = 1;
+   e._overrideEngine = false;
+
    // Testing optional parameters
    samplerJs = baseOptJs;
    experimentJs = baseExpJs;
@@ -621,7 +718,7 @@ namespace
 
    samplerJs = baseOptJs;
    experimentJs = baseExpJs;
-   samplerJs["Chain Candidates"] = std::vector<std::vector<double>>({{0.0}});
+   samplerJs["Chain Candidates"] = std::vector<double>({0.0});
    ASSERT_NO_THROW(sampler->setConfiguration(samplerJs));
 
    samplerJs = baseOptJs;
@@ -651,7 +748,7 @@ namespace
 
    samplerJs = baseOptJs;
    experimentJs = baseExpJs;
-   samplerJs["Chain Candidates Gradients"] = std::vector<std::vector<double>>({{0.0}});
+   samplerJs["Chain Candidates Gradients"] = std::vector<double>({0.0});
    ASSERT_NO_THROW(sampler->setConfiguration(samplerJs));
 
    samplerJs = baseOptJs;
@@ -671,7 +768,7 @@ namespace
 
    samplerJs = baseOptJs;
    experimentJs = baseExpJs;
-   samplerJs["Chain Candidates Covariance"] = std::vector<std::vector<double>>({{0.0}});
+   samplerJs["Chain Candidates Covariance"] = std::vector<double>({0.0});
    ASSERT_NO_THROW(sampler->setConfiguration(samplerJs));
 
    samplerJs = baseOptJs;
@@ -681,7 +778,7 @@ namespace
 
    samplerJs = baseOptJs;
    experimentJs = baseExpJs;
-   samplerJs["Chain Leaders"] = std::vector<std::vector<double>>({{0.0}});
+   samplerJs["Chain Leaders"] = std::vector<double>({0.0});
    ASSERT_NO_THROW(sampler->setConfiguration(samplerJs));
 
    samplerJs = baseOptJs;
@@ -711,7 +808,7 @@ namespace
 
    samplerJs = baseOptJs;
    experimentJs = baseExpJs;
-   samplerJs["Chain Leaders Covariance"] = std::vector<std::vector<double>>({{0.0}});
+   samplerJs["Chain Leaders Covariance"] = std::vector<double>({0.0});
    ASSERT_NO_THROW(sampler->setConfiguration(samplerJs));
 
    samplerJs = baseOptJs;
@@ -721,7 +818,7 @@ namespace
 
    samplerJs = baseOptJs;
    experimentJs = baseExpJs;
-   samplerJs["Chain Leaders Gradients"] = std::vector<std::vector<double>>({{0.0}});
+   samplerJs["Chain Leaders Gradients"] = std::vector<double>({0.0});
    ASSERT_NO_THROW(sampler->setConfiguration(samplerJs));
 
    samplerJs = baseOptJs;
@@ -901,7 +998,7 @@ namespace
 
    samplerJs = baseOptJs;
    experimentJs = baseExpJs;
-   samplerJs["Sample Database"] = std::vector<std::vector<double>>({{0.0}});
+   samplerJs["Sample Database"] = std::vector<double>({0.0});
    ASSERT_NO_THROW(sampler->setConfiguration(samplerJs));
 
    samplerJs = baseOptJs;
@@ -931,7 +1028,7 @@ namespace
 
    samplerJs = baseOptJs;
    experimentJs = baseExpJs;
-   samplerJs["Sample Gradient Database"] = std::vector<std::vector<double>>({{0.0}});
+   samplerJs["Sample Gradient Database"] = std::vector<double>({0.0});
    ASSERT_NO_THROW(sampler->setConfiguration(samplerJs));
 
    samplerJs = baseOptJs;
@@ -951,7 +1048,7 @@ namespace
 
    samplerJs = baseOptJs;
    experimentJs = baseExpJs;
-   samplerJs["Sample Covariance Database"] = std::vector<std::vector<double>>({{0.0}});
+   samplerJs["Sample Covariance Database"] = std::vector<double>({0.0});
    ASSERT_NO_THROW(sampler->setConfiguration(samplerJs));
 
    samplerJs = baseOptJs;
@@ -1091,6 +1188,21 @@ namespace
    samplerJs["Max Chain Length"] = 16;
    ASSERT_NO_THROW(sampler->setConfiguration(samplerJs));
 
+   samplerJs = baseOptJs;
+   experimentJs = baseExpJs;
+   samplerJs.erase("Balance Chain Lengths");
+   ASSERT_ANY_THROW(sampler->setConfiguration(samplerJs));
+
+   samplerJs = baseOptJs;
+   experimentJs = baseExpJs;
+   samplerJs["Balance Chain Lengths"] = "Not a Number";
+   ASSERT_ANY_THROW(sampler->setConfiguration(samplerJs));
+
+   samplerJs = baseOptJs;
+   experimentJs = baseExpJs;
+   samplerJs["Balance Chain Lengths"] = true;
+   ASSERT_NO_THROW(sampler->setConfiguration(samplerJs));
+
    samplerJs = baseOptJs;
    experimentJs = baseExpJs;
    samplerJs.erase("Burn In");
@@ -1227,6 +1339,39 @@ namespace
    ASSERT_NO_THROW(sampler->setConfiguration(samplerJs));
   }
 
+  // Standard normal likelihood
+  void tmcmcResumeTestModel(Sample &s)
+  {
+   auto x = s["Parameters"][0].get<double>();
+   s["logLikelihood"] = -0.5 * x * x;
+  }
+
+  TEST(samplers, TMCMCResume)
+  {
+   Experiment e;
+   e["Problem"]["Type"] = "Bayesian/Custom";
+   e["Problem"]["Likelihood Model"] = &tmcmcResumeTestModel;
+   e["Distributions"][0]["Name"] = "Uniform 0";
+   e["Distributions"][0]["Type"] = "Univariate/Uniform";
+   e["Distributions"][0]["Minimum"] = -10.0;
+   e["Distributions"][0]["Maximum"] = +10.0;
+   e["Variables"][0]["Name"] = "X";
+   e["Variables"][0]["Prior Distribution"] = "Uniform 0";
+   e["Solver"]["Type"] = "Sampler/TMCMC";
+   e["Solver"]["Population Size"] = 500;
+   e["Solver"]["Termination Criteria"]["Max Generations"] = 2;
+   e["File Output"]["Enabled"] = false;
+   e["Console Output"]["Verbosity"] = "Silent";
+
+   Engine k;
+   ASSERT_NO_THROW(k.run(e));
+
+   // The resumed solver is created from the saved state, and must draw the next proposals from it
+   e["Solver"]["Termination Criteria"]["Max Generations"] = 4;
+   ASSERT_NO_THROW(k.run(e));
+   ASSERT_EQ(e["Current Generation"].get<size_t>(), 4);
+  }
+
   //////////////// HMC CLASS ////////////////////////
 
   TEST(samplers, HMC)
@@ -1317,6 +1462,18 @@ namespace
    sampler->_initialFastAdaptionInterval = 300;
    ASSERT_NO_THROW(sampler->setInitialConfiguration());
 
+   sampler->_chainCount = 0;
+   ASSERT_ANY_THROW(sampler->setInitialConfiguration());
+
+   sampler->_chainCount = 4;
+   ASSERT_NO_THROW(sampler->setInitialConfiguration());
+   ASSERT_EQ(sampler->_chainPositionLeaders.size(), 3);
+
+   sampler->_version = "Riemannian Const";
+   ASSERT_ANY_THROW(sampler->setInitialConfiguration());
+   sampler->_version = "Euclidean";
+   sampler->_chainCount = 1;
+
    sampler->_version = "Euclidean";
    sampler->_useAdaptiveStepSize = true;
    sampler->_burnIn = 0;
@@ -1889,6 +2046,21 @@ namespace
    samplerJs["Initial Slow Adaption Interval"] = 1;
    ASSERT_NO_THROW(sampler->setConfiguration(samplerJs));
 
+   samplerJs = baseOptJs;
+   experimentJs = baseExpJs;
+   samplerJs.erase("Chain Count");
+   ASSERT_ANY_THROW(sampler->setConfiguration(samplerJs));
+
+   samplerJs = baseOptJs;
+   experimentJs = baseExpJs;
+   samplerJs["Chain Count"] = "Not a Number";
+   ASSERT_ANY_THROW(sampler->setConfiguration(samplerJs));
+
+   samplerJs = baseOptJs;
+   experimentJs = baseExpJs;
+   samplerJs["Chain Count"] = 4;
+   ASSERT_NO_THROW(sampler->setConfiguration(samplerJs));
+
    samplerJs = baseOptJs;
    experimentJs = baseExpJs;
    samplerJs["Termination Criteria"].erase("Max Samples");
@@ -2096,6 +2268,42 @@ namespace
    e._problem = pS;
   }
 
+  // Standard normal distribution, which slows down the evaluations of lower x so that the chains finish them out of order
+  void hmcChainsTestModel(Sample &s)
+  {
+   auto x = s["Parameters"][0].get<double>();
+   usleep((useconds_t)(std::min(std::max(2.0 - x, 0.0), 4.0) * 100));
+   s["logP(x)"] = -0.5 * x * x;
+   s["grad(logP(x))"] = std::vector<double>({ -x });
+  }
+
+  TEST(samplers, HMCChains)
+  {
+   // Several chains must run to completion, whether their samples finish right away (sequential) or later (concurrent)
+   for (std::string conduitType : { "Sequential", "Concurrent" })
+   {
+    Experiment e;
+    e["Problem"]["Type"] = "Sampling";
+    e["Problem"]["Probability Function"] = &hmcChainsTestModel;
+    e["Variables"][0]["Name"] = "X";
+    e["Variables"][0]["Initial Mean"] = 0.0;
+    e["Variables"][0]["Initial Standard Deviation"] = 1.0;
+    e["Solver"]["Type"] = "Sampler/HMC";
+    e["Solver"]["Burn In"] = 10;
+    e["Solver"]["Chain Count"] = 4;
+    e["Solver"]["Termination Criteria"]["Max Samples"] = 100;
+    e["File Output"]["Enabled"] = false;
+    e["Console Output"]["Verbosity"] = "Silent";
+
+    Engine k;
+    k["Conduit"]["Type"] = conduitType;
+    if (conduitType == "Concurrent") k["Conduit"]["Concurrent Jobs"] = 2;
+    ASSERT_NO_THROW(k.run(e));
+
+    ASSERT_GE(e["Results"]["Sample Database"].size(), 100);
+   }
+  }
+
   //////////////// Nested CLASS ////////////////////////
 
   TEST(samplers, Nested)
@@ -2423,7 +2631,7 @@ namespace
 
    samplerJs = baseOptJs;
    experimentJs = baseExpJs;
-   samplerJs["Live Samples"] = std::vector<std::vector<double>>({{1.0}});
+   samplerJs["Live Samples"] = std::vector<double>({1.0});
    ASSERT_NO_THROW(sampler->setConfiguration(samplerJs));
 
    samplerJs = baseOptJs;
@@ -2731,6 +2939,93 @@ namespace
    ASSERT_NO_THROW(ellipse.initSphere());
    ASSERT_NO_THROW(ellipse.scaleVolume(1.0));
 
+   // Testing the ellipsoid updates against their scalar definitions, on two correlated clusters in three dimensions
+   const size_t D = 3;
+   const size_t N = 200;
+   sampler->_variableCount = D;
+   sampler->_numberLivePoints = N;
+   sampler->_logVolume = 0.0;
+   sampler->_liveSamples.resize(N * D);
+   std::mt19937 rng(1337);
+   std::normal_distribution<double> normal(0.0, 0.05);
+   for (size_t i = 0; i < N; i++)
+   {
+    const double z = normal(rng);
+    for (size_t d = 0; d < D; d++) sampler->_liveSamples[i * D + d] = (i % 2 == 0 ? 0.25 : 0.75) + z + normal(rng);
+   }
+
+   ellipse_t parent(D);
+   parent.num = N;
+   parent.sampleIdx.resize(N);
+   std::iota(parent.sampleIdx.begin(), parent.sampleIdx.end(), 0);
+   sampler->updateEllipseMean(parent);
+   ASSERT_TRUE(sampler->updateEllipseCov(parent));
+   ASSERT_TRUE(sampler->updateEllipseVolume(parent));
+
+   // Mahalanobis distance with the inverse covariance (x - mean)^T C^-1 (x - mean)
+   std::vector<double> points(sampler->_liveSamples.begin(), sampler->_liveSamples.begin() + 20 * D);
+   std::vector<double> distances;
+   sampler->mahalanobisDistances(parent, points, distances);
+   ASSERT_EQ(distances.size(), 20);
+   for (size_t i = 0; i < 20; i++)
+   {
+    double distance = 0.0;
+    for (size_t j = 0; j < D; j++)
+     for (size_t k = 0; k < D; k++)
+      distance += (points[i * D + j] - parent.mean[j]) * parent.invCov[j * D + k] * (points[i * D + k] - parent.mean[k]);
+
+    ASSERT_NEAR(distances[i], distance, 1e-8 * (1.0 + distance));
+    ASSERT_NEAR(sampler->mahalanobisDistance(std::vector<double>(points.begin() + i * D, points.begin() + (i + 1) * D), parent), distance, 1e-8 * (1.0 + distance));
+   }
+
+   // K-means split with the euclidean distances to both means, starting at the ends of the longest axis
+   std::vector<double> meanOne(D), meanTwo(D);
+   for (size_t d = 0; d < D; d++)
+   {
+    meanOne[d] = parent.mean[d] + parent.paxes[d * D] * parent.evals[0];
+    meanTwo[d] = parent.mean[d] - parent.paxes[d * D] * parent.evals[0];
+   }
+
+   std::vector<size_t> clusterOne, clusterTwo;
+   for (size_t iter = 0; iter < 100; iter++)
+   {
+    std::vector<size_t> one, two;
+    for (size_t i = 0; i < N; i++)
+    {
+     double distanceOne = 0.0, distanceTwo = 0.0;
+     for (size_t d = 0; d < D; d++)
+     {
+      distanceOne += std::pow(sampler->_liveSamples[i * D + d] - meanOne[d], 2);
+      distanceTwo += std::pow(sampler->_liveSamples[i * D + d] - meanTwo[d], 2);
+     }
+     if (distanceOne < distanceTwo) one.push_back(i); else two.push_back(i);
+    }
+
+    if (one == clusterOne && two == clusterTwo) break;
+    clusterOne = one;
+    clusterTwo = two;
+
+    std::fill(meanOne.begin(), meanOne.end(), 0.0);
+    std::fill(meanTwo.begin(), meanTwo.end(), 0.0);
+    for (size_t i : one) for (size_t d = 0; d < D; d++) meanOne[d] += sampler->_liveSamples[i * D + d] / one.size();
+    for (size_t i : two) for (size_t d = 0; d < D; d++) meanTwo[d] += sampler->_liveSamples[i * D + d] / two.size();
+   }
+
+   ellipse_t childOne(D), childTwo(D);
+   ASSERT_TRUE(sampler->kmeansClustering(parent, 100, childOne, childTwo));
+   ASSERT_EQ(childOne.sampleIdx, clusterOne);
+   ASSERT_EQ(childTwo.sampleIdx, clusterTwo);
+   ASSERT_EQ(childOne.num + childTwo.num, N);
+
+   // Fewer samples than dimensions, sharing a coordinate, still give a (diagonal) cholesky factor
+   sampler->_liveSamples = std::vector<double>({0.5, 0.1, 0.2, 0.5, 0.3, 0.4});
+   ellipse_t small(D);
+   small.num = 2;
+   small.sampleIdx = std::vector<size_t>({0, 1});
+   sampler->updateEllipseMean(small);
+   ASSERT_TRUE(sampler->updateEllipseCov(small));
+   ASSERT_GT(small.axes[0], 0.0);
+
    // Testing termination criteria
    e._currentGeneration = 2;
    sampler->_lStar = 1.0;
@@ -1,6 +1,7 @@
 #include "gtest/gtest.h"
 #include "korali.hpp"
 #include "sample/sample.hpp"
+#include <cstring>
 
 namespace
 {
@@ -23,4 +24,50 @@ namespace
   ASSERT_ANY_THROW(s1.get<int>("", 0, "Unknown"));
  }
 
+ TEST(Sample, binaryBuffers)
+ {
+  Sample s;
+  ASSERT_TRUE(s._buffers.empty());
+
+  s.doubleBuffer("Parameters") = std::vector<double>({1.0, 2.0, 3.0});
+  s.floatBuffer("Input Data") = std::vector<float>({4.0f, 5.0f});
+  ASSERT_FALSE(s._buffers.empty());
+
+  // Header describes buffers in transfer order: doubles first, then floats
+  auto header = s._buffers.getHeader();
+  ASSERT_EQ(header.size(), 2);
+  ASSERT_EQ(header[0]["Name"], "Parameters");
+  ASSERT_EQ(header[0]["Type"], "double");
+  ASSERT_EQ(header[0]["Size"], 3);
+  ASSERT_EQ(header[1]["Name"], "Input Data");
+  ASSERT_EQ(header[1]["Type"], "float");
+  ASSERT_EQ(header[1]["Size"], 2);
+
+  // Allocating from the header and copying raw bytes reproduces the buffers
+  SampleBuffers received;
+  ASSERT_NO_THROW(received.allocate(header));
+  std::vector<std::pair<void *, size_t>> src, dst;
+  s._buffers.forEachBuffer([&](void *data, size_t size) { src.push_back({data, size}); });
+  received.forEachBuffer([&](void *data, size_t size) { dst.push_back({data, size}); });
+  ASSERT_EQ(src.size(), dst.size());
+  for (size_t i = 0; i < src.size(); i++)
+  {
+   ASSERT_EQ(src[i].second, dst[i].second);
+   memcpy(dst[i].first, src[i].first, src[i].second);
+  }
+  ASSERT_EQ(received._double["Parameters"][2], 3.0);
+  ASSERT_EQ(received._float["Input Data"][1], 5.0f);
+
+  // Swapping hands over storage without copying
+  const double *ptr = s.doubleBuffer("Parameters").data();
+  SampleBuffers other;
+  other.swap(s._buffers);
+  ASSERT_TRUE(s._buffers.empty());
+  ASSERT_EQ(other._double["Parameters"].data(), ptr);
+
+  // Unknown buffer types are rejected
+  header[0]["Type"] = "int";
+  ASSERT_ANY_THROW(received.allocate(header));
+ }
+
 } // namespace